@@ -92,7 +92,7 @@ int bitexact_log2tan(int isin,int icos)
 
 #ifdef FIXED_POINT
 /* Compute the amplitude (sqrt energy) in each of the bands */
-void compute_band_energies(const CELTMode *m, const celt_sig *X, celt_ener *bandE, int end, int C, int LM, int arch)
+void compute_band_energies_c(const CELTMode *m, const celt_sig *X, celt_ener *bandE, int end, int C, int LM, int arch)
 {
    int i, c, N;
    const opus_int16 *eBands = m->eBands;
@@ -134,10 +134,11 @@ void compute_band_energies(const CELTMode *m, const celt_sig *X, celt_ener *band
 }
 
 /* Normalise each band such that the energy is one. */
-void normalise_bands(const CELTMode *m, const celt_sig * OPUS_RESTRICT freq, celt_norm * OPUS_RESTRICT X, const celt_ener *bandE, int end, int C, int M)
+void normalise_bands_c(const CELTMode *m, const celt_sig * OPUS_RESTRICT freq, celt_norm * OPUS_RESTRICT X, const celt_ener *bandE, int end, int C, int M, int arch)
 {
    int i, c, N;
    const opus_int16 *eBands = m->eBands;
+   (void)arch;
    N = M*m->shortMdctSize;
    c=0; do {
       i=0; do {
@@ -156,7 +157,7 @@ void normalise_bands(const CELTMode *m, const celt_sig * OPUS_RESTRICT freq, cel
 
 #else /* FIXED_POINT */
 /* Compute the amplitude (sqrt energy) in each of the bands */
-void compute_band_energies(const CELTMode *m, const celt_sig *X, celt_ener *bandE, int end, int C, int LM, int arch)
+void compute_band_energies_c(const CELTMode *m, const celt_sig *X, celt_ener *bandE, int end, int C, int LM, int arch)
 {
    int i, c, N;
    const opus_int16 *eBands = m->eBands;
@@ -174,10 +175,11 @@ void compute_band_energies(const CELTMode *m, const celt_sig *X, celt_ener *band
 }
 
 /* Normalise each band such that the energy is one. */
-void normalise_bands(const CELTMode *m, const celt_sig * OPUS_RESTRICT freq, celt_norm * OPUS_RESTRICT X, const celt_ener *bandE, int end, int C, int M)
+void normalise_bands_c(const CELTMode *m, const celt_sig * OPUS_RESTRICT freq, celt_norm * OPUS_RESTRICT X, const celt_ener *bandE, int end, int C, int M, int arch)
 {
    int i, c, N;
    const opus_int16 *eBands = m->eBands;
+   (void)arch;
    N = M*m->shortMdctSize;
    c=0; do {
       for (i=0;i<end;i++)
@@ -193,15 +195,16 @@ void normalise_bands(const CELTMode *m, const celt_sig * OPUS_RESTRICT freq, cel
 #endif /* FIXED_POINT */
 
 /* De-normalise the energy to produce the synthesis from the unit-energy bands */
-void denormalise_bands(const CELTMode *m, const celt_norm * OPUS_RESTRICT X,
+void denormalise_bands_c(const CELTMode *m, const celt_norm * OPUS_RESTRICT X,
       celt_sig * OPUS_RESTRICT freq, const opus_val16 *bandLogE, int start,
-      int end, int M, int downsample, int silence)
+      int end, int M, int downsample, int silence, int arch)
 {
    int i, N;
    int bound;
    celt_sig * OPUS_RESTRICT f;
    const celt_norm * OPUS_RESTRICT x;
    const opus_int16 *eBands = m->eBands;
+   (void)arch;
    N = M*m->shortMdctSize;
    bound = M*eBands[end];
    if (downsample!=1)
@@ -629,7 +632,7 @@ static void interleave_hadamard(celt_norm *X, int N0, int stride, int hadamard)
    RESTORE_STACK;
 }
 
-void haar1(celt_norm *X, int N0, int stride)
+void haar1_c(celt_norm *X, int N0, int stride)
 {
    int i, j;
    N0 >>= 1;
@@ -644,6 +647,19 @@ void haar1(celt_norm *X, int N0, int stride)
       }
 }
 
+opus_val32 l1_metric_c(const celt_norm *tmp, int N, int LM, opus_val16 bias)
+{
+   int i;
+   opus_val32 L1;
+   L1 = 0;
+   for (i=0;i<N;i++)
+      L1 += EXTEND32(ABS16(tmp[i]));
+   /* When in doubt, prefer good freq resolution */
+   L1 = MAC16_32_Q15(L1, LM*bias, L1);
+   return L1;
+
+}
+
 static int compute_qn(int N, int b, int offset, int pulse_cap, int stereo)
 {
    static const opus_int16 exp2_table8[8] =
@@ -1153,9 +1169,9 @@ static unsigned quant_band(struct band_ctx *ctx, celt_norm *X,
             0,1,1,1,2,3,3,3,2,3,3,3,2,3,3,3
       };
       if (encode)
-         haar1(X, N>>k, 1<<k);
+         haar1(X, N>>k, 1<<k, ctx->arch);
       if (lowband)
-         haar1(lowband, N>>k, 1<<k);
+         haar1(lowband, N>>k, 1<<k, ctx->arch);
       fill = bit_interleave_table[fill&0xF]|bit_interleave_table[fill>>4]<<2;
    }
    B>>=recombine;
@@ -1165,9 +1181,9 @@ static unsigned quant_band(struct band_ctx *ctx, celt_norm *X,
    while ((N_B&1) == 0 && tf_change<0)
    {
       if (encode)
-         haar1(X, N_B, B);
+         haar1(X, N_B, B, ctx->arch);
       if (lowband)
-         haar1(lowband, N_B, B);
+         haar1(lowband, N_B, B, ctx->arch);
       fill |= fill<<B;
       B <<= 1;
       N_B >>= 1;
@@ -1203,7 +1219,7 @@ static unsigned quant_band(struct band_ctx *ctx, celt_norm *X,
          B >>= 1;
          N_B <<= 1;
          cm |= cm>>B;
-         haar1(X, N_B, B);
+         haar1(X, N_B, B, ctx->arch);
       }
 
       for (k=0;k<recombine;k++)
@@ -1213,7 +1229,7 @@ static unsigned quant_band(struct band_ctx *ctx, celt_norm *X,
                0xC0,0xC3,0xCC,0xCF,0xF0,0xF3,0xFC,0xFF
          };
          cm = bit_deinterleave_table[cm];
-         haar1(X, N0>>k, 1<<k);
+         haar1(X, N0>>k, 1<<k, ctx->arch);
       }
       B<<=recombine;
 
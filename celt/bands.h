@@ -44,7 +44,7 @@ int bitexact_log2tan(int isin,int icos);
  * @param X Spectrum
  * @param bandE Square root of the energy for each band (returned)
  */
-void compute_band_energies(const CELTMode *m, const celt_sig *X, celt_ener *bandE, int end, int C, int LM, int arch);
+void compute_band_energies_c(const CELTMode *m, const celt_sig *X, celt_ener *bandE, int end, int C, int LM, int arch);
 
 /*void compute_noise_energies(const CELTMode *m, const celt_sig *X, const opus_val16 *tonality, celt_ener *bandE);*/
 
@@ -54,16 +54,57 @@ void compute_band_energies(const CELTMode *m, const celt_sig *X, celt_ener *band
  * @param X Spectrum (returned normalised)
  * @param bandE Square root of the energy for each band
  */
-void normalise_bands(const CELTMode *m, const celt_sig * OPUS_RESTRICT freq, celt_norm * OPUS_RESTRICT X, const celt_ener *bandE, int end, int C, int M);
+void normalise_bands_c(const CELTMode *m, const celt_sig * OPUS_RESTRICT freq, celt_norm * OPUS_RESTRICT X, const celt_ener *bandE, int end, int C, int M, int arch);
 
 /** Denormalise each band of X to restore full amplitude
  * @param m Mode data
  * @param X Spectrum (returned de-normalised)
  * @param bandE Square root of the energy for each band
  */
-void denormalise_bands(const CELTMode *m, const celt_norm * OPUS_RESTRICT X,
+void denormalise_bands_c(const CELTMode *m, const celt_norm * OPUS_RESTRICT X,
       celt_sig * OPUS_RESTRICT freq, const opus_val16 *bandE, int start,
-      int end, int M, int downsample, int silence);
+      int end, int M, int downsample, int silence, int arch);
+
+/** Applies one level of the Haar transform along the stride, combining
+    pairs of rows of X
+ * @param X Band coefficients (modified in place)
+ * @param N0 Number of rows
+ * @param stride Number of columns
+ */
+void haar1_c(celt_norm *X, int N0, int stride);
+
+/** L1 norm of a band for tf_analysis(), biased by LM to prefer good
+    frequency resolution */
+opus_val32 l1_metric_c(const celt_norm *tmp, int N, int LM, opus_val16 bias);
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2) || defined(OPUS_X86_MAY_HAVE_AVX2)
+#include "x86/bands_sse.h"
+#endif
+
+#ifndef OVERRIDE_COMPUTE_BAND_ENERGIES
+#define compute_band_energies(m, X, bandE, end, C, LM, arch) \
+    (compute_band_energies_c(m, X, bandE, end, C, LM, arch))
+#endif
+
+#ifndef OVERRIDE_NORMALISE_BANDS
+#define normalise_bands(m, freq, X, bandE, end, C, M, arch) \
+    (normalise_bands_c(m, freq, X, bandE, end, C, M, arch))
+#endif
+
+#ifndef OVERRIDE_DENORMALISE_BANDS
+#define denormalise_bands(m, X, freq, bandE, start, end, M, downsample, silence, arch) \
+    (denormalise_bands_c(m, X, freq, bandE, start, end, M, downsample, silence, arch))
+#endif
+
+#ifndef OVERRIDE_HAAR1
+#define haar1(X, N0, stride, arch) \
+    ((void)(arch), haar1_c(X, N0, stride))
+#endif
+
+#ifndef OVERRIDE_L1_METRIC
+#define l1_metric(tmp, N, LM, bias, arch) \
+    ((void)(arch), l1_metric_c(tmp, N, LM, bias))
+#endif
 
 #define SPREAD_NONE       (0)
 #define SPREAD_LIGHT      (1)
@@ -78,8 +119,6 @@ int spreading_decision(const CELTMode *m, const celt_norm *X, int *average,
 void measure_norm_mse(const CELTMode *m, float *X, float *X0, float *bandE, float *bandE0, int M, int N, int C);
 #endif
 
-void haar1(celt_norm *X, int N0, int stride);
-
 /** Quantisation/encoding of the residual spectrum
  * @param encode flag that indicates whether we're encoding (1) or decoding (0)
  * @param m Mode data
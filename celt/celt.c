@@ -300,6 +300,101 @@ const char *opus_strerror(int error)
       return error_strings[-error];
 }
 
+int opus_set_allocator(opus_alloc_func alloc_fn, opus_free_func free_fn,
+      void *user_data)
+{
+#if defined(OVERRIDE_OPUS_ALLOC) || defined(OVERRIDE_OPUS_FREE)
+   /* opus_alloc()/opus_free() are replaced at build time and would ignore
+      the callbacks */
+   (void)alloc_fn;
+   (void)free_fn;
+   (void)user_data;
+   return OPUS_UNIMPLEMENTED;
+#else
+   /* Two slots, so that the struct being filled in is never the published
+      one */
+   static OpusAllocator slots[2];
+   const OpusAllocator *current;
+   OpusAllocator *next;
+   if ((alloc_fn == NULL) != (free_fn == NULL))
+      return OPUS_BAD_ARG;
+   if (alloc_fn == NULL)
+   {
+      OPUS_ALLOCATOR_STORE(NULL);
+      return OPUS_OK;
+   }
+   current = OPUS_ALLOCATOR_LOAD();
+   next = current == &slots[0] ? &slots[1] : &slots[0];
+   next->alloc = alloc_fn;
+   next->free = free_fn;
+   next->user_data = user_data;
+   OPUS_ALLOCATOR_STORE(next);
+   return OPUS_OK;
+#endif
+}
+
+#ifdef SCRATCH_ARENA
+# ifdef ENABLE_VALGRIND
+/* The valgrind PUSH() leaves a guard gap after every allocation */
+#  define SCRATCH_ARENA_SIZE (GLOBAL_STACK_SIZE*2)
+# else
+#  define SCRATCH_ARENA_SIZE GLOBAL_STACK_SIZE
+# endif
+#endif
+
+opus_int32 opus_scratch_arena_get_size(void)
+{
+#ifdef SCRATCH_ARENA
+   return SCRATCH_ARENA_SIZE;
+#else
+   return 0;
+#endif
+}
+
+int opus_scratch_arena_init(void *buf, opus_int32 size)
+{
+#ifdef SCRATCH_ARENA
+   char *arena;
+   if (size < SCRATCH_ARENA_SIZE)
+      return OPUS_BAD_ARG;
+   arena = (char *)buf;
+   if (arena == NULL)
+   {
+      arena = (char *)opus_alloc_scratch(size);
+      if (arena == NULL)
+         return OPUS_ALLOC_FAIL;
+   }
+   opus_scratch_arena_release();
+   scratch_ptr = global_stack = arena;
+   scratch_owned = buf == NULL;
+#ifdef ENABLE_VALGRIND
+   global_stack_top = arena + size;
+#endif
+   return OPUS_OK;
+#else
+   (void)buf;
+   (void)size;
+   return OPUS_UNIMPLEMENTED;
+#endif
+}
+
+void opus_scratch_arena_release(void)
+{
+#ifdef SCRATCH_ARENA
+   if (scratch_owned)
+      opus_free_scratch(scratch_ptr);
+#ifdef ENABLE_VALGRIND
+   else if (scratch_ptr != NULL)
+      VALGRIND_MAKE_MEM_UNDEFINED(scratch_ptr, global_stack_top-scratch_ptr);
+#endif
+   scratch_ptr = global_stack = NULL;
+   scratch_owned = 0;
+#ifdef ENABLE_VALGRIND
+   global_stack_top = NULL;
+#endif
+#endif
+}
+
 const char *opus_get_version_string(void)
 {
     return "libopus " PACKAGE_VERSION
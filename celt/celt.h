@@ -210,9 +210,36 @@ extern const signed char tf_select_table[4][8];
 
 int resampling_factor(opus_int32 rate);
 
-void celt_preemphasis(const opus_val16 * OPUS_RESTRICT pcmp, celt_sig * OPUS_RESTRICT inp,
+void celt_preemphasis_c(const opus_val16 * OPUS_RESTRICT pcmp, celt_sig * OPUS_RESTRICT inp,
                         int N, int CC, int upsample, const opus_val16 *coef, celt_sig *mem, int clip);
 
+void deemphasis_c(celt_sig *in[], opus_val16 *pcm, int N, int C, int downsample,
+      const opus_val16 *coef, celt_sig *mem, int accum);
+
+void transient_masking_curve_c(const opus_val32 * OPUS_RESTRICT in,
+      opus_val16 * OPUS_RESTRICT tmp, int len, int allow_weak_transients,
+      opus_val32 *mean, opus_val16 *maxE);
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+#include "x86/emphasis_sse.h"
+#include "x86/transient_sse.h"
+#endif
+
+#ifndef OVERRIDE_CELT_PREEMPHASIS
+#define celt_preemphasis(pcmp, inp, N, CC, upsample, coef, mem, clip, arch) \
+    ((void)(arch), celt_preemphasis_c(pcmp, inp, N, CC, upsample, coef, mem, clip))
+#endif
+
+#ifndef OVERRIDE_DEEMPHASIS
+#define deemphasis(in, pcm, N, C, downsample, coef, mem, accum, arch) \
+    ((void)(arch), deemphasis_c(in, pcm, N, C, downsample, coef, mem, accum))
+#endif
+
+#ifndef OVERRIDE_TRANSIENT_MASKING_CURVE
+#define transient_masking_curve(in, tmp, len, allow_weak_transients, mean, maxE, arch) \
+    ((void)(arch), transient_masking_curve_c(in, tmp, len, allow_weak_transients, mean, maxE))
+#endif
+
 void comb_filter(opus_val32 *y, opus_val32 *x, int T0, int T1, int N,
       opus_val16 g0, opus_val16 g1, int tapset0, int tapset1,
       const opus_val16 *window, int overlap, int arch);
@@ -230,7 +257,6 @@ void comb_filter_const_c(opus_val32 *y, opus_val32 *x, int T, int N,
 void init_caps(const CELTMode *m,int *cap,int LM,int C);
 
 #ifdef RESYNTH
-void deemphasis(celt_sig *in[], opus_val16 *pcm, int N, int C, int downsample, const opus_val16 *coef, celt_sig *mem);
 void celt_synthesis(const CELTMode *mode, celt_norm *X, celt_sig * out_syn[],
       opus_val16 *oldBandE, int start, int effEnd, int C, int CC, int isTransient,
       int LM, int downsample, int silence);
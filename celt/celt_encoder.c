@@ -224,17 +224,15 @@ void opus_custom_encoder_destroy(CELTEncoder *st)
 #endif /* CUSTOM_MODES */
 
 
-static int transient_analysis(const opus_val32 * OPUS_RESTRICT in, int len, int C,
-                              opus_val16 *tf_estimate, int *tf_chan, int allow_weak_transients,
-                              int *weak_transient)
+/* Computes the masking threshold of one channel for transient_analysis(),
+   on pairs of samples, in tmp[0...len/2-1]. Also returns the sum of the
+   energies of the pairs in *mean and the largest threshold in *maxE. */
+void transient_masking_curve_c(const opus_val32 * OPUS_RESTRICT in,
+      opus_val16 * OPUS_RESTRICT tmp, int len, int allow_weak_transients,
+      opus_val32 *mean, opus_val16 *maxE)
 {
    int i;
-   VARDECL(opus_val16, tmp);
    opus_val32 mem0,mem1;
-   int is_transient = 0;
-   opus_int32 mask_metric = 0;
-   int c;
-   opus_val16 tf_max;
    int len2;
    /* Forward masking: 6.7 dB/ms. */
 #ifdef FIXED_POINT
@@ -242,21 +240,6 @@ static int transient_analysis(const opus_val32 * OPUS_RESTRICT in, int len, int
 #else
    opus_val16 forward_decay = QCONST16(.0625f,15);
 #endif
-   /* Table of 6*64/x, trained on real data to minimize the average error */
-   static const unsigned char inv_table[128] = {
-         255,255,156,110, 86, 70, 59, 51, 45, 40, 37, 33, 31, 28, 26, 25,
-          23, 22, 21, 20, 19, 18, 17, 16, 16, 15, 15, 14, 13, 13, 12, 12,
-          12, 12, 11, 11, 11, 10, 10, 10,  9,  9,  9,  9,  9,  9,  8,  8,
-           8,  8,  8,  7,  7,  7,  7,  7,  7,  6,  6,  6,  6,  6,  6,  6,
-           6,  6,  6,  6,  6,  6,  6,  6,  6,  5,  5,  5,  5,  5,  5,  5,
-           5,  5,  5,  5,  5,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,
-           4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  3,  3,
-           3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  2,
-   };
-   SAVE_STACK;
-   ALLOC(tmp, len, opus_val16);
-
-   *weak_transient = 0;
    /* For lower bitrates, let's be more conservative and have a forward masking
       decay of 3.3 dB/ms. This avoids having to code transients at very low
       bitrate (mostly for hybrid), which can result in unstable energy and/or
@@ -270,80 +253,112 @@ static int transient_analysis(const opus_val32 * OPUS_RESTRICT in, int len, int
 #endif
    }
    len2=len/2;
-   for (c=0;c<C;c++)
+   mem0=0;
+   mem1=0;
+   /* High-pass filter: (1 - 2*z^-1 + z^-2) / (1 - z^-1 + .5*z^-2) */
+   for (i=0;i<len;i++)
    {
-      opus_val32 mean;
-      opus_int32 unmask=0;
-      opus_val32 norm;
-      opus_val16 maxE;
-      mem0=0;
-      mem1=0;
-      /* High-pass filter: (1 - 2*z^-1 + z^-2) / (1 - z^-1 + .5*z^-2) */
-      for (i=0;i<len;i++)
-      {
-         opus_val32 x,y;
-         x = SHR32(in[i+c*len],SIG_SHIFT);
-         y = ADD32(mem0, x);
+      opus_val32 x,y;
+      x = SHR32(in[i],SIG_SHIFT);
+      y = ADD32(mem0, x);
 #ifdef FIXED_POINT
-         mem0 = mem1 + y - SHL32(x,1);
-         mem1 = x - SHR32(y,1);
+      mem0 = mem1 + y - SHL32(x,1);
+      mem1 = x - SHR32(y,1);
 #else
-         mem0 = mem1 + y - 2*x;
-         mem1 = x - .5f*y;
+      mem0 = mem1 + y - 2*x;
+      mem1 = x - .5f*y;
 #endif
-         tmp[i] = SROUND16(y, 2);
-         /*printf("%f ", tmp[i]);*/
-      }
-      /*printf("\n");*/
-      /* First few samples are bad because we don't propagate the memory */
-      OPUS_CLEAR(tmp, 12);
+      tmp[i] = SROUND16(y, 2);
+      /*printf("%f ", tmp[i]);*/
+   }
+   /*printf("\n");*/
+   /* First few samples are bad because we don't propagate the memory */
+   OPUS_CLEAR(tmp, 12);
 
 #ifdef FIXED_POINT
-      /* Normalize tmp to max range */
+   /* Normalize tmp to max range */
+   {
+      int shift=0;
+      shift = 14-celt_ilog2(MAX16(1, celt_maxabs16(tmp, len)));
+      if (shift!=0)
       {
-         int shift=0;
-         shift = 14-celt_ilog2(MAX16(1, celt_maxabs16(tmp, len)));
-         if (shift!=0)
-         {
-            for (i=0;i<len;i++)
-               tmp[i] = SHL16(tmp[i], shift);
-         }
+         for (i=0;i<len;i++)
+            tmp[i] = SHL16(tmp[i], shift);
       }
+   }
 #endif
 
-      mean=0;
-      mem0=0;
-      /* Grouping by two to reduce complexity */
-      /* Forward pass to compute the post-echo threshold*/
-      for (i=0;i<len2;i++)
-      {
-         opus_val16 x2 = PSHR32(MULT16_16(tmp[2*i],tmp[2*i]) + MULT16_16(tmp[2*i+1],tmp[2*i+1]),16);
-         mean += x2;
+   *mean=0;
+   mem0=0;
+   /* Grouping by two to reduce complexity */
+   /* Forward pass to compute the post-echo threshold*/
+   for (i=0;i<len2;i++)
+   {
+      opus_val16 x2 = PSHR32(MULT16_16(tmp[2*i],tmp[2*i]) + MULT16_16(tmp[2*i+1],tmp[2*i+1]),16);
+      *mean += x2;
 #ifdef FIXED_POINT
-         /* FIXME: Use PSHR16() instead */
-         tmp[i] = mem0 + PSHR32(x2-mem0,forward_shift);
+      /* FIXME: Use PSHR16() instead */
+      tmp[i] = mem0 + PSHR32(x2-mem0,forward_shift);
 #else
-         tmp[i] = mem0 + MULT16_16_P15(forward_decay,x2-mem0);
+      tmp[i] = mem0 + MULT16_16_P15(forward_decay,x2-mem0);
 #endif
-         mem0 = tmp[i];
-      }
+      mem0 = tmp[i];
+   }
 
-      mem0=0;
-      maxE=0;
-      /* Backward pass to compute the pre-echo threshold */
-      for (i=len2-1;i>=0;i--)
-      {
-         /* Backward masking: 13.9 dB/ms. */
+   mem0=0;
+   *maxE=0;
+   /* Backward pass to compute the pre-echo threshold */
+   for (i=len2-1;i>=0;i--)
+   {
+      /* Backward masking: 13.9 dB/ms. */
 #ifdef FIXED_POINT
-         /* FIXME: Use PSHR16() instead */
-         tmp[i] = mem0 + PSHR32(tmp[i]-mem0,3);
+      /* FIXME: Use PSHR16() instead */
+      tmp[i] = mem0 + PSHR32(tmp[i]-mem0,3);
 #else
-         tmp[i] = mem0 + MULT16_16_P15(QCONST16(0.125f,15),tmp[i]-mem0);
+      tmp[i] = mem0 + MULT16_16_P15(QCONST16(0.125f,15),tmp[i]-mem0);
 #endif
-         mem0 = tmp[i];
-         maxE = MAX16(maxE, mem0);
-      }
-      /*for (i=0;i<len2;i++)printf("%f ", tmp[i]/mean);printf("\n");*/
+      mem0 = tmp[i];
+      *maxE = MAX16(*maxE, mem0);
+   }
+   /*for (i=0;i<len2;i++)printf("%f ", tmp[i]/mean);printf("\n");*/
+}
+
+static int transient_analysis(const opus_val32 * OPUS_RESTRICT in, int len, int C,
+                              opus_val16 *tf_estimate, int *tf_chan, int allow_weak_transients,
+                              int *weak_transient, int arch)
+{
+   int i;
+   VARDECL(opus_val16, tmp);
+   int is_transient = 0;
+   opus_int32 mask_metric = 0;
+   int c;
+   opus_val16 tf_max;
+   int len2;
+   /* Table of 6*64/x, trained on real data to minimize the average error */
+   static const unsigned char inv_table[128] = {
+         255,255,156,110, 86, 70, 59, 51, 45, 40, 37, 33, 31, 28, 26, 25,
+          23, 22, 21, 20, 19, 18, 17, 16, 16, 15, 15, 14, 13, 13, 12, 12,
+          12, 12, 11, 11, 11, 10, 10, 10,  9,  9,  9,  9,  9,  9,  8,  8,
+           8,  8,  8,  7,  7,  7,  7,  7,  7,  6,  6,  6,  6,  6,  6,  6,
+           6,  6,  6,  6,  6,  6,  6,  6,  6,  5,  5,  5,  5,  5,  5,  5,
+           5,  5,  5,  5,  5,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,
+           4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  3,  3,
+           3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  2,
+   };
+   SAVE_STACK;
+   ALLOC(tmp, len, opus_val16);
+
+   *weak_transient = 0;
+   len2=len/2;
+   for (c=0;c<C;c++)
+   {
+      opus_val32 mean;
+      opus_int32 unmask=0;
+      opus_val32 norm;
+      opus_val16 maxE;
+
+      transient_masking_curve(in+c*len, tmp, len, allow_weak_transients,
+            &mean, &maxE, arch);
 
       /* Compute the ratio of the "frame energy" over the harmonic mean of the energy.
          This essentially corresponds to a bitrate-normalized temporal noise-to-mask
@@ -487,7 +502,7 @@ static void compute_mdcts(const CELTMode *mode, int shortBlocks, celt_sig * OPUS
 }
 
 
-void celt_preemphasis(const opus_val16 * OPUS_RESTRICT pcmp, celt_sig * OPUS_RESTRICT inp,
+void celt_preemphasis_c(const opus_val16 * OPUS_RESTRICT pcmp, celt_sig * OPUS_RESTRICT inp,
                         int N, int CC, int upsample, const opus_val16 *coef, celt_sig *mem, int clip)
 {
    int i;
@@ -562,22 +577,9 @@ void celt_preemphasis(const opus_val16 * OPUS_RESTRICT pcmp, celt_sig * OPUS_RES
 
 
 
-static opus_val32 l1_metric(const celt_norm *tmp, int N, int LM, opus_val16 bias)
-{
-   int i;
-   opus_val32 L1;
-   L1 = 0;
-   for (i=0;i<N;i++)
-      L1 += EXTEND32(ABS16(tmp[i]));
-   /* When in doubt, prefer good freq resolution */
-   L1 = MAC16_32_Q15(L1, LM*bias, L1);
-   return L1;
-
-}
-
 static int tf_analysis(const CELTMode *m, int len, int isTransient,
       int *tf_res, int lambda, celt_norm *X, int N0, int LM,
-      opus_val16 tf_estimate, int tf_chan)
+      opus_val16 tf_estimate, int tf_chan, int arch)
 {
    int i;
    VARDECL(int, metric);
@@ -616,14 +618,14 @@ static int tf_analysis(const CELTMode *m, int len, int isTransient,
       /*if (C==2)
          for (j=0;j<N;j++)
             tmp[j] = ADD16(SHR16(tmp[j], 1),SHR16(X[N0+j+(m->eBands[i]<<LM)], 1));*/
-      L1 = l1_metric(tmp, N, isTransient ? LM : 0, bias);
+      L1 = l1_metric(tmp, N, isTransient ? LM : 0, bias, arch);
       best_L1 = L1;
       /* Check the -1 case for transients */
       if (isTransient && !narrow)
       {
          OPUS_COPY(tmp_1, tmp, N);
-         haar1(tmp_1, N>>LM, 1<<LM);
-         L1 = l1_metric(tmp_1, N, LM+1, bias);
+         haar1(tmp_1, N>>LM, 1<<LM, arch);
+         L1 = l1_metric(tmp_1, N, LM+1, bias, arch);
          if (L1<best_L1)
          {
             best_L1 = L1;
@@ -640,9 +642,9 @@ static int tf_analysis(const CELTMode *m, int len, int isTransient,
          else
             B = k+1;
 
-         haar1(tmp, N>>k, 1<<k);
+         haar1(tmp, N>>k, 1<<k, arch);
 
-         L1 = l1_metric(tmp, N, B, bias);
+         L1 = l1_metric(tmp, N, B, bias, arch);
 
          if (L1 < best_L1)
          {
@@ -1416,6 +1418,10 @@ int celt_encode_with_ec(CELTEncoder * OPUS_RESTRICT st, const opus_val16 * pcm,
    int weak_transient = 0;
    VARDECL(opus_val16, surround_dynalloc);
    ALLOC_STACK;
+#if !defined(VAR_ARRAYS) && !defined(USE_ALLOCA)
+   if (global_stack==NULL)
+      return OPUS_ALLOC_FAIL;
+#endif
 
    mode = st->mode;
    nbEBands = mode->nbEBands;
@@ -1590,7 +1596,7 @@ int celt_encode_with_ec(CELTEncoder * OPUS_RESTRICT st, const opus_val16 * pcm,
       need_clip = st->clip && sample_max>65536.f;
 #endif
       celt_preemphasis(pcm+c, in+c*(N+overlap)+overlap, N, CC, st->upsample,
-                  mode->preemph, st->preemph_memE+c, need_clip);
+                  mode->preemph, st->preemph_memE+c, need_clip, st->arch);
    } while (++c<CC);
 
 
@@ -1635,7 +1641,8 @@ int celt_encode_with_ec(CELTEncoder * OPUS_RESTRICT st, const opus_val16 * pcm,
          though (small SILK quantization offset value). */
       int allow_weak_transients = hybrid && effectiveBytes<15 && st->silk_info.offset >= 100;
       isTransient = transient_analysis(in, N+overlap, CC,
-            &tf_estimate, &tf_chan, allow_weak_transients, &weak_transient);
+            &tf_estimate, &tf_chan, allow_weak_transients, &weak_transient,
+            st->arch);
    }
    if (LM>0 && ec_tell(enc)+3<=total_bits)
    {
@@ -1803,7 +1810,7 @@ int celt_encode_with_ec(CELTEncoder * OPUS_RESTRICT st, const opus_val16 * pcm,
    ALLOC(X, C*N, celt_norm);         /**< Interleaved normalised MDCTs */
 
    /* Band normalisation */
-   normalise_bands(mode, freq, X, bandE, effEnd, C, M);
+   normalise_bands(mode, freq, X, bandE, effEnd, C, M, st->arch);
 
    ALLOC(tf_res, nbEBands, int);
    /* Disable variable tf resolution for hybrid and at very low bitrate */
@@ -1811,7 +1818,7 @@ int celt_encode_with_ec(CELTEncoder * OPUS_RESTRICT st, const opus_val16 * pcm,
    {
       int lambda;
       lambda = IMAX(5, 1280/effectiveBytes + 2);
-      tf_select = tf_analysis(mode, effEnd, isTransient, tf_res, lambda, X, N, LM, tf_estimate, tf_chan);
+      tf_select = tf_analysis(mode, effEnd, isTransient, tf_res, lambda, X, N, LM, tf_estimate, tf_chan, st->arch);
       for (i=effEnd;i<end;i++)
          tf_res[i] = tf_res[effEnd-1];
    } else if (hybrid && weak_transient)
@@ -2197,7 +2204,7 @@ int celt_encode_with_ec(CELTEncoder * OPUS_RESTRICT st, const opus_val16 * pcm,
       } while (++c<CC);
 
       /* We reuse freq[] as scratch space for the de-emphasis */
-      deemphasis(out_mem, (opus_val16*)pcm, N, CC, st->upsample, mode->preemph, st->preemph_memD);
+      deemphasis(out_mem, (opus_val16*)pcm, N, CC, st->upsample, mode->preemph, st->preemph_memD, 0, st->arch);
       st->prefilter_period_old = st->prefilter_period;
       st->prefilter_gain_old = st->prefilter_gain;
       st->prefilter_tapset_old = st->prefilter_tapset;
@@ -2280,6 +2287,10 @@ int opus_custom_encode_float(CELTEncoder * OPUS_RESTRICT st, const float * pcm,
    int j, ret, C, N;
    VARDECL(opus_int16, in);
    ALLOC_STACK;
+#if !defined(VAR_ARRAYS) && !defined(USE_ALLOCA)
+   if (global_stack==NULL)
+      return OPUS_ALLOC_FAIL;
+#endif
 
    if (pcm==NULL)
       return OPUS_BAD_ARG;
@@ -2307,6 +2318,10 @@ int opus_custom_encode(CELTEncoder * OPUS_RESTRICT st, const opus_int16 * pcm, i
    int j, ret, C, N;
    VARDECL(celt_sig, in);
    ALLOC_STACK;
+#if !defined(VAR_ARRAYS) && !defined(USE_ALLOCA)
+   if (global_stack==NULL)
+      return OPUS_ALLOC_FAIL;
+#endif
 
    if (pcm==NULL)
       return OPUS_BAD_ARG;
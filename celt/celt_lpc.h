@@ -31,7 +31,7 @@
 #include "arch.h"
 #include "cpu_support.h"
 
-#if defined(OPUS_X86_MAY_HAVE_SSE4_1)
+#if defined(OPUS_X86_MAY_HAVE_SSE4_1) || defined(OPUS_X86_MAY_HAVE_AVX2)
 #include "x86/celt_lpc_sse.h"
 #endif
 
@@ -52,7 +52,7 @@ void celt_fir_c(
     (celt_fir_c(x, num, y, N, ord, arch))
 #endif
 
-void celt_iir(const opus_val32 *x,
+void celt_iir_c(const opus_val32 *x,
          const opus_val16 *den,
          opus_val32 *y,
          int N,
@@ -60,7 +60,17 @@ void celt_iir(const opus_val32 *x,
          opus_val16 *mem,
          int arch);
 
-int _celt_autocorr(const opus_val16 *x, opus_val32 *ac,
+#if !defined(OVERRIDE_CELT_IIR)
+#define celt_iir(x, den, y, N, ord, mem, arch) \
+    (celt_iir_c(x, den, y, N, ord, mem, arch))
+#endif
+
+int _celt_autocorr_c(const opus_val16 *x, opus_val32 *ac,
          const opus_val16 *window, int overlap, int lag, int n, int arch);
 
+#if !defined(OVERRIDE_CELT_AUTOCORR)
+#define _celt_autocorr(x, ac, window, overlap, lag, n, arch) \
+    (_celt_autocorr_c(x, ac, window, overlap, lag, n, arch))
+#endif
+
 #endif /* PLC_H */
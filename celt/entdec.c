@@ -101,18 +101,39 @@ static int ec_read_byte_from_end(ec_dec *_this){
    high-order symbol.*/
 static void ec_dec_normalize(ec_dec *_this){
   /*If the range is too small, rescale it and input some bits.*/
-  while(_this->rng<=EC_CODE_BOT){
-    int sym;
-    _this->nbits_total+=EC_SYM_BITS;
-    _this->rng<<=EC_SYM_BITS;
+  if(_this->rng<=EC_CODE_BOT){
+    opus_uint32 sym;
+    int         nsyms;
+    int         shift;
+    /*Work out up front how many symbols we need (at most three), so they can
+       all be folded into val at once instead of one at a time.*/
+    nsyms=(EC_CODE_BITS-1-EC_ILOG((_this->rng-1)|1))/EC_SYM_BITS;
+    shift=nsyms*EC_SYM_BITS;
+    _this->nbits_total+=shift;
+    _this->rng<<=shift;
     /*Use up the remaining bits from our last symbol.*/
     sym=_this->rem;
-    /*Read the next value from the input.*/
-    _this->rem=ec_read_byte(_this);
-    /*Take the rest of the bits we need from this new symbol.*/
-    sym=(sym<<EC_SYM_BITS|_this->rem)>>(EC_SYM_BITS-EC_CODE_EXTRA);
+    /*Read the next values from the input, skipping the end-of-buffer checks
+       when they cannot trigger.*/
+    if(_this->offs+nsyms<=_this->storage){
+      const unsigned char *p;
+      int                  i;
+      p=_this->buf+_this->offs;
+      for(i=0;i<nsyms;i++)sym=sym<<EC_SYM_BITS|p[i];
+      _this->offs+=nsyms;
+      _this->rem=p[nsyms-1];
+    }
+    else{
+      int i;
+      for(i=0;i<nsyms;i++){
+        _this->rem=ec_read_byte(_this);
+        sym=sym<<EC_SYM_BITS|_this->rem;
+      }
+    }
+    /*Take the rest of the bits we need from the new symbols.*/
+    sym>>=EC_SYM_BITS-EC_CODE_EXTRA;
     /*And subtract them from val, capped to be less than EC_CODE_TOP.*/
-    _this->val=((_this->val<<EC_SYM_BITS)+(EC_SYM_MAX&~sym))&(EC_CODE_TOP-1);
+    _this->val=((_this->val<<shift)+(((1U<<shift)-1)&~sym))&(EC_CODE_TOP-1);
   }
 }
 
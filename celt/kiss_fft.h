@@ -100,6 +100,10 @@ typedef struct kiss_fft_state{
 #include "arm/fft_arm.h"
 #endif
 
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+#include "x86/kiss_fft_sse.h"
+#endif
+
 /*typedef struct kiss_fft_state* kiss_fft_cfg;*/
 
 /**
@@ -153,7 +157,8 @@ int opus_fft_alloc_arch_c(kiss_fft_state *st);
 
 #if !defined(OVERRIDE_OPUS_FFT)
 /* Is run-time CPU detection enabled on this platform? */
-#if defined(OPUS_HAVE_RTCD) && (defined(HAVE_ARM_NE10))
+#if defined(OPUS_HAVE_RTCD) && (defined(HAVE_ARM_NE10) || \
+ defined(OPUS_X86_MAY_HAVE_AVX2))
 
 extern int (*const OPUS_FFT_ALLOC_ARCH_IMPL[OPUS_ARCHMASK+1])(
  kiss_fft_state *st);
@@ -176,7 +181,7 @@ extern void (*const OPUS_IFFT[OPUS_ARCHMASK+1])(const kiss_fft_state *cfg,
 #define opus_ifft(_cfg, _fin, _fout, arch) \
    ((*OPUS_IFFT[(arch)&OPUS_ARCHMASK])(_cfg, _fin, _fout))
 
-#else /* else for if defined(OPUS_HAVE_RTCD) && (defined(HAVE_ARM_NE10)) */
+#else /* else for if defined(OPUS_HAVE_RTCD) && (defined(HAVE_ARM_NE10) || ...) */
 
 #define opus_fft_alloc_arch(_st, arch) \
          ((void)(arch), opus_fft_alloc_arch_c(_st))
@@ -190,7 +195,7 @@ extern void (*const OPUS_IFFT[OPUS_ARCHMASK+1])(const kiss_fft_state *cfg,
 #define opus_ifft(_cfg, _fin, _fout, arch) \
          ((void)(arch), opus_ifft_c(_cfg, _fin, _fout))
 
-#endif /* end if defined(OPUS_HAVE_RTCD) && (defined(HAVE_ARM_NE10)) */
+#endif /* end if defined(OPUS_HAVE_RTCD) && (defined(HAVE_ARM_NE10) || ...) */
 #endif /* end if !defined(OVERRIDE_OPUS_FFT) */
 
 #ifdef __cplusplus
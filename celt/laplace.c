@@ -96,15 +96,23 @@ int ec_laplace_decode(ec_dec *dec, unsigned fs, int decay)
    int val=0;
    unsigned fl;
    unsigned fm;
-   fm = ec_decode_bin(dec, 15);
+   opus_uint32 ext;
+   opus_uint32 d;
+   /* Rather than dividing to get fm=ec_decode_bin(dec, 15) up front, compare
+      the decoder state against scaled bounds: for 0<x<=32768, fm>=x exactly
+      when d<ext*(32768-x). */
+   ext = dec->rng>>15;
+   dec->ext = ext;
+   d = dec->val;
    fl = 0;
-   if (fm >= fs)
+   if (d < IMUL32(ext, 32768-fs))
    {
       val++;
       fl = fs;
       fs = ec_laplace_get_freq1(fs, decay)+LAPLACE_MINP;
       /* Search the decaying part of the PDF.*/
-      while(fs > LAPLACE_MINP && fm >= fl+2*fs)
+      while(fs > LAPLACE_MINP && fl+2*fs <= 32768
+            && d < IMUL32(ext, 32768-(fl+2*fs)))
       {
          fs *= 2;
          fl += fs;
@@ -116,19 +124,19 @@ int ec_laplace_decode(ec_dec *dec, unsigned fs, int decay)
       if (fs <= LAPLACE_MINP)
       {
          int di;
+         fm = 32768-IMIN(d/ext+1, 32768);
          di = (fm-fl)>>(LAPLACE_LOG_MINP+1);
          val += di;
          fl += 2*di*LAPLACE_MINP;
       }
-      if (fm < fl+fs)
+      if (fl+fs > 32768 || d >= IMUL32(ext, 32768-(fl+fs)))
          val = -val;
       else
          fl += fs;
    }
    celt_assert(fl<32768);
    celt_assert(fs>0);
-   celt_assert(fl<=fm);
-   celt_assert(fm<IMIN(fl+fs,32768));
+   celt_assert(fl==0 || d<IMUL32(ext, 32768-fl));
    ec_dec_update(dec, fl, IMIN(fl+fs,32768), 32768);
    return val;
 }
@@ -57,6 +57,10 @@ typedef struct {
 #include "arm/mdct_arm.h"
 #endif
 
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+#include "x86/mdct_sse.h"
+#endif
+
 
 int clt_mdct_init(mdct_lookup *l,int N, int maxshift, int arch);
 void clt_mdct_clear(mdct_lookup *l, int arch);
@@ -76,7 +80,8 @@ void clt_mdct_backward_c(const mdct_lookup *l, kiss_fft_scalar *in,
 
 #if !defined(OVERRIDE_OPUS_MDCT)
 /* Is run-time CPU detection enabled on this platform? */
-#if defined(OPUS_HAVE_RTCD) && defined(HAVE_ARM_NE10)
+#if defined(OPUS_HAVE_RTCD) && (defined(HAVE_ARM_NE10) || \
+ defined(OPUS_X86_MAY_HAVE_AVX2))
 
 extern void (*const CLT_MDCT_FORWARD_IMPL[OPUS_ARCHMASK+1])(
       const mdct_lookup *l, kiss_fft_scalar *in,
@@ -98,7 +103,7 @@ extern void (*const CLT_MDCT_BACKWARD_IMPL[OPUS_ARCHMASK+1])(
                                                    _window, _overlap, _shift, \
                                                    _stride, _arch)
 
-#else /* if defined(OPUS_HAVE_RTCD) && defined(HAVE_ARM_NE10) */
+#else /* if defined(OPUS_HAVE_RTCD) && (defined(HAVE_ARM_NE10) || ...) */
 
 #define clt_mdct_forward(_l, _in, _out, _window, _overlap, _shift, _stride, _arch) \
    clt_mdct_forward_c(_l, _in, _out, _window, _overlap, _shift, _stride, _arch)
@@ -106,7 +111,7 @@ extern void (*const CLT_MDCT_BACKWARD_IMPL[OPUS_ARCHMASK+1])(
 #define clt_mdct_backward(_l, _in, _out, _window, _overlap, _shift, _stride, _arch) \
    clt_mdct_backward_c(_l, _in, _out, _window, _overlap, _shift, _stride, _arch)
 
-#endif /* end if defined(OPUS_HAVE_RTCD) && defined(HAVE_ARM_NE10) && !defined(FIXED_POINT) */
+#endif /* end if defined(OPUS_HAVE_RTCD) && (defined(HAVE_ARM_NE10) || ...) */
 #endif /* end if !defined(OVERRIDE_OPUS_MDCT) */
 
 #endif
@@ -42,10 +42,37 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-/** Opus wrapper for malloc(). To do your own dynamic allocation, all you need to do is replace this function and opus_free */
+/** Allocator installed with opus_set_allocator() */
+typedef struct {
+   opus_alloc_func alloc;
+   opus_free_func free;
+   void *user_data;
+} OpusAllocator;
+
+/** Current allocator, or NULL when the default malloc()/free() pair is in
+    use. opus_set_allocator() fills in a struct before publishing it with a
+    single pointer store, so readers always see a consistent set. */
+#ifdef CELT_C
+const OpusAllocator *opus_allocator = NULL;
+#else
+extern const OpusAllocator *opus_allocator;
+#endif
+
+#ifdef __ATOMIC_ACQUIRE
+# define OPUS_ALLOCATOR_LOAD() __atomic_load_n(&opus_allocator, __ATOMIC_ACQUIRE)
+# define OPUS_ALLOCATOR_STORE(a) __atomic_store_n(&opus_allocator, (a), __ATOMIC_RELEASE)
+#else
+# define OPUS_ALLOCATOR_LOAD() (*(const OpusAllocator * volatile *)&opus_allocator)
+# define OPUS_ALLOCATOR_STORE(a) (*(const OpusAllocator * volatile *)&opus_allocator = (a))
+#endif
+
+/** Opus wrapper for malloc(). To do your own dynamic allocation, either call opus_set_allocator() or replace this function and opus_free */
 #ifndef OVERRIDE_OPUS_ALLOC
 static OPUS_INLINE void *opus_alloc (size_t size)
 {
+   const OpusAllocator *allocator = OPUS_ALLOCATOR_LOAD();
+   if (allocator)
+      return allocator->alloc(allocator->user_data, size);
    return malloc(size);
 }
 #endif
@@ -59,11 +86,26 @@ static OPUS_INLINE void *opus_alloc_scratch (size_t size)
 }
 #endif
 
-/** Opus wrapper for free(). To do your own dynamic allocation, all you need to do is replace this function and opus_alloc */
+/** Opus wrapper for free(). To do your own dynamic allocation, either call opus_set_allocator() or replace this function and opus_alloc */
 #ifndef OVERRIDE_OPUS_FREE
 static OPUS_INLINE void opus_free (void *ptr)
 {
-   free(ptr);
+   const OpusAllocator *allocator = OPUS_ALLOCATOR_LOAD();
+   if (allocator)
+   {
+      if (ptr != NULL)
+         allocator->free(allocator->user_data, ptr);
+   }
+   else
+      free(ptr);
+}
+#endif
+
+/** Releases an area obtained from opus_alloc_scratch() */
+#ifndef OVERRIDE_OPUS_FREE_SCRATCH
+static OPUS_INLINE void opus_free_scratch (void *ptr)
+{
+   opus_free(ptr);
 }
 #endif
 
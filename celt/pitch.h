@@ -38,7 +38,8 @@
 #include "cpu_support.h"
 
 #if (defined(OPUS_X86_MAY_HAVE_SSE) && !defined(FIXED_POINT)) \
-  || ((defined(OPUS_X86_MAY_HAVE_SSE4_1) || defined(OPUS_X86_MAY_HAVE_SSE2)) && defined(FIXED_POINT))
+  || ((defined(OPUS_X86_MAY_HAVE_SSE4_1) || defined(OPUS_X86_MAY_HAVE_SSE2)) && defined(FIXED_POINT)) \
+  || defined(OPUS_X86_MAY_HAVE_AVX2)
 #include "x86/pitch_sse.h"
 #endif
 
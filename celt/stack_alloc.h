@@ -35,8 +35,12 @@
 #include "opus_types.h"
 #include "opus_defines.h"
 
-#if (!defined (VAR_ARRAYS) && !defined (USE_ALLOCA) && !defined (NONTHREADSAFE_PSEUDOSTACK))
-#error "Opus requires one of VAR_ARRAYS, USE_ALLOCA, or NONTHREADSAFE_PSEUDOSTACK be defined to select the temporary allocation mode."
+#if (!defined (VAR_ARRAYS) && !defined (USE_ALLOCA) && !defined (NONTHREADSAFE_PSEUDOSTACK) && !defined (SCRATCH_ARENA))
+#error "Opus requires one of VAR_ARRAYS, USE_ALLOCA, NONTHREADSAFE_PSEUDOSTACK, or SCRATCH_ARENA be defined to select the temporary allocation mode."
+#endif
+
+#if defined (SCRATCH_ARENA) && (defined (VAR_ARRAYS) || defined (USE_ALLOCA))
+#error "SCRATCH_ARENA cannot be combined with VAR_ARRAYS or USE_ALLOCA."
 #endif
 
 #ifdef USE_ALLOCA
@@ -115,43 +119,100 @@
 
 #else
 
+/* With SCRATCH_ARENA, the pseudostack is thread-local: each thread bump-allocates
+   from its own arena, set up with opus_scratch_arena_init() or, failing that,
+   allocated by the first call the thread makes into the library. Nothing is
+   placed on the thread stack, and separate codec states can be used in
+   parallel from different threads. */
+#ifdef SCRATCH_ARENA
+# ifndef OPUS_THREAD_LOCAL
+#  ifdef _MSC_VER
+#   define OPUS_THREAD_LOCAL __declspec(thread)
+#  else
+#   define OPUS_THREAD_LOCAL _Thread_local
+#  endif
+# endif
+#define STACK_STORAGE OPUS_THREAD_LOCAL
+/* Align all temporaries for SIMD loads and for kernels that expect 32-bit alignment */
+#define STACK_ALIGNMENT(type) 16
+#else
+#define STACK_STORAGE
+#define STACK_ALIGNMENT(type) (sizeof(type)/(sizeof(char)))
+#endif
+
+#ifdef CELT_C
+STACK_STORAGE char *scratch_ptr=0;
+STACK_STORAGE char *global_stack=0;
+#else
+extern STACK_STORAGE char *global_stack;
+extern STACK_STORAGE char *scratch_ptr;
+#endif /* CELT_C */
+
+#ifdef SCRATCH_ARENA
+/* Non-zero when scratch_ptr was allocated by the library rather than supplied by the caller */
 #ifdef CELT_C
-char *scratch_ptr=0;
-char *global_stack=0;
+STACK_STORAGE int scratch_owned=0;
 #else
-extern char *global_stack;
-extern char *scratch_ptr;
+extern STACK_STORAGE int scratch_owned;
 #endif /* CELT_C */
+#endif
 
 #ifdef ENABLE_VALGRIND
 
 #include <valgrind/memcheck.h>
 
 #ifdef CELT_C
-char *global_stack_top=0;
+STACK_STORAGE char *global_stack_top=0;
 #else
-extern char *global_stack_top;
+extern STACK_STORAGE char *global_stack_top;
 #endif /* CELT_C */
 
 #define ALIGN(stack, size) ((stack) += ((size) - (long)(stack)) & ((size) - 1))
-#define PUSH(stack, size, type) (VALGRIND_MAKE_MEM_NOACCESS(stack, global_stack_top-stack),ALIGN((stack),sizeof(type)/sizeof(char)),VALGRIND_MAKE_MEM_UNDEFINED(stack, ((size)*sizeof(type)/sizeof(char))),(stack)+=(2*(size)*sizeof(type)/sizeof(char)),(type*)((stack)-(2*(size)*sizeof(type)/sizeof(char))))
+#define PUSH(stack, size, type) (VALGRIND_MAKE_MEM_NOACCESS(stack, global_stack_top-stack),ALIGN((stack),STACK_ALIGNMENT(type)),VALGRIND_MAKE_MEM_UNDEFINED(stack, ((size)*sizeof(type)/sizeof(char))),(stack)+=(2*(size)*sizeof(type)/sizeof(char)),(type*)((stack)-(2*(size)*sizeof(type)/sizeof(char))))
 #define RESTORE_STACK ((global_stack = _saved_stack),VALGRIND_MAKE_MEM_NOACCESS(global_stack, global_stack_top-global_stack))
+#ifdef SCRATCH_ARENA
+#define ALLOC_STACK char *_saved_stack; ((global_stack = (global_stack==0) ? opus_scratch_arena_lazy(GLOBAL_STACK_SIZE*2) : global_stack),VALGRIND_MAKE_MEM_NOACCESS(global_stack, global_stack_top-global_stack)); _saved_stack = global_stack;
+#else
 #define ALLOC_STACK char *_saved_stack; ((global_stack = (global_stack==0) ? ((global_stack_top=opus_alloc_scratch(GLOBAL_STACK_SIZE*2)+(GLOBAL_STACK_SIZE*2))-(GLOBAL_STACK_SIZE*2)) : global_stack),VALGRIND_MAKE_MEM_NOACCESS(global_stack, global_stack_top-global_stack)); _saved_stack = global_stack;
+#endif
 
 #else
 
 #define ALIGN(stack, size) ((stack) += ((size) - (long)(stack)) & ((size) - 1))
-#define PUSH(stack, size, type) (ALIGN((stack),sizeof(type)/sizeof(char)),(stack)+=(size)*(sizeof(type)/sizeof(char)),(type*)((stack)-(size)*(sizeof(type)/sizeof(char))))
+#define PUSH(stack, size, type) (ALIGN((stack),STACK_ALIGNMENT(type)),(stack)+=(size)*(sizeof(type)/(sizeof(char))),(type*)((stack)-(size)*(sizeof(type)/(sizeof(char)))))
 #if 0 /* Set this to 1 to instrument pseudostack usage */
 #define RESTORE_STACK (printf("%ld %s:%d\n", global_stack-scratch_ptr, __FILE__, __LINE__),global_stack = _saved_stack)
 #else
 #define RESTORE_STACK (global_stack = _saved_stack)
 #endif
+#ifdef SCRATCH_ARENA
+#define ALLOC_STACK char *_saved_stack; (global_stack = (global_stack==0) ? opus_scratch_arena_lazy(GLOBAL_STACK_SIZE) : global_stack); _saved_stack = global_stack;
+#else
 #define ALLOC_STACK char *_saved_stack; (global_stack = (global_stack==0) ? (scratch_ptr=opus_alloc_scratch(GLOBAL_STACK_SIZE)) : global_stack); _saved_stack = global_stack;
+#endif
 
 #endif /* ENABLE_VALGRIND */
 
 #include "os_support.h"
+
+#ifdef SCRATCH_ARENA
+/* Allocates the arena of a thread that did not call opus_scratch_arena_init().
+   On failure global_stack stays NULL, which the entry points check for right
+   after ALLOC_STACK so that they can return OPUS_ALLOC_FAIL. */
+static OPUS_INLINE char *opus_scratch_arena_lazy(size_t size)
+{
+   char *arena = (char *)opus_alloc_scratch(size);
+   if (arena == NULL)
+      return NULL;
+   scratch_ptr = arena;
+   scratch_owned = 1;
+#ifdef ENABLE_VALGRIND
+   global_stack_top = arena + size;
+#endif
+   return arena;
+}
+#endif
+
 #define VARDECL(type, var) type *var
 #define ALLOC(var, size, type) var = PUSH(global_stack, size, type)
 #define SAVE_STACK char *_saved_stack = global_stack;
@@ -37,7 +37,7 @@
 #include "entdec.h"
 #include "modes.h"
 
-#if (defined(OPUS_X86_MAY_HAVE_SSE2) && !defined(FIXED_POINT))
+#if (defined(OPUS_X86_MAY_HAVE_SSE2) && !defined(FIXED_POINT)) || defined(OPUS_X86_MAY_HAVE_AVX2)
 #include "x86/vq_sse.h"
 #endif
 
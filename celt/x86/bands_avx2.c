@@ -0,0 +1,624 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+#include "bands.h"
+#include "modes.h"
+#include "mathops.h"
+#include "quant_bands.h"
+#include "x86cpu.h"
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+
+#ifdef FIXED_POINT
+
+/* Truncates each 32-bit lane to 16 bits, sign-extended, like EXTRACT16(). */
+static OPUS_INLINE __m256i extract16_avx2(__m256i x)
+{
+   return _mm256_srai_epi32(_mm256_slli_epi32(x, 16), 16);
+}
+
+/* Same as VSHR32() with the shift applied to every lane. */
+static OPUS_INLINE __m256i vshr32_avx2(__m256i x, int shift)
+{
+   if (shift>0)
+      return _mm256_sra_epi32(x, _mm_cvtsi32_si128(shift));
+   else
+      return _mm256_sll_epi32(x, _mm_cvtsi32_si128(-shift));
+}
+
+static OPUS_INLINE opus_int32 hadd32_avx2(__m256i x)
+{
+   __m128i t;
+   t = _mm_add_epi32(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1));
+   t = _mm_add_epi32(t, _mm_shuffle_epi32(t, _MM_SHUFFLE(1, 0, 3, 2)));
+   t = _mm_add_epi32(t, _mm_shuffle_epi32(t, _MM_SHUFFLE(2, 3, 0, 1)));
+   return _mm_cvtsi128_si32(t);
+}
+
+/* MULT16_16_Q15() on 16-bit lanes, keeping bits 15 to 30 of the product. */
+static OPUS_INLINE __m256i mult16_16_q15_avx2(__m256i a, __m256i b)
+{
+   return _mm256_or_si256(_mm256_slli_epi16(_mm256_mulhi_epi16(a, b), 1),
+         _mm256_srli_epi16(_mm256_mullo_epi16(a, b), 15));
+}
+
+void compute_band_energies_avx2(const CELTMode *m, const celt_sig *X,
+      celt_ener *bandE, int end, int C, int LM, int arch)
+{
+   int i, c, N;
+   const opus_int16 *eBands = m->eBands;
+   (void)arch;
+   N = m->shortMdctSize<<LM;
+   c=0; do {
+      for (i=0;i<end;i++)
+      {
+         int j, len;
+         const celt_sig *x;
+         opus_val32 maxval=0;
+         opus_val32 minval=0;
+         opus_val32 sum = 0;
+         __m256i vmax, vmin;
+         opus_val32 tmp[8];
+
+         x = &X[c*N+(eBands[i]<<LM)];
+         len = (eBands[i+1]-eBands[i])<<LM;
+         vmax = vmin = _mm256_setzero_si256();
+         for (j=0;j<len-7;j+=8)
+         {
+            __m256i xi = _mm256_loadu_si256((const __m256i*)&x[j]);
+            vmax = _mm256_max_epi32(vmax, xi);
+            vmin = _mm256_min_epi32(vmin, xi);
+         }
+         if (j > 0)
+         {
+            int k;
+            _mm256_storeu_si256((__m256i*)tmp, vmax);
+            for (k=0;k<8;k++)
+               maxval = MAX32(maxval, tmp[k]);
+            _mm256_storeu_si256((__m256i*)tmp, vmin);
+            for (k=0;k<8;k++)
+               minval = MIN32(minval, tmp[k]);
+         }
+         for (;j<len;j++)
+         {
+            maxval = MAX32(maxval, x[j]);
+            minval = MIN32(minval, x[j]);
+         }
+         maxval = MAX32(maxval, -minval);
+         if (maxval > 0)
+         {
+            int shift = celt_ilog2(maxval) - 14 + (((m->logN[i]>>BITRES)+LM+1)>>1);
+            __m256i acc = _mm256_setzero_si256();
+            /* The order of the squares doesn't matter, so the lane shuffle
+               done by packs is harmless here. */
+            for (j=0;j<len-15;j+=16)
+            {
+               __m256i x0, x1;
+               x0 = extract16_avx2(vshr32_avx2(_mm256_loadu_si256((const __m256i*)&x[j]), shift));
+               x1 = extract16_avx2(vshr32_avx2(_mm256_loadu_si256((const __m256i*)&x[j+8]), shift));
+               x0 = _mm256_packs_epi32(x0, x1);
+               acc = _mm256_add_epi32(acc, _mm256_madd_epi16(x0, x0));
+            }
+            if (j<len-7)
+            {
+               __m256i x0;
+               x0 = extract16_avx2(vshr32_avx2(_mm256_loadu_si256((const __m256i*)&x[j]), shift));
+               acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(x0, x0));
+               j += 8;
+            }
+            sum = hadd32_avx2(acc);
+            for (;j<len;j++)
+            {
+               opus_val16 t = EXTRACT16(VSHR32(x[j], shift));
+               sum = MAC16_16(sum, t, t);
+            }
+            /* We're adding one here to ensure the normalized band isn't larger than unity norm */
+            bandE[i+c*m->nbEBands] = EPSILON+VSHR32(EXTEND32(celt_sqrt(sum)),-shift);
+         } else {
+            bandE[i+c*m->nbEBands] = EPSILON;
+         }
+      }
+   } while (++c<C);
+}
+
+void normalise_bands_avx2(const CELTMode *m,
+      const celt_sig * OPUS_RESTRICT freq, celt_norm * OPUS_RESTRICT X,
+      const celt_ener *bandE, int end, int C, int M, int arch)
+{
+   int i, c, N;
+   const opus_int16 *eBands = m->eBands;
+   (void)arch;
+   N = M*m->shortMdctSize;
+   c=0; do {
+      i=0; do {
+         opus_val16 g;
+         int j, band_end, shift;
+         opus_val16 E;
+         __m256i g16;
+         const celt_sig *f;
+         celt_norm *x;
+         shift = celt_zlog2(bandE[i+c*m->nbEBands])-13;
+         E = VSHR32(bandE[i+c*m->nbEBands], shift);
+         g = EXTRACT16(celt_rcp(SHL32(E,3)));
+         g16 = _mm256_set1_epi16(g);
+         j=M*eBands[i];
+         band_end = M*eBands[i+1];
+         f = &freq[c*N];
+         x = &X[c*N];
+         for (;j<band_end-15;j+=16)
+         {
+            __m256i x0, x1;
+            x0 = extract16_avx2(vshr32_avx2(_mm256_loadu_si256((const __m256i*)&f[j]), shift-1));
+            x1 = extract16_avx2(vshr32_avx2(_mm256_loadu_si256((const __m256i*)&f[j+8]), shift-1));
+            x0 = _mm256_permute4x64_epi64(_mm256_packs_epi32(x0, x1), _MM_SHUFFLE(3, 1, 2, 0));
+            _mm256_storeu_si256((__m256i*)&x[j], mult16_16_q15_avx2(x0, g16));
+         }
+         if (j<band_end-7)
+         {
+            __m256i x0;
+            __m128i x8;
+            x0 = extract16_avx2(vshr32_avx2(_mm256_loadu_si256((const __m256i*)&f[j]), shift-1));
+            x8 = _mm_packs_epi32(_mm256_castsi256_si128(x0), _mm256_extracti128_si256(x0, 1));
+            x8 = _mm256_castsi256_si128(mult16_16_q15_avx2(_mm256_castsi128_si256(x8), g16));
+            _mm_storeu_si128((__m128i*)&x[j], x8);
+            j += 8;
+         }
+         for (;j<band_end;j++)
+            x[j] = MULT16_16_Q15(VSHR32(f[j],shift-1),g);
+      } while (++i<end);
+   } while (++c<C);
+}
+
+void denormalise_bands_avx2(const CELTMode *m,
+      const celt_norm * OPUS_RESTRICT X, celt_sig * OPUS_RESTRICT freq,
+      const opus_val16 *bandLogE, int start, int end, int M, int downsample,
+      int silence, int arch)
+{
+   int i, N;
+   int bound;
+   celt_sig * OPUS_RESTRICT f;
+   const celt_norm * OPUS_RESTRICT x;
+   const opus_int16 *eBands = m->eBands;
+   (void)arch;
+   N = M*m->shortMdctSize;
+   bound = M*eBands[end];
+   if (downsample!=1)
+      bound = IMIN(bound, N/downsample);
+   if (silence)
+   {
+      bound = 0;
+      start = end = 0;
+   }
+   f = freq;
+   x = X+M*eBands[start];
+   for (i=0;i<M*eBands[start];i++)
+      *f++ = 0;
+   for (i=start;i<end;i++)
+   {
+      int j, band_end;
+      opus_val16 g;
+      opus_val16 lg;
+      int shift;
+      __m256i g8;
+      j=M*eBands[i];
+      band_end = M*eBands[i+1];
+      lg = SATURATE16(ADD32(bandLogE[i], SHL32((opus_val32)eMeans[i],6)));
+      /* Handle the integer part of the log energy */
+      shift = 16-(lg>>DB_SHIFT);
+      if (shift>31)
+      {
+         shift=0;
+         g=0;
+      } else {
+         /* Handle the fractional part. */
+         g = celt_exp2_frac(lg&((1<<DB_SHIFT)-1));
+      }
+      /* Handle extreme gains with negative shift. */
+      if (shift<0)
+      {
+         /* For shift <= -2 and g > 16384 we'd be likely to overflow, so we're
+            capping the gain here, which is equivalent to a cap of 18 on lg.
+            This shouldn't trigger unless the bitstream is already corrupted. */
+         if (shift <= -2)
+         {
+            g = 16384;
+            shift = -2;
+         }
+      }
+      g8 = _mm256_set1_epi32(g);
+      for (;j<band_end-7;j+=8)
+      {
+         __m256i x0;
+         x0 = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)x));
+         _mm256_storeu_si256((__m256i*)f, vshr32_avx2(_mm256_mullo_epi32(x0, g8), shift));
+         x += 8;
+         f += 8;
+      }
+      for (;j<band_end;j++)
+      {
+         *f++ = VSHR32(MULT16_16(*x++, g), shift);
+      }
+   }
+   celt_assert(start <= end);
+   OPUS_CLEAR(&freq[bound], N-bound);
+}
+
+/* Returns PSHR32(c*a + c'*b, 15) in 32-bit lanes for 16-bit lanes
+   interleaved as {a, b, a, b, ...} and coefficients {c, c', c, c', ...}. */
+static OPUS_INLINE __m256i haar1_madd_avx2(__m256i ab, __m256i coef)
+{
+   return _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(ab, coef),
+         _mm256_set1_epi32(16384)), 15);
+}
+
+/* One butterfly level on a row pair per 128-bit lane, held as
+   {a0..a3, b0..b3}. */
+static OPUS_INLINE __m256i haar1_pair_avx2(__m256i x, __m256i sum_coef,
+      __m256i diff_coef)
+{
+   __m256i ab;
+   ab = _mm256_unpacklo_epi16(x, _mm256_srli_si256(x, 8));
+   return _mm256_packs_epi32(extract16_avx2(haar1_madd_avx2(ab, sum_coef)),
+         extract16_avx2(haar1_madd_avx2(ab, diff_coef)));
+}
+
+void haar1_avx2(celt_norm *X, int N0, int stride)
+{
+   int i, j, len;
+   const opus_int16 c = QCONST16(.70710678f,15);
+   __m256i sum_coef, diff_coef;
+   sum_coef = _mm256_set1_epi16(c);
+   diff_coef = _mm256_set1_epi32((opus_int32)(((opus_uint32)(opus_uint16)-c<<16)|c));
+   len = (N0>>1)*2*stride;
+   i = 0;
+   if (stride==1)
+   {
+      for (;i<len-15;i+=16)
+      {
+         __m256i x, s, d;
+         x = _mm256_loadu_si256((__m256i*)(void*)(X+i));
+         s = extract16_avx2(haar1_madd_avx2(x, sum_coef));
+         d = extract16_avx2(haar1_madd_avx2(x, diff_coef));
+         _mm256_storeu_si256((__m256i*)(void*)(X+i), _mm256_packs_epi32(
+               _mm256_unpacklo_epi32(s, d), _mm256_unpackhi_epi32(s, d)));
+      }
+   } else if (stride==2)
+   {
+      /* Two row pairs per 128-bit lane, regrouped as {a, c, b, d} so that
+         each half holds one pair like the stride 4 case. */
+      for (;i<len-15;i+=16)
+      {
+         __m256i x;
+         x = _mm256_loadu_si256((__m256i*)(void*)(X+i));
+         x = _mm256_shuffle_epi32(x, _MM_SHUFFLE(3, 1, 2, 0));
+         x = haar1_pair_avx2(x, sum_coef, diff_coef);
+         _mm256_storeu_si256((__m256i*)(void*)(X+i),
+               _mm256_shuffle_epi32(x, _MM_SHUFFLE(3, 1, 2, 0)));
+      }
+   } else if (stride==4)
+   {
+      for (;i<len-15;i+=16)
+      {
+         __m256i x;
+         x = _mm256_loadu_si256((__m256i*)(void*)(X+i));
+         _mm256_storeu_si256((__m256i*)(void*)(X+i),
+               haar1_pair_avx2(x, sum_coef, diff_coef));
+      }
+   } else if (stride==8)
+   {
+      /* One row pair per register, with each lane taking half the columns. */
+      for (;i<len;i+=16)
+      {
+         __m256i x;
+         x = _mm256_loadu_si256((__m256i*)(void*)(X+i));
+         x = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 1, 2, 0));
+         x = haar1_pair_avx2(x, sum_coef, diff_coef);
+         _mm256_storeu_si256((__m256i*)(void*)(X+i),
+               _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 1, 2, 0)));
+      }
+   } else if ((stride&15)==0)
+   {
+      for (j=0;j<len;j+=2*stride)
+      {
+         celt_norm *x0, *x1;
+         x0 = X+j;
+         x1 = x0+stride;
+         for (i=0;i<stride;i+=16)
+         {
+            __m256i a, b, lo, hi;
+            a = _mm256_loadu_si256((__m256i*)(void*)(x0+i));
+            b = _mm256_loadu_si256((__m256i*)(void*)(x1+i));
+            lo = _mm256_unpacklo_epi16(a, b);
+            hi = _mm256_unpackhi_epi16(a, b);
+            _mm256_storeu_si256((__m256i*)(void*)(x0+i), _mm256_packs_epi32(
+                  extract16_avx2(haar1_madd_avx2(lo, sum_coef)),
+                  extract16_avx2(haar1_madd_avx2(hi, sum_coef))));
+            _mm256_storeu_si256((__m256i*)(void*)(x1+i), _mm256_packs_epi32(
+                  extract16_avx2(haar1_madd_avx2(lo, diff_coef)),
+                  extract16_avx2(haar1_madd_avx2(hi, diff_coef))));
+         }
+      }
+      return;
+   }
+   /* Whole row pairs are left over, if any. */
+   haar1_c(X+i, (len-i)/stride, stride);
+}
+
+opus_val32 l1_metric_avx2(const celt_norm *tmp, int N, int LM, opus_val16 bias)
+{
+   int i;
+   opus_val32 L1;
+   __m256i acc, zero;
+   acc = zero = _mm256_setzero_si256();
+   for (i=0;i<N-15;i+=16)
+   {
+      __m256i x;
+      /* abs(-32768) stays 0x8000, which is right once zero-extended. */
+      x = _mm256_abs_epi16(_mm256_loadu_si256((__m256i*)(void*)(tmp+i)));
+      acc = _mm256_add_epi32(acc, _mm256_unpacklo_epi16(x, zero));
+      acc = _mm256_add_epi32(acc, _mm256_unpackhi_epi16(x, zero));
+   }
+   L1 = hadd32_avx2(acc);
+   for (;i<N;i++)
+      L1 += EXTEND32(ABS16(tmp[i]));
+   /* When in doubt, prefer good freq resolution */
+   L1 = MAC16_32_Q15(L1, LM*bias, L1);
+   return L1;
+}
+
+#else /* FIXED_POINT */
+
+void compute_band_energies_avx2(const CELTMode *m, const celt_sig *X,
+      celt_ener *bandE, int end, int C, int LM, int arch)
+{
+   int i, c, N;
+   const opus_int16 *eBands = m->eBands;
+   (void)arch;
+   N = m->shortMdctSize<<LM;
+   c=0; do {
+      celt_ener *E = &bandE[c*m->nbEBands];
+      for (i=0;i<end;i++)
+      {
+         int j, len;
+         const celt_sig *x;
+         float xy;
+         __m256 sum;
+         __m128 s4;
+         x = &X[c*N+(eBands[i]<<LM)];
+         len = (eBands[i+1]-eBands[i])<<LM;
+         sum = _mm256_setzero_ps();
+         for (j=0;j<len-7;j+=8)
+         {
+            __m256 xi = _mm256_loadu_ps(x+j);
+            sum = _mm256_fmadd_ps(xi, xi, sum);
+         }
+         s4 = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+         s4 = _mm_add_ps(s4, _mm_movehl_ps(s4, s4));
+         s4 = _mm_add_ss(s4, _mm_shuffle_ps(s4, s4, 0x55));
+         xy = _mm_cvtss_f32(s4);
+         for (;j<len;j++)
+            xy = MAC16_16(xy, x[j], x[j]);
+         E[i] = 1e-27f + xy;
+      }
+      /* Square roots for eight bands at a time. */
+      for (i=0;i<end-7;i+=8)
+         _mm256_storeu_ps(&E[i], _mm256_sqrt_ps(_mm256_loadu_ps(&E[i])));
+      if (i<end-3)
+      {
+         _mm_storeu_ps(&E[i], _mm_sqrt_ps(_mm_loadu_ps(&E[i])));
+         i += 4;
+      }
+      for (;i<end;i++)
+         E[i] = celt_sqrt(E[i]);
+   } while (++c<C);
+}
+
+void normalise_bands_avx2(const CELTMode *m,
+      const celt_sig * OPUS_RESTRICT freq, celt_norm * OPUS_RESTRICT X,
+      const celt_ener *bandE, int end, int C, int M, int arch)
+{
+   int i, c, N;
+   const opus_int16 *eBands = m->eBands;
+   VARDECL(opus_val16, g);
+   SAVE_STACK;
+   (void)arch;
+   ALLOC(g, IMAX(end, 1), opus_val16);
+   N = M*m->shortMdctSize;
+   c=0; do {
+      const celt_ener *E = &bandE[c*m->nbEBands];
+      /* Gains for eight bands at a time. */
+      for (i=0;i<end-7;i+=8)
+      {
+         __m256 e8 = _mm256_add_ps(_mm256_set1_ps(1e-27f), _mm256_loadu_ps(&E[i]));
+         _mm256_storeu_ps(&g[i], _mm256_div_ps(_mm256_set1_ps(1.f), e8));
+      }
+      for (;i<end;i++)
+         g[i] = 1.f/(1e-27f+E[i]);
+      for (i=0;i<end;i++)
+      {
+         int j, band_end;
+         __m256 g8 = _mm256_set1_ps(g[i]);
+         j=M*eBands[i];
+         band_end = M*eBands[i+1];
+         for (;j<band_end-7;j+=8)
+            _mm256_storeu_ps(&X[j+c*N], _mm256_mul_ps(_mm256_loadu_ps(&freq[j+c*N]), g8));
+         for (;j<band_end;j++)
+            X[j+c*N] = freq[j+c*N]*g[i];
+      }
+   } while (++c<C);
+   RESTORE_STACK;
+}
+
+void denormalise_bands_avx2(const CELTMode *m,
+      const celt_norm * OPUS_RESTRICT X, celt_sig * OPUS_RESTRICT freq,
+      const opus_val16 *bandLogE, int start, int end, int M, int downsample,
+      int silence, int arch)
+{
+   int i, N;
+   int bound;
+   celt_sig * OPUS_RESTRICT f;
+   const celt_norm * OPUS_RESTRICT x;
+   const opus_int16 *eBands = m->eBands;
+   (void)arch;
+   N = M*m->shortMdctSize;
+   bound = M*eBands[end];
+   if (downsample!=1)
+      bound = IMIN(bound, N/downsample);
+   if (silence)
+   {
+      bound = 0;
+      start = end = 0;
+   }
+   f = freq;
+   x = X+M*eBands[start];
+   for (i=0;i<M*eBands[start];i++)
+      *f++ = 0;
+   for (i=start;i<end;i++)
+   {
+      int j, band_end;
+      opus_val16 g;
+      opus_val16 lg;
+      __m256 g8;
+      j=M*eBands[i];
+      band_end = M*eBands[i+1];
+      lg = SATURATE16(ADD32(bandLogE[i], SHL32((opus_val32)eMeans[i],6)));
+      g = celt_exp2(MIN32(32.f, lg));
+      g8 = _mm256_set1_ps(g);
+      for (;j<band_end-7;j+=8)
+      {
+         _mm256_storeu_ps(f, _mm256_mul_ps(_mm256_loadu_ps(x), g8));
+         x += 8;
+         f += 8;
+      }
+      for (;j<band_end;j++)
+         *f++ = *x++ * g;
+   }
+   celt_assert(start <= end);
+   OPUS_CLEAR(&freq[bound], N-bound);
+}
+
+void haar1_avx2(celt_norm *X, int N0, int stride)
+{
+   int i, j, len;
+   __m256 c8;
+   c8 = _mm256_set1_ps(.70710678f);
+   len = (N0>>1)*2*stride;
+   i = 0;
+   if (stride<=4)
+   {
+      /* Deinterleave the a and b sides of sixteen values, then put the sums
+         and differences back in place. */
+      for (;i<len-15;i+=16)
+      {
+         __m256 x0, x1, a, b, s, d;
+         x0 = _mm256_loadu_ps(X+i);
+         x1 = _mm256_loadu_ps(X+i+8);
+         if (stride==1)
+         {
+            a = _mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(2, 0, 2, 0));
+            b = _mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(3, 1, 3, 1));
+         } else if (stride==2)
+         {
+            a = _mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(1, 0, 1, 0));
+            b = _mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(3, 2, 3, 2));
+         } else {
+            a = _mm256_permute2f128_ps(x0, x1, 0x20);
+            b = _mm256_permute2f128_ps(x0, x1, 0x31);
+         }
+         a = _mm256_mul_ps(a, c8);
+         b = _mm256_mul_ps(b, c8);
+         s = _mm256_add_ps(a, b);
+         d = _mm256_sub_ps(a, b);
+         if (stride==1)
+         {
+            x0 = _mm256_unpacklo_ps(s, d);
+            x1 = _mm256_unpackhi_ps(s, d);
+         } else if (stride==2)
+         {
+            x0 = _mm256_shuffle_ps(s, d, _MM_SHUFFLE(1, 0, 1, 0));
+            x1 = _mm256_shuffle_ps(s, d, _MM_SHUFFLE(3, 2, 3, 2));
+         } else {
+            x0 = _mm256_permute2f128_ps(s, d, 0x20);
+            x1 = _mm256_permute2f128_ps(s, d, 0x31);
+         }
+         _mm256_storeu_ps(X+i, x0);
+         _mm256_storeu_ps(X+i+8, x1);
+      }
+   } else if ((stride&7)==0)
+   {
+      for (j=0;j<len;j+=2*stride)
+      {
+         celt_norm *x0, *x1;
+         x0 = X+j;
+         x1 = x0+stride;
+         for (i=0;i<stride;i+=8)
+         {
+            __m256 a, b;
+            a = _mm256_mul_ps(_mm256_loadu_ps(x0+i), c8);
+            b = _mm256_mul_ps(_mm256_loadu_ps(x1+i), c8);
+            _mm256_storeu_ps(x0+i, _mm256_add_ps(a, b));
+            _mm256_storeu_ps(x1+i, _mm256_sub_ps(a, b));
+         }
+      }
+      return;
+   }
+   /* Whole row pairs are left over, if any. */
+   haar1_c(X+i, (len-i)/stride, stride);
+}
+
+opus_val32 l1_metric_avx2(const celt_norm *tmp, int N, int LM, opus_val16 bias)
+{
+   int i;
+   opus_val32 L1;
+   __m256 acc0, acc1, sign;
+   __m128 acc;
+   acc0 = acc1 = _mm256_setzero_ps();
+   sign = _mm256_set1_ps(-0.f);
+   for (i=0;i<N-15;i+=16)
+   {
+      acc0 = _mm256_add_ps(acc0, _mm256_andnot_ps(sign, _mm256_loadu_ps(tmp+i)));
+      acc1 = _mm256_add_ps(acc1, _mm256_andnot_ps(sign, _mm256_loadu_ps(tmp+i+8)));
+   }
+   acc0 = _mm256_add_ps(acc0, acc1);
+   acc = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+   acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+   acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(1, 1, 1, 1)));
+   L1 = _mm_cvtss_f32(acc);
+   for (;i<N;i++)
+      L1 += EXTEND32(ABS16(tmp[i]));
+   /* When in doubt, prefer good freq resolution */
+   L1 = MAC16_32_Q15(L1, LM*bias, L1);
+   return L1;
+}
+
+#endif /* FIXED_POINT */
+
+#endif
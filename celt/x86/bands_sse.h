@@ -0,0 +1,134 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef BANDS_SSE_H
+#define BANDS_SSE_H
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2) || defined(OPUS_X86_MAY_HAVE_AVX2)
+#define OVERRIDE_COMPUTE_BAND_ENERGIES
+#define OVERRIDE_NORMALISE_BANDS
+#define OVERRIDE_DENORMALISE_BANDS
+#define OVERRIDE_HAAR1
+#define OVERRIDE_L1_METRIC
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2)
+void compute_band_energies_sse2(const CELTMode *m, const celt_sig *X,
+      celt_ener *bandE, int end, int C, int LM, int arch);
+
+void normalise_bands_sse2(const CELTMode *m,
+      const celt_sig * OPUS_RESTRICT freq, celt_norm * OPUS_RESTRICT X,
+      const celt_ener *bandE, int end, int C, int M, int arch);
+
+void denormalise_bands_sse2(const CELTMode *m,
+      const celt_norm * OPUS_RESTRICT X, celt_sig * OPUS_RESTRICT freq,
+      const opus_val16 *bandE, int start, int end, int M, int downsample,
+      int silence, int arch);
+
+void haar1_sse2(celt_norm *X, int N0, int stride);
+
+opus_val32 l1_metric_sse2(const celt_norm *tmp, int N, int LM, opus_val16 bias);
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+void compute_band_energies_avx2(const CELTMode *m, const celt_sig *X,
+      celt_ener *bandE, int end, int C, int LM, int arch);
+
+void normalise_bands_avx2(const CELTMode *m,
+      const celt_sig * OPUS_RESTRICT freq, celt_norm * OPUS_RESTRICT X,
+      const celt_ener *bandE, int end, int C, int M, int arch);
+
+void denormalise_bands_avx2(const CELTMode *m,
+      const celt_norm * OPUS_RESTRICT X, celt_sig * OPUS_RESTRICT freq,
+      const opus_val16 *bandE, int start, int end, int M, int downsample,
+      int silence, int arch);
+
+void haar1_avx2(celt_norm *X, int N0, int stride);
+
+opus_val32 l1_metric_avx2(const celt_norm *tmp, int N, int LM, opus_val16 bias);
+#endif
+
+#if defined(OPUS_X86_PRESUME_AVX2)
+
+#define compute_band_energies(m, X, bandE, end, C, LM, arch) \
+    (compute_band_energies_avx2(m, X, bandE, end, C, LM, arch))
+#define normalise_bands(m, freq, X, bandE, end, C, M, arch) \
+    (normalise_bands_avx2(m, freq, X, bandE, end, C, M, arch))
+#define denormalise_bands(m, X, freq, bandE, start, end, M, downsample, silence, arch) \
+    (denormalise_bands_avx2(m, X, freq, bandE, start, end, M, downsample, silence, arch))
+#define haar1(X, N0, stride, arch) \
+    ((void)(arch), haar1_avx2(X, N0, stride))
+#define l1_metric(tmp, N, LM, bias, arch) \
+    ((void)(arch), l1_metric_avx2(tmp, N, LM, bias))
+
+#elif defined(OPUS_X86_PRESUME_SSE2) && !defined(OPUS_X86_MAY_HAVE_AVX2)
+
+#define compute_band_energies(m, X, bandE, end, C, LM, arch) \
+    (compute_band_energies_sse2(m, X, bandE, end, C, LM, arch))
+#define normalise_bands(m, freq, X, bandE, end, C, M, arch) \
+    (normalise_bands_sse2(m, freq, X, bandE, end, C, M, arch))
+#define denormalise_bands(m, X, freq, bandE, start, end, M, downsample, silence, arch) \
+    (denormalise_bands_sse2(m, X, freq, bandE, start, end, M, downsample, silence, arch))
+#define haar1(X, N0, stride, arch) \
+    ((void)(arch), haar1_sse2(X, N0, stride))
+#define l1_metric(tmp, N, LM, bias, arch) \
+    ((void)(arch), l1_metric_sse2(tmp, N, LM, bias))
+
+#else
+
+extern void (*const COMPUTE_BAND_ENERGIES_IMPL[OPUS_ARCHMASK + 1])(
+      const CELTMode *m, const celt_sig *X, celt_ener *bandE, int end, int C,
+      int LM, int arch);
+#define compute_band_energies(m, X, bandE, end, C, LM, arch) \
+    ((*COMPUTE_BAND_ENERGIES_IMPL[(arch) & OPUS_ARCHMASK])(m, X, bandE, end, C, LM, arch))
+
+extern void (*const NORMALISE_BANDS_IMPL[OPUS_ARCHMASK + 1])(
+      const CELTMode *m, const celt_sig * OPUS_RESTRICT freq,
+      celt_norm * OPUS_RESTRICT X, const celt_ener *bandE, int end, int C,
+      int M, int arch);
+#define normalise_bands(m, freq, X, bandE, end, C, M, arch) \
+    ((*NORMALISE_BANDS_IMPL[(arch) & OPUS_ARCHMASK])(m, freq, X, bandE, end, C, M, arch))
+
+extern void (*const DENORMALISE_BANDS_IMPL[OPUS_ARCHMASK + 1])(
+      const CELTMode *m, const celt_norm * OPUS_RESTRICT X,
+      celt_sig * OPUS_RESTRICT freq, const opus_val16 *bandE, int start,
+      int end, int M, int downsample, int silence, int arch);
+#define denormalise_bands(m, X, freq, bandE, start, end, M, downsample, silence, arch) \
+    ((*DENORMALISE_BANDS_IMPL[(arch) & OPUS_ARCHMASK])(m, X, freq, bandE, start, end, M, downsample, silence, arch))
+
+extern void (*const HAAR1_IMPL[OPUS_ARCHMASK + 1])(
+      celt_norm *X, int N0, int stride);
+#define haar1(X, N0, stride, arch) \
+    ((*HAAR1_IMPL[(arch) & OPUS_ARCHMASK])(X, N0, stride))
+
+extern opus_val32 (*const L1_METRIC_IMPL[OPUS_ARCHMASK + 1])(
+      const celt_norm *tmp, int N, int LM, opus_val16 bias);
+#define l1_metric(tmp, N, LM, bias, arch) \
+    ((*L1_METRIC_IMPL[(arch) & OPUS_ARCHMASK])(tmp, N, LM, bias))
+
+#endif
+#endif
+
+#endif
@@ -0,0 +1,578 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#include "bands.h"
+#include "modes.h"
+#include "mathops.h"
+#include "quant_bands.h"
+#include "x86cpu.h"
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2)
+
+#ifdef FIXED_POINT
+
+/* Truncates each 32-bit lane to 16 bits, sign-extended, like EXTRACT16(). */
+static OPUS_INLINE __m128i extract16_sse2(__m128i x)
+{
+   return _mm_srai_epi32(_mm_slli_epi32(x, 16), 16);
+}
+
+static OPUS_INLINE __m128i max32_sse2(__m128i a, __m128i b)
+{
+   __m128i gt = _mm_cmpgt_epi32(a, b);
+   return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+}
+
+static OPUS_INLINE __m128i min32_sse2(__m128i a, __m128i b)
+{
+   __m128i gt = _mm_cmpgt_epi32(a, b);
+   return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a));
+}
+
+/* Same as VSHR32() with the shift applied to every lane. */
+static OPUS_INLINE __m128i vshr32_sse2(__m128i x, int shift)
+{
+   if (shift>0)
+      return _mm_sra_epi32(x, _mm_cvtsi32_si128(shift));
+   else
+      return _mm_sll_epi32(x, _mm_cvtsi32_si128(-shift));
+}
+
+static OPUS_INLINE opus_int32 hadd32_sse2(__m128i x)
+{
+   x = _mm_add_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+   x = _mm_add_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)));
+   return _mm_cvtsi128_si32(x);
+}
+
+void compute_band_energies_sse2(const CELTMode *m, const celt_sig *X,
+      celt_ener *bandE, int end, int C, int LM, int arch)
+{
+   int i, c, N;
+   const opus_int16 *eBands = m->eBands;
+   (void)arch;
+   N = m->shortMdctSize<<LM;
+   c=0; do {
+      for (i=0;i<end;i++)
+      {
+         int j, len;
+         const celt_sig *x;
+         opus_val32 maxval=0;
+         opus_val32 minval=0;
+         opus_val32 sum = 0;
+         __m128i vmax, vmin;
+         opus_val32 tmp[4];
+
+         x = &X[c*N+(eBands[i]<<LM)];
+         len = (eBands[i+1]-eBands[i])<<LM;
+         vmax = vmin = _mm_setzero_si128();
+         for (j=0;j<len-3;j+=4)
+         {
+            __m128i xi = _mm_loadu_si128((const __m128i*)&x[j]);
+            vmax = max32_sse2(vmax, xi);
+            vmin = min32_sse2(vmin, xi);
+         }
+         _mm_storeu_si128((__m128i*)tmp, vmax);
+         maxval = MAX32(MAX32(tmp[0], tmp[1]), MAX32(tmp[2], tmp[3]));
+         _mm_storeu_si128((__m128i*)tmp, vmin);
+         minval = MIN32(MIN32(tmp[0], tmp[1]), MIN32(tmp[2], tmp[3]));
+         for (;j<len;j++)
+         {
+            maxval = MAX32(maxval, x[j]);
+            minval = MIN32(minval, x[j]);
+         }
+         maxval = MAX32(maxval, -minval);
+         if (maxval > 0)
+         {
+            int shift = celt_ilog2(maxval) - 14 + (((m->logN[i]>>BITRES)+LM+1)>>1);
+            __m128i acc = _mm_setzero_si128();
+            for (j=0;j<len-7;j+=8)
+            {
+               __m128i x0, x1;
+               x0 = extract16_sse2(vshr32_sse2(_mm_loadu_si128((const __m128i*)&x[j]), shift));
+               x1 = extract16_sse2(vshr32_sse2(_mm_loadu_si128((const __m128i*)&x[j+4]), shift));
+               x0 = _mm_packs_epi32(x0, x1);
+               acc = _mm_add_epi32(acc, _mm_madd_epi16(x0, x0));
+            }
+            sum = hadd32_sse2(acc);
+            for (;j<len;j++)
+            {
+               opus_val16 t = EXTRACT16(VSHR32(x[j], shift));
+               sum = MAC16_16(sum, t, t);
+            }
+            /* We're adding one here to ensure the normalized band isn't larger than unity norm */
+            bandE[i+c*m->nbEBands] = EPSILON+VSHR32(EXTEND32(celt_sqrt(sum)),-shift);
+         } else {
+            bandE[i+c*m->nbEBands] = EPSILON;
+         }
+      }
+   } while (++c<C);
+}
+
+void normalise_bands_sse2(const CELTMode *m,
+      const celt_sig * OPUS_RESTRICT freq, celt_norm * OPUS_RESTRICT X,
+      const celt_ener *bandE, int end, int C, int M, int arch)
+{
+   int i, c, N;
+   const opus_int16 *eBands = m->eBands;
+   (void)arch;
+   N = M*m->shortMdctSize;
+   c=0; do {
+      i=0; do {
+         opus_val16 g;
+         int j, band_end, shift;
+         opus_val16 E;
+         __m128i g8;
+         shift = celt_zlog2(bandE[i+c*m->nbEBands])-13;
+         E = VSHR32(bandE[i+c*m->nbEBands], shift);
+         g = EXTRACT16(celt_rcp(SHL32(E,3)));
+         g8 = _mm_set1_epi16(g);
+         j=M*eBands[i];
+         band_end = M*eBands[i+1];
+         for (;j<band_end-7;j+=8)
+         {
+            __m128i x0, x1, hi, lo;
+            x0 = extract16_sse2(vshr32_sse2(_mm_loadu_si128((const __m128i*)&freq[j+c*N]), shift-1));
+            x1 = extract16_sse2(vshr32_sse2(_mm_loadu_si128((const __m128i*)&freq[j+c*N+4]), shift-1));
+            x0 = _mm_packs_epi32(x0, x1);
+            /* Bits 15 to 30 of the 32-bit product, i.e. MULT16_16_Q15(). */
+            hi = _mm_mulhi_epi16(x0, g8);
+            lo = _mm_mullo_epi16(x0, g8);
+            x0 = _mm_or_si128(_mm_slli_epi16(hi, 1), _mm_srli_epi16(lo, 15));
+            _mm_storeu_si128((__m128i*)&X[j+c*N], x0);
+         }
+         for (;j<band_end;j++)
+            X[j+c*N] = MULT16_16_Q15(VSHR32(freq[j+c*N],shift-1),g);
+      } while (++i<end);
+   } while (++c<C);
+}
+
+void denormalise_bands_sse2(const CELTMode *m,
+      const celt_norm * OPUS_RESTRICT X, celt_sig * OPUS_RESTRICT freq,
+      const opus_val16 *bandLogE, int start, int end, int M, int downsample,
+      int silence, int arch)
+{
+   int i, N;
+   int bound;
+   celt_sig * OPUS_RESTRICT f;
+   const celt_norm * OPUS_RESTRICT x;
+   const opus_int16 *eBands = m->eBands;
+   (void)arch;
+   N = M*m->shortMdctSize;
+   bound = M*eBands[end];
+   if (downsample!=1)
+      bound = IMIN(bound, N/downsample);
+   if (silence)
+   {
+      bound = 0;
+      start = end = 0;
+   }
+   f = freq;
+   x = X+M*eBands[start];
+   for (i=0;i<M*eBands[start];i++)
+      *f++ = 0;
+   for (i=start;i<end;i++)
+   {
+      int j, band_end;
+      opus_val16 g;
+      opus_val16 lg;
+      int shift;
+      __m128i g8;
+      j=M*eBands[i];
+      band_end = M*eBands[i+1];
+      lg = SATURATE16(ADD32(bandLogE[i], SHL32((opus_val32)eMeans[i],6)));
+      /* Handle the integer part of the log energy */
+      shift = 16-(lg>>DB_SHIFT);
+      if (shift>31)
+      {
+         shift=0;
+         g=0;
+      } else {
+         /* Handle the fractional part. */
+         g = celt_exp2_frac(lg&((1<<DB_SHIFT)-1));
+      }
+      /* Handle extreme gains with negative shift. */
+      if (shift<0)
+      {
+         /* For shift <= -2 and g > 16384 we'd be likely to overflow, so we're
+            capping the gain here, which is equivalent to a cap of 18 on lg.
+            This shouldn't trigger unless the bitstream is already corrupted. */
+         if (shift <= -2)
+         {
+            g = 16384;
+            shift = -2;
+         }
+      }
+      g8 = _mm_set1_epi16(g);
+      for (;j<band_end-7;j+=8)
+      {
+         __m128i x0, hi, lo;
+         x0 = _mm_loadu_si128((const __m128i*)x);
+         hi = _mm_mulhi_epi16(x0, g8);
+         lo = _mm_mullo_epi16(x0, g8);
+         _mm_storeu_si128((__m128i*)f, vshr32_sse2(_mm_unpacklo_epi16(lo, hi), shift));
+         _mm_storeu_si128((__m128i*)(f+4), vshr32_sse2(_mm_unpackhi_epi16(lo, hi), shift));
+         x += 8;
+         f += 8;
+      }
+      for (;j<band_end;j++)
+      {
+         *f++ = VSHR32(MULT16_16(*x++, g), shift);
+      }
+   }
+   celt_assert(start <= end);
+   OPUS_CLEAR(&freq[bound], N-bound);
+}
+
+/* Returns PSHR32(c*a + c'*b, 15) in 32-bit lanes for 16-bit lanes
+   interleaved as {a, b, a, b, ...} and coefficients {c, c', c, c', ...}. */
+static OPUS_INLINE __m128i haar1_madd_sse2(__m128i ab, __m128i coef)
+{
+   return _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(ab, coef),
+         _mm_set1_epi32(16384)), 15);
+}
+
+/* One butterfly level on a row pair held as {a0..a3, b0..b3}. */
+static OPUS_INLINE __m128i haar1_pair_sse2(__m128i x, __m128i sum_coef,
+      __m128i diff_coef)
+{
+   __m128i ab;
+   ab = _mm_unpacklo_epi16(x, _mm_srli_si128(x, 8));
+   return _mm_packs_epi32(extract16_sse2(haar1_madd_sse2(ab, sum_coef)),
+         extract16_sse2(haar1_madd_sse2(ab, diff_coef)));
+}
+
+void haar1_sse2(celt_norm *X, int N0, int stride)
+{
+   int i, j, len;
+   const opus_int16 c = QCONST16(.70710678f,15);
+   __m128i sum_coef, diff_coef;
+   sum_coef = _mm_set1_epi16(c);
+   diff_coef = _mm_set_epi16(-c, c, -c, c, -c, c, -c, c);
+   len = (N0>>1)*2*stride;
+   i = 0;
+   if (stride==1)
+   {
+      for (;i<len-7;i+=8)
+      {
+         __m128i x, s, d;
+         x = _mm_loadu_si128((__m128i*)(void*)(X+i));
+         s = extract16_sse2(haar1_madd_sse2(x, sum_coef));
+         d = extract16_sse2(haar1_madd_sse2(x, diff_coef));
+         _mm_storeu_si128((__m128i*)(void*)(X+i), _mm_packs_epi32(
+               _mm_unpacklo_epi32(s, d), _mm_unpackhi_epi32(s, d)));
+      }
+   } else if (stride==2)
+   {
+      /* Two row pairs per register, regrouped as {a, c, b, d} so that each
+         half holds one pair like the stride 4 case. */
+      for (;i<len-7;i+=8)
+      {
+         __m128i x;
+         x = _mm_loadu_si128((__m128i*)(void*)(X+i));
+         x = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 1, 2, 0));
+         x = haar1_pair_sse2(x, sum_coef, diff_coef);
+         _mm_storeu_si128((__m128i*)(void*)(X+i),
+               _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 1, 2, 0)));
+      }
+   } else if (stride==4)
+   {
+      for (;i<len-7;i+=8)
+      {
+         __m128i x;
+         x = _mm_loadu_si128((__m128i*)(void*)(X+i));
+         _mm_storeu_si128((__m128i*)(void*)(X+i),
+               haar1_pair_sse2(x, sum_coef, diff_coef));
+      }
+   } else if ((stride&7)==0)
+   {
+      for (j=0;j<len;j+=2*stride)
+      {
+         celt_norm *x0, *x1;
+         x0 = X+j;
+         x1 = x0+stride;
+         for (i=0;i<stride;i+=8)
+         {
+            __m128i a, b, lo, hi;
+            a = _mm_loadu_si128((__m128i*)(void*)(x0+i));
+            b = _mm_loadu_si128((__m128i*)(void*)(x1+i));
+            lo = _mm_unpacklo_epi16(a, b);
+            hi = _mm_unpackhi_epi16(a, b);
+            _mm_storeu_si128((__m128i*)(void*)(x0+i), _mm_packs_epi32(
+                  extract16_sse2(haar1_madd_sse2(lo, sum_coef)),
+                  extract16_sse2(haar1_madd_sse2(hi, sum_coef))));
+            _mm_storeu_si128((__m128i*)(void*)(x1+i), _mm_packs_epi32(
+                  extract16_sse2(haar1_madd_sse2(lo, diff_coef)),
+                  extract16_sse2(haar1_madd_sse2(hi, diff_coef))));
+         }
+      }
+      return;
+   }
+   /* Whole row pairs are left over, if any. */
+   haar1_c(X+i, (len-i)/stride, stride);
+}
+
+opus_val32 l1_metric_sse2(const celt_norm *tmp, int N, int LM, opus_val16 bias)
+{
+   int i;
+   opus_val32 L1;
+   __m128i acc, zero;
+   acc = zero = _mm_setzero_si128();
+   for (i=0;i<N-7;i+=8)
+   {
+      __m128i x;
+      x = _mm_loadu_si128((__m128i*)(void*)(tmp+i));
+      /* -32768 stays 0x8000, which is right once zero-extended. */
+      x = _mm_max_epi16(x, _mm_sub_epi16(zero, x));
+      acc = _mm_add_epi32(acc, _mm_unpacklo_epi16(x, zero));
+      acc = _mm_add_epi32(acc, _mm_unpackhi_epi16(x, zero));
+   }
+   L1 = hadd32_sse2(acc);
+   for (;i<N;i++)
+      L1 += EXTEND32(ABS16(tmp[i]));
+   /* When in doubt, prefer good freq resolution */
+   L1 = MAC16_32_Q15(L1, LM*bias, L1);
+   return L1;
+}
+
+#else /* FIXED_POINT */
+
+void compute_band_energies_sse2(const CELTMode *m, const celt_sig *X,
+      celt_ener *bandE, int end, int C, int LM, int arch)
+{
+   int i, c, N;
+   const opus_int16 *eBands = m->eBands;
+   (void)arch;
+   N = m->shortMdctSize<<LM;
+   c=0; do {
+      celt_ener *E = &bandE[c*m->nbEBands];
+      for (i=0;i<end;i++)
+      {
+         int j, len;
+         const celt_sig *x;
+         float xy;
+         __m128 sum;
+         x = &X[c*N+(eBands[i]<<LM)];
+         len = (eBands[i+1]-eBands[i])<<LM;
+         /* Same summation order as celt_inner_prod_sse(). */
+         sum = _mm_setzero_ps();
+         for (j=0;j<len-3;j+=4)
+         {
+            __m128 xi = _mm_loadu_ps(x+j);
+            sum = _mm_add_ps(sum, _mm_mul_ps(xi, xi));
+         }
+         sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+         sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 0x55));
+         _mm_store_ss(&xy, sum);
+         for (;j<len;j++)
+            xy = MAC16_16(xy, x[j], x[j]);
+         E[i] = 1e-27f + xy;
+      }
+      /* Square roots for four bands at a time. */
+      for (i=0;i<end-3;i+=4)
+         _mm_storeu_ps(&E[i], _mm_sqrt_ps(_mm_loadu_ps(&E[i])));
+      for (;i<end;i++)
+         E[i] = celt_sqrt(E[i]);
+   } while (++c<C);
+}
+
+void normalise_bands_sse2(const CELTMode *m,
+      const celt_sig * OPUS_RESTRICT freq, celt_norm * OPUS_RESTRICT X,
+      const celt_ener *bandE, int end, int C, int M, int arch)
+{
+   int i, c, N;
+   const opus_int16 *eBands = m->eBands;
+   VARDECL(opus_val16, g);
+   SAVE_STACK;
+   (void)arch;
+   ALLOC(g, IMAX(end, 1), opus_val16);
+   N = M*m->shortMdctSize;
+   c=0; do {
+      const celt_ener *E = &bandE[c*m->nbEBands];
+      /* Gains for four bands at a time. */
+      for (i=0;i<end-3;i+=4)
+      {
+         __m128 e4 = _mm_add_ps(_mm_set1_ps(1e-27f), _mm_loadu_ps(&E[i]));
+         _mm_storeu_ps(&g[i], _mm_div_ps(_mm_set1_ps(1.f), e4));
+      }
+      for (;i<end;i++)
+         g[i] = 1.f/(1e-27f+E[i]);
+      for (i=0;i<end;i++)
+      {
+         int j, band_end;
+         __m128 g4 = _mm_set1_ps(g[i]);
+         j=M*eBands[i];
+         band_end = M*eBands[i+1];
+         for (;j<band_end-3;j+=4)
+            _mm_storeu_ps(&X[j+c*N], _mm_mul_ps(_mm_loadu_ps(&freq[j+c*N]), g4));
+         for (;j<band_end;j++)
+            X[j+c*N] = freq[j+c*N]*g[i];
+      }
+   } while (++c<C);
+   RESTORE_STACK;
+}
+
+void denormalise_bands_sse2(const CELTMode *m,
+      const celt_norm * OPUS_RESTRICT X, celt_sig * OPUS_RESTRICT freq,
+      const opus_val16 *bandLogE, int start, int end, int M, int downsample,
+      int silence, int arch)
+{
+   int i, N;
+   int bound;
+   celt_sig * OPUS_RESTRICT f;
+   const celt_norm * OPUS_RESTRICT x;
+   const opus_int16 *eBands = m->eBands;
+   (void)arch;
+   N = M*m->shortMdctSize;
+   bound = M*eBands[end];
+   if (downsample!=1)
+      bound = IMIN(bound, N/downsample);
+   if (silence)
+   {
+      bound = 0;
+      start = end = 0;
+   }
+   f = freq;
+   x = X+M*eBands[start];
+   for (i=0;i<M*eBands[start];i++)
+      *f++ = 0;
+   for (i=start;i<end;i++)
+   {
+      int j, band_end;
+      opus_val16 g;
+      opus_val16 lg;
+      __m128 g4;
+      j=M*eBands[i];
+      band_end = M*eBands[i+1];
+      lg = SATURATE16(ADD32(bandLogE[i], SHL32((opus_val32)eMeans[i],6)));
+      g = celt_exp2(MIN32(32.f, lg));
+      g4 = _mm_set1_ps(g);
+      for (;j<band_end-3;j+=4)
+      {
+         _mm_storeu_ps(f, _mm_mul_ps(_mm_loadu_ps(x), g4));
+         x += 4;
+         f += 4;
+      }
+      for (;j<band_end;j++)
+         *f++ = *x++ * g;
+   }
+   celt_assert(start <= end);
+   OPUS_CLEAR(&freq[bound], N-bound);
+}
+
+void haar1_sse2(celt_norm *X, int N0, int stride)
+{
+   int i, j, len;
+   __m128 c4;
+   c4 = _mm_set1_ps(.70710678f);
+   len = (N0>>1)*2*stride;
+   i = 0;
+   if (stride==1 || stride==2)
+   {
+      /* Deinterleave the a and b sides of eight values, then put the sums
+         and differences back in place. */
+      for (;i<len-7;i+=8)
+      {
+         __m128 x0, x1, a, b, s, d;
+         x0 = _mm_loadu_ps(X+i);
+         x1 = _mm_loadu_ps(X+i+4);
+         if (stride==1)
+         {
+            a = _mm_shuffle_ps(x0, x1, _MM_SHUFFLE(2, 0, 2, 0));
+            b = _mm_shuffle_ps(x0, x1, _MM_SHUFFLE(3, 1, 3, 1));
+         } else {
+            a = _mm_shuffle_ps(x0, x1, _MM_SHUFFLE(1, 0, 1, 0));
+            b = _mm_shuffle_ps(x0, x1, _MM_SHUFFLE(3, 2, 3, 2));
+         }
+         a = _mm_mul_ps(a, c4);
+         b = _mm_mul_ps(b, c4);
+         s = _mm_add_ps(a, b);
+         d = _mm_sub_ps(a, b);
+         if (stride==1)
+         {
+            x0 = _mm_unpacklo_ps(s, d);
+            x1 = _mm_unpackhi_ps(s, d);
+         } else {
+            x0 = _mm_shuffle_ps(s, d, _MM_SHUFFLE(1, 0, 1, 0));
+            x1 = _mm_shuffle_ps(s, d, _MM_SHUFFLE(3, 2, 3, 2));
+         }
+         _mm_storeu_ps(X+i, x0);
+         _mm_storeu_ps(X+i+4, x1);
+      }
+   } else if ((stride&3)==0)
+   {
+      for (j=0;j<len;j+=2*stride)
+      {
+         celt_norm *x0, *x1;
+         x0 = X+j;
+         x1 = x0+stride;
+         for (i=0;i<stride;i+=4)
+         {
+            __m128 a, b;
+            a = _mm_mul_ps(_mm_loadu_ps(x0+i), c4);
+            b = _mm_mul_ps(_mm_loadu_ps(x1+i), c4);
+            _mm_storeu_ps(x0+i, _mm_add_ps(a, b));
+            _mm_storeu_ps(x1+i, _mm_sub_ps(a, b));
+         }
+      }
+      return;
+   }
+   /* Whole row pairs are left over, if any. */
+   haar1_c(X+i, (len-i)/stride, stride);
+}
+
+opus_val32 l1_metric_sse2(const celt_norm *tmp, int N, int LM, opus_val16 bias)
+{
+   int i;
+   opus_val32 L1;
+   __m128 acc0, acc1, sign;
+   acc0 = acc1 = _mm_setzero_ps();
+   sign = _mm_set1_ps(-0.f);
+   for (i=0;i<N-7;i+=8)
+   {
+      acc0 = _mm_add_ps(acc0, _mm_andnot_ps(sign, _mm_loadu_ps(tmp+i)));
+      acc1 = _mm_add_ps(acc1, _mm_andnot_ps(sign, _mm_loadu_ps(tmp+i+4)));
+   }
+   acc0 = _mm_add_ps(acc0, acc1);
+   acc0 = _mm_add_ps(acc0, _mm_movehl_ps(acc0, acc0));
+   acc0 = _mm_add_ss(acc0, _mm_shuffle_ps(acc0, acc0, _MM_SHUFFLE(1, 1, 1, 1)));
+   L1 = _mm_cvtss_f32(acc0);
+   for (;i<N;i++)
+      L1 += EXTEND32(ABS16(tmp[i]));
+   /* When in doubt, prefer good freq resolution */
+   L1 = MAC16_32_Q15(L1, LM*bias, L1);
+   return L1;
+}
+
+#endif /* FIXED_POINT */
+
+#endif
@@ -0,0 +1,463 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+#include "celt_lpc.h"
+#include "stack_alloc.h"
+#include "mathops.h"
+#include "pitch.h"
+#include "x86cpu.h"
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+
+#if defined(FIXED_POINT)
+
+void celt_fir_avx2(const opus_val16 *x,
+         const opus_val16 *num,
+         opus_val16 *y,
+         int N,
+         int ord,
+         int arch)
+{
+   int i,j;
+   VARDECL(opus_val16, rnum);
+   VARDECL(opus_int32, rnum2);
+   __m256i vecNoA;
+   opus_int32 noA;
+   SAVE_STACK;
+
+   (void)arch;
+   ALLOC(rnum, ord, opus_val16);
+   ALLOC(rnum2, (ord+1)>>1, opus_int32);
+   for(i=0;i<ord;i++)
+      rnum[i] = num[ord-i-1];
+   /* Pairs of taps, packed the way _mm256_madd_epi16() wants them. */
+   for(i=0;i<ord-1;i+=2)
+      rnum2[i>>1] = (opus_int32)(((opus_uint32)(opus_uint16)rnum[i+1]<<16)|(opus_uint16)rnum[i]);
+   noA = EXTEND32(1) << SIG_SHIFT >> 1;
+   vecNoA = _mm256_set1_epi32(noA);
+
+   /* Eight outputs at a time. Interleaving x[k] with x[k+1] lets each madd
+      apply two taps to all eight outputs. */
+   for (i=0;i<N-7;i+=8)
+   {
+      __m256i vecSum;
+      __m128i vecOut;
+      vecSum = _mm256_setzero_si256();
+      for (j=0;j<ord-1;j+=2)
+      {
+         __m128i x0, x1;
+         __m256i vecX;
+         x0 = _mm_loadu_si128((__m128i *)(x+i+j-ord));
+         x1 = _mm_loadu_si128((__m128i *)(x+i+j-ord+1));
+         vecX = _mm256_inserti128_si256(_mm256_castsi128_si256(
+               _mm_unpacklo_epi16(x0, x1)), _mm_unpackhi_epi16(x0, x1), 1);
+         vecSum = _mm256_add_epi32(vecSum,
+               _mm256_madd_epi16(vecX, _mm256_set1_epi32(rnum2[j>>1])));
+      }
+      if (j<ord)
+      {
+         vecSum = _mm256_add_epi32(vecSum, _mm256_mullo_epi32(
+               _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i *)(x+i+j-ord))),
+               _mm256_set1_epi32(rnum[j])));
+      }
+      vecSum = _mm256_srai_epi32(_mm256_add_epi32(vecSum, vecNoA), SIG_SHIFT);
+      vecSum = _mm256_add_epi32(vecSum,
+            _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i *)(x+i))));
+      vecOut = _mm_packs_epi32(_mm256_castsi256_si128(vecSum),
+            _mm256_extracti128_si256(vecSum, 1));
+      _mm_storeu_si128((__m128i *)(y+i), vecOut);
+   }
+   for (;i<N;i++)
+   {
+      opus_val32 sum = 0;
+      for (j=0;j<ord;j++)
+         sum = MAC16_16(sum, rnum[j], x[i+j-ord]);
+      y[i] = SATURATE16(ADD32(EXTEND32(x[i]), PSHR32(sum, SIG_SHIFT)));
+   }
+
+   RESTORE_STACK;
+}
+
+#else
+
+void celt_fir_avx2(const opus_val16 *x,
+         const opus_val16 *num,
+         opus_val16 *y,
+         int N,
+         int ord,
+         int arch)
+{
+   int i,j;
+   VARDECL(opus_val16, rnum);
+   SAVE_STACK;
+
+   (void)arch;
+   celt_assert(x != y);
+   ALLOC(rnum, ord, opus_val16);
+   for(i=0;i<ord;i++)
+      rnum[i] = num[ord-i-1];
+   /* Eight outputs at a time, one broadcast tap per FMA. */
+   for (i=0;i<N-7;i+=8)
+   {
+      __m256 sum;
+      sum = _mm256_loadu_ps(x+i);
+      for (j=0;j<ord;j++)
+         sum = _mm256_fmadd_ps(_mm256_set1_ps(rnum[j]), _mm256_loadu_ps(x+i+j-ord), sum);
+      _mm256_storeu_ps(y+i, sum);
+   }
+   for (;i<N;i++)
+   {
+      opus_val32 sum = x[i];
+      for (j=0;j<ord;j++)
+         sum = MAC16_16(sum, rnum[j], x[i+j-ord]);
+      y[i] = sum;
+   }
+   RESTORE_STACK;
+}
+
+#endif
+
+#if !defined(SMALL_FOOTPRINT)
+/* Same block formulation as celt_iir_c(), with blocks of eight outputs. The
+   part of each output that only depends on earlier blocks is computed as an
+   FIR over all eight lanes, using several accumulators so that the taps on
+   the most recent outputs are not one long dependency chain. The feedback
+   within the block is then applied one output at a time in fixed-point, to
+   keep the rounding of every output, and in float as a convolution with the
+   first eight samples of the impulse response of the filter. */
+void celt_iir_avx2(const opus_val32 *_x,
+         const opus_val16 *den,
+         opus_val32 *_y,
+         int N,
+         int ord,
+         opus_val16 *mem,
+         int arch)
+{
+   int i,j,k;
+   VARDECL(opus_val16, rden);
+   VARDECL(opus_val16, y);
+#ifdef FIXED_POINT
+   VARDECL(opus_int32, rden2);
+#else
+   float h[8];
+   __m256 vecH[8];
+   __m256i vecPerm[8];
+#endif
+   SAVE_STACK;
+
+   (void)arch;
+   celt_assert((ord&3)==0);
+   ALLOC(rden, ord, opus_val16);
+   ALLOC(y, N+ord, opus_val16);
+   for(i=0;i<ord;i++)
+      rden[i] = den[ord-i-1];
+#ifdef FIXED_POINT
+   ALLOC(rden2, ord>>1, opus_int32);
+   for(i=0;i<ord;i+=2)
+      rden2[i>>1] = (opus_int32)(((opus_uint32)(opus_uint16)rden[i+1]<<16)|(opus_uint16)rden[i]);
+#else
+   h[0] = 1;
+   for (k=1;k<8;k++)
+   {
+      h[k] = 0;
+      for (j=0;j<k && j<ord;j++)
+         h[k] -= den[j]*h[k-j-1];
+   }
+   /* Lane k of vecH[j] is h[j] if k>=j, so that multiplying it with the sums
+      rotated up by j lanes only keeps the sums from earlier in the block. */
+   for (j=0;j<8;j++)
+   {
+      vecH[j] = _mm256_and_ps(_mm256_set1_ps(h[j]), _mm256_castsi256_ps(
+            _mm256_cmpgt_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+            _mm256_set1_epi32(j-1))));
+      vecPerm[j] = _mm256_and_si256(_mm256_sub_epi32(
+            _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(j)),
+            _mm256_set1_epi32(7));
+   }
+#endif
+   for(i=0;i<ord;i++)
+      y[i] = -mem[ord-i-1];
+   for(;i<N+ord;i++)
+      y[i]=0;
+   for (i=0;i<N-7;i+=8)
+   {
+#ifdef FIXED_POINT
+      opus_val32 sum[8];
+      __m256i vecSum0, vecSum1;
+      vecSum0 = _mm256_loadu_si256((__m256i *)(_x+i));
+      vecSum1 = _mm256_setzero_si256();
+      for (j=0;j<ord;j+=4)
+      {
+         __m128i y0, y1, y2;
+         __m256i vecY;
+         y0 = _mm_loadu_si128((__m128i *)(y+i+j));
+         y1 = _mm_loadu_si128((__m128i *)(y+i+j+1));
+         y2 = _mm_loadu_si128((__m128i *)(y+i+j+2));
+         vecY = _mm256_inserti128_si256(_mm256_castsi128_si256(
+               _mm_unpacklo_epi16(y0, y1)), _mm_unpackhi_epi16(y0, y1), 1);
+         vecSum0 = _mm256_add_epi32(vecSum0,
+               _mm256_madd_epi16(vecY, _mm256_set1_epi32(rden2[j>>1])));
+         y0 = _mm_loadu_si128((__m128i *)(y+i+j+3));
+         vecY = _mm256_inserti128_si256(_mm256_castsi128_si256(
+               _mm_unpacklo_epi16(y2, y0)), _mm_unpackhi_epi16(y2, y0), 1);
+         vecSum1 = _mm256_add_epi32(vecSum1,
+               _mm256_madd_epi16(vecY, _mm256_set1_epi32(rden2[(j>>1)+1])));
+      }
+      _mm256_storeu_si256((__m256i *)sum, _mm256_add_epi32(vecSum0, vecSum1));
+      /* Patch up the result to compensate for the fact that this is an IIR,
+         starting from the oldest output so the newest one is needed last. */
+      for (k=0;k<8;k++)
+      {
+         for (j=k-1;j>=0;j--)
+            sum[k] = MAC16_16(sum[k], y[i+ord+k-j-1], den[j]);
+         y[i+ord+k] = -SROUND16(sum[k],SIG_SHIFT);
+         _y[i+k] = sum[k];
+      }
+#else
+      __m256 vecFir, vecSum0, vecSum1, vecSum2, vecSum3;
+      vecSum0 = _mm256_loadu_ps(_x+i);
+      vecSum1 = _mm256_setzero_ps();
+      vecSum2 = _mm256_setzero_ps();
+      vecSum3 = _mm256_setzero_ps();
+      for (j=0;j<ord;j+=4)
+      {
+         vecSum0 = _mm256_fmadd_ps(_mm256_set1_ps(rden[j]), _mm256_loadu_ps(y+i+j), vecSum0);
+         vecSum1 = _mm256_fmadd_ps(_mm256_set1_ps(rden[j+1]), _mm256_loadu_ps(y+i+j+1), vecSum1);
+         vecSum2 = _mm256_fmadd_ps(_mm256_set1_ps(rden[j+2]), _mm256_loadu_ps(y+i+j+2), vecSum2);
+         vecSum3 = _mm256_fmadd_ps(_mm256_set1_ps(rden[j+3]), _mm256_loadu_ps(y+i+j+3), vecSum3);
+      }
+      vecFir = _mm256_add_ps(_mm256_add_ps(vecSum0, vecSum1), _mm256_add_ps(vecSum2, vecSum3));
+      vecSum1 = _mm256_mul_ps(vecH[1], _mm256_permutevar8x32_ps(vecFir, vecPerm[1]));
+      vecSum2 = _mm256_mul_ps(vecH[2], _mm256_permutevar8x32_ps(vecFir, vecPerm[2]));
+      vecSum3 = _mm256_mul_ps(vecH[3], _mm256_permutevar8x32_ps(vecFir, vecPerm[3]));
+      vecSum0 = _mm256_fmadd_ps(vecH[4], _mm256_permutevar8x32_ps(vecFir, vecPerm[4]), vecFir);
+      vecSum1 = _mm256_fmadd_ps(vecH[5], _mm256_permutevar8x32_ps(vecFir, vecPerm[5]), vecSum1);
+      vecSum2 = _mm256_fmadd_ps(vecH[6], _mm256_permutevar8x32_ps(vecFir, vecPerm[6]), vecSum2);
+      vecSum3 = _mm256_fmadd_ps(vecH[7], _mm256_permutevar8x32_ps(vecFir, vecPerm[7]), vecSum3);
+      vecSum0 = _mm256_add_ps(_mm256_add_ps(vecSum0, vecSum1), _mm256_add_ps(vecSum2, vecSum3));
+      _mm256_storeu_ps(_y+i, vecSum0);
+      _mm256_storeu_ps(y+i+ord, _mm256_sub_ps(_mm256_setzero_ps(), vecSum0));
+#endif
+   }
+   for (;i<N-3;i+=4)
+   {
+      opus_val32 sum[4];
+      for (k=0;k<4;k++)
+      {
+         sum[k] = _x[i+k];
+         for (j=0;j<ord;j++)
+            sum[k] = MAC16_16(sum[k], rden[j], y[i+k+j]);
+      }
+      for (k=0;k<4;k++)
+      {
+         for (j=k-1;j>=0;j--)
+            sum[k] = MAC16_16(sum[k], y[i+ord+k-j-1], den[j]);
+         y[i+ord+k] = -SROUND16(sum[k],SIG_SHIFT);
+         _y[i+k] = sum[k];
+      }
+   }
+   for (;i<N;i++)
+   {
+      opus_val32 sum = _x[i];
+      for (j=0;j<ord;j++)
+         sum -= MULT16_16(rden[j],y[i+j]);
+      y[i+ord] = SROUND16(sum,SIG_SHIFT);
+      _y[i] = sum;
+   }
+   for(i=0;i<ord;i++)
+      mem[i] = _y[N-i-1];
+   RESTORE_STACK;
+}
+#endif
+
+#define AUTOCORR_STEP 16
+
+/* Correlations for lags k0 to k0+3 over x[0] to x[n-1], where n is a multiple
+   of AUTOCORR_STEP and x is preceded by at least k0+3 zeros. */
+static OPUS_INLINE void autocorr_lags_avx2(const opus_val16 *x, opus_val32 *ac,
+      int n, int k0)
+{
+   int i;
+#ifdef FIXED_POINT
+   __m256i acc0, acc1, acc2, acc3;
+   __m128i t0, t1, t2, t3;
+   acc0 = acc1 = acc2 = acc3 = _mm256_setzero_si256();
+   for (i=0;i<n;i+=AUTOCORR_STEP)
+   {
+      __m256i a = _mm256_loadu_si256((__m256i *)(x+i));
+      acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(a, _mm256_loadu_si256((__m256i *)(x+i-k0))));
+      acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(a, _mm256_loadu_si256((__m256i *)(x+i-k0-1))));
+      acc2 = _mm256_add_epi32(acc2, _mm256_madd_epi16(a, _mm256_loadu_si256((__m256i *)(x+i-k0-2))));
+      acc3 = _mm256_add_epi32(acc3, _mm256_madd_epi16(a, _mm256_loadu_si256((__m256i *)(x+i-k0-3))));
+   }
+   t0 = _mm_add_epi32(_mm256_castsi256_si128(acc0), _mm256_extracti128_si256(acc0, 1));
+   t1 = _mm_add_epi32(_mm256_castsi256_si128(acc1), _mm256_extracti128_si256(acc1, 1));
+   t2 = _mm_add_epi32(_mm256_castsi256_si128(acc2), _mm256_extracti128_si256(acc2, 1));
+   t3 = _mm_add_epi32(_mm256_castsi256_si128(acc3), _mm256_extracti128_si256(acc3, 1));
+   /* Leaves the sum for lag k0+k in lane k. */
+   t0 = _mm_hadd_epi32(_mm_hadd_epi32(t0, t1), _mm_hadd_epi32(t2, t3));
+   _mm_storeu_si128((__m128i *)ac, t0);
+#else
+   __m256 acc0, acc1, acc2, acc3, acc4, acc5, acc6, acc7;
+   __m128 t0, t1, t2, t3;
+   acc0 = acc1 = acc2 = acc3 = _mm256_setzero_ps();
+   acc4 = acc5 = acc6 = acc7 = _mm256_setzero_ps();
+   /* Two sets of accumulators, to hide the latency of the FMAs. */
+   for (i=0;i<n;i+=AUTOCORR_STEP)
+   {
+      __m256 a = _mm256_loadu_ps(x+i);
+      __m256 b = _mm256_loadu_ps(x+i+8);
+      acc0 = _mm256_fmadd_ps(a, _mm256_loadu_ps(x+i-k0), acc0);
+      acc1 = _mm256_fmadd_ps(a, _mm256_loadu_ps(x+i-k0-1), acc1);
+      acc2 = _mm256_fmadd_ps(a, _mm256_loadu_ps(x+i-k0-2), acc2);
+      acc3 = _mm256_fmadd_ps(a, _mm256_loadu_ps(x+i-k0-3), acc3);
+      acc4 = _mm256_fmadd_ps(b, _mm256_loadu_ps(x+i+8-k0), acc4);
+      acc5 = _mm256_fmadd_ps(b, _mm256_loadu_ps(x+i+8-k0-1), acc5);
+      acc6 = _mm256_fmadd_ps(b, _mm256_loadu_ps(x+i+8-k0-2), acc6);
+      acc7 = _mm256_fmadd_ps(b, _mm256_loadu_ps(x+i+8-k0-3), acc7);
+   }
+   acc0 = _mm256_add_ps(acc0, acc4);
+   acc1 = _mm256_add_ps(acc1, acc5);
+   acc2 = _mm256_add_ps(acc2, acc6);
+   acc3 = _mm256_add_ps(acc3, acc7);
+   t0 = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+   t1 = _mm_add_ps(_mm256_castps256_ps128(acc1), _mm256_extractf128_ps(acc1, 1));
+   t2 = _mm_add_ps(_mm256_castps256_ps128(acc2), _mm256_extractf128_ps(acc2, 1));
+   t3 = _mm_add_ps(_mm256_castps256_ps128(acc3), _mm256_extractf128_ps(acc3, 1));
+   t0 = _mm_hadd_ps(_mm_hadd_ps(t0, t1), _mm_hadd_ps(t2, t3));
+   _mm_storeu_ps(ac, t0);
+#endif
+}
+
+/* Unlike _celt_autocorr_c(), the correlation is not split into a
+   celt_pitch_xcorr() part and a tail. The windowed (and in fixed-point,
+   scaled) signal is copied between zeros, so that every lag can be computed
+   over the whole padded length, four lags per pass over the signal. */
+int _celt_autocorr_avx2(
+                   const opus_val16 *x,   /*  in: [0...n-1] samples x   */
+                   opus_val32       *ac,  /* out: [0...lag-1] ac values */
+                   const opus_val16       *window,
+                   int          overlap,
+                   int          lag,
+                   int          n,
+                   int          arch
+                  )
+{
+   int i, k, k0;
+   int pad, len;
+   int shift;
+   opus_val16 *xptr;
+   VARDECL(opus_val16, xx);
+   SAVE_STACK;
+   (void)arch;
+   celt_assert(n>0);
+   celt_assert(overlap>=0);
+   pad = (lag+4)&~3;
+   len = (n+AUTOCORR_STEP-1)/AUTOCORR_STEP*AUTOCORR_STEP;
+   ALLOC(xx, pad+len, opus_val16);
+   xptr = xx+pad;
+   OPUS_CLEAR(xx, pad);
+   OPUS_COPY(xptr, x, n);
+   OPUS_CLEAR(xptr+n, len-n);
+   for (i=0;i<overlap;i++)
+   {
+      xptr[i] = MULT16_16_Q15(x[i],window[i]);
+      xptr[n-i-1] = MULT16_16_Q15(x[n-i-1],window[i]);
+   }
+   shift=0;
+#ifdef FIXED_POINT
+   {
+      opus_val32 ac0;
+      __m256i vecAc0;
+      __m128i t;
+      vecAc0 = _mm256_setzero_si256();
+      /* The padding is zero, so it doesn't change the sum. */
+      for (i=0;i<len;i+=8)
+      {
+         __m256i vecX = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i *)(xptr+i)));
+         vecAc0 = _mm256_add_epi32(vecAc0,
+               _mm256_srai_epi32(_mm256_mullo_epi32(vecX, vecX), 9));
+      }
+      t = _mm_add_epi32(_mm256_castsi256_si128(vecAc0), _mm256_extracti128_si256(vecAc0, 1));
+      t = _mm_add_epi32(t, _mm_shuffle_epi32(t, _MM_SHUFFLE(1, 0, 3, 2)));
+      t = _mm_add_epi32(t, _mm_shuffle_epi32(t, _MM_SHUFFLE(2, 3, 0, 1)));
+      ac0 = 1+(n<<7) + _mm_cvtsi128_si32(t);
+
+      shift = celt_ilog2(ac0)-30+10;
+      shift = (shift)/2;
+      if (shift>0)
+      {
+         __m256i vecRound = _mm256_set1_epi32(1<<(shift-1));
+         __m128i vecShift = _mm_cvtsi32_si128(shift);
+         for (i=0;i<len;i+=8)
+         {
+            __m256i vecX = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i *)(xptr+i)));
+            vecX = _mm256_sra_epi32(_mm256_add_epi32(vecX, vecRound), vecShift);
+            _mm_storeu_si128((__m128i *)(xptr+i), _mm_packs_epi32(
+                  _mm256_castsi256_si128(vecX), _mm256_extracti128_si256(vecX, 1)));
+         }
+      } else
+         shift = 0;
+   }
+#endif
+   for (k0=0;k0<=lag;k0+=4)
+   {
+      opus_val32 ack[4];
+      autocorr_lags_avx2(xptr, ack, len, k0);
+      for (k=0;k<4 && k0+k<=lag;k++)
+         ac[k0+k] = ack[k];
+   }
+#ifdef FIXED_POINT
+   shift = 2*shift;
+   if (shift<=0)
+      ac[0] += SHL32((opus_int32)1, -shift);
+   if (ac[0] < 268435456)
+   {
+      int shift2 = 29 - EC_ILOG(ac[0]);
+      for (i=0;i<=lag;i++)
+         ac[i] = SHL32(ac[i], shift2);
+      shift -= shift2;
+   } else if (ac[0] >= 536870912)
+   {
+      int shift2=1;
+      if (ac[0] >= 1073741824)
+         shift2++;
+      for (i=0;i<=lag;i++)
+         ac[i] = SHR32(ac[i], shift2);
+      shift += shift2;
+   }
+#endif
+
+   RESTORE_STACK;
+   return shift;
+}
+
+#endif
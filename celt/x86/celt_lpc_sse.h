@@ -32,9 +32,10 @@
 #include "config.h"
 #endif
 
-#if defined(OPUS_X86_MAY_HAVE_SSE4_1) && defined(FIXED_POINT)
+#if (defined(OPUS_X86_MAY_HAVE_SSE4_1) && defined(FIXED_POINT)) || defined(OPUS_X86_MAY_HAVE_AVX2)
 #define OVERRIDE_CELT_FIR
 
+#if defined(OPUS_X86_MAY_HAVE_SSE4_1) && defined(FIXED_POINT)
 void celt_fir_sse4_1(
          const opus_val16 *x,
          const opus_val16 *num,
@@ -42,8 +43,23 @@ void celt_fir_sse4_1(
          int N,
          int ord,
          int arch);
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+void celt_fir_avx2(
+         const opus_val16 *x,
+         const opus_val16 *num,
+         opus_val16 *y,
+         int N,
+         int ord,
+         int arch);
+#endif
 
-#if defined(OPUS_X86_PRESUME_SSE4_1)
+#if defined(OPUS_X86_PRESUME_AVX2)
+#define celt_fir(x, num, y, N, ord, arch) \
+    ((void)arch, celt_fir_avx2(x, num, y, N, ord, arch))
+
+#elif defined(OPUS_X86_PRESUME_SSE4_1) && defined(FIXED_POINT) && !defined(OPUS_X86_MAY_HAVE_AVX2)
 #define celt_fir(x, num, y, N, ord, arch) \
     ((void)arch, celt_fir_sse4_1(x, num, y, N, ord, arch))
 
@@ -63,4 +79,63 @@ extern void (*const CELT_FIR_IMPL[OPUS_ARCHMASK + 1])(
 #endif
 #endif
 
+#if defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(SMALL_FOOTPRINT)
+#define OVERRIDE_CELT_IIR
+
+void celt_iir_avx2(const opus_val32 *x,
+         const opus_val16 *den,
+         opus_val32 *y,
+         int N,
+         int ord,
+         opus_val16 *mem,
+         int arch);
+
+#if defined(OPUS_X86_PRESUME_AVX2)
+#define celt_iir(x, den, y, N, ord, mem, arch) \
+    ((void)arch, celt_iir_avx2(x, den, y, N, ord, mem, arch))
+
+#else
+
+extern void (*const CELT_IIR_IMPL[OPUS_ARCHMASK + 1])(
+         const opus_val32 *x,
+         const opus_val16 *den,
+         opus_val32 *y,
+         int N,
+         int ord,
+         opus_val16 *mem,
+         int arch);
+
+#  define celt_iir(x, den, y, N, ord, mem, arch) \
+    ((*CELT_IIR_IMPL[(arch) & OPUS_ARCHMASK])(x, den, y, N, ord, mem, arch))
+
+#endif
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+#define OVERRIDE_CELT_AUTOCORR
+
+int _celt_autocorr_avx2(const opus_val16 *x, opus_val32 *ac,
+         const opus_val16 *window, int overlap, int lag, int n, int arch);
+
+#if defined(OPUS_X86_PRESUME_AVX2)
+#define _celt_autocorr(x, ac, window, overlap, lag, n, arch) \
+    ((void)arch, _celt_autocorr_avx2(x, ac, window, overlap, lag, n, arch))
+
+#else
+
+extern int (*const CELT_AUTOCORR_IMPL[OPUS_ARCHMASK + 1])(
+         const opus_val16 *x,
+         opus_val32 *ac,
+         const opus_val16 *window,
+         int overlap,
+         int lag,
+         int n,
+         int arch);
+
+#  define _celt_autocorr(x, ac, window, overlap, lag, n, arch) \
+    ((*CELT_AUTOCORR_IMPL[(arch) & OPUS_ARCHMASK])(x, ac, window, overlap, lag, n, arch))
+
+#endif
+#endif
+
 #endif
@@ -0,0 +1,481 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+#include "celt.h"
+#include "arch.h"
+#include "mathops.h"
+#include "stack_alloc.h"
+#include "x86cpu.h"
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+
+#ifdef FIXED_POINT
+
+/* Loads 8 samples spaced CC apart (CC is 1 or 2), widened to 32 bits. For
+   stereo we only read p[0] to p[14], so the second channel never reads past
+   the end of the interleaved buffer. */
+static OPUS_INLINE __m256i load_pcm8(const opus_val16 *p, int CC)
+{
+   __m128i x;
+   if (CC == 1)
+      x = _mm_loadu_si128((const __m128i*)p);
+   else {
+      __m128i a, b;
+      a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)p),
+            _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1));
+      b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(p+7)),
+            _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, 2, 3, 6, 7, 10, 11, 14, 15));
+      x = _mm_or_si128(a, b);
+   }
+   return _mm256_cvtepi16_epi32(x);
+}
+
+/* Returns { prev[7], v[0], ..., v[6] }. */
+static OPUS_INLINE __m256i shift_in_epi32(__m256i v, __m256i prev)
+{
+   __m256i t, p;
+   t = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6));
+   p = _mm256_permutevar8x32_epi32(prev, _mm256_set1_epi32(7));
+   return _mm256_blend_epi32(t, p, 0x01);
+}
+
+/* SIG2WORD16() on eight samples, packed in order in the low 128 bits. */
+static OPUS_INLINE __m128i sig2word16_avx2(const celt_sig *x)
+{
+   __m256i v;
+   v = _mm256_loadu_si256((const __m256i*)x);
+   v = _mm256_srai_epi32(_mm256_add_epi32(v, _mm256_set1_epi32(1<<(SIG_SHIFT-1))), SIG_SHIFT);
+   v = _mm256_permute4x64_epi64(_mm256_packs_epi32(v, v), _MM_SHUFFLE(3, 1, 2, 0));
+   return _mm256_castsi256_si128(v);
+}
+
+/* The pre-emphasis filter only depends on past inputs, so eight outputs can
+   be computed at once, bit-exact with celt_preemphasis_c(). */
+void celt_preemphasis_avx2(const opus_val16 * OPUS_RESTRICT pcmp,
+      celt_sig * OPUS_RESTRICT inp, int N, int CC, int upsample,
+      const opus_val16 *coef, celt_sig *mem, int clip)
+{
+   int i;
+   opus_val16 coef0;
+   celt_sig m;
+   int Nu;
+   __m256i c8, mprev;
+
+   if (coef[1] != 0 || CC > 2)
+   {
+      celt_preemphasis_c(pcmp, inp, N, CC, upsample, coef, mem, clip);
+      return;
+   }
+   (void)clip;
+   coef0 = coef[0];
+   m = *mem;
+   c8 = _mm256_set1_epi32(coef0);
+   mprev = _mm256_set1_epi32(m);
+
+   /* Fast path for the normal 48kHz case */
+   if (upsample == 1)
+   {
+      for (i=0;i<N-7;i+=8)
+      {
+         __m256i x, mv;
+         x = load_pcm8(&pcmp[CC*i], CC);
+         mv = _mm256_srai_epi32(_mm256_mullo_epi32(c8, x), 15-SIG_SHIFT);
+         _mm256_storeu_si256((__m256i*)&inp[i], _mm256_sub_epi32(
+               _mm256_slli_epi32(x, SIG_SHIFT), shift_in_epi32(mv, mprev)));
+         mprev = mv;
+      }
+      m = _mm256_extract_epi32(mprev, 7);
+      for (;i<N;i++)
+      {
+         opus_val16 x;
+         x = SCALEIN(pcmp[CC*i]);
+         /* Apply pre-emphasis */
+         inp[i] = SHL32(x, SIG_SHIFT) - m;
+         m = SHR32(MULT16_16(coef0, x), 15-SIG_SHIFT);
+      }
+      *mem = m;
+      return;
+   }
+
+   Nu = N/upsample;
+   OPUS_CLEAR(inp, N);
+   for (i=0;i<Nu;i++)
+      inp[i*upsample] = SCALEIN(pcmp[CC*i]);
+   for (i=0;i<N-7;i+=8)
+   {
+      __m256i x, mv;
+      x = _mm256_loadu_si256((const __m256i*)&inp[i]);
+      x = _mm256_srai_epi32(_mm256_slli_epi32(x, 16), 16);
+      mv = _mm256_srai_epi32(_mm256_mullo_epi32(c8, x), 15-SIG_SHIFT);
+      _mm256_storeu_si256((__m256i*)&inp[i], _mm256_sub_epi32(
+            _mm256_slli_epi32(x, SIG_SHIFT), shift_in_epi32(mv, mprev)));
+      mprev = mv;
+   }
+   m = _mm256_extract_epi32(mprev, 7);
+   for (;i<N;i++)
+   {
+      opus_val16 x;
+      x = inp[i];
+      /* Apply pre-emphasis */
+      inp[i] = SHL32(x, SIG_SHIFT) - m;
+      m = SHR32(MULT16_16(coef0, x), 15-SIG_SHIFT);
+   }
+   *mem = m;
+}
+
+/* The de-emphasis recursion truncates at every step, so it can't be split
+   into blocks without changing the output. It stays serial; the saturation,
+   accumulation and channel interleaving are done eight samples at a time. */
+void deemphasis_avx2(celt_sig *in[], opus_val16 *pcm, int N, int C,
+      int downsample, const opus_val16 *coef, celt_sig *mem, int accum)
+{
+   int c, j;
+   int Nd;
+   opus_val16 coef0;
+   VARDECL(celt_sig, scratch);
+   SAVE_STACK;
+
+   if (coef[1] != 0 || C > 2)
+   {
+      deemphasis_c(in, pcm, N, C, downsample, coef, mem, accum);
+      RESTORE_STACK;
+      return;
+   }
+   ALLOC(scratch, C*N, celt_sig);
+   coef0 = coef[0];
+   Nd = N/downsample;
+   c=0; do {
+      const celt_sig * OPUS_RESTRICT x;
+      celt_sig * OPUS_RESTRICT s;
+      celt_sig m = mem[c];
+      x = in[c];
+      s = &scratch[c*N];
+      for (j=0;j<N;j++)
+      {
+         celt_sig tmp = x[j] + VERY_SMALL + m;
+         m = MULT16_32_Q15(coef0, tmp);
+         s[j] = tmp;
+      }
+      mem[c] = m;
+   } while (++c<C);
+
+   j=0;
+   if (downsample == 1)
+   {
+      if (C == 2)
+      {
+         for (;j<N-7;j+=8)
+         {
+            __m128i l, r, y0, y1;
+            l = sig2word16_avx2(&scratch[j]);
+            r = sig2word16_avx2(&scratch[N+j]);
+            y0 = _mm_unpacklo_epi16(l, r);
+            y1 = _mm_unpackhi_epi16(l, r);
+            if (accum)
+            {
+               y0 = _mm_adds_epi16(y0, _mm_loadu_si128((__m128i*)&pcm[2*j]));
+               y1 = _mm_adds_epi16(y1, _mm_loadu_si128((__m128i*)&pcm[2*j+8]));
+            }
+            _mm_storeu_si128((__m128i*)&pcm[2*j], y0);
+            _mm_storeu_si128((__m128i*)&pcm[2*j+8], y1);
+         }
+      } else {
+         for (;j<N-7;j+=8)
+         {
+            __m128i y0;
+            y0 = sig2word16_avx2(&scratch[j]);
+            if (accum)
+               y0 = _mm_adds_epi16(y0, _mm_loadu_si128((__m128i*)&pcm[j]));
+            _mm_storeu_si128((__m128i*)&pcm[j], y0);
+         }
+      }
+   }
+   c=0; do {
+      int k;
+      opus_val16 * OPUS_RESTRICT y = pcm+c;
+      const celt_sig *s = &scratch[c*N];
+      if (accum)
+      {
+         for (k=j;k<Nd;k++)
+            y[k*C] = SAT16(ADD32(y[k*C], SCALEOUT(SIG2WORD16(s[k*downsample]))));
+      } else {
+         for (k=j;k<Nd;k++)
+            y[k*C] = SCALEOUT(SIG2WORD16(s[k*downsample]));
+      }
+   } while (++c<C);
+   RESTORE_STACK;
+}
+
+#else /* FIXED_POINT */
+
+/* Loads 8 samples spaced CC apart (CC is 1 or 2). For stereo we only read
+   p[0] to p[14], so the second channel never reads past the end of the
+   interleaved buffer. */
+static OPUS_INLINE __m256 load_pcm8(const opus_val16 *p, int CC)
+{
+   __m256 a, b;
+   if (CC == 1)
+      return _mm256_loadu_ps(p);
+   a = _mm256_permutevar8x32_ps(_mm256_loadu_ps(p),
+         _mm256_setr_epi32(0, 2, 4, 6, 0, 0, 0, 0));
+   b = _mm256_permutevar8x32_ps(_mm256_loadu_ps(p+7),
+         _mm256_setr_epi32(0, 0, 0, 0, 1, 3, 5, 7));
+   return _mm256_blend_ps(a, b, 0xF0);
+}
+
+/* Returns { prev[7], v[0], ..., v[6] }. */
+static OPUS_INLINE __m256 shift_in_ps(__m256 v, __m256 prev)
+{
+   __m256 t, p;
+   t = _mm256_permutevar8x32_ps(v, _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6));
+   p = _mm256_permutevar8x32_ps(prev, _mm256_set1_epi32(7));
+   return _mm256_blend_ps(t, p, 0x01);
+}
+
+/* The pre-emphasis filter only depends on past inputs, so eight outputs can
+   be computed at once with the same operations as celt_preemphasis_c(). */
+void celt_preemphasis_avx2(const opus_val16 * OPUS_RESTRICT pcmp,
+      celt_sig * OPUS_RESTRICT inp, int N, int CC, int upsample,
+      const opus_val16 *coef, celt_sig *mem, int clip)
+{
+   int i;
+   opus_val16 coef0;
+   celt_sig m;
+   int Nu;
+   __m256 c8, mprev;
+
+   if (coef[1] != 0 || CC > 2)
+   {
+      celt_preemphasis_c(pcmp, inp, N, CC, upsample, coef, mem, clip);
+      return;
+   }
+   coef0 = coef[0];
+   m = *mem;
+   c8 = _mm256_set1_ps(coef0);
+   mprev = _mm256_set1_ps(m);
+
+   /* Fast path for the normal 48kHz case and no clipping */
+   if (upsample == 1 && !clip)
+   {
+      __m256 scale = _mm256_set1_ps(CELT_SIG_SCALE);
+      for (i=0;i<N-7;i+=8)
+      {
+         __m256 x, mv;
+         x = _mm256_mul_ps(load_pcm8(&pcmp[CC*i], CC), scale);
+         mv = _mm256_mul_ps(c8, x);
+         _mm256_storeu_ps(&inp[i], _mm256_sub_ps(x, shift_in_ps(mv, mprev)));
+         mprev = mv;
+      }
+      m = _mm_cvtss_f32(_mm256_extractf128_ps(_mm256_permute_ps(mprev, 0xFF), 1));
+      for (;i<N;i++)
+      {
+         opus_val16 x;
+         x = SCALEIN(pcmp[CC*i]);
+         /* Apply pre-emphasis */
+         inp[i] = SHL32(x, SIG_SHIFT) - m;
+         m = SHR32(MULT16_16(coef0, x), 15-SIG_SHIFT);
+      }
+      *mem = m;
+      return;
+   }
+
+   Nu = N/upsample;
+   if (upsample!=1)
+   {
+      OPUS_CLEAR(inp, N);
+   }
+   for (i=0;i<Nu;i++)
+      inp[i*upsample] = SCALEIN(pcmp[CC*i]);
+   if (clip)
+   {
+      /* Clip input to avoid encoding non-portable files */
+      for (i=0;i<Nu;i++)
+         inp[i*upsample] = MAX32(-65536.f, MIN32(65536.f,inp[i*upsample]));
+   }
+   for (i=0;i<N-7;i+=8)
+   {
+      __m256 x, mv;
+      x = _mm256_loadu_ps(&inp[i]);
+      mv = _mm256_mul_ps(c8, x);
+      _mm256_storeu_ps(&inp[i], _mm256_sub_ps(x, shift_in_ps(mv, mprev)));
+      mprev = mv;
+   }
+   m = _mm_cvtss_f32(_mm256_extractf128_ps(_mm256_permute_ps(mprev, 0xFF), 1));
+   for (;i<N;i++)
+   {
+      opus_val16 x;
+      x = inp[i];
+      /* Apply pre-emphasis */
+      inp[i] = SHL32(x, SIG_SHIFT) - m;
+      m = SHR32(MULT16_16(coef0, x), 15-SIG_SHIFT);
+   }
+   *mem = m;
+}
+
+typedef struct {
+   __m256 c1, c2, c4;
+   __m256 pow;
+} deemph_coefs;
+
+static void deemph_coefs_init(deemph_coefs *k, opus_val16 coef0)
+{
+   int i;
+   float p[8];
+   p[0] = 1;
+   for (i=1;i<8;i++)
+      p[i] = p[i-1]*coef0;
+   k->c1 = _mm256_set1_ps(p[1]);
+   k->c2 = _mm256_set1_ps(p[2]);
+   k->c4 = _mm256_set1_ps(p[4]);
+   k->pow = _mm256_loadu_ps(p);
+}
+
+/* Runs the recursion tmp[j] = x[j] + VERY_SMALL + coef0*tmp[j-1] over eight
+   samples as a log-step prefix scan, then adds the contribution of the
+   incoming state *m (coef0*tmp[-1], broadcast) and updates it. */
+static OPUS_INLINE __m256 deemph_block(const deemph_coefs *k, __m256 x, __m256 *m)
+{
+   __m256 y, t;
+   y = _mm256_add_ps(x, _mm256_set1_ps(VERY_SMALL));
+   t = _mm256_permutevar8x32_ps(y, _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6));
+   y = _mm256_fmadd_ps(k->c1, _mm256_blend_ps(t, _mm256_setzero_ps(), 0x01), y);
+   t = _mm256_permutevar8x32_ps(y, _mm256_setr_epi32(0, 0, 0, 1, 2, 3, 4, 5));
+   y = _mm256_fmadd_ps(k->c2, _mm256_blend_ps(t, _mm256_setzero_ps(), 0x03), y);
+   t = _mm256_permute2f128_ps(y, y, 0x08);
+   y = _mm256_fmadd_ps(k->c4, t, y);
+   y = _mm256_fmadd_ps(k->pow, *m, y);
+   *m = _mm256_mul_ps(k->c1, _mm256_permutevar8x32_ps(y, _mm256_set1_epi32(7)));
+   return y;
+}
+
+void deemphasis_avx2(celt_sig *in[], opus_val16 *pcm, int N, int C,
+      int downsample, const opus_val16 *coef, celt_sig *mem, int accum)
+{
+   int c, j;
+   int Nd;
+   opus_val16 coef0;
+   deemph_coefs k;
+   __m256 scale;
+   VARDECL(celt_sig, scratch);
+   SAVE_STACK;
+
+   if (coef[1] != 0 || C > 2)
+   {
+      deemphasis_c(in, pcm, N, C, downsample, coef, mem, accum);
+      RESTORE_STACK;
+      return;
+   }
+   (void)accum;
+   celt_assert(accum==0);
+   coef0 = coef[0];
+   deemph_coefs_init(&k, coef0);
+   scale = _mm256_set1_ps(1/CELT_SIG_SCALE);
+   Nd = N/downsample;
+
+   if (downsample == 1 && C == 2)
+   {
+      const celt_sig * OPUS_RESTRICT x0 = in[0];
+      const celt_sig * OPUS_RESTRICT x1 = in[1];
+      __m256 m0, m1;
+      celt_sig s0, s1;
+      m0 = _mm256_set1_ps(mem[0]);
+      m1 = _mm256_set1_ps(mem[1]);
+      for (j=0;j<N-7;j+=8)
+      {
+         __m256 t0, t1, lo, hi;
+         t0 = _mm256_mul_ps(deemph_block(&k, _mm256_loadu_ps(&x0[j]), &m0), scale);
+         t1 = _mm256_mul_ps(deemph_block(&k, _mm256_loadu_ps(&x1[j]), &m1), scale);
+         lo = _mm256_unpacklo_ps(t0, t1);
+         hi = _mm256_unpackhi_ps(t0, t1);
+         _mm256_storeu_ps(&pcm[2*j], _mm256_permute2f128_ps(lo, hi, 0x20));
+         _mm256_storeu_ps(&pcm[2*j+8], _mm256_permute2f128_ps(lo, hi, 0x31));
+      }
+      s0 = _mm256_cvtss_f32(m0);
+      s1 = _mm256_cvtss_f32(m1);
+      for (;j<N;j++)
+      {
+         celt_sig tmp0, tmp1;
+         tmp0 = x0[j] + VERY_SMALL + s0;
+         tmp1 = x1[j] + VERY_SMALL + s1;
+         s0 = MULT16_32_Q15(coef0, tmp0);
+         s1 = MULT16_32_Q15(coef0, tmp1);
+         pcm[2*j  ] = SCALEOUT(SIG2WORD16(tmp0));
+         pcm[2*j+1] = SCALEOUT(SIG2WORD16(tmp1));
+      }
+      mem[0] = s0;
+      mem[1] = s1;
+      RESTORE_STACK;
+      return;
+   }
+
+   ALLOC(scratch, N, celt_sig);
+   c=0; do {
+      const celt_sig * OPUS_RESTRICT x;
+      opus_val16 * OPUS_RESTRICT y;
+      __m256 m8;
+      celt_sig m;
+      x = in[c];
+      y = pcm+c;
+      m8 = _mm256_set1_ps(mem[c]);
+      if (downsample == 1)
+      {
+         /* Mono: write the output directly. */
+         for (j=0;j<N-7;j+=8)
+            _mm256_storeu_ps(&y[j], _mm256_mul_ps(deemph_block(&k, _mm256_loadu_ps(&x[j]), &m8), scale));
+         m = _mm256_cvtss_f32(m8);
+         for (;j<N;j++)
+         {
+            celt_sig tmp = x[j] + VERY_SMALL + m;
+            m = MULT16_32_Q15(coef0, tmp);
+            y[j] = SCALEOUT(SIG2WORD16(tmp));
+         }
+      } else {
+         for (j=0;j<N-7;j+=8)
+            _mm256_storeu_ps(&scratch[j], deemph_block(&k, _mm256_loadu_ps(&x[j]), &m8));
+         m = _mm256_cvtss_f32(m8);
+         for (;j<N;j++)
+         {
+            celt_sig tmp = x[j] + VERY_SMALL + m;
+            m = MULT16_32_Q15(coef0, tmp);
+            scratch[j] = tmp;
+         }
+         /* Perform down-sampling */
+         for (j=0;j<Nd;j++)
+            y[j*C] = SCALEOUT(SIG2WORD16(scratch[j*downsample]));
+      }
+      mem[c] = m;
+   } while (++c<C);
+   RESTORE_STACK;
+}
+
+#endif /* FIXED_POINT */
+
+#endif
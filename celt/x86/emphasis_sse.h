@@ -0,0 +1,68 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef EMPHASIS_SSE_H
+#define EMPHASIS_SSE_H
+
+#include "cpu_support.h"
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+#define OVERRIDE_CELT_PREEMPHASIS
+#define OVERRIDE_DEEMPHASIS
+
+void celt_preemphasis_avx2(const opus_val16 * OPUS_RESTRICT pcmp,
+      celt_sig * OPUS_RESTRICT inp, int N, int CC, int upsample,
+      const opus_val16 *coef, celt_sig *mem, int clip);
+
+void deemphasis_avx2(celt_sig *in[], opus_val16 *pcm, int N, int C,
+      int downsample, const opus_val16 *coef, celt_sig *mem, int accum);
+
+#if defined(OPUS_X86_PRESUME_AVX2)
+
+#define celt_preemphasis(pcmp, inp, N, CC, upsample, coef, mem, clip, arch) \
+    ((void)(arch), celt_preemphasis_avx2(pcmp, inp, N, CC, upsample, coef, mem, clip))
+#define deemphasis(in, pcm, N, C, downsample, coef, mem, accum, arch) \
+    ((void)(arch), deemphasis_avx2(in, pcm, N, C, downsample, coef, mem, accum))
+
+#else
+
+extern void (*const CELT_PREEMPHASIS_IMPL[OPUS_ARCHMASK + 1])(
+      const opus_val16 * OPUS_RESTRICT pcmp, celt_sig * OPUS_RESTRICT inp,
+      int N, int CC, int upsample, const opus_val16 *coef, celt_sig *mem,
+      int clip);
+#define celt_preemphasis(pcmp, inp, N, CC, upsample, coef, mem, clip, arch) \
+    ((*CELT_PREEMPHASIS_IMPL[(arch) & OPUS_ARCHMASK])(pcmp, inp, N, CC, upsample, coef, mem, clip))
+
+extern void (*const DEEMPHASIS_IMPL[OPUS_ARCHMASK + 1])(celt_sig *in[],
+      opus_val16 *pcm, int N, int C, int downsample, const opus_val16 *coef,
+      celt_sig *mem, int accum);
+#define deemphasis(in, pcm, N, C, downsample, coef, mem, accum, arch) \
+    ((*DEEMPHASIS_IMPL[(arch) & OPUS_ARCHMASK])(in, pcm, N, C, downsample, coef, mem, accum))
+
+#endif
+#endif
+
+#endif
@@ -0,0 +1,498 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+
+#include "_kiss_fft_guts.h"
+#include "arch.h"
+#include "os_support.h"
+#include "x86cpu.h"
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+
+/* Each vector holds four consecutive kiss_fft_cpx values, interleaved as
+   r0 i0 r1 i1 r2 i2 r3 i3.  The butterflies below are vectorised along the
+   j (or u) index, so a single gather of four strided twiddles is shared by
+   all N sub-transforms of a stage.  In fixed point every multiply goes
+   through mulq15_avx2(), which reproduces S_MUL() exactly, and all the
+   additions wrap like the *_ovflw() macros, so the result is bit-exact with
+   opus_fft_impl(). */
+
+#ifdef FIXED_POINT
+
+typedef __m256i fft_vec;
+
+#define CPX_LOAD(p) _mm256_loadu_si256((const __m256i *)(p))
+#define CPX_STORE(p, v) _mm256_storeu_si256((__m256i *)(p), v)
+#define CPX_ADD(a, b) _mm256_add_epi32(a, b)
+#define CPX_SUB(a, b) _mm256_sub_epi32(a, b)
+#define CPX_HALF(a) _mm256_srai_epi32(a, 1)
+#define CPX_PERM128(a, b, imm) _mm256_permute2x128_si256(a, b, imm)
+#define CPX_UNPACKLO(a, b) _mm256_unpacklo_epi64(a, b)
+#define CPX_UNPACKHI(a, b) _mm256_unpackhi_epi64(a, b)
+/* Keeps the first complex value of each 128-bit lane from a, the second from b. */
+#define CPX_BLEND_HI(a, b) _mm256_blend_epi32(a, b, 0xCC)
+
+/* Lane-wise MULT16_32_Q15(c, x) where c holds sign-extended Q15 values. */
+static OPUS_INLINE __m256i mulq15_avx2(__m256i x, __m256i c)
+{
+   __m256i even, odd;
+   even = _mm256_mul_epi32(x, c);
+   odd = _mm256_mul_epi32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(c, 32));
+   even = _mm256_srli_epi64(even, 15);
+   odd = _mm256_slli_epi64(odd, 17);
+   return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+/* Lane-wise MULT16_32_Q16(c, x). */
+static OPUS_INLINE __m256i mulq16_avx2(__m256i x, __m256i c)
+{
+   __m256i even, odd;
+   even = _mm256_mul_epi32(x, c);
+   odd = _mm256_mul_epi32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(c, 32));
+   even = _mm256_srli_epi64(even, 16);
+   odd = _mm256_slli_epi64(odd, 16);
+   return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+#define CPX_MULC(a, c) mulq15_avx2(a, _mm256_set1_epi32(c))
+
+/* Multiplies by -i: (r, i) -> (i, -r). */
+static OPUS_INLINE __m256i cpx_mul_neg_i(__m256i a)
+{
+   return _mm256_sign_epi32(_mm256_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1)),
+         _mm256_setr_epi32(1, -1, 1, -1, 1, -1, 1, -1));
+}
+
+static OPUS_INLINE __m256i cpx_conj(__m256i a)
+{
+   return _mm256_sign_epi32(a, _mm256_setr_epi32(1, -1, 1, -1, 1, -1, 1, -1));
+}
+
+/* C_MUL() of four values by four twiddles. */
+static OPUS_INLINE __m256i cpx_mul(__m256i a, __m256i w)
+{
+   __m256i p1, p2;
+   p1 = mulq15_avx2(a, _mm256_shuffle_epi32(w, _MM_SHUFFLE(2, 2, 0, 0)));
+   p2 = mulq15_avx2(_mm256_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1)),
+         _mm256_shuffle_epi32(w, _MM_SHUFFLE(3, 3, 1, 1)));
+   return _mm256_add_epi32(p1, _mm256_sign_epi32(p2,
+         _mm256_setr_epi32(-1, 1, -1, 1, -1, 1, -1, 1)));
+}
+
+static OPUS_INLINE __m256i load_twiddles4(const kiss_twiddle_cpx *tw, int stride)
+{
+   return _mm256_cvtepi16_epi32(_mm_setr_epi16(
+         tw[0].r, tw[0].i, tw[stride].r, tw[stride].i,
+         tw[2*stride].r, tw[2*stride].i, tw[3*stride].r, tw[3*stride].i));
+}
+
+/* Rotations of the radix-2 stage (m==4): F2[k]*exp(-i*pi*k/4). */
+static OPUS_INLINE __m256i bfly2_rotate(__m256i x)
+{
+   __m256i s, t;
+   s = _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+   t = _mm256_add_epi32(
+         _mm256_sign_epi32(x, _mm256_setr_epi32(1, 1, 1, 1, 0, 0, -1, -1)),
+         _mm256_sign_epi32(s, _mm256_setr_epi32(0, 0, 1, -1, 1, -1, 1, -1)));
+   return _mm256_blend_epi32(t,
+         mulq15_avx2(t, _mm256_set1_epi32(QCONST16(0.7071067812f, 15))), 0xCC);
+}
+
+static OPUS_INLINE void store_scatter4(kiss_fft_cpx *fout,
+      const opus_int16 *bitrev, __m256i v)
+{
+   __m128i lo, hi;
+   lo = _mm256_castsi256_si128(v);
+   hi = _mm256_extracti128_si256(v, 1);
+   _mm_storel_epi64((__m128i *)&fout[bitrev[0]], lo);
+   _mm_storel_epi64((__m128i *)&fout[bitrev[1]], _mm_unpackhi_epi64(lo, lo));
+   _mm_storel_epi64((__m128i *)&fout[bitrev[2]], hi);
+   _mm_storel_epi64((__m128i *)&fout[bitrev[3]], _mm_unpackhi_epi64(hi, hi));
+}
+
+#else
+
+typedef __m256 fft_vec;
+
+#define CPX_LOAD(p) _mm256_loadu_ps((const float *)(p))
+#define CPX_STORE(p, v) _mm256_storeu_ps((float *)(p), v)
+#define CPX_ADD(a, b) _mm256_add_ps(a, b)
+#define CPX_SUB(a, b) _mm256_sub_ps(a, b)
+#define CPX_HALF(a) _mm256_mul_ps(a, _mm256_set1_ps(.5f))
+#define CPX_PERM128(a, b, imm) _mm256_permute2f128_ps(a, b, imm)
+#define CPX_UNPACKLO(a, b) _mm256_castpd_ps(_mm256_unpacklo_pd( \
+      _mm256_castps_pd(a), _mm256_castps_pd(b)))
+#define CPX_UNPACKHI(a, b) _mm256_castpd_ps(_mm256_unpackhi_pd( \
+      _mm256_castps_pd(a), _mm256_castps_pd(b)))
+#define CPX_BLEND_HI(a, b) _mm256_blend_ps(a, b, 0xCC)
+#define CPX_MULC(a, c) _mm256_mul_ps(a, _mm256_set1_ps(c))
+
+static OPUS_INLINE __m256 cpx_mul_neg_i(__m256 a)
+{
+   return _mm256_xor_ps(_mm256_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1)),
+         _mm256_setr_ps(0.f, -0.f, 0.f, -0.f, 0.f, -0.f, 0.f, -0.f));
+}
+
+static OPUS_INLINE __m256 cpx_conj(__m256 a)
+{
+   return _mm256_xor_ps(a,
+         _mm256_setr_ps(0.f, -0.f, 0.f, -0.f, 0.f, -0.f, 0.f, -0.f));
+}
+
+static OPUS_INLINE __m256 cpx_mul(__m256 a, __m256 w)
+{
+   return _mm256_fmaddsub_ps(a, _mm256_moveldup_ps(w),
+         _mm256_mul_ps(_mm256_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1)),
+               _mm256_movehdup_ps(w)));
+}
+
+static OPUS_INLINE __m256 load_twiddles4(const kiss_twiddle_cpx *tw, int stride)
+{
+   return _mm256_setr_ps(tw[0].r, tw[0].i, tw[stride].r, tw[stride].i,
+         tw[2*stride].r, tw[2*stride].i, tw[3*stride].r, tw[3*stride].i);
+}
+
+static OPUS_INLINE __m256 bfly2_rotate(__m256 x)
+{
+   const float tw = 0.7071067812f;
+   return cpx_mul(x, _mm256_setr_ps(1.f, 0.f, tw, -tw, 0.f, -1.f, -tw, -tw));
+}
+
+static OPUS_INLINE void store_scatter4(kiss_fft_cpx *fout,
+      const opus_int16 *bitrev, __m256 v)
+{
+   __m128 lo, hi;
+   lo = _mm256_castps256_ps128(v);
+   hi = _mm256_extractf128_ps(v, 1);
+   _mm_storel_pi((__m64 *)&fout[bitrev[0]], lo);
+   _mm_storeh_pi((__m64 *)&fout[bitrev[1]], lo);
+   _mm_storel_pi((__m64 *)&fout[bitrev[2]], hi);
+   _mm_storeh_pi((__m64 *)&fout[bitrev[3]], hi);
+}
+
+#endif
+
+static void kf_bfly2_avx2(kiss_fft_cpx *Fout, int N)
+{
+   int i;
+   for (i=0;i<N;i++)
+   {
+      fft_vec a, t;
+      a = CPX_LOAD(Fout);
+      t = bfly2_rotate(CPX_LOAD(Fout + 4));
+      CPX_STORE(Fout + 4, CPX_SUB(a, t));
+      CPX_STORE(Fout, CPX_ADD(a, t));
+      Fout += 8;
+   }
+}
+
+static void kf_bfly4_m1_avx2(kiss_fft_cpx *Fout, int N)
+{
+   int i;
+   /* Two radix-4 butterflies per iteration, one per 128-bit lane. */
+   for (i=0;i<N-1;i+=2)
+   {
+      fft_vec v0, v1, lo, hi, a, b, u, w, sum, dif;
+      v0 = CPX_LOAD(Fout);
+      v1 = CPX_LOAD(Fout + 4);
+      lo = CPX_PERM128(v0, v1, 0x20);
+      hi = CPX_PERM128(v0, v1, 0x31);
+      a = CPX_ADD(lo, hi);
+      b = CPX_SUB(lo, hi);
+      u = CPX_UNPACKLO(a, b);
+      w = CPX_UNPACKHI(a, b);
+      w = CPX_BLEND_HI(w, cpx_mul_neg_i(w));
+      sum = CPX_ADD(u, w);
+      dif = CPX_SUB(u, w);
+      CPX_STORE(Fout, CPX_PERM128(sum, dif, 0x20));
+      CPX_STORE(Fout + 4, CPX_PERM128(sum, dif, 0x31));
+      Fout += 8;
+   }
+   if (i<N)
+   {
+      kiss_fft_cpx scratch0, scratch1;
+
+      C_SUB( scratch0 , *Fout, Fout[2] );
+      C_ADDTO(*Fout, Fout[2]);
+      C_ADD( scratch1 , Fout[1] , Fout[3] );
+      C_SUB( Fout[2], *Fout, scratch1 );
+      C_ADDTO( *Fout , scratch1 );
+      C_SUB( scratch1 , Fout[1] , Fout[3] );
+
+      Fout[1].r = ADD32_ovflw(scratch0.r, scratch1.i);
+      Fout[1].i = SUB32_ovflw(scratch0.i, scratch1.r);
+      Fout[3].r = SUB32_ovflw(scratch0.r, scratch1.i);
+      Fout[3].i = ADD32_ovflw(scratch0.i, scratch1.r);
+   }
+}
+
+static void kf_bfly4_avx2(kiss_fft_cpx *Fout, const size_t fstride,
+      const kiss_fft_state *st, int m, int N, int mm)
+{
+   int i, j;
+   const int m2=2*m;
+   const int m3=3*m;
+   for (j=0;j<m;j+=4)
+   {
+      fft_vec tw1, tw2, tw3;
+      kiss_fft_cpx *F = Fout + j;
+      tw1 = load_twiddles4(st->twiddles + j*fstride, fstride);
+      tw2 = load_twiddles4(st->twiddles + 2*j*fstride, 2*fstride);
+      tw3 = load_twiddles4(st->twiddles + 3*j*fstride, 3*fstride);
+      for (i=0;i<N;i++)
+      {
+         fft_vec f0, s0, s1, s2, s3, s4, s5;
+         f0 = CPX_LOAD(F);
+         s0 = cpx_mul(CPX_LOAD(F + m), tw1);
+         s1 = cpx_mul(CPX_LOAD(F + m2), tw2);
+         s2 = cpx_mul(CPX_LOAD(F + m3), tw3);
+         s5 = CPX_SUB(f0, s1);
+         f0 = CPX_ADD(f0, s1);
+         s3 = CPX_ADD(s0, s2);
+         s4 = cpx_mul_neg_i(CPX_SUB(s0, s2));
+         CPX_STORE(F, CPX_ADD(f0, s3));
+         CPX_STORE(F + m, CPX_ADD(s5, s4));
+         CPX_STORE(F + m2, CPX_SUB(f0, s3));
+         CPX_STORE(F + m3, CPX_SUB(s5, s4));
+         F += mm;
+      }
+   }
+}
+
+static void kf_bfly3_avx2(kiss_fft_cpx *Fout, const size_t fstride,
+      const kiss_fft_state *st, int m, int N, int mm)
+{
+   int i, j;
+   const int m2 = 2*m;
+   kiss_twiddle_scalar epi3i;
+#ifdef FIXED_POINT
+   epi3i = -28378;
+#else
+   epi3i = st->twiddles[fstride*m].i;
+#endif
+   for (j=0;j<m;j+=4)
+   {
+      fft_vec tw1, tw2;
+      kiss_fft_cpx *F = Fout + j;
+      tw1 = load_twiddles4(st->twiddles + j*fstride, fstride);
+      tw2 = load_twiddles4(st->twiddles + 2*j*fstride, 2*fstride);
+      for (i=0;i<N;i++)
+      {
+         fft_vec f0, fm, s0, s1, s2, s3;
+         f0 = CPX_LOAD(F);
+         s1 = cpx_mul(CPX_LOAD(F + m), tw1);
+         s2 = cpx_mul(CPX_LOAD(F + m2), tw2);
+         s3 = CPX_ADD(s1, s2);
+         s0 = CPX_SUB(s1, s2);
+         fm = CPX_SUB(f0, CPX_HALF(s3));
+         s0 = cpx_mul_neg_i(CPX_MULC(s0, epi3i));
+         CPX_STORE(F, CPX_ADD(f0, s3));
+         CPX_STORE(F + m2, CPX_ADD(fm, s0));
+         CPX_STORE(F + m, CPX_SUB(fm, s0));
+         F += mm;
+      }
+   }
+}
+
+static void kf_bfly5_avx2(kiss_fft_cpx *Fout, const size_t fstride,
+      const kiss_fft_state *st, int m, int N, int mm)
+{
+   int i, u;
+   kiss_twiddle_cpx ya, yb;
+#ifdef FIXED_POINT
+   ya.r = 10126;
+   ya.i = -31164;
+   yb.r = -26510;
+   yb.i = -19261;
+#else
+   ya = st->twiddles[fstride*m];
+   yb = st->twiddles[fstride*2*m];
+#endif
+   for (u=0;u<m;u+=4)
+   {
+      fft_vec tw1, tw2, tw3, tw4;
+      kiss_fft_cpx *F = Fout + u;
+      tw1 = load_twiddles4(st->twiddles + u*fstride, fstride);
+      tw2 = load_twiddles4(st->twiddles + 2*u*fstride, 2*fstride);
+      tw3 = load_twiddles4(st->twiddles + 3*u*fstride, 3*fstride);
+      tw4 = load_twiddles4(st->twiddles + 4*u*fstride, 4*fstride);
+      for (i=0;i<N;i++)
+      {
+         fft_vec s0, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12;
+         s0 = CPX_LOAD(F);
+         s1 = cpx_mul(CPX_LOAD(F + m), tw1);
+         s2 = cpx_mul(CPX_LOAD(F + 2*m), tw2);
+         s3 = cpx_mul(CPX_LOAD(F + 3*m), tw3);
+         s4 = cpx_mul(CPX_LOAD(F + 4*m), tw4);
+
+         s7 = CPX_ADD(s1, s4);
+         s10 = CPX_SUB(s1, s4);
+         s8 = CPX_ADD(s2, s3);
+         s9 = CPX_SUB(s2, s3);
+
+         CPX_STORE(F, CPX_ADD(s0, CPX_ADD(s7, s8)));
+
+         s5 = CPX_ADD(s0, CPX_ADD(CPX_MULC(s7, ya.r), CPX_MULC(s8, yb.r)));
+         s6 = cpx_mul_neg_i(CPX_ADD(CPX_MULC(s10, ya.i), CPX_MULC(s9, yb.i)));
+         CPX_STORE(F + m, CPX_SUB(s5, s6));
+         CPX_STORE(F + 4*m, CPX_ADD(s5, s6));
+
+         s11 = CPX_ADD(s0, CPX_ADD(CPX_MULC(s7, yb.r), CPX_MULC(s8, ya.r)));
+         s12 = cpx_mul_neg_i(CPX_SUB(CPX_MULC(s9, ya.i), CPX_MULC(s10, yb.i)));
+         CPX_STORE(F + 2*m, CPX_ADD(s11, s12));
+         CPX_STORE(F + 3*m, CPX_SUB(s11, s12));
+         F += mm;
+      }
+   }
+}
+
+void opus_fft_impl_avx2(const kiss_fft_state *st, kiss_fft_cpx *fout)
+{
+   int m2, m;
+   int p;
+   int L;
+   int fstride[MAXFACTORS];
+   int i;
+   int shift;
+
+   /* st->shift can be -1 */
+   shift = st->shift>0 ? st->shift : 0;
+
+   fstride[0] = 1;
+   L=0;
+   do {
+      p = st->factors[2*L];
+      m = st->factors[2*L+1];
+      /* Only the factorizations used by the standard modes (and custom
+         sizes sharing their structure) are vectorised: a radix-4 last
+         stage, a radix-2 stage after a radix-4 one, and multiples of four
+         for everything else. */
+      if (m == 1 ? p != 4 : (m&3) || (p == 2 && m != 4))
+      {
+         opus_fft_impl(st, fout);
+         return;
+      }
+      fstride[L+1] = fstride[L]*p;
+      L++;
+   } while(m!=1);
+   m = st->factors[2*L-1];
+   for (i=L-1;i>=0;i--)
+   {
+      if (i!=0)
+         m2 = st->factors[2*i-1];
+      else
+         m2 = 1;
+      switch (st->factors[2*i])
+      {
+      case 2:
+         kf_bfly2_avx2(fout, fstride[i]);
+         break;
+      case 4:
+         if (m==1)
+            kf_bfly4_m1_avx2(fout, fstride[i]);
+         else
+            kf_bfly4_avx2(fout,fstride[i]<<shift,st,m, fstride[i], m2);
+         break;
+      case 3:
+         kf_bfly3_avx2(fout,fstride[i]<<shift,st,m, fstride[i], m2);
+         break;
+      case 5:
+         kf_bfly5_avx2(fout,fstride[i]<<shift,st,m, fstride[i], m2);
+         break;
+      }
+      m = m2;
+   }
+}
+
+void opus_fft_avx2(const kiss_fft_state *st, const kiss_fft_cpx *fin,
+      kiss_fft_cpx *fout)
+{
+   int i;
+   opus_val16 scale;
+#ifdef FIXED_POINT
+   /* Allows us to scale with MULT16_32_Q16(), which is faster than
+      MULT16_32_Q15() on ARM. */
+   int scale_shift = st->scale_shift-1;
+   __m256i scale_v;
+   __m128i shift_v;
+#else
+   __m256 scale_v;
+#endif
+   scale = st->scale;
+
+   celt_assert2 (fin != fout, "In-place FFT not supported");
+#ifdef FIXED_POINT
+   scale_v = _mm256_set1_epi32(scale);
+   shift_v = _mm_cvtsi32_si128(scale_shift);
+#else
+   scale_v = _mm256_set1_ps(scale);
+#endif
+   /* Bit-reverse the input */
+   for (i=0;i<st->nfft-3;i+=4)
+   {
+#ifdef FIXED_POINT
+      __m256i x = _mm256_sra_epi32(mulq16_avx2(CPX_LOAD(fin + i), scale_v),
+            shift_v);
+#else
+      __m256 x = _mm256_mul_ps(CPX_LOAD(fin + i), scale_v);
+#endif
+      store_scatter4(fout, st->bitrev + i, x);
+   }
+   for (;i<st->nfft;i++)
+   {
+      kiss_fft_cpx x = fin[i];
+      fout[st->bitrev[i]].r = SHR32(MULT16_32_Q16(scale, x.r), scale_shift);
+      fout[st->bitrev[i]].i = SHR32(MULT16_32_Q16(scale, x.i), scale_shift);
+   }
+   opus_fft_impl_avx2(st, fout);
+}
+
+void opus_ifft_avx2(const kiss_fft_state *st, const kiss_fft_cpx *fin,
+      kiss_fft_cpx *fout)
+{
+   int i;
+   celt_assert2 (fin != fout, "In-place FFT not supported");
+   /* Bit-reverse and conjugate the input */
+   for (i=0;i<st->nfft-3;i+=4)
+      store_scatter4(fout, st->bitrev + i, cpx_conj(CPX_LOAD(fin + i)));
+   for (;i<st->nfft;i++)
+   {
+      fout[st->bitrev[i]].r = fin[i].r;
+      fout[st->bitrev[i]].i = -fin[i].i;
+   }
+   opus_fft_impl_avx2(st, fout);
+   for (i=0;i<st->nfft-3;i+=4)
+      CPX_STORE(fout + i, cpx_conj(CPX_LOAD(fout + i)));
+   for (;i<st->nfft;i++)
+      fout[i].i = -fout[i].i;
+}
+
+#endif
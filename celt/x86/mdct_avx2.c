@@ -0,0 +1,532 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+
+#include "mdct.h"
+#include "kiss_fft.h"
+#include "_kiss_fft_guts.h"
+#include "os_support.h"
+#include "mathops.h"
+#include "stack_alloc.h"
+#include "x86cpu.h"
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+
+/* The fold/window, rotation and TDAC passes below follow clt_mdct_forward_c()
+   and clt_mdct_backward_c() term by term, eight values at a time, with
+   scalar loops picking up whatever does not fill a vector.  The reversed
+   and strided accesses are done with full loads and a permute, so fixed
+   point stays bit-exact with the C version. */
+
+#ifdef FIXED_POINT
+
+typedef __m256i mdct_vec;
+
+#define VLOAD(p) _mm256_loadu_si256((const __m256i *)(p))
+#define VSTORE(p, v) _mm256_storeu_si256((__m256i *)(p), v)
+#define WLOAD(p) _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(p)))
+#define VADD(a, b) _mm256_add_epi32(a, b)
+#define VSUB(a, b) _mm256_sub_epi32(a, b)
+#define VPERM(v, idx) _mm256_permutevar8x32_epi32(v, idx)
+#define VBLEND_ODD(a, b) _mm256_blend_epi32(a, b, 0xAA)
+#define VNEG_EVEN(v) _mm256_sign_epi32(v, \
+      _mm256_setr_epi32(-1, 1, -1, 1, -1, 1, -1, 1))
+#define VNEG_ODD(v) _mm256_sign_epi32(v, \
+      _mm256_setr_epi32(1, -1, 1, -1, 1, -1, 1, -1))
+
+/* Lane-wise MULT16_32_Q15(w, x) where w holds sign-extended Q15 values. */
+static OPUS_INLINE __m256i mulq15_avx2(__m256i x, __m256i w)
+{
+   __m256i even, odd;
+   even = _mm256_mul_epi32(x, w);
+   odd = _mm256_mul_epi32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(w, 32));
+   return _mm256_blend_epi32(_mm256_srli_epi64(even, 15),
+         _mm256_slli_epi64(odd, 17), 0xAA);
+}
+
+/* Lane-wise MULT16_32_Q16(w, x). */
+static OPUS_INLINE __m256i mulq16_avx2(__m256i x, __m256i w)
+{
+   __m256i even, odd;
+   even = _mm256_mul_epi32(x, w);
+   odd = _mm256_mul_epi32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(w, 32));
+   return _mm256_blend_epi32(_mm256_srli_epi64(even, 16),
+         _mm256_slli_epi64(odd, 16), 0xAA);
+}
+
+#define VMULW(x, w) mulq15_avx2(x, w)
+
+/* Interleaves t0[0..3] and t1[0..3] as four (t0, t1) pairs. */
+static OPUS_INLINE __m256i load_trig4(const kiss_twiddle_scalar *t0,
+      const kiss_twiddle_scalar *t1)
+{
+   return _mm256_cvtepi16_epi32(_mm_unpacklo_epi16(
+         _mm_loadl_epi64((const __m128i *)t0),
+         _mm_loadl_epi64((const __m128i *)t1)));
+}
+
+/* (a.r*t0 - a.i*t1, a.i*t0 + a.r*t1) with S_MUL() rounding. */
+static OPUS_INLINE __m256i cpx_mul(__m256i a, __m256i w)
+{
+   __m256i p1, p2;
+   p1 = mulq15_avx2(a, _mm256_shuffle_epi32(w, _MM_SHUFFLE(2, 2, 0, 0)));
+   p2 = mulq15_avx2(_mm256_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1)),
+         _mm256_shuffle_epi32(w, _MM_SHUFFLE(3, 3, 1, 1)));
+   return _mm256_add_epi32(p1, VNEG_EVEN(p2));
+}
+
+static OPUS_INLINE void store_scatter4(kiss_fft_cpx *fout,
+      const opus_int16 *bitrev, __m256i v)
+{
+   __m128i lo, hi;
+   lo = _mm256_castsi256_si128(v);
+   hi = _mm256_extracti128_si256(v, 1);
+   _mm_storel_epi64((__m128i *)&fout[bitrev[0]], lo);
+   _mm_storel_epi64((__m128i *)&fout[bitrev[1]], _mm_unpackhi_epi64(lo, lo));
+   _mm_storel_epi64((__m128i *)&fout[bitrev[2]], hi);
+   _mm_storel_epi64((__m128i *)&fout[bitrev[3]], _mm_unpackhi_epi64(hi, hi));
+}
+
+#else
+
+typedef __m256 mdct_vec;
+
+#define VLOAD(p) _mm256_loadu_ps(p)
+#define VSTORE(p, v) _mm256_storeu_ps(p, v)
+#define WLOAD(p) _mm256_loadu_ps(p)
+#define VADD(a, b) _mm256_add_ps(a, b)
+#define VSUB(a, b) _mm256_sub_ps(a, b)
+#define VPERM(v, idx) _mm256_permutevar8x32_ps(v, idx)
+#define VBLEND_ODD(a, b) _mm256_blend_ps(a, b, 0xAA)
+#define VNEG_EVEN(v) _mm256_xor_ps(v, \
+      _mm256_setr_ps(-0.f, 0.f, -0.f, 0.f, -0.f, 0.f, -0.f, 0.f))
+#define VNEG_ODD(v) _mm256_xor_ps(v, \
+      _mm256_setr_ps(0.f, -0.f, 0.f, -0.f, 0.f, -0.f, 0.f, -0.f))
+#define VMULW(x, w) _mm256_mul_ps(x, w)
+
+static OPUS_INLINE __m256 load_trig4(const kiss_twiddle_scalar *t0,
+      const kiss_twiddle_scalar *t1)
+{
+   __m128 a, b;
+   a = _mm_loadu_ps(t0);
+   b = _mm_loadu_ps(t1);
+   return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(a, b)),
+         _mm_unpackhi_ps(a, b), 1);
+}
+
+static OPUS_INLINE __m256 cpx_mul(__m256 a, __m256 w)
+{
+   return _mm256_fmaddsub_ps(a, _mm256_moveldup_ps(w),
+         _mm256_mul_ps(_mm256_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1)),
+               _mm256_movehdup_ps(w)));
+}
+
+static OPUS_INLINE void store_scatter4(kiss_fft_cpx *fout,
+      const opus_int16 *bitrev, __m256 v)
+{
+   __m128 lo, hi;
+   lo = _mm256_castps256_ps128(v);
+   hi = _mm256_extractf128_ps(v, 1);
+   _mm_storel_pi((__m64 *)&fout[bitrev[0]], lo);
+   _mm_storeh_pi((__m64 *)&fout[bitrev[1]], lo);
+   _mm_storel_pi((__m64 *)&fout[bitrev[2]], hi);
+   _mm_storeh_pi((__m64 *)&fout[bitrev[3]], hi);
+}
+
+#endif
+
+/* Forward MDCT trashes the input array */
+void clt_mdct_forward_avx2(const mdct_lookup *l, kiss_fft_scalar *in,
+      kiss_fft_scalar * OPUS_RESTRICT out, const opus_val16 *window,
+      int overlap, int shift, int stride, int arch)
+{
+   int i;
+   int N, N2, N4, L1;
+   VARDECL(kiss_fft_scalar, f);
+   VARDECL(kiss_fft_cpx, f2);
+   const kiss_fft_state *st = l->kfft[shift];
+   const kiss_twiddle_scalar *trig;
+   opus_val16 scale;
+   __m256i idx_even, idx_rev;
+#ifdef FIXED_POINT
+   /* Allows us to scale with MULT16_32_Q16(), which is faster than
+      MULT16_32_Q15() on ARM. */
+   int scale_shift = st->scale_shift-1;
+#endif
+   SAVE_STACK;
+   (void)arch;
+   scale = st->scale;
+
+   N = l->n;
+   trig = l->trig;
+   for (i=0;i<shift;i++)
+   {
+      N >>= 1;
+      trig += N;
+   }
+   N2 = N>>1;
+   N4 = N>>2;
+   L1 = (overlap+3)>>2;
+
+   ALLOC(f, N2, kiss_fft_scalar);
+   ALLOC(f2, N4, kiss_fft_cpx);
+
+   /* Spread the even elements of a vector to both lanes of each pair, or
+      the odd ones in reverse order (for the pointers walking backwards). */
+   idx_even = _mm256_setr_epi32(0, 0, 2, 2, 4, 4, 6, 6);
+   idx_rev = _mm256_setr_epi32(7, 7, 5, 5, 3, 3, 1, 1);
+
+   /* Consider the input to be composed of four blocks: [a, b, c, d] */
+   /* Window, shuffle, fold */
+   {
+      /* Temp pointers to make it really clear to the compiler what we're doing */
+      const kiss_fft_scalar * OPUS_RESTRICT xp1 = in+(overlap>>1);
+      const kiss_fft_scalar * OPUS_RESTRICT xp2 = in+N2-1+(overlap>>1);
+      kiss_fft_scalar * OPUS_RESTRICT yp = f;
+      const opus_val16 * OPUS_RESTRICT wp1 = window+(overlap>>1);
+      const opus_val16 * OPUS_RESTRICT wp2 = window+(overlap>>1)-1;
+      for(i=0;i<L1-3;i+=4)
+      {
+         mdct_vec a, b, c, d, w1, w2;
+         a = VPERM(VLOAD(xp1), idx_even);
+         b = VPERM(VLOAD(xp1+N2), idx_even);
+         c = VPERM(VLOAD(xp2-7), idx_rev);
+         d = VPERM(VLOAD(xp2-N2-7), idx_rev);
+         w1 = VPERM(WLOAD(wp1), idx_even);
+         w2 = VPERM(WLOAD(wp2-7), idx_rev);
+         /* Real part arranged as -d-cR, Imag part arranged as -b+aR*/
+         VSTORE(yp, VADD(VMULW(VBLEND_ODD(b, a), VBLEND_ODD(w2, w1)),
+               VNEG_ODD(VMULW(VBLEND_ODD(c, d), VBLEND_ODD(w1, w2)))));
+         yp+=8;
+         xp1+=8;
+         xp2-=8;
+         wp1+=8;
+         wp2-=8;
+      }
+      for(;i<L1;i++)
+      {
+         *yp++ = MULT16_32_Q15(*wp2, xp1[N2]) + MULT16_32_Q15(*wp1,*xp2);
+         *yp++ = MULT16_32_Q15(*wp1, *xp1)    - MULT16_32_Q15(*wp2, xp2[-N2]);
+         xp1+=2;
+         xp2-=2;
+         wp1+=2;
+         wp2-=2;
+      }
+      wp1 = window;
+      wp2 = window+overlap-1;
+      for(;i<N4-L1-3;i+=4)
+      {
+         /* Real part arranged as a-bR, Imag part arranged as -c-dR */
+         VSTORE(yp, VBLEND_ODD(VPERM(VLOAD(xp2-7), idx_rev),
+               VPERM(VLOAD(xp1), idx_even)));
+         yp+=8;
+         xp1+=8;
+         xp2-=8;
+      }
+      for(;i<N4-L1;i++)
+      {
+         *yp++ = *xp2;
+         *yp++ = *xp1;
+         xp1+=2;
+         xp2-=2;
+      }
+      for(;i<N4-3;i+=4)
+      {
+         mdct_vec a, a2, c, d, w1, w2;
+         a = VPERM(VLOAD(xp1), idx_even);
+         a2 = VPERM(VLOAD(xp1-N2), idx_even);
+         c = VPERM(VLOAD(xp2-7), idx_rev);
+         d = VPERM(VLOAD(xp2+N2-7), idx_rev);
+         w1 = VPERM(WLOAD(wp1), idx_even);
+         w2 = VPERM(WLOAD(wp2-7), idx_rev);
+         /* Real part arranged as a-bR, Imag part arranged as -c-dR */
+         VSTORE(yp, VADD(VMULW(VBLEND_ODD(c, a), w2),
+               VNEG_EVEN(VMULW(VBLEND_ODD(a2, d), w1))));
+         yp+=8;
+         xp1+=8;
+         xp2-=8;
+         wp1+=8;
+         wp2-=8;
+      }
+      for(;i<N4;i++)
+      {
+         *yp++ =  -MULT16_32_Q15(*wp1, xp1[-N2]) + MULT16_32_Q15(*wp2, *xp2);
+         *yp++ = MULT16_32_Q15(*wp2, *xp1)     + MULT16_32_Q15(*wp1, xp2[N2]);
+         xp1+=2;
+         xp2-=2;
+         wp1+=2;
+         wp2-=2;
+      }
+   }
+   /* Pre-rotation */
+   {
+      kiss_fft_scalar * OPUS_RESTRICT yp = f;
+      const kiss_twiddle_scalar *t = &trig[0];
+#ifdef FIXED_POINT
+      __m256i scale_v = _mm256_set1_epi32(scale);
+      __m256i round_v = _mm256_set1_epi32((1<<scale_shift)>>1);
+      __m128i shift_v = _mm_cvtsi32_si128(scale_shift);
+#else
+      __m256 scale_v = _mm256_set1_ps(scale);
+#endif
+      for(i=0;i<N4-3;i+=4)
+      {
+         mdct_vec y;
+         y = cpx_mul(VLOAD(yp), load_trig4(t+i, t+N4+i));
+#ifdef FIXED_POINT
+         y = _mm256_sra_epi32(_mm256_add_epi32(mulq16_avx2(y, scale_v),
+               round_v), shift_v);
+#else
+         y = _mm256_mul_ps(y, scale_v);
+#endif
+         store_scatter4(f2, st->bitrev+i, y);
+         yp+=8;
+      }
+      for(;i<N4;i++)
+      {
+         kiss_fft_cpx yc;
+         kiss_twiddle_scalar t0, t1;
+         kiss_fft_scalar re, im, yr, yi;
+         t0 = t[i];
+         t1 = t[N4+i];
+         re = *yp++;
+         im = *yp++;
+         yr = S_MUL(re,t0)  -  S_MUL(im,t1);
+         yi = S_MUL(im,t0)  +  S_MUL(re,t1);
+         yc.r = yr;
+         yc.i = yi;
+         yc.r = PSHR32(MULT16_32_Q16(scale, yc.r), scale_shift);
+         yc.i = PSHR32(MULT16_32_Q16(scale, yc.i), scale_shift);
+         f2[st->bitrev[i]] = yc;
+      }
+   }
+
+   /* N/4 complex FFT, does not downscale anymore */
+   opus_fft_impl_avx2(st, f2);
+
+   /* Post-rotate, leaving (yr, yi) in place of each FFT output */
+   {
+      kiss_fft_scalar * OPUS_RESTRICT fp = (kiss_fft_scalar *)f2;
+      const kiss_twiddle_scalar *t = &trig[0];
+      for(i=0;i<N4-3;i+=4)
+      {
+         VSTORE(fp+2*i, VNEG_EVEN(cpx_mul(VLOAD(fp+2*i),
+               load_trig4(t+i, t+N4+i))));
+      }
+      for(;i<N4;i++)
+      {
+         kiss_fft_scalar yr, yi;
+         yr = S_MUL(f2[i].i,t[N4+i]) - S_MUL(f2[i].r,t[i]);
+         yi = S_MUL(f2[i].r,t[N4+i]) + S_MUL(f2[i].i,t[i]);
+         f2[i].r = yr;
+         f2[i].i = yi;
+      }
+   }
+   /* De-interleave into the output: yr goes to the even slots from the
+      front, yi to the odd slots from the back. */
+   if (stride == 1)
+   {
+      kiss_fft_scalar * OPUS_RESTRICT fp = (kiss_fft_scalar *)f2;
+      for(i=0;i<N4-3;i+=4)
+      {
+         VSTORE(out+2*i, VBLEND_ODD(VLOAD(fp+2*i),
+               VPERM(VLOAD(fp+2*(N4-4-i)), idx_rev)));
+      }
+      for(;i<N4;i++)
+      {
+         out[2*i] = f2[i].r;
+         out[2*i+1] = f2[N4-1-i].i;
+      }
+   } else {
+      for(i=0;i<N4;i++)
+      {
+         out[2*stride*i] = f2[i].r;
+         out[stride*(N2-1-2*i)] = f2[i].i;
+      }
+   }
+   RESTORE_STACK;
+}
+
+void clt_mdct_backward_avx2(const mdct_lookup *l, kiss_fft_scalar *in,
+      kiss_fft_scalar * OPUS_RESTRICT out,
+      const opus_val16 * OPUS_RESTRICT window, int overlap, int shift,
+      int stride, int arch)
+{
+   int i;
+   int N, N2, N4;
+   const kiss_twiddle_scalar *trig;
+   (void) arch;
+
+   N = l->n;
+   trig = l->trig;
+   for (i=0;i<shift;i++)
+   {
+      N >>= 1;
+      trig += N;
+   }
+   N2 = N>>1;
+   N4 = N>>2;
+
+   /* Pre-rotate */
+   {
+      /* Temp pointers to make it really clear to the compiler what we're doing */
+      const kiss_fft_scalar * OPUS_RESTRICT xp1 = in;
+      const kiss_fft_scalar * OPUS_RESTRICT xp2 = in+stride*(N2-1);
+      kiss_fft_scalar * OPUS_RESTRICT yp = out+(overlap>>1);
+      const kiss_twiddle_scalar * OPUS_RESTRICT t = &trig[0];
+      const opus_int16 * OPUS_RESTRICT bitrev = l->kfft[shift]->bitrev;
+      i=0;
+      if (stride == 1)
+      {
+         __m256i idx_even = _mm256_setr_epi32(0, 0, 2, 2, 4, 4, 6, 6);
+         __m256i idx_rev = _mm256_setr_epi32(7, 7, 5, 5, 3, 3, 1, 1);
+         for(;i<N4-3;i+=4)
+         {
+            mdct_vec x;
+            /* (x1, x2) pairs; the product comes out as (yi, yr), which is
+               the swapped order we store in. */
+            x = VBLEND_ODD(VPERM(VLOAD(xp1), idx_even),
+                  VPERM(VLOAD(xp2-7), idx_rev));
+            store_scatter4((kiss_fft_cpx *)yp, bitrev,
+                  cpx_mul(x, load_trig4(t+i, t+N4+i)));
+            bitrev+=4;
+            xp1+=8;
+            xp2-=8;
+         }
+      }
+      for(;i<N4;i++)
+      {
+         int rev;
+         kiss_fft_scalar yr, yi;
+         rev = *bitrev++;
+         yr = ADD32_ovflw(S_MUL(*xp2, t[i]), S_MUL(*xp1, t[N4+i]));
+         yi = SUB32_ovflw(S_MUL(*xp1, t[i]), S_MUL(*xp2, t[N4+i]));
+         /* We swap real and imag because we use an FFT instead of an IFFT. */
+         yp[2*rev+1] = yr;
+         yp[2*rev] = yi;
+         /* Storing the pre-rotation directly in the bitrev order. */
+         xp1+=2*stride;
+         xp2-=2*stride;
+      }
+   }
+
+   opus_fft_impl_avx2(l->kfft[shift], (kiss_fft_cpx*)(out+(overlap>>1)));
+
+   /* Post-rotate and de-shuffle from both ends of the buffer at once to make
+      it in-place. */
+   {
+      kiss_fft_scalar * yp0 = out+(overlap>>1);
+      kiss_fft_scalar * yp1 = out+(overlap>>1)+N2-2;
+      const kiss_twiddle_scalar *t = &trig[0];
+      __m256i idx_a = _mm256_setr_epi32(1, 1, 3, 3, 5, 5, 7, 7);
+      __m256i idx_b = _mm256_setr_epi32(6, 6, 4, 4, 2, 2, 0, 0);
+      /* Four pairs from each end per iteration, as long as the two blocks
+         don't meet.  Each product holds (yi, yr) of its own pair; the yr go
+         back to the same pair and the yi to the mirrored one. */
+      for(i=0;2*i+8<=N4;i+=4)
+      {
+         mdct_vec fc, bc;
+         fc = VNEG_EVEN(cpx_mul(VLOAD(yp0), load_trig4(t+i, t+N4+i)));
+         bc = VNEG_EVEN(cpx_mul(VLOAD(yp1-6),
+               load_trig4(t+N4-4-i, t+N2-4-i)));
+         VSTORE(yp0, VBLEND_ODD(VPERM(fc, idx_a), VPERM(bc, idx_b)));
+         VSTORE(yp1-6, VBLEND_ODD(VPERM(bc, idx_a), VPERM(fc, idx_b)));
+         yp0 += 8;
+         yp1 -= 8;
+      }
+      /* Loop to (N4+1)>>1 to handle odd N4. When N4 is odd, the
+         middle pair will be computed twice. */
+      for(;i<(N4+1)>>1;i++)
+      {
+         kiss_fft_scalar re, im, yr, yi;
+         kiss_twiddle_scalar t0, t1;
+         /* We swap real and imag because we're using an FFT instead of an IFFT. */
+         re = yp0[1];
+         im = yp0[0];
+         t0 = t[i];
+         t1 = t[N4+i];
+         /* We'd scale up by 2 here, but instead it's done when mixing the windows */
+         yr = ADD32_ovflw(S_MUL(re,t0), S_MUL(im,t1));
+         yi = SUB32_ovflw(S_MUL(re,t1), S_MUL(im,t0));
+         /* We swap real and imag because we're using an FFT instead of an IFFT. */
+         re = yp1[1];
+         im = yp1[0];
+         yp0[0] = yr;
+         yp1[1] = yi;
+
+         t0 = t[(N4-i-1)];
+         t1 = t[(N2-i-1)];
+         /* We'd scale up by 2 here, but instead it's done when mixing the windows */
+         yr = ADD32_ovflw(S_MUL(re,t0), S_MUL(im,t1));
+         yi = SUB32_ovflw(S_MUL(re,t1), S_MUL(im,t0));
+         yp1[0] = yr;
+         yp0[1] = yi;
+         yp0 += 2;
+         yp1 -= 2;
+      }
+   }
+
+   /* Mirror on both sides for TDAC */
+   {
+      kiss_fft_scalar * OPUS_RESTRICT xp1 = out+overlap-1;
+      kiss_fft_scalar * OPUS_RESTRICT yp1 = out;
+      const opus_val16 * OPUS_RESTRICT wp1 = window;
+      const opus_val16 * OPUS_RESTRICT wp2 = window+overlap-1;
+      __m256i idx_r = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+
+      for(i = 0; i < overlap/2-7; i+=8)
+      {
+         mdct_vec x1, x2, w1, w2;
+         x1 = VPERM(VLOAD(xp1-7), idx_r);
+         x2 = VLOAD(yp1);
+         w1 = WLOAD(wp1);
+         w2 = VPERM(WLOAD(wp2-7), idx_r);
+         VSTORE(yp1, VSUB(VMULW(x2, w2), VMULW(x1, w1)));
+         VSTORE(xp1-7, VPERM(VADD(VMULW(x2, w1), VMULW(x1, w2)), idx_r));
+         yp1 += 8;
+         xp1 -= 8;
+         wp1 += 8;
+         wp2 -= 8;
+      }
+      for(; i < overlap/2; i++)
+      {
+         kiss_fft_scalar x1, x2;
+         x1 = *xp1;
+         x2 = *yp1;
+         *yp1++ = SUB32_ovflw(MULT16_32_Q15(*wp2, x2), MULT16_32_Q15(*wp1, x1));
+         *xp1-- = ADD32_ovflw(MULT16_32_Q15(*wp1, x2), MULT16_32_Q15(*wp2, x1));
+         wp1++;
+         wp2--;
+      }
+   }
+}
+
+#endif
@@ -0,0 +1,363 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+
+#include "macros.h"
+#include "celt_lpc.h"
+#include "stack_alloc.h"
+#include "mathops.h"
+#include "pitch.h"
+#include "x86cpu.h"
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+
+#ifndef FIXED_POINT
+
+/* Horizontal sum of four vectors: returns {sum(a0), sum(a1), sum(a2), sum(a3)}. */
+static OPUS_INLINE __m128 hadd4_avx2(__m256 a0, __m256 a1, __m256 a2, __m256 a3)
+{
+   __m256 t;
+   t = _mm256_hadd_ps(_mm256_hadd_ps(a0, a1), _mm256_hadd_ps(a2, a3));
+   return _mm_add_ps(_mm256_castps256_ps128(t), _mm256_extractf128_ps(t, 1));
+}
+
+static OPUS_INLINE float hsum_avx2(__m256 a)
+{
+   __m128 sum;
+   sum = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+   sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+   sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 0x55));
+   return _mm_cvtss_f32(sum);
+}
+
+void xcorr_kernel_avx2(const opus_val16 *x, const opus_val16 *y, opus_val32 sum[4], int len)
+{
+   int j;
+   __m256 xsum0, xsum1, xsum2, xsum3;
+   __m128 xsum;
+   xsum0 = _mm256_setzero_ps();
+   xsum1 = _mm256_setzero_ps();
+   xsum2 = _mm256_setzero_ps();
+   xsum3 = _mm256_setzero_ps();
+   /* Each lag gets its own accumulator so that all the loads are contiguous
+      and the only shuffling is in the final reduction. */
+   for (j = 0; j < len-7; j += 8)
+   {
+      __m256 x0 = _mm256_loadu_ps(x+j);
+      xsum0 = _mm256_fmadd_ps(x0, _mm256_loadu_ps(y+j), xsum0);
+      xsum1 = _mm256_fmadd_ps(x0, _mm256_loadu_ps(y+j+1), xsum1);
+      xsum2 = _mm256_fmadd_ps(x0, _mm256_loadu_ps(y+j+2), xsum2);
+      xsum3 = _mm256_fmadd_ps(x0, _mm256_loadu_ps(y+j+3), xsum3);
+   }
+   xsum = _mm_add_ps(_mm_loadu_ps(sum), hadd4_avx2(xsum0, xsum1, xsum2, xsum3));
+   for (; j < len; j++)
+      xsum = _mm_fmadd_ps(_mm_set1_ps(x[j]), _mm_loadu_ps(y+j), xsum);
+   _mm_storeu_ps(sum, xsum);
+}
+
+void dual_inner_prod_avx2(const opus_val16 *x, const opus_val16 *y01, const opus_val16 *y02,
+      int N, opus_val32 *xy1, opus_val32 *xy2)
+{
+   int i;
+   __m256 xsum1, xsum2;
+   opus_val32 xy01, xy02;
+   xsum1 = _mm256_setzero_ps();
+   xsum2 = _mm256_setzero_ps();
+   for (i=0;i<N-7;i+=8)
+   {
+      __m256 xi = _mm256_loadu_ps(x+i);
+      xsum1 = _mm256_fmadd_ps(xi, _mm256_loadu_ps(y01+i), xsum1);
+      xsum2 = _mm256_fmadd_ps(xi, _mm256_loadu_ps(y02+i), xsum2);
+   }
+   xy01 = hsum_avx2(xsum1);
+   xy02 = hsum_avx2(xsum2);
+   for (;i<N;i++)
+   {
+      xy01 = MAC16_16(xy01, x[i], y01[i]);
+      xy02 = MAC16_16(xy02, x[i], y02[i]);
+   }
+   *xy1 = xy01;
+   *xy2 = xy02;
+}
+
+opus_val32 celt_inner_prod_avx2(const opus_val16 *x, const opus_val16 *y,
+      int N)
+{
+   int i;
+   float xy;
+   __m256 sum0, sum1;
+   sum0 = _mm256_setzero_ps();
+   sum1 = _mm256_setzero_ps();
+   /* Two accumulators to hide the FMA latency. */
+   for (i=0;i<N-15;i+=16)
+   {
+      sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(x+i), _mm256_loadu_ps(y+i), sum0);
+      sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(x+i+8), _mm256_loadu_ps(y+i+8), sum1);
+   }
+   if (i<N-7)
+   {
+      sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(x+i), _mm256_loadu_ps(y+i), sum0);
+      i += 8;
+   }
+   xy = hsum_avx2(_mm256_add_ps(sum0, sum1));
+   for (;i<N;i++)
+   {
+      xy = MAC16_16(xy, x[i], y[i]);
+   }
+   return xy;
+}
+
+void comb_filter_const_avx2(opus_val32 *y, opus_val32 *x, int T, int N,
+      opus_val16 g10, opus_val16 g11, opus_val16 g12)
+{
+   int i;
+   __m256 g10v, g11v, g12v;
+   g10v = _mm256_set1_ps(g10);
+   g11v = _mm256_set1_ps(g11);
+   g12v = _mm256_set1_ps(g12);
+   /* Since T >= COMBFILTER_MINPERIOD, all the x[] values we read for a block
+      of 8 outputs were already final, even when filtering in place. */
+   for (i=0;i<N-7;i+=8)
+   {
+      __m256 yi, yi2;
+      const opus_val32 *xp = &x[i-T-2];
+      yi = _mm256_fmadd_ps(g10v, _mm256_loadu_ps(xp+2), _mm256_loadu_ps(x+i));
+      yi2 = _mm256_mul_ps(g12v, _mm256_add_ps(_mm256_loadu_ps(xp+4), _mm256_loadu_ps(xp)));
+      yi2 = _mm256_fmadd_ps(g11v, _mm256_add_ps(_mm256_loadu_ps(xp+3), _mm256_loadu_ps(xp+1)), yi2);
+      _mm256_storeu_ps(y+i, _mm256_add_ps(yi, yi2));
+   }
+   /* N is a multiple of 4 for all the standard modes. */
+   if (i<N-3)
+   {
+      __m128 yi, yi2;
+      const opus_val32 *xp = &x[i-T-2];
+      yi = _mm_fmadd_ps(_mm256_castps256_ps128(g10v), _mm_loadu_ps(xp+2), _mm_loadu_ps(x+i));
+      yi2 = _mm_mul_ps(_mm256_castps256_ps128(g12v), _mm_add_ps(_mm_loadu_ps(xp+4), _mm_loadu_ps(xp)));
+      yi2 = _mm_fmadd_ps(_mm256_castps256_ps128(g11v), _mm_add_ps(_mm_loadu_ps(xp+3), _mm_loadu_ps(xp+1)), yi2);
+      _mm_storeu_ps(y+i, _mm_add_ps(yi, yi2));
+      i += 4;
+   }
+#ifdef CUSTOM_MODES
+   for (;i<N;i++)
+   {
+      y[i] = x[i]
+               + MULT16_32_Q15(g10,x[i-T])
+               + MULT16_32_Q15(g11,ADD32(x[i-T+1],x[i-T-1]))
+               + MULT16_32_Q15(g12,ADD32(x[i-T+2],x[i-T-2]));
+   }
+#endif
+}
+
+#else /* FIXED_POINT */
+
+/* Horizontal sum of four vectors: returns {sum(a0), sum(a1), sum(a2), sum(a3)}. */
+static OPUS_INLINE __m128i hadd4_epi32_avx2(__m256i a0, __m256i a1, __m256i a2, __m256i a3)
+{
+   __m256i t;
+   t = _mm256_hadd_epi32(_mm256_hadd_epi32(a0, a1), _mm256_hadd_epi32(a2, a3));
+   return _mm_add_epi32(_mm256_castsi256_si128(t), _mm256_extracti128_si256(t, 1));
+}
+
+static OPUS_INLINE opus_int32 hsum_epi32_avx2(__m256i a)
+{
+   __m128i sum;
+   sum = _mm_add_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1));
+   sum = _mm_add_epi32(sum, _mm_unpackhi_epi64(sum, sum));
+   sum = _mm_add_epi32(sum, _mm_shufflelo_epi16(sum, 0x0E));
+   return _mm_cvtsi128_si32(sum);
+}
+
+/* All the integer kernels below accumulate with wrap-around 32-bit adds,
+   which makes them bit-exact with the C code regardless of the order in which
+   the products get summed. */
+
+void xcorr_kernel_avx2(const opus_val16 *x, const opus_val16 *y, opus_val32 sum[4], int len)
+{
+   int j;
+   __m256i sum0, sum1, sum2, sum3;
+   __m128i vecSum;
+
+   celt_assert(len >= 3);
+
+   sum0 = _mm256_setzero_si256();
+   sum1 = _mm256_setzero_si256();
+   sum2 = _mm256_setzero_si256();
+   sum3 = _mm256_setzero_si256();
+
+   for (j=0;j<len-15;j+=16)
+   {
+      __m256i vecX = _mm256_loadu_si256((__m256i *)(&x[j]));
+      sum0 = _mm256_add_epi32(sum0, _mm256_madd_epi16(vecX, _mm256_loadu_si256((__m256i *)(&y[j + 0]))));
+      sum1 = _mm256_add_epi32(sum1, _mm256_madd_epi16(vecX, _mm256_loadu_si256((__m256i *)(&y[j + 1]))));
+      sum2 = _mm256_add_epi32(sum2, _mm256_madd_epi16(vecX, _mm256_loadu_si256((__m256i *)(&y[j + 2]))));
+      sum3 = _mm256_add_epi32(sum3, _mm256_madd_epi16(vecX, _mm256_loadu_si256((__m256i *)(&y[j + 3]))));
+   }
+   if (j<len-7)
+   {
+      __m128i vecX = _mm_loadu_si128((__m128i *)(&x[j]));
+      sum0 = _mm256_add_epi32(sum0, _mm256_castsi128_si256(_mm_madd_epi16(vecX, _mm_loadu_si128((__m128i *)(&y[j + 0])))));
+      sum1 = _mm256_add_epi32(sum1, _mm256_castsi128_si256(_mm_madd_epi16(vecX, _mm_loadu_si128((__m128i *)(&y[j + 1])))));
+      sum2 = _mm256_add_epi32(sum2, _mm256_castsi128_si256(_mm_madd_epi16(vecX, _mm_loadu_si128((__m128i *)(&y[j + 2])))));
+      sum3 = _mm256_add_epi32(sum3, _mm256_castsi128_si256(_mm_madd_epi16(vecX, _mm_loadu_si128((__m128i *)(&y[j + 3])))));
+      j += 8;
+   }
+   vecSum = hadd4_epi32_avx2(sum0, sum1, sum2, sum3);
+
+   for (;j<len;j++)
+   {
+      vecSum = _mm_add_epi32(vecSum, _mm_mullo_epi32(_mm_set1_epi32(x[j]),
+            OP_CVTEPI16_EPI32_M64(&y[j])));
+   }
+
+   vecSum = _mm_add_epi32(vecSum, _mm_loadu_si128((__m128i *)(&sum[0])));
+   _mm_storeu_si128((__m128i *)sum, vecSum);
+}
+
+opus_val32 celt_inner_prod_avx2(const opus_val16 *x, const opus_val16 *y,
+      int N)
+{
+   int i;
+   opus_int32 sum;
+   __m256i acc1, acc2;
+
+   acc1 = _mm256_setzero_si256();
+   acc2 = _mm256_setzero_si256();
+
+   for (i=0;i<N-31;i+=32)
+   {
+      acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(
+            _mm256_loadu_si256((__m256i *)(&x[i])), _mm256_loadu_si256((__m256i *)(&y[i]))));
+      acc2 = _mm256_add_epi32(acc2, _mm256_madd_epi16(
+            _mm256_loadu_si256((__m256i *)(&x[i + 16])), _mm256_loadu_si256((__m256i *)(&y[i + 16]))));
+   }
+   if (i<N-15)
+   {
+      acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(
+            _mm256_loadu_si256((__m256i *)(&x[i])), _mm256_loadu_si256((__m256i *)(&y[i]))));
+      i += 16;
+   }
+   if (i<N-7)
+   {
+      acc2 = _mm256_add_epi32(acc2, _mm256_castsi128_si256(_mm_madd_epi16(
+            _mm_loadu_si128((__m128i *)(&x[i])), _mm_loadu_si128((__m128i *)(&y[i])))));
+      i += 8;
+   }
+   sum = hsum_epi32_avx2(_mm256_add_epi32(acc1, acc2));
+   for (;i<N;i++)
+   {
+      sum = MAC16_16(sum, x[i], y[i]);
+   }
+   return sum;
+}
+
+void dual_inner_prod_avx2(const opus_val16 *x, const opus_val16 *y01, const opus_val16 *y02,
+      int N, opus_val32 *xy1, opus_val32 *xy2)
+{
+   int i;
+   opus_val32 xy01, xy02;
+   __m256i acc1, acc2;
+
+   acc1 = _mm256_setzero_si256();
+   acc2 = _mm256_setzero_si256();
+   for (i=0;i<N-15;i+=16)
+   {
+      __m256i xi = _mm256_loadu_si256((__m256i *)(&x[i]));
+      acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(xi, _mm256_loadu_si256((__m256i *)(&y01[i]))));
+      acc2 = _mm256_add_epi32(acc2, _mm256_madd_epi16(xi, _mm256_loadu_si256((__m256i *)(&y02[i]))));
+   }
+   if (i<N-7)
+   {
+      __m128i xi = _mm_loadu_si128((__m128i *)(&x[i]));
+      acc1 = _mm256_add_epi32(acc1, _mm256_castsi128_si256(_mm_madd_epi16(xi, _mm_loadu_si128((__m128i *)(&y01[i])))));
+      acc2 = _mm256_add_epi32(acc2, _mm256_castsi128_si256(_mm_madd_epi16(xi, _mm_loadu_si128((__m128i *)(&y02[i])))));
+      i += 8;
+   }
+   xy01 = hsum_epi32_avx2(acc1);
+   xy02 = hsum_epi32_avx2(acc2);
+   for (;i<N;i++)
+   {
+      xy01 = MAC16_16(xy01, x[i], y01[i]);
+      xy02 = MAC16_16(xy02, x[i], y02[i]);
+   }
+   *xy1 = xy01;
+   *xy2 = xy02;
+}
+
+/* MULT16_32_Q15() on 8 lanes, split into 16x16 products the same way as the
+   non-64-bit version in fixed_generic.h, so that it stays bit-exact. */
+static OPUS_INLINE __m256i mult16_32_q15_avx2(__m256i a, __m256i b)
+{
+   __m256i hi, lo;
+   hi = _mm256_slli_epi32(_mm256_mullo_epi32(a, _mm256_srai_epi32(b, 16)), 1);
+   lo = _mm256_srai_epi32(_mm256_mullo_epi32(a,
+         _mm256_and_si256(b, _mm256_set1_epi32(0xFFFF))), 15);
+   return _mm256_add_epi32(hi, lo);
+}
+
+void comb_filter_const_avx2(opus_val32 *y, opus_val32 *x, int T, int N,
+      opus_val16 g10, opus_val16 g11, opus_val16 g12)
+{
+   int i;
+   __m256i g10v, g11v, g12v, satp, satn;
+   g10v = _mm256_set1_epi32(g10);
+   g11v = _mm256_set1_epi32(g11);
+   g12v = _mm256_set1_epi32(g12);
+   satp = _mm256_set1_epi32(SIG_SAT);
+   satn = _mm256_set1_epi32(-SIG_SAT);
+   /* Since T >= COMBFILTER_MINPERIOD, all the x[] values we read for a block
+      of 8 outputs were already final, even when filtering in place. */
+   for (i=0;i<N-7;i+=8)
+   {
+      __m256i yi;
+      const opus_val32 *xp = &x[i-T-2];
+      yi = _mm256_loadu_si256((__m256i *)(x+i));
+      yi = _mm256_add_epi32(yi, mult16_32_q15_avx2(g10v,
+            _mm256_loadu_si256((__m256i *)(xp+2))));
+      yi = _mm256_add_epi32(yi, mult16_32_q15_avx2(g11v, _mm256_add_epi32(
+            _mm256_loadu_si256((__m256i *)(xp+1)), _mm256_loadu_si256((__m256i *)(xp+3)))));
+      yi = _mm256_add_epi32(yi, mult16_32_q15_avx2(g12v, _mm256_add_epi32(
+            _mm256_loadu_si256((__m256i *)(xp)), _mm256_loadu_si256((__m256i *)(xp+4)))));
+      yi = _mm256_min_epi32(_mm256_max_epi32(yi, satn), satp);
+      _mm256_storeu_si256((__m256i *)(y+i), yi);
+   }
+   for (;i<N;i++)
+   {
+      y[i] = x[i]
+               + MULT16_32_Q15(g10,x[i-T])
+               + MULT16_32_Q15(g11,ADD32(x[i-T+1],x[i-T-1]))
+               + MULT16_32_Q15(g12,ADD32(x[i-T+2],x[i-T-2]));
+      y[i] = SATURATE(y[i], SIG_SAT);
+   }
+}
+
+#endif /* FIXED_POINT */
+
+#endif
@@ -53,17 +53,30 @@ void xcorr_kernel_sse(
                     int              len);
 #endif
 
-#if defined(OPUS_X86_PRESUME_SSE4_1) && defined(FIXED_POINT)
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+void xcorr_kernel_avx2(
+                    const opus_val16 *x,
+                    const opus_val16 *y,
+                    opus_val32       sum[4],
+                    int              len);
+#endif
+
+#if defined(OPUS_X86_PRESUME_AVX2)
+#define OVERRIDE_XCORR_KERNEL
+#define xcorr_kernel(x, y, sum, len, arch) \
+    ((void)arch, xcorr_kernel_avx2(x, y, sum, len))
+
+#elif defined(OPUS_X86_PRESUME_SSE4_1) && defined(FIXED_POINT) && !defined(OPUS_X86_MAY_HAVE_AVX2)
 #define OVERRIDE_XCORR_KERNEL
 #define xcorr_kernel(x, y, sum, len, arch) \
     ((void)arch, xcorr_kernel_sse4_1(x, y, sum, len))
 
-#elif defined(OPUS_X86_PRESUME_SSE) && !defined(FIXED_POINT)
+#elif defined(OPUS_X86_PRESUME_SSE) && !defined(FIXED_POINT) && !defined(OPUS_X86_MAY_HAVE_AVX2)
 #define OVERRIDE_XCORR_KERNEL
 #define xcorr_kernel(x, y, sum, len, arch) \
     ((void)arch, xcorr_kernel_sse(x, y, sum, len))
 
-#elif (defined(OPUS_X86_MAY_HAVE_SSE4_1) && defined(FIXED_POINT)) || (defined(OPUS_X86_MAY_HAVE_SSE) && !defined(FIXED_POINT))
+#elif (defined(OPUS_X86_MAY_HAVE_SSE4_1) && defined(FIXED_POINT)) || (defined(OPUS_X86_MAY_HAVE_SSE) && !defined(FIXED_POINT)) || defined(OPUS_X86_MAY_HAVE_AVX2)
 
 extern void (*const XCORR_KERNEL_IMPL[OPUS_ARCHMASK + 1])(
                     const opus_val16 *x,
@@ -98,25 +111,37 @@ opus_val32 celt_inner_prod_sse(
     int               N);
 #endif
 
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+opus_val32 celt_inner_prod_avx2(
+    const opus_val16 *x,
+    const opus_val16 *y,
+    int               N);
+#endif
 
-#if defined(OPUS_X86_PRESUME_SSE4_1) && defined(FIXED_POINT)
+
+#if defined(OPUS_X86_PRESUME_AVX2)
+#define OVERRIDE_CELT_INNER_PROD
+#define celt_inner_prod(x, y, N, arch) \
+    ((void)arch, celt_inner_prod_avx2(x, y, N))
+
+#elif defined(OPUS_X86_PRESUME_SSE4_1) && defined(FIXED_POINT) && !defined(OPUS_X86_MAY_HAVE_AVX2)
 #define OVERRIDE_CELT_INNER_PROD
 #define celt_inner_prod(x, y, N, arch) \
     ((void)arch, celt_inner_prod_sse4_1(x, y, N))
 
-#elif defined(OPUS_X86_PRESUME_SSE2) && defined(FIXED_POINT) && !defined(OPUS_X86_MAY_HAVE_SSE4_1)
+#elif defined(OPUS_X86_PRESUME_SSE2) && defined(FIXED_POINT) && !defined(OPUS_X86_MAY_HAVE_SSE4_1) && !defined(OPUS_X86_MAY_HAVE_AVX2)
 #define OVERRIDE_CELT_INNER_PROD
 #define celt_inner_prod(x, y, N, arch) \
     ((void)arch, celt_inner_prod_sse2(x, y, N))
 
-#elif defined(OPUS_X86_PRESUME_SSE) && !defined(FIXED_POINT)
+#elif defined(OPUS_X86_PRESUME_SSE) && !defined(FIXED_POINT) && !defined(OPUS_X86_MAY_HAVE_AVX2)
 #define OVERRIDE_CELT_INNER_PROD
 #define celt_inner_prod(x, y, N, arch) \
     ((void)arch, celt_inner_prod_sse(x, y, N))
 
 
 #elif ((defined(OPUS_X86_MAY_HAVE_SSE4_1) || defined(OPUS_X86_MAY_HAVE_SSE2)) && defined(FIXED_POINT)) || \
-    (defined(OPUS_X86_MAY_HAVE_SSE) && !defined(FIXED_POINT))
+    (defined(OPUS_X86_MAY_HAVE_SSE) && !defined(FIXED_POINT)) || defined(OPUS_X86_MAY_HAVE_AVX2)
 
 extern opus_val32 (*const CELT_INNER_PROD_IMPL[OPUS_ARCHMASK + 1])(
                     const opus_val16 *x,
@@ -129,7 +154,7 @@ extern opus_val32 (*const CELT_INNER_PROD_IMPL[OPUS_ARCHMASK + 1])(
 
 #endif
 
-#if defined(OPUS_X86_MAY_HAVE_SSE) && !defined(FIXED_POINT)
+#if (defined(OPUS_X86_MAY_HAVE_SSE) && !defined(FIXED_POINT)) || defined(OPUS_X86_MAY_HAVE_AVX2)
 
 #define OVERRIDE_DUAL_INNER_PROD
 #define OVERRIDE_COMB_FILTER_CONST
@@ -137,6 +162,7 @@ extern opus_val32 (*const CELT_INNER_PROD_IMPL[OPUS_ARCHMASK + 1])(
 #undef dual_inner_prod
 #undef comb_filter_const
 
+#if defined(OPUS_X86_MAY_HAVE_SSE) && !defined(FIXED_POINT)
 void dual_inner_prod_sse(const opus_val16 *x,
     const opus_val16 *y01,
     const opus_val16 *y02,
@@ -151,9 +177,34 @@ void comb_filter_const_sse(opus_val32 *y,
     opus_val16  g10,
     opus_val16  g11,
     opus_val16  g12);
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+void dual_inner_prod_avx2(const opus_val16 *x,
+    const opus_val16 *y01,
+    const opus_val16 *y02,
+    int               N,
+    opus_val32       *xy1,
+    opus_val32       *xy2);
 
+void comb_filter_const_avx2(opus_val32 *y,
+    opus_val32 *x,
+    int         T,
+    int         N,
+    opus_val16  g10,
+    opus_val16  g11,
+    opus_val16  g12);
+#endif
+
+
+#if defined(OPUS_X86_PRESUME_AVX2)
+# define dual_inner_prod(x, y01, y02, N, xy1, xy2, arch) \
+    ((void)(arch),dual_inner_prod_avx2(x, y01, y02, N, xy1, xy2))
+
+# define comb_filter_const(y, x, T, N, g10, g11, g12, arch) \
+    ((void)(arch),comb_filter_const_avx2(y, x, T, N, g10, g11, g12))
 
-#if defined(OPUS_X86_PRESUME_SSE)
+#elif defined(OPUS_X86_PRESUME_SSE) && !defined(FIXED_POINT) && !defined(OPUS_X86_MAY_HAVE_AVX2)
 # define dual_inner_prod(x, y01, y02, N, xy1, xy2, arch) \
     ((void)(arch),dual_inner_prod_sse(x, y01, y02, N, xy1, xy2))
 
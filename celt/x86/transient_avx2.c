@@ -0,0 +1,356 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+#include "celt.h"
+#include "arch.h"
+#include "mathops.h"
+#include "x86cpu.h"
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+
+#ifdef FIXED_POINT
+
+/* The high-pass filter and the two masking passes round at every sample, so
+   they stay scalar. The normalization and the energy of the pairs, which
+   are most of the rest, are done on sixteen samples at a time. */
+void transient_masking_curve_avx2(const opus_val32 * OPUS_RESTRICT in,
+      opus_val16 * OPUS_RESTRICT tmp, int len, int allow_weak_transients,
+      opus_val32 *mean, opus_val16 *maxE)
+{
+   int i;
+   opus_val32 mem0,mem1;
+   int len2;
+   int forward_shift;
+   int shift;
+   opus_val32 maxval, minval;
+   __m256i vecMax, vecMin;
+   __m256i vecMean;
+   __m128i t;
+
+   forward_shift = allow_weak_transients ? 5 : 4;
+   len2=len/2;
+   mem0=0;
+   mem1=0;
+   /* High-pass filter: (1 - 2*z^-1 + z^-2) / (1 - z^-1 + .5*z^-2) */
+   for (i=0;i<len;i++)
+   {
+      opus_val32 x,y;
+      x = SHR32(in[i],SIG_SHIFT);
+      y = ADD32(mem0, x);
+      mem0 = mem1 + y - SHL32(x,1);
+      mem1 = x - SHR32(y,1);
+      tmp[i] = SROUND16(y, 2);
+   }
+   /* First few samples are bad because we don't propagate the memory */
+   OPUS_CLEAR(tmp, 12);
+
+   /* Normalize tmp to max range */
+   vecMax = _mm256_setzero_si256();
+   vecMin = _mm256_setzero_si256();
+   for (i=0;i<len-15;i+=16)
+   {
+      __m256i vecX = _mm256_loadu_si256((__m256i *)(tmp+i));
+      vecMax = _mm256_max_epi16(vecMax, vecX);
+      vecMin = _mm256_min_epi16(vecMin, vecX);
+   }
+   t = _mm_max_epi16(_mm256_castsi256_si128(vecMax), _mm256_extracti128_si256(vecMax, 1));
+   t = _mm_max_epi16(t, _mm_shuffle_epi32(t, _MM_SHUFFLE(1, 0, 3, 2)));
+   t = _mm_max_epi16(t, _mm_shuffle_epi32(t, _MM_SHUFFLE(2, 3, 0, 1)));
+   t = _mm_max_epi16(t, _mm_shufflelo_epi16(t, _MM_SHUFFLE(2, 3, 0, 1)));
+   maxval = (opus_int16)_mm_extract_epi16(t, 0);
+   t = _mm_min_epi16(_mm256_castsi256_si128(vecMin), _mm256_extracti128_si256(vecMin, 1));
+   t = _mm_min_epi16(t, _mm_shuffle_epi32(t, _MM_SHUFFLE(1, 0, 3, 2)));
+   t = _mm_min_epi16(t, _mm_shuffle_epi32(t, _MM_SHUFFLE(2, 3, 0, 1)));
+   t = _mm_min_epi16(t, _mm_shufflelo_epi16(t, _MM_SHUFFLE(2, 3, 0, 1)));
+   minval = (opus_int16)_mm_extract_epi16(t, 0);
+   for (;i<len;i++)
+   {
+      maxval = MAX32(maxval, tmp[i]);
+      minval = MIN32(minval, tmp[i]);
+   }
+   shift = 14-celt_ilog2(MAX16(1, MAX32(maxval, -minval)));
+   if (shift>0)
+   {
+      __m128i vecShift = _mm_cvtsi32_si128(shift);
+      for (i=0;i<len-15;i+=16)
+      {
+         _mm256_storeu_si256((__m256i *)(tmp+i), _mm256_sll_epi16(
+               _mm256_loadu_si256((__m256i *)(tmp+i)), vecShift));
+      }
+      for (;i<len;i++)
+         tmp[i] = SHL16(tmp[i], shift);
+   } else if (shift!=0)
+   {
+      for (i=0;i<len;i++)
+         tmp[i] = SHL16(tmp[i], shift);
+   }
+
+   /* Energy of the pairs, written over the first half of tmp. Block i only
+      writes to samples that were already read. */
+   vecMean = _mm256_setzero_si256();
+   for (i=0;i<len2-7;i+=8)
+   {
+      __m256i vecX, vecX2;
+      vecX = _mm256_loadu_si256((__m256i *)(tmp+2*i));
+      vecX2 = _mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(vecX, vecX),
+            _mm256_set1_epi32(32768)), 16);
+      /* Truncate to 16 bits, like the conversion to opus_val16. */
+      vecX2 = _mm256_srai_epi32(_mm256_slli_epi32(vecX2, 16), 16);
+      vecMean = _mm256_add_epi32(vecMean, vecX2);
+      vecX2 = _mm256_permute4x64_epi64(_mm256_packs_epi32(vecX2, vecX2), _MM_SHUFFLE(3, 1, 2, 0));
+      _mm_storeu_si128((__m128i *)(tmp+i), _mm256_castsi256_si128(vecX2));
+   }
+   t = _mm_add_epi32(_mm256_castsi256_si128(vecMean), _mm256_extracti128_si256(vecMean, 1));
+   t = _mm_add_epi32(t, _mm_shuffle_epi32(t, _MM_SHUFFLE(1, 0, 3, 2)));
+   t = _mm_add_epi32(t, _mm_shuffle_epi32(t, _MM_SHUFFLE(2, 3, 0, 1)));
+   *mean = _mm_cvtsi128_si32(t);
+   for (;i<len2;i++)
+   {
+      opus_val16 x2 = PSHR32(MULT16_16(tmp[2*i],tmp[2*i]) + MULT16_16(tmp[2*i+1],tmp[2*i+1]),16);
+      *mean += x2;
+      tmp[i] = x2;
+   }
+
+   mem0=0;
+   /* Forward pass to compute the post-echo threshold*/
+   for (i=0;i<len2;i++)
+   {
+      tmp[i] = mem0 + PSHR32(tmp[i]-mem0,forward_shift);
+      mem0 = tmp[i];
+   }
+
+   mem0=0;
+   *maxE=0;
+   /* Backward pass to compute the pre-echo threshold */
+   for (i=len2-1;i>=0;i--)
+   {
+      tmp[i] = mem0 + PSHR32(tmp[i]-mem0,3);
+      mem0 = tmp[i];
+      *maxE = MAX16(*maxE, mem0);
+   }
+}
+
+#else
+
+/* Rotates the lanes of x up by n, for use with coefficients that are zero in
+   the lanes that wrapped around. */
+static OPUS_INLINE __m256 rotate_up_ps(__m256 x, int n)
+{
+   return _mm256_permutevar8x32_ps(x, _mm256_and_si256(_mm256_sub_epi32(
+         _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(n)),
+         _mm256_set1_epi32(7)));
+}
+
+static OPUS_INLINE __m256 broadcast_lane_ps(__m256 x, int n)
+{
+   return _mm256_permutevar8x32_ps(x, _mm256_set1_epi32(n));
+}
+
+/* Coefficient r^n in lanes n and up, zero below. */
+static OPUS_INLINE __m256 scan_coef_ps(float rn, int n)
+{
+   return _mm256_and_ps(_mm256_set1_ps(rn), _mm256_castsi256_ps(_mm256_cmpgt_epi32(
+         _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(n-1))));
+}
+
+/* In float, all three recursive filters are linear, so they are computed
+   eight samples at a time. Each block is the response of the filter to the
+   block's input alone, plus the response to the filter state left by the
+   previous block, so only the latter is a serial dependency. */
+void transient_masking_curve_avx2(const opus_val32 * OPUS_RESTRICT in,
+      opus_val16 * OPUS_RESTRICT tmp, int len, int allow_weak_transients,
+      opus_val32 *mean, opus_val16 *maxE)
+{
+   int i;
+   int len2;
+   opus_val16 forward_decay;
+   opus_val16 r;
+   opus_val32 mem0;
+   __m256 vecMean, vecMax;
+   __m256 vecY;
+   __m128 t;
+
+   /* Forward masking: 6.7 dB/ms, or 3.3 dB/ms at lower bitrates. */
+   forward_decay = allow_weak_transients ? .03125f : .0625f;
+   len2=len/2;
+
+   /* High-pass filter: (1 - 2*z^-1 + z^-2) / (1 - z^-1 + .5*z^-2). The
+      first block starts from a zero state, so only the FIR part needs
+      special care. */
+   vecY = _mm256_setzero_ps();
+   for (i=0;i<len-7;i+=8)
+   {
+      __m256 vecX0, vecX1, vecX2, vecF, vecConv;
+      vecX0 = _mm256_loadu_ps(in+i);
+      if (i==0)
+      {
+         vecX1 = rotate_up_ps(vecX0, 1);
+         vecX1 = _mm256_blend_ps(vecX1, _mm256_setzero_ps(), 0x01);
+         vecX2 = rotate_up_ps(vecX0, 2);
+         vecX2 = _mm256_blend_ps(vecX2, _mm256_setzero_ps(), 0x03);
+      } else {
+         vecX1 = _mm256_loadu_ps(in+i-1);
+         vecX2 = _mm256_loadu_ps(in+i-2);
+      }
+      vecF = _mm256_add_ps(_mm256_fnmadd_ps(_mm256_set1_ps(2.f), vecX1, vecX0), vecX2);
+      /* Impulse response of 1/(1 - z^-1 + .5*z^-2): 1, 1, .5, 0, -.25, -.25,
+         -.125, 0. */
+      vecConv = _mm256_add_ps(vecF, _mm256_mul_ps(scan_coef_ps(1.f, 1), rotate_up_ps(vecF, 1)));
+      vecConv = _mm256_fmadd_ps(scan_coef_ps(.5f, 2), rotate_up_ps(vecF, 2), vecConv);
+      vecConv = _mm256_fmadd_ps(scan_coef_ps(-.25f, 4), rotate_up_ps(vecF, 4), vecConv);
+      vecConv = _mm256_fmadd_ps(scan_coef_ps(-.25f, 5), rotate_up_ps(vecF, 5), vecConv);
+      vecConv = _mm256_fmadd_ps(scan_coef_ps(-.125f, 6), rotate_up_ps(vecF, 6), vecConv);
+      /* Response to the last two outputs of the previous block. */
+      vecY = _mm256_fmadd_ps(_mm256_setr_ps(1.f, .5f, 0.f, -.25f, -.25f, -.125f, 0.f, .0625f),
+            broadcast_lane_ps(vecY, 7), _mm256_fmadd_ps(
+            _mm256_setr_ps(-.5f, -.5f, -.25f, 0.f, .125f, .125f, .0625f, 0.f),
+            broadcast_lane_ps(vecY, 6), vecConv));
+      _mm256_storeu_ps(tmp+i, vecY);
+   }
+   {
+      opus_val32 mem1, y1, y2;
+      /* Rebuild the state of the direct form from the last two outputs. */
+      y1 = i>0 ? tmp[i-1] : 0;
+      y2 = i>1 ? tmp[i-2] : 0;
+      mem0 = y1 - 2*(i>0 ? in[i-1] : 0) + (i>1 ? in[i-2] : 0) - .5f*y2;
+      mem1 = (i>0 ? in[i-1] : 0) - .5f*y1;
+      for (;i<len;i++)
+      {
+         opus_val32 x,y;
+         x = in[i];
+         y = mem0 + x;
+         mem0 = mem1 + y - 2*x;
+         mem1 = x - .5f*y;
+         tmp[i] = y;
+      }
+   }
+   /* First few samples are bad because we don't propagate the memory */
+   OPUS_CLEAR(tmp, 12);
+
+   /* Energy of the pairs, written over the first half of tmp. Block i only
+      writes to samples that were already read. */
+   vecMean = _mm256_setzero_ps();
+   for (i=0;i<len2-7;i+=8)
+   {
+      __m256 vecA, vecB, vecX2;
+      vecA = _mm256_loadu_ps(tmp+2*i);
+      vecB = _mm256_loadu_ps(tmp+2*i+8);
+      vecX2 = _mm256_hadd_ps(_mm256_mul_ps(vecA, vecA), _mm256_mul_ps(vecB, vecB));
+      vecX2 = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(vecX2), _MM_SHUFFLE(3, 1, 2, 0)));
+      vecMean = _mm256_add_ps(vecMean, vecX2);
+      _mm256_storeu_ps(tmp+i, vecX2);
+   }
+   t = _mm_add_ps(_mm256_castps256_ps128(vecMean), _mm256_extractf128_ps(vecMean, 1));
+   t = _mm_add_ps(t, _mm_movehl_ps(t, t));
+   t = _mm_add_ss(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1)));
+   *mean = _mm_cvtss_f32(t);
+   for (;i<len2;i++)
+   {
+      opus_val16 x2 = tmp[2*i]*tmp[2*i] + tmp[2*i+1]*tmp[2*i+1];
+      *mean += x2;
+      tmp[i] = x2;
+   }
+
+   /* Forward pass to compute the post-echo threshold, as
+      tmp[i] = (1-forward_decay)*tmp[i-1] + forward_decay*x2[i]. */
+   r = 1-forward_decay;
+   {
+      __m256 vecC1, vecC2, vecC4, vecR;
+      vecC1 = scan_coef_ps(r, 1);
+      vecC2 = scan_coef_ps(r*r, 2);
+      vecC4 = scan_coef_ps(r*r*r*r, 4);
+      vecR = _mm256_setr_ps(r, r*r, r*r*r, r*r*r*r, r*r*r*r*r, r*r*r*r*r*r,
+            r*r*r*r*r*r*r, r*r*r*r*r*r*r*r);
+      vecY = _mm256_setzero_ps();
+      for (i=0;i<len2-7;i+=8)
+      {
+         __m256 vecS;
+         vecS = _mm256_mul_ps(_mm256_set1_ps(forward_decay), _mm256_loadu_ps(tmp+i));
+         vecS = _mm256_fmadd_ps(vecC1, rotate_up_ps(vecS, 1), vecS);
+         vecS = _mm256_fmadd_ps(vecC2, rotate_up_ps(vecS, 2), vecS);
+         vecS = _mm256_fmadd_ps(vecC4, rotate_up_ps(vecS, 4), vecS);
+         vecY = _mm256_fmadd_ps(vecR, broadcast_lane_ps(vecY, 7), vecS);
+         _mm256_storeu_ps(tmp+i, vecY);
+      }
+      mem0 = i>0 ? tmp[i-1] : 0;
+      for (;i<len2;i++)
+      {
+         tmp[i] = mem0 + forward_decay*(tmp[i]-mem0);
+         mem0 = tmp[i];
+      }
+   }
+
+   /* Backward pass to compute the pre-echo threshold, starting with the
+      samples that don't fill a whole block at the end. */
+   mem0=0;
+   *maxE=0;
+   for (i=len2-1;i>=(len2&~7);i--)
+   {
+      tmp[i] = mem0 + .125f*(tmp[i]-mem0);
+      mem0 = tmp[i];
+      *maxE = MAX16(*maxE, mem0);
+   }
+   r = .875f;
+   {
+      __m256 vecC1, vecC2, vecC4, vecR;
+      __m256i vecDown1, vecDown2, vecDown4;
+      /* Same as the forward pass, with the lanes in reverse order. */
+      vecC1 = _mm256_setr_ps(r, r, r, r, r, r, r, 0);
+      vecC2 = _mm256_setr_ps(r*r, r*r, r*r, r*r, r*r, r*r, 0, 0);
+      vecC4 = _mm256_setr_ps(r*r*r*r, r*r*r*r, r*r*r*r, r*r*r*r, 0, 0, 0, 0);
+      vecR = _mm256_setr_ps(r*r*r*r*r*r*r*r, r*r*r*r*r*r*r, r*r*r*r*r*r,
+            r*r*r*r*r, r*r*r*r, r*r*r, r*r, r);
+      vecDown1 = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+      vecDown2 = _mm256_setr_epi32(2, 3, 4, 5, 6, 7, 0, 1);
+      vecDown4 = _mm256_setr_epi32(4, 5, 6, 7, 0, 1, 2, 3);
+      vecY = _mm256_set1_ps(mem0);
+      vecMax = _mm256_set1_ps(*maxE);
+      for (i=(len2&~7)-8;i>=0;i-=8)
+      {
+         __m256 vecS;
+         vecS = _mm256_mul_ps(_mm256_set1_ps(.125f), _mm256_loadu_ps(tmp+i));
+         vecS = _mm256_fmadd_ps(vecC1, _mm256_permutevar8x32_ps(vecS, vecDown1), vecS);
+         vecS = _mm256_fmadd_ps(vecC2, _mm256_permutevar8x32_ps(vecS, vecDown2), vecS);
+         vecS = _mm256_fmadd_ps(vecC4, _mm256_permutevar8x32_ps(vecS, vecDown4), vecS);
+         vecY = _mm256_fmadd_ps(vecR, broadcast_lane_ps(vecY, 0), vecS);
+         vecMax = _mm256_max_ps(vecMax, vecY);
+         _mm256_storeu_ps(tmp+i, vecY);
+      }
+      t = _mm_max_ps(_mm256_castps256_ps128(vecMax), _mm256_extractf128_ps(vecMax, 1));
+      t = _mm_max_ps(t, _mm_movehl_ps(t, t));
+      t = _mm_max_ss(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1)));
+      *maxE = _mm_cvtss_f32(t);
+   }
+}
+
+#endif
+
+#endif
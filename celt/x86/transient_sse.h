@@ -0,0 +1,55 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef TRANSIENT_SSE_H
+#define TRANSIENT_SSE_H
+
+#include "cpu_support.h"
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+#define OVERRIDE_TRANSIENT_MASKING_CURVE
+
+void transient_masking_curve_avx2(const opus_val32 * OPUS_RESTRICT in,
+      opus_val16 * OPUS_RESTRICT tmp, int len, int allow_weak_transients,
+      opus_val32 *mean, opus_val16 *maxE);
+
+#if defined(OPUS_X86_PRESUME_AVX2)
+
+#define transient_masking_curve(in, tmp, len, allow_weak_transients, mean, maxE, arch) \
+    ((void)(arch), transient_masking_curve_avx2(in, tmp, len, allow_weak_transients, mean, maxE))
+
+#else
+
+extern void (*const TRANSIENT_MASKING_CURVE_IMPL[OPUS_ARCHMASK + 1])(
+      const opus_val32 * OPUS_RESTRICT in, opus_val16 * OPUS_RESTRICT tmp,
+      int len, int allow_weak_transients, opus_val32 *mean, opus_val16 *maxE);
+#define transient_masking_curve(in, tmp, len, allow_weak_transients, mean, maxE, arch) \
+    ((*TRANSIENT_MASKING_CURVE_IMPL[(arch) & OPUS_ARCHMASK])(in, tmp, len, allow_weak_transients, mean, maxE))
+
+#endif
+#endif
+
+#endif
@@ -0,0 +1,447 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+#include "stack_alloc.h"
+#include "mathops.h"
+#include "vq.h"
+#include "x86cpu.h"
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+
+#ifndef FIXED_POINT
+
+opus_val16 op_pvq_search_avx2(celt_norm *_X, int *iy, int K, int N, int arch)
+{
+   int i, j;
+   int pulsesLeft;
+   float xy, yy;
+   VARDECL(celt_norm, y);
+   VARDECL(celt_norm, X);
+   VARDECL(float, signy);
+   __m256 signmask;
+   __m256 sums;
+   __m128 sum4;
+   __m256i eights;
+   SAVE_STACK;
+
+   (void)arch;
+   /* All bits set to zero, except for the sign bit. */
+   signmask = _mm256_set1_ps(-0.f);
+   eights = _mm256_set1_epi32(8);
+   ALLOC(y, N+7, celt_norm);
+   ALLOC(X, N+7, celt_norm);
+   ALLOC(signy, N+7, float);
+
+   OPUS_COPY(X, _X, N);
+   for (j=N;j<N+7;j++)
+      X[j] = 0;
+   sums = _mm256_setzero_ps();
+   for (j=0;j<N;j+=8)
+   {
+      __m256 x8, s8;
+      x8 = _mm256_loadu_ps(&X[j]);
+      s8 = _mm256_cmp_ps(x8, _mm256_setzero_ps(), _CMP_LT_OQ);
+      /* Get rid of the sign */
+      x8 = _mm256_andnot_ps(signmask, x8);
+      sums = _mm256_add_ps(sums, x8);
+      /* Clear y and iy in case we don't do the projection. */
+      _mm256_storeu_ps(&y[j], _mm256_setzero_ps());
+      _mm256_storeu_si256((__m256i*)&iy[j], _mm256_setzero_si256());
+      _mm256_storeu_ps(&X[j], x8);
+      _mm256_storeu_ps(&signy[j], s8);
+   }
+   sum4 = _mm_add_ps(_mm256_castps256_ps128(sums), _mm256_extractf128_ps(sums, 1));
+   sum4 = _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4));
+   sum4 = _mm_add_ss(sum4, _mm_shuffle_ps(sum4, sum4, 0x55));
+
+   xy = yy = 0;
+
+   pulsesLeft = K;
+
+   /* Do a pre-search by projecting on the pyramid */
+   if (K > (N>>1))
+   {
+      __m256i pulses_sum;
+      __m256 yy8, xy8;
+      __m256 rcp8;
+      __m128i p4;
+      __m128 t4;
+      opus_val32 sum = _mm_cvtss_f32(sum4);
+      /* If X is too small, just replace it with a pulse at 0 */
+      /* Prevents infinities and NaNs from causing too many pulses
+         to be allocated. 64 is an approximation of infinity here. */
+      if (!(sum > EPSILON && sum < 64))
+      {
+         X[0] = QCONST16(1.f,14);
+         j=1; do
+            X[j]=0;
+         while (++j<N);
+         sum = QCONST16(1.f,14);
+      }
+      /* Using K+e with e < 1 guarantees we cannot get more than K pulses. */
+      rcp8 = _mm256_set1_ps((K+.8f)*celt_rcp(sum));
+      xy8 = yy8 = _mm256_setzero_ps();
+      pulses_sum = _mm256_setzero_si256();
+      for (j=0;j<N;j+=8)
+      {
+         __m256 x8, y8;
+         __m256i iy8;
+         x8 = _mm256_loadu_ps(&X[j]);
+         iy8 = _mm256_cvttps_epi32(_mm256_mul_ps(x8, rcp8));
+         pulses_sum = _mm256_add_epi32(pulses_sum, iy8);
+         _mm256_storeu_si256((__m256i*)&iy[j], iy8);
+         y8 = _mm256_cvtepi32_ps(iy8);
+         xy8 = _mm256_fmadd_ps(x8, y8, xy8);
+         yy8 = _mm256_fmadd_ps(y8, y8, yy8);
+         /* double the y[] vector so we don't have to do it in the search loop. */
+         _mm256_storeu_ps(&y[j], _mm256_add_ps(y8, y8));
+      }
+      p4 = _mm_add_epi32(_mm256_castsi256_si128(pulses_sum),
+            _mm256_extracti128_si256(pulses_sum, 1));
+      p4 = _mm_add_epi32(p4, _mm_shuffle_epi32(p4, _MM_SHUFFLE(1, 0, 3, 2)));
+      p4 = _mm_add_epi32(p4, _mm_shuffle_epi32(p4, _MM_SHUFFLE(2, 3, 0, 1)));
+      pulsesLeft -= _mm_cvtsi128_si32(p4);
+      t4 = _mm_add_ps(_mm256_castps256_ps128(xy8), _mm256_extractf128_ps(xy8, 1));
+      t4 = _mm_add_ps(t4, _mm_movehl_ps(t4, t4));
+      t4 = _mm_add_ss(t4, _mm_shuffle_ps(t4, t4, 0x55));
+      xy = _mm_cvtss_f32(t4);
+      t4 = _mm_add_ps(_mm256_castps256_ps128(yy8), _mm256_extractf128_ps(yy8, 1));
+      t4 = _mm_add_ps(t4, _mm_movehl_ps(t4, t4));
+      t4 = _mm_add_ss(t4, _mm_shuffle_ps(t4, t4, 0x55));
+      yy = _mm_cvtss_f32(t4);
+   }
+   for (j=N;j<N+7;j++)
+   {
+      X[j] = -100;
+      y[j] = 100;
+   }
+   celt_assert2(pulsesLeft>=0, "Allocated too many pulses in the quick pass");
+
+   /* This should never happen, but just in case it does (e.g. on silence)
+      we fill the first bin with pulses. */
+   if (pulsesLeft > N+3)
+   {
+      opus_val16 tmp = (opus_val16)pulsesLeft;
+      yy = MAC16_16(yy, tmp, tmp);
+      yy = MAC16_16(yy, tmp, y[0]);
+      iy[0] += pulsesLeft;
+      pulsesLeft=0;
+   }
+
+   for (i=0;i<pulsesLeft;i++)
+   {
+      int best_id;
+      __m256 xy8, yy8;
+      __m256 max, max2;
+      __m256i count;
+      __m256i pos;
+      __m128i pos4;
+      /* The squared magnitude term gets added anyway, so we might as well
+         add it outside the loop */
+      yy = ADD16(yy, 1);
+      xy8 = _mm256_set1_ps(xy);
+      yy8 = _mm256_set1_ps(yy);
+      max = _mm256_setzero_ps();
+      pos = _mm256_setzero_si256();
+      count = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+      for (j=0;j<N;j+=8)
+      {
+         __m256 x8, y8, r8, gt;
+         x8 = _mm256_add_ps(_mm256_loadu_ps(&X[j]), xy8);
+         y8 = _mm256_rsqrt_ps(_mm256_add_ps(_mm256_loadu_ps(&y[j]), yy8));
+         r8 = _mm256_mul_ps(x8, y8);
+         /* Each lane keeps the first index of its own max. */
+         gt = _mm256_cmp_ps(r8, max, _CMP_GT_OQ);
+         pos = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(pos),
+               _mm256_castsi256_ps(count), gt));
+         max = _mm256_max_ps(max, r8);
+         count = _mm256_add_epi32(count, eights);
+      }
+      /* Horizontal max */
+      max2 = _mm256_max_ps(max, _mm256_permute2f128_ps(max, max, 1));
+      max2 = _mm256_max_ps(max2, _mm256_permute_ps(max2, _MM_SHUFFLE(1, 0, 3, 2)));
+      max2 = _mm256_max_ps(max2, _mm256_permute_ps(max2, _MM_SHUFFLE(2, 3, 0, 1)));
+      /* Among the lanes that hold the global max, take the lowest index. */
+      pos = _mm256_castps_si256(_mm256_blendv_ps(
+            _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff)),
+            _mm256_castsi256_ps(pos), _mm256_cmp_ps(max, max2, _CMP_EQ_OQ)));
+      pos4 = _mm_min_epi32(_mm256_castsi256_si128(pos), _mm256_extracti128_si256(pos, 1));
+      pos4 = _mm_min_epi32(pos4, _mm_shuffle_epi32(pos4, _MM_SHUFFLE(1, 0, 3, 2)));
+      pos4 = _mm_min_epi32(pos4, _mm_shuffle_epi32(pos4, _MM_SHUFFLE(2, 3, 0, 1)));
+      best_id = _mm_cvtsi128_si32(pos4);
+
+      /* Updating the sums of the new pulse(s) */
+      xy = ADD32(xy, EXTEND32(X[best_id]));
+      /* We're multiplying y[j] by two so we don't have to do it here */
+      yy = ADD16(yy, y[best_id]);
+
+      /* Only now that we've made the final choice, update y/iy */
+      /* Multiplying y[j] by 2 so we don't have to do it everywhere else */
+      y[best_id] += 2;
+      iy[best_id]++;
+   }
+
+   /* Put the original sign back */
+   for (j=0;j<N;j+=8)
+   {
+      __m256i y8;
+      __m256i s8;
+      y8 = _mm256_loadu_si256((__m256i*)&iy[j]);
+      s8 = _mm256_castps_si256(_mm256_loadu_ps(&signy[j]));
+      y8 = _mm256_xor_si256(_mm256_add_epi32(y8, s8), s8);
+      _mm256_storeu_si256((__m256i*)&iy[j], y8);
+   }
+   RESTORE_STACK;
+   return yy;
+}
+
+#else
+
+/* Truncates each 32-bit lane to a signed 16-bit value, like an assignment
+   to opus_val16. */
+static OPUS_INLINE __m256i extract16_avx2(__m256i x)
+{
+   return _mm256_srai_epi32(_mm256_slli_epi32(x, 16), 16);
+}
+
+static OPUS_INLINE __m256i load16_avx2(const opus_val16 *x)
+{
+   return _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)x));
+}
+
+/* Same search as op_pvq_search_c(), bit-exact.  The per-pulse argmax keeps
+   one candidate per lane (the first index of that lane's best ratio, using
+   the same cross-multiplied comparison as the C code) and only resolves the
+   eight candidates at the end, taking the lowest index on ties so the result
+   matches the serial scan. */
+opus_val16 op_pvq_search_avx2(celt_norm *_X, int *iy, int K, int N, int arch)
+{
+   int i, j;
+   int pulsesLeft;
+   opus_val32 sum;
+   opus_val32 xy;
+   opus_val16 yy;
+   VARDECL(celt_norm, y);
+   VARDECL(celt_norm, X);
+   VARDECL(opus_int16, signx);
+   __m256i sum8, lane_idx;
+   __m128i sum4;
+   SAVE_STACK;
+
+   (void)arch;
+   ALLOC(y, N+7, celt_norm);
+   ALLOC(X, N+7, celt_norm);
+   ALLOC(signx, N+7, opus_int16);
+
+   OPUS_COPY(X, _X, N);
+   for (j=N;j<N+7;j++)
+      X[j] = 0;
+
+   /* Get rid of the sign */
+   sum8 = _mm256_setzero_si256();
+   for (j=0;j<N;j+=8)
+   {
+      __m128i x8;
+      x8 = _mm_loadu_si128((__m128i*)&X[j]);
+      _mm_storeu_si128((__m128i*)&signx[j], _mm_srai_epi16(x8, 15));
+      x8 = _mm_abs_epi16(x8);
+      _mm_storeu_si128((__m128i*)&X[j], x8);
+      _mm_storeu_si128((__m128i*)&y[j], _mm_setzero_si128());
+      _mm256_storeu_si256((__m256i*)&iy[j], _mm256_setzero_si256());
+      sum8 = _mm256_add_epi32(sum8, _mm256_cvtepi16_epi32(x8));
+   }
+   sum4 = _mm_add_epi32(_mm256_castsi256_si128(sum8),
+         _mm256_extracti128_si256(sum8, 1));
+   sum4 = _mm_add_epi32(sum4, _mm_shuffle_epi32(sum4, _MM_SHUFFLE(1, 0, 3, 2)));
+   sum4 = _mm_add_epi32(sum4, _mm_shuffle_epi32(sum4, _MM_SHUFFLE(2, 3, 0, 1)));
+
+   xy = yy = 0;
+
+   pulsesLeft = K;
+
+   /* Do a pre-search by projecting on the pyramid */
+   if (K > (N>>1))
+   {
+      opus_val16 rcp;
+      __m256i rcp8, xy8, yy8, pulses_sum;
+      __m128i t4;
+      sum = _mm_cvtsi128_si32(sum4);
+      /* If X is too small, just replace it with a pulse at 0 */
+      if (sum <= K)
+      {
+         X[0] = QCONST16(1.f,14);
+         j=1; do
+            X[j]=0;
+         while (++j<N);
+         sum = QCONST16(1.f,14);
+      }
+      rcp = EXTRACT16(MULT16_32_Q16(K, celt_rcp(sum)));
+      rcp8 = _mm256_set1_epi32(rcp);
+      xy8 = yy8 = pulses_sum = _mm256_setzero_si256();
+      for (j=0;j<N;j+=8)
+      {
+         __m256i x8, iy8, y8;
+         x8 = load16_avx2(&X[j]);
+         /* It's really important to round *towards zero* here */
+         iy8 = _mm256_srai_epi32(_mm256_mullo_epi32(x8, rcp8), 15);
+         _mm256_storeu_si256((__m256i*)&iy[j], iy8);
+         pulses_sum = _mm256_add_epi32(pulses_sum, iy8);
+         y8 = extract16_avx2(iy8);
+         yy8 = _mm256_add_epi32(yy8, _mm256_mullo_epi32(y8, y8));
+         xy8 = _mm256_add_epi32(xy8, _mm256_mullo_epi32(x8, y8));
+         y8 = extract16_avx2(_mm256_add_epi32(y8, y8));
+         _mm_storeu_si128((__m128i*)&y[j], _mm256_castsi256_si128(
+               _mm256_permute4x64_epi64(_mm256_packs_epi32(y8, y8), 0x08)));
+      }
+      t4 = _mm_add_epi32(_mm256_castsi256_si128(pulses_sum),
+            _mm256_extracti128_si256(pulses_sum, 1));
+      t4 = _mm_add_epi32(t4, _mm_shuffle_epi32(t4, _MM_SHUFFLE(1, 0, 3, 2)));
+      t4 = _mm_add_epi32(t4, _mm_shuffle_epi32(t4, _MM_SHUFFLE(2, 3, 0, 1)));
+      pulsesLeft -= _mm_cvtsi128_si32(t4);
+      t4 = _mm_add_epi32(_mm256_castsi256_si128(xy8),
+            _mm256_extracti128_si256(xy8, 1));
+      t4 = _mm_add_epi32(t4, _mm_shuffle_epi32(t4, _MM_SHUFFLE(1, 0, 3, 2)));
+      t4 = _mm_add_epi32(t4, _mm_shuffle_epi32(t4, _MM_SHUFFLE(2, 3, 0, 1)));
+      xy = _mm_cvtsi128_si32(t4);
+      t4 = _mm_add_epi32(_mm256_castsi256_si128(yy8),
+            _mm256_extracti128_si256(yy8, 1));
+      t4 = _mm_add_epi32(t4, _mm_shuffle_epi32(t4, _MM_SHUFFLE(1, 0, 3, 2)));
+      t4 = _mm_add_epi32(t4, _mm_shuffle_epi32(t4, _MM_SHUFFLE(2, 3, 0, 1)));
+      yy = (opus_val16)_mm_cvtsi128_si32(t4);
+   }
+   celt_assert2(pulsesLeft>=0, "Allocated too many pulses in the quick pass");
+
+   /* This should never happen, but just in case it does (e.g. on silence)
+      we fill the first bin with pulses. */
+   if (pulsesLeft > N+3)
+   {
+      opus_val16 tmp = (opus_val16)pulsesLeft;
+      yy = MAC16_16(yy, tmp, tmp);
+      yy = MAC16_16(yy, tmp, y[0]);
+      iy[0] += pulsesLeft;
+      pulsesLeft=0;
+   }
+
+   lane_idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+   for (i=0;i<pulsesLeft;i++)
+   {
+      int best_id;
+      int rshift;
+      opus_val32 best_num;
+      opus_val16 best_den;
+      __m256i xy8, yy8, n8, idx, num, den, best_num8, best_den8, best_idx8;
+      __m128i sh;
+      opus_int32 lnum[8], lden[8], lidx[8];
+      rshift = 1+celt_ilog2(K-pulsesLeft+i+1);
+      /* The squared magnitude term gets added anyway, so we might as well
+         add it outside the loop */
+      yy = ADD16(yy, 1);
+      xy8 = _mm256_set1_epi32(xy);
+      yy8 = _mm256_set1_epi32(yy);
+      n8 = _mm256_set1_epi32(N);
+      sh = _mm_cvtsi32_si128(rshift);
+      idx = lane_idx;
+      best_num8 = best_den8 = best_idx8 = _mm256_setzero_si256();
+      for (j=0;j<N;j+=8)
+      {
+         __m256i rxy;
+         /* Temporary sums of the new pulse(s) */
+         rxy = extract16_avx2(_mm256_sra_epi32(
+               _mm256_add_epi32(xy8, load16_avx2(&X[j])), sh));
+         num = extract16_avx2(_mm256_srai_epi32(_mm256_mullo_epi32(rxy, rxy), 15));
+         /* We're multiplying y[j] by two so we don't have to do it here */
+         den = extract16_avx2(_mm256_add_epi32(yy8, load16_avx2(&y[j])));
+         if (j == 0)
+         {
+            best_num8 = num;
+            best_den8 = den;
+            best_idx8 = idx;
+         } else {
+            __m256i gt;
+            gt = _mm256_cmpgt_epi32(_mm256_mullo_epi32(best_den8, num),
+                  _mm256_mullo_epi32(den, best_num8));
+            /* Lanes past the end never replace a candidate. */
+            gt = _mm256_and_si256(gt, _mm256_cmpgt_epi32(n8, idx));
+            best_num8 = _mm256_blendv_epi8(best_num8, num, gt);
+            best_den8 = _mm256_blendv_epi8(best_den8, den, gt);
+            best_idx8 = _mm256_blendv_epi8(best_idx8, idx, gt);
+         }
+         idx = _mm256_add_epi32(idx, _mm256_set1_epi32(8));
+      }
+      _mm256_storeu_si256((__m256i*)lnum, best_num8);
+      _mm256_storeu_si256((__m256i*)lden, best_den8);
+      _mm256_storeu_si256((__m256i*)lidx, best_idx8);
+      best_num = lnum[0];
+      best_den = lden[0];
+      best_id = lidx[0];
+      for (j=1;j<8;j++)
+      {
+         opus_val32 a, b;
+         /* Only possible when N < 8 */
+         if (lidx[j] >= N)
+            break;
+         a = MULT16_16(best_den, lnum[j]);
+         b = MULT16_16(lden[j], best_num);
+         if (a > b || (a == b && lidx[j] < best_id))
+         {
+            best_den = lden[j];
+            best_num = lnum[j];
+            best_id = lidx[j];
+         }
+      }
+
+      /* Updating the sums of the new pulse(s) */
+      xy = ADD32(xy, EXTEND32(X[best_id]));
+      /* We're multiplying y[j] by two so we don't have to do it here */
+      yy = ADD16(yy, y[best_id]);
+
+      /* Only now that we've made the final choice, update y/iy */
+      /* Multiplying y[j] by 2 so we don't have to do it everywhere else */
+      y[best_id] += 2;
+      iy[best_id]++;
+   }
+
+   /* Put the original sign back */
+   for (j=0;j<N;j+=8)
+   {
+      __m256i y8, s8;
+      y8 = _mm256_loadu_si256((__m256i*)&iy[j]);
+      s8 = load16_avx2(&signx[j]);
+      y8 = _mm256_sub_epi32(_mm256_xor_si256(y8, s8), s8);
+      _mm256_storeu_si256((__m256i*)&iy[j], y8);
+   }
+   RESTORE_STACK;
+   return yy;
+}
+
+#endif
+
+#endif
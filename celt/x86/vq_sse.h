@@ -27,12 +27,24 @@
 #ifndef VQ_SSE_H
 #define VQ_SSE_H
 
-#if defined(OPUS_X86_MAY_HAVE_SSE2) && !defined(FIXED_POINT)
+#if (defined(OPUS_X86_MAY_HAVE_SSE2) && !defined(FIXED_POINT)) || \
+  defined(OPUS_X86_MAY_HAVE_AVX2)
 #define OVERRIDE_OP_PVQ_SEARCH
 
+#if !defined(FIXED_POINT)
 opus_val16 op_pvq_search_sse2(celt_norm *_X, int *iy, int K, int N, int arch);
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+opus_val16 op_pvq_search_avx2(celt_norm *_X, int *iy, int K, int N, int arch);
+#endif
+
+#if defined(OPUS_X86_PRESUME_AVX2)
+#define op_pvq_search(x, iy, K, N, arch) \
+    (op_pvq_search_avx2(x, iy, K, N, arch))
 
-#if defined(OPUS_X86_PRESUME_SSE2)
+#elif defined(OPUS_X86_PRESUME_SSE2) && !defined(FIXED_POINT) && \
+  !defined(OPUS_X86_MAY_HAVE_AVX2)
 #define op_pvq_search(x, iy, K, N, arch) \
     (op_pvq_search_sse2(x, iy, K, N, arch))
 
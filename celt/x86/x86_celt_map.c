@@ -34,12 +34,17 @@
 #include "pitch.h"
 #include "pitch_sse.h"
 #include "vq.h"
+#include "kiss_fft.h"
+#include "mdct.h"
+#include "bands.h"
+#include "celt.h"
 
 #if defined(OPUS_HAVE_RTCD)
 
 # if defined(FIXED_POINT)
 
-#if defined(OPUS_X86_MAY_HAVE_SSE4_1) && !defined(OPUS_X86_PRESUME_SSE4_1)
+#if (defined(OPUS_X86_MAY_HAVE_SSE4_1) && !defined(OPUS_X86_PRESUME_SSE4_1)) || \
+ (defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(OPUS_X86_PRESUME_AVX2))
 
 void (*const CELT_FIR_IMPL[OPUS_ARCHMASK + 1])(
          const opus_val16 *x,
@@ -53,7 +58,7 @@ void (*const CELT_FIR_IMPL[OPUS_ARCHMASK + 1])(
   celt_fir_c,
   celt_fir_c,
   MAY_HAVE_SSE4_1(celt_fir), /* sse4.1  */
-  MAY_HAVE_SSE4_1(celt_fir)  /* avx  */
+  MAY_HAVE_AVX2(celt_fir)    /* avx2  */
 };
 
 void (*const XCORR_KERNEL_IMPL[OPUS_ARCHMASK + 1])(
@@ -66,13 +71,14 @@ void (*const XCORR_KERNEL_IMPL[OPUS_ARCHMASK + 1])(
   xcorr_kernel_c,
   xcorr_kernel_c,
   MAY_HAVE_SSE4_1(xcorr_kernel), /* sse4.1  */
-  MAY_HAVE_SSE4_1(xcorr_kernel)  /* avx  */
+  MAY_HAVE_AVX2(xcorr_kernel)    /* avx2  */
 };
 
 #endif
 
 #if (defined(OPUS_X86_MAY_HAVE_SSE4_1) && !defined(OPUS_X86_PRESUME_SSE4_1)) ||  \
- (!defined(OPUS_X86_MAY_HAVE_SSE_4_1) && defined(OPUS_X86_MAY_HAVE_SSE2) && !defined(OPUS_X86_PRESUME_SSE2))
+ (!defined(OPUS_X86_MAY_HAVE_SSE_4_1) && defined(OPUS_X86_MAY_HAVE_SSE2) && !defined(OPUS_X86_PRESUME_SSE2)) || \
+ (defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(OPUS_X86_PRESUME_AVX2))
 
 opus_val32 (*const CELT_INNER_PROD_IMPL[OPUS_ARCHMASK + 1])(
          const opus_val16 *x,
@@ -83,14 +89,60 @@ opus_val32 (*const CELT_INNER_PROD_IMPL[OPUS_ARCHMASK + 1])(
   celt_inner_prod_c,
   MAY_HAVE_SSE2(celt_inner_prod),
   MAY_HAVE_SSE4_1(celt_inner_prod), /* sse4.1  */
-  MAY_HAVE_SSE4_1(celt_inner_prod)  /* avx  */
+  MAY_HAVE_AVX2(celt_inner_prod)    /* avx2  */
+};
+
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(OPUS_X86_PRESUME_AVX2)
+
+void (*const DUAL_INNER_PROD_IMPL[OPUS_ARCHMASK + 1])(
+                    const opus_val16 *x,
+                    const opus_val16 *y01,
+                    const opus_val16 *y02,
+                    int               N,
+                    opus_val32       *xy1,
+                    opus_val32       *xy2
+) = {
+  dual_inner_prod_c,                /* non-sse */
+  dual_inner_prod_c,
+  dual_inner_prod_c,
+  dual_inner_prod_c,
+  MAY_HAVE_AVX2(dual_inner_prod)    /* avx2  */
+};
+
+void (*const COMB_FILTER_CONST_IMPL[OPUS_ARCHMASK + 1])(
+              opus_val32 *y,
+              opus_val32 *x,
+              int         T,
+              int         N,
+              opus_val16  g10,
+              opus_val16  g11,
+              opus_val16  g12
+) = {
+  comb_filter_const_c,                /* non-sse */
+  comb_filter_const_c,
+  comb_filter_const_c,
+  comb_filter_const_c,
+  MAY_HAVE_AVX2(comb_filter_const)    /* avx2  */
+};
+
+opus_val16 (*const OP_PVQ_SEARCH_IMPL[OPUS_ARCHMASK + 1])(
+      celt_norm *_X, int *iy, int K, int N, int arch
+) = {
+  op_pvq_search_c,                /* non-sse */
+  op_pvq_search_c,
+  op_pvq_search_c,
+  op_pvq_search_c,
+  MAY_HAVE_AVX2(op_pvq_search)    /* avx2  */
 };
 
 #endif
 
 # else
 
-#if defined(OPUS_X86_MAY_HAVE_SSE) && !defined(OPUS_X86_PRESUME_SSE)
+#if (defined(OPUS_X86_MAY_HAVE_SSE) && !defined(OPUS_X86_PRESUME_SSE)) || \
+ (defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(OPUS_X86_PRESUME_AVX2))
 
 void (*const XCORR_KERNEL_IMPL[OPUS_ARCHMASK + 1])(
          const opus_val16 *x,
@@ -102,7 +154,7 @@ void (*const XCORR_KERNEL_IMPL[OPUS_ARCHMASK + 1])(
   MAY_HAVE_SSE(xcorr_kernel),
   MAY_HAVE_SSE(xcorr_kernel),
   MAY_HAVE_SSE(xcorr_kernel),
-  MAY_HAVE_SSE(xcorr_kernel)
+  MAY_HAVE_AVX2(xcorr_kernel)
 };
 
 opus_val32 (*const CELT_INNER_PROD_IMPL[OPUS_ARCHMASK + 1])(
@@ -114,7 +166,7 @@ opus_val32 (*const CELT_INNER_PROD_IMPL[OPUS_ARCHMASK + 1])(
   MAY_HAVE_SSE(celt_inner_prod),
   MAY_HAVE_SSE(celt_inner_prod),
   MAY_HAVE_SSE(celt_inner_prod),
-  MAY_HAVE_SSE(celt_inner_prod)
+  MAY_HAVE_AVX2(celt_inner_prod)
 };
 
 void (*const DUAL_INNER_PROD_IMPL[OPUS_ARCHMASK + 1])(
@@ -129,7 +181,7 @@ void (*const DUAL_INNER_PROD_IMPL[OPUS_ARCHMASK + 1])(
   MAY_HAVE_SSE(dual_inner_prod),
   MAY_HAVE_SSE(dual_inner_prod),
   MAY_HAVE_SSE(dual_inner_prod),
-  MAY_HAVE_SSE(dual_inner_prod)
+  MAY_HAVE_AVX2(dual_inner_prod)
 };
 
 void (*const COMB_FILTER_CONST_IMPL[OPUS_ARCHMASK + 1])(
@@ -145,13 +197,33 @@ void (*const COMB_FILTER_CONST_IMPL[OPUS_ARCHMASK + 1])(
   MAY_HAVE_SSE(comb_filter_const),
   MAY_HAVE_SSE(comb_filter_const),
   MAY_HAVE_SSE(comb_filter_const),
-  MAY_HAVE_SSE(comb_filter_const)
+  MAY_HAVE_AVX2(comb_filter_const)
 };
 
 
 #endif
 
-#if defined(OPUS_X86_MAY_HAVE_SSE2) && !defined(OPUS_X86_PRESUME_SSE2)
+#if defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(OPUS_X86_PRESUME_AVX2)
+
+void (*const CELT_FIR_IMPL[OPUS_ARCHMASK + 1])(
+         const opus_val16 *x,
+         const opus_val16 *num,
+         opus_val16       *y,
+         int              N,
+         int              ord,
+         int              arch
+) = {
+  celt_fir_c,                /* non-sse */
+  celt_fir_c,
+  celt_fir_c,
+  celt_fir_c,
+  MAY_HAVE_AVX2(celt_fir)    /* avx2  */
+};
+
+#endif
+
+#if (defined(OPUS_X86_MAY_HAVE_SSE2) && !defined(OPUS_X86_PRESUME_SSE2)) || \
+ (defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(OPUS_X86_PRESUME_AVX2))
 opus_val16 (*const OP_PVQ_SEARCH_IMPL[OPUS_ARCHMASK + 1])(
       celt_norm *_X, int *iy, int K, int N, int arch
 ) = {
@@ -159,9 +231,205 @@ opus_val16 (*const OP_PVQ_SEARCH_IMPL[OPUS_ARCHMASK + 1])(
   op_pvq_search_c,
   MAY_HAVE_SSE2(op_pvq_search),
   MAY_HAVE_SSE2(op_pvq_search),
-  MAY_HAVE_SSE2(op_pvq_search)
+  MAY_HAVE_AVX2(op_pvq_search)    /* avx2  */
 };
 #endif
 
+#endif
+
+#if (defined(OPUS_X86_MAY_HAVE_SSE2) && !defined(OPUS_X86_PRESUME_SSE2)) || \
+ (defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(OPUS_X86_PRESUME_AVX2))
+
+void (*const COMPUTE_BAND_ENERGIES_IMPL[OPUS_ARCHMASK + 1])(
+      const CELTMode *m, const celt_sig *X, celt_ener *bandE, int end, int C,
+      int LM, int arch
+) = {
+  compute_band_energies_c,                /* non-sse */
+  compute_band_energies_c,
+  MAY_HAVE_SSE2(compute_band_energies),
+  MAY_HAVE_SSE2(compute_band_energies),
+  MAY_HAVE_AVX2(compute_band_energies)    /* avx2  */
+};
+
+void (*const NORMALISE_BANDS_IMPL[OPUS_ARCHMASK + 1])(
+      const CELTMode *m, const celt_sig * OPUS_RESTRICT freq,
+      celt_norm * OPUS_RESTRICT X, const celt_ener *bandE, int end, int C,
+      int M, int arch
+) = {
+  normalise_bands_c,                /* non-sse */
+  normalise_bands_c,
+  MAY_HAVE_SSE2(normalise_bands),
+  MAY_HAVE_SSE2(normalise_bands),
+  MAY_HAVE_AVX2(normalise_bands)    /* avx2  */
+};
+
+void (*const DENORMALISE_BANDS_IMPL[OPUS_ARCHMASK + 1])(
+      const CELTMode *m, const celt_norm * OPUS_RESTRICT X,
+      celt_sig * OPUS_RESTRICT freq, const opus_val16 *bandE, int start,
+      int end, int M, int downsample, int silence, int arch
+) = {
+  denormalise_bands_c,                /* non-sse */
+  denormalise_bands_c,
+  MAY_HAVE_SSE2(denormalise_bands),
+  MAY_HAVE_SSE2(denormalise_bands),
+  MAY_HAVE_AVX2(denormalise_bands)    /* avx2  */
+};
+
+void (*const HAAR1_IMPL[OPUS_ARCHMASK + 1])(
+      celt_norm *X, int N0, int stride
+) = {
+  haar1_c,                /* non-sse */
+  haar1_c,
+  MAY_HAVE_SSE2(haar1),
+  MAY_HAVE_SSE2(haar1),
+  MAY_HAVE_AVX2(haar1)    /* avx2  */
+};
+
+opus_val32 (*const L1_METRIC_IMPL[OPUS_ARCHMASK + 1])(
+      const celt_norm *tmp, int N, int LM, opus_val16 bias
+) = {
+  l1_metric_c,                /* non-sse */
+  l1_metric_c,
+  MAY_HAVE_SSE2(l1_metric),
+  MAY_HAVE_SSE2(l1_metric),
+  MAY_HAVE_AVX2(l1_metric)    /* avx2  */
+};
+
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(OPUS_X86_PRESUME_AVX2)
+
+void (*const CELT_PREEMPHASIS_IMPL[OPUS_ARCHMASK + 1])(
+      const opus_val16 * OPUS_RESTRICT pcmp, celt_sig * OPUS_RESTRICT inp,
+      int N, int CC, int upsample, const opus_val16 *coef, celt_sig *mem,
+      int clip
+) = {
+  celt_preemphasis_c,                /* non-sse */
+  celt_preemphasis_c,
+  celt_preemphasis_c,
+  celt_preemphasis_c,
+  MAY_HAVE_AVX2(celt_preemphasis)    /* avx2  */
+};
+
+void (*const DEEMPHASIS_IMPL[OPUS_ARCHMASK + 1])(celt_sig *in[],
+      opus_val16 *pcm, int N, int C, int downsample, const opus_val16 *coef,
+      celt_sig *mem, int accum
+) = {
+  deemphasis_c,                /* non-sse */
+  deemphasis_c,
+  deemphasis_c,
+  deemphasis_c,
+  MAY_HAVE_AVX2(deemphasis)    /* avx2  */
+};
+
+void (*const TRANSIENT_MASKING_CURVE_IMPL[OPUS_ARCHMASK + 1])(
+      const opus_val32 * OPUS_RESTRICT in, opus_val16 * OPUS_RESTRICT tmp,
+      int len, int allow_weak_transients, opus_val32 *mean, opus_val16 *maxE
+) = {
+  transient_masking_curve_c,                /* non-sse */
+  transient_masking_curve_c,
+  transient_masking_curve_c,
+  transient_masking_curve_c,
+  MAY_HAVE_AVX2(transient_masking_curve)    /* avx2  */
+};
+
+# if !defined(SMALL_FOOTPRINT)
+void (*const CELT_IIR_IMPL[OPUS_ARCHMASK + 1])(
+         const opus_val32 *x,
+         const opus_val16 *den,
+         opus_val32       *y,
+         int              N,
+         int              ord,
+         opus_val16       *mem,
+         int              arch
+) = {
+  celt_iir_c,                /* non-sse */
+  celt_iir_c,
+  celt_iir_c,
+  celt_iir_c,
+  MAY_HAVE_AVX2(celt_iir)    /* avx2  */
+};
+# endif
+
+int (*const CELT_AUTOCORR_IMPL[OPUS_ARCHMASK + 1])(
+         const opus_val16 *x,
+         opus_val32       *ac,
+         const opus_val16 *window,
+         int              overlap,
+         int              lag,
+         int              n,
+         int              arch
+) = {
+  _celt_autocorr_c,                /* non-sse */
+  _celt_autocorr_c,
+  _celt_autocorr_c,
+  _celt_autocorr_c,
+  MAY_HAVE_AVX2(_celt_autocorr)    /* avx2  */
+};
+
+# if defined(CUSTOM_MODES)
+int (*const OPUS_FFT_ALLOC_ARCH_IMPL[OPUS_ARCHMASK+1])(kiss_fft_state *st) = {
+  opus_fft_alloc_arch_c,        /* non-sse */
+  opus_fft_alloc_arch_c,
+  opus_fft_alloc_arch_c,
+  opus_fft_alloc_arch_c,        /* sse4.1  */
+  opus_fft_alloc_arch_c         /* avx2  */
+};
+
+void (*const OPUS_FFT_FREE_ARCH_IMPL[OPUS_ARCHMASK+1])(kiss_fft_state *st) = {
+  opus_fft_free_arch_c,         /* non-sse */
+  opus_fft_free_arch_c,
+  opus_fft_free_arch_c,
+  opus_fft_free_arch_c,         /* sse4.1  */
+  opus_fft_free_arch_c          /* avx2  */
+};
+# endif /* CUSTOM_MODES */
+
+void (*const OPUS_FFT[OPUS_ARCHMASK+1])(const kiss_fft_state *cfg,
+                                        const kiss_fft_cpx *fin,
+                                        kiss_fft_cpx *fout) = {
+  opus_fft_c,                   /* non-sse */
+  opus_fft_c,
+  opus_fft_c,
+  opus_fft_c,                   /* sse4.1  */
+  MAY_HAVE_AVX2(opus_fft)       /* avx2  */
+};
+
+void (*const OPUS_IFFT[OPUS_ARCHMASK+1])(const kiss_fft_state *cfg,
+                                         const kiss_fft_cpx *fin,
+                                         kiss_fft_cpx *fout) = {
+  opus_ifft_c,                  /* non-sse */
+  opus_ifft_c,
+  opus_ifft_c,
+  opus_ifft_c,                  /* sse4.1  */
+  MAY_HAVE_AVX2(opus_ifft)      /* avx2  */
+};
+
+void (*const CLT_MDCT_FORWARD_IMPL[OPUS_ARCHMASK+1])(const mdct_lookup *l,
+                                                     kiss_fft_scalar *in,
+                                                     kiss_fft_scalar * OPUS_RESTRICT out,
+                                                     const opus_val16 *window,
+                                                     int overlap, int shift,
+                                                     int stride, int arch) = {
+  clt_mdct_forward_c,           /* non-sse */
+  clt_mdct_forward_c,
+  clt_mdct_forward_c,
+  clt_mdct_forward_c,           /* sse4.1  */
+  MAY_HAVE_AVX2(clt_mdct_forward) /* avx2  */
+};
+
+void (*const CLT_MDCT_BACKWARD_IMPL[OPUS_ARCHMASK+1])(const mdct_lookup *l,
+                                                      kiss_fft_scalar *in,
+                                                      kiss_fft_scalar * OPUS_RESTRICT out,
+                                                      const opus_val16 *window,
+                                                      int overlap, int shift,
+                                                      int stride, int arch) = {
+  clt_mdct_backward_c,          /* non-sse */
+  clt_mdct_backward_c,
+  clt_mdct_backward_c,
+  clt_mdct_backward_c,          /* sse4.1  */
+  MAY_HAVE_AVX2(clt_mdct_backward) /* avx2  */
+};
+
 #endif
 #endif
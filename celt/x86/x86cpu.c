@@ -38,7 +38,7 @@
 #if (defined(OPUS_X86_MAY_HAVE_SSE) && !defined(OPUS_X86_PRESUME_SSE)) || \
   (defined(OPUS_X86_MAY_HAVE_SSE2) && !defined(OPUS_X86_PRESUME_SSE2)) || \
   (defined(OPUS_X86_MAY_HAVE_SSE4_1) && !defined(OPUS_X86_PRESUME_SSE4_1)) || \
-  (defined(OPUS_X86_MAY_HAVE_AVX) && !defined(OPUS_X86_PRESUME_AVX))
+  (defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(OPUS_X86_PRESUME_AVX2))
 
 
 #if defined(_MSC_VER)
@@ -46,7 +46,12 @@
 #include <intrin.h>
 static _inline void cpuid(unsigned int CPUInfo[4], unsigned int InfoType)
 {
-    __cpuid((int*)CPUInfo, InfoType);
+    __cpuidex((int*)CPUInfo, InfoType, 0);
+}
+
+static _inline unsigned int xgetbv0(void)
+{
+    return (unsigned int)_xgetbv(0);
 }
 
 #else
@@ -68,7 +73,7 @@ static void cpuid(unsigned int CPUInfo[4], unsigned int InfoType)
         "=r" (CPUInfo[1]),
         "=c" (CPUInfo[2]),
         "=d" (CPUInfo[3]) :
-        "0" (InfoType)
+        "0" (InfoType), "2" (0)
     );
 #else
     __asm__ __volatile__ (
@@ -77,14 +82,31 @@ static void cpuid(unsigned int CPUInfo[4], unsigned int InfoType)
         "=b" (CPUInfo[1]),
         "=c" (CPUInfo[2]),
         "=d" (CPUInfo[3]) :
-        "0" (InfoType)
+        "0" (InfoType), "2" (0)
     );
 #endif
 #elif defined(CPU_INFO_BY_C)
-    __get_cpuid(InfoType, &(CPUInfo[0]), &(CPUInfo[1]), &(CPUInfo[2]), &(CPUInfo[3]));
+    /* Leaf 7 has sub-leaves, so always ask for sub-leaf 0. */
+    __cpuid_count(InfoType, 0, CPUInfo[0], CPUInfo[1], CPUInfo[2], CPUInfo[3]);
 #endif
 }
 
+/* Reads XCR0 to find out which register states the OS saves on a context
+   switch. The instruction is emitted as raw bytes so that we don't need
+   -mxsave for this file. */
+static unsigned int xgetbv0(void)
+{
+    unsigned int eax, edx;
+    __asm__ __volatile__ (
+        ".byte 0x0f, 0x01, 0xd0":
+        "=a" (eax),
+        "=d" (edx) :
+        "c" (0)
+    );
+    (void)edx;
+    return eax;
+}
+
 #endif
 
 typedef struct CPU_Feature{
@@ -93,7 +115,7 @@ typedef struct CPU_Feature{
     int HW_SSE2;
     int HW_SSE41;
     /*  SIMD: 256-bit */
-    int HW_AVX;
+    int HW_AVX2;
 } CPU_Feature;
 
 static void opus_cpu_feature_check(CPU_Feature *cpu_feature)
@@ -105,17 +127,26 @@ static void opus_cpu_feature_check(CPU_Feature *cpu_feature)
     nIds = info[0];
 
     if (nIds >= 1){
+        int avx_fma;
         cpuid(info, 1);
         cpu_feature->HW_SSE = (info[3] & (1 << 25)) != 0;
         cpu_feature->HW_SSE2 = (info[3] & (1 << 26)) != 0;
         cpu_feature->HW_SSE41 = (info[2] & (1 << 19)) != 0;
-        cpu_feature->HW_AVX = (info[2] & (1 << 28)) != 0;
+        /* AVX and FMA, plus OSXSAVE so that we can ask whether the OS
+           actually preserves the YMM registers. */
+        avx_fma = (info[2] & (1 << 28)) != 0 && (info[2] & (1 << 12)) != 0
+              && (info[2] & (1 << 27)) != 0 && (xgetbv0() & 0x6) == 0x6;
+        cpu_feature->HW_AVX2 = 0;
+        if (avx_fma && nIds >= 7) {
+            cpuid(info, 7);
+            cpu_feature->HW_AVX2 = (info[1] & (1 << 5)) != 0;
+        }
     }
     else {
         cpu_feature->HW_SSE = 0;
         cpu_feature->HW_SSE2 = 0;
         cpu_feature->HW_SSE41 = 0;
-        cpu_feature->HW_AVX = 0;
+        cpu_feature->HW_AVX2 = 0;
     }
 }
 
@@ -145,7 +176,7 @@ int opus_select_arch(void)
     }
     arch++;
 
-    if (!cpu_feature.HW_AVX)
+    if (!cpu_feature.HW_AVX2)
     {
         return arch;
     }
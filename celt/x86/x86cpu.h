@@ -46,10 +46,10 @@
 #  define MAY_HAVE_SSE4_1(name) name ## _c
 # endif
 
-# if defined(OPUS_X86_MAY_HAVE_AVX)
-#  define MAY_HAVE_AVX(name) name ## _avx
+# if defined(OPUS_X86_MAY_HAVE_AVX2)
+#  define MAY_HAVE_AVX2(name) name ## _avx2
 # else
-#  define MAY_HAVE_AVX(name) name ## _c
+#  define MAY_HAVE_AVX2(name) name ## _c
 # endif
 
 # if defined(OPUS_HAVE_RTCD)
@@ -62,34 +62,25 @@ int opus_select_arch(void);
   reference, these require 16-byte alignment and load a full 16 bytes (instead
   of 4 or 8), possibly reading out of bounds.
 
-  We can insert an explicit MOVD or MOVQ using _mm_cvtsi32_si128() or
-  _mm_loadl_epi64(), which should have the same semantics as an m32 or m64
-  reference in the PMOVSXWD instruction itself, but gcc is not smart enough to
-  optimize this out when optimizations ARE enabled.
+  We insert an explicit MOVD or MOVQ using _mm_cvtsi32_si128() or
+  _mm_loadl_epi64(), which has the same semantics as an m32 or m64 reference
+  in the PMOVSXWD instruction itself. Older gcc releases were not smart enough
+  to optimize this out when optimizations are enabled, so we used to
+  dereference a full __m128i there instead, but newer gcc releases (12 and
+  later) turn that dereference into an aligned MOVDQA even with optimizations
+  on, which faults on the unaligned pointers we pass in.
 
   Clang, in contrast, requires us to do this always for _mm_cvtepi8_epi32
   (which is fair, since technically the compiler is always allowed to do the
   dereference before invoking the function implementing the intrinsic).
-  However, it is smart enough to eliminate the extra MOVD instruction.
-  For _mm_cvtepi16_epi32, it does the right thing, though does *not* optimize out
-  the extra MOVQ if it's specified explicitly */
+  However, it is smart enough to eliminate the extra MOVD instruction. */
 
-# if defined(__clang__) || !defined(__OPTIMIZE__)
-#  define OP_CVTEPI8_EPI32_M32(x) \
+# define OP_CVTEPI8_EPI32_M32(x) \
  (_mm_cvtepi8_epi32(_mm_cvtsi32_si128(*(int *)(x))))
-# else
-#  define OP_CVTEPI8_EPI32_M32(x) \
- (_mm_cvtepi8_epi32(*(__m128i *)(x)))
-#endif
 
 /* similar reasoning about the instruction sequence as in the 32-bit macro above,
  */
-# if defined(__clang__) || !defined(__OPTIMIZE__)
-#  define OP_CVTEPI16_EPI32_M64(x) \
+# define OP_CVTEPI16_EPI32_M64(x) \
  (_mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i *)(x))))
-# else
-#  define OP_CVTEPI16_EPI32_M64(x) \
- (_mm_cvtepi16_epi32(*(__m128i *)(x)))
-# endif
 
 #endif
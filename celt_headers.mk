@@ -48,6 +48,11 @@ celt/mips/kiss_fft_mipsr1.h \
 celt/mips/mdct_mipsr1.h \
 celt/mips/pitch_mipsr1.h \
 celt/mips/vq_mipsr1.h \
+celt/x86/bands_sse.h \
+celt/x86/emphasis_sse.h \
+celt/x86/kiss_fft_sse.h \
+celt/x86/mdct_sse.h \
 celt/x86/pitch_sse.h \
+celt/x86/transient_sse.h \
 celt/x86/vq_sse.h \
 celt/x86/x86cpu.h
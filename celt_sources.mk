@@ -23,6 +23,7 @@ celt/x86/x86_celt_map.c \
 celt/x86/pitch_sse.c
 
 CELT_SOURCES_SSE2 = \
+celt/x86/bands_sse2.c \
 celt/x86/pitch_sse2.c \
 celt/x86/vq_sse2.c
 
@@ -30,6 +31,16 @@ CELT_SOURCES_SSE4_1 = \
 celt/x86/celt_lpc_sse4_1.c \
 celt/x86/pitch_sse4_1.c
 
+CELT_SOURCES_AVX2 = \
+celt/x86/bands_avx2.c \
+celt/x86/celt_lpc_avx2.c \
+celt/x86/emphasis_avx2.c \
+celt/x86/kiss_fft_avx2.c \
+celt/x86/mdct_avx2.c \
+celt/x86/pitch_avx2.c \
+celt/x86/transient_avx2.c \
+celt/x86/vq_avx2.c
+
 CELT_SOURCES_ARM = \
 celt/arm/armcpu.c \
 celt/arm/arm_celt_map.c
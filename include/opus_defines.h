@@ -34,6 +34,7 @@
 #define OPUS_DEFINES_H
 
 #include "opus_types.h"
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -778,6 +779,93 @@ OPUS_EXPORT const char *opus_strerror(int error);
 OPUS_EXPORT const char *opus_get_version_string(void);
 /**@}*/
 
+/** @defgroup opus_scratch_arena Scratch arena
+  *
+  * Builds configured with <code>--enable-scratch-arena</code> take the
+  * temporary buffers of every encode and decode call from a per-thread
+  * arena rather than from the stack. A thread can set its arena up front,
+  * possibly in memory it provides, and release it before it exits. A thread
+  * that calls into the library without an arena gets one allocated on its
+  * first call; that arena stays in place until the thread calls
+  * opus_scratch_arena_release(). If it cannot be allocated, that call fails
+  * with #OPUS_ALLOC_FAIL.
+  * @{
+  */
+
+/** Gets the size of the scratch arena each thread needs.
+  * @returns The size in bytes, or 0 if this build does not use a scratch arena.
+  */
+OPUS_EXPORT opus_int32 opus_scratch_arena_get_size(void);
+
+/** Sets up the scratch arena of the calling thread.
+  *
+  * Any arena the thread already had is released first. This must not be
+  * called from within a call into the library.
+  * @param[in] buf <tt>void*</tt>: Memory for the arena, which must stay valid
+  *                until opus_scratch_arena_release() is called, or NULL to
+  *                have the library allocate it
+  * @param[in] size <tt>opus_int32</tt>: Size of the arena in bytes, at least
+  *                 opus_scratch_arena_get_size()
+  * @returns #OPUS_OK on success, #OPUS_BAD_ARG if the arena is too small,
+  *          #OPUS_ALLOC_FAIL if it could not be allocated, or
+  *          #OPUS_UNIMPLEMENTED if this build does not use a scratch arena.
+  */
+OPUS_EXPORT int opus_scratch_arena_init(void *buf, opus_int32 size);
+
+/** Releases the scratch arena of the calling thread.
+  *
+  * An arena allocated by the library is freed; one supplied by the caller
+  * may be reused once this returns. Safe to call when the thread has no
+  * arena, and a no-op in builds that do not use one.
+  */
+OPUS_EXPORT void opus_scratch_arena_release(void);
+/**@}*/
+
+/** @defgroup opus_allocator Custom memory allocation
+  * @{
+  */
+
+/** Allocation callback used by opus_set_allocator().
+  *
+  * @param[in] user_data <tt>void*</tt>: The pointer passed to opus_set_allocator()
+  * @param[in] size <tt>size_t</tt>: Number of bytes to allocate
+  * @returns A block suitably aligned for any type, or NULL on failure
+  */
+typedef void *(*opus_alloc_func)(void *user_data, size_t size);
+
+/** Release callback used by opus_set_allocator().
+  *
+  * @param[in] user_data <tt>void*</tt>: The pointer passed to opus_set_allocator()
+  * @param[in] ptr <tt>void*</tt>: A block returned by the matching #opus_alloc_func,
+  *                never NULL
+  */
+typedef void (*opus_free_func)(void *user_data, void *ptr);
+
+/** Replaces the allocator used for all memory libopus allocates on its own.
+  *
+  * This covers the <code>*_create()</code> calls, custom mode creation and,
+  * in builds without variable-length arrays or alloca(), the scratch space
+  * used for temporaries. It has no effect on states the application
+  * allocates itself and initializes with <code>*_init()</code>.
+  *
+  * The allocator is global and is read without any locking. It must be set
+  * before any object is created or any scratch space is allocated, or once
+  * all objects have been destroyed and every scratch arena released, since
+  * each block is released through the allocator that is current at that
+  * point. It must not be changed while another thread is in the library.
+  *
+  * @param[in] alloc_fn <tt>opus_alloc_func</tt>: Allocation callback, or NULL
+  * @param[in] free_fn <tt>opus_free_func</tt>: Release callback, or NULL
+  * @param[in] user_data <tt>void*</tt>: Passed unchanged to both callbacks
+  * @returns #OPUS_OK on success, #OPUS_BAD_ARG if only one of the
+  *          callbacks is NULL, or #OPUS_UNIMPLEMENTED if the library was
+  *          built with its own opus_alloc()/opus_free() replacements.
+  *          Passing NULL for both restores malloc() and free().
+  */
+OPUS_EXPORT int opus_set_allocator(opus_alloc_func alloc_fn,
+      opus_free_func free_fn, void *user_data);
+/**@}*/
+
 #ifdef __cplusplus
 }
 #endif
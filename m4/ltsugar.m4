@@ -0,0 +1 @@
+/usr/share/aclocal/ltsugar.m4
\ No newline at end of file
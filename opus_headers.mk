@@ -5,4 +5,9 @@ src/opus_private.h \
 src/analysis.h \
 src/mapping_matrix.h \
 src/mlp.h \
-src/tansig_table.h
+src/tansig_table.h \
+src/x86/analysis_sse.h \
+src/x86/downmix_sse.h \
+src/x86/mapping_matrix_sse.h \
+src/x86/mlp_sse.h \
+src/x86/soft_clip_sse.h
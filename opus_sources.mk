@@ -13,3 +13,24 @@ OPUS_SOURCES_FLOAT = \
 src/analysis.c \
 src/mlp.c \
 src/mlp_data.c
+
+OPUS_SOURCES_SSE = \
+src/x86/x86_src_map.c
+
+OPUS_SOURCES_SSE2 = \
+src/x86/downmix_sse2.c \
+src/x86/mapping_matrix_sse2.c
+
+OPUS_SOURCES_AVX2 = \
+src/x86/downmix_avx2.c \
+src/x86/mapping_matrix_avx2.c
+
+OPUS_SOURCES_FLOAT_SSE2 = \
+src/x86/analysis_sse2.c \
+src/x86/mlp_sse2.c \
+src/x86/soft_clip_sse2.c
+
+OPUS_SOURCES_FLOAT_AVX2 = \
+src/x86/analysis_avx2.c \
+src/x86/mlp_avx2.c \
+src/x86/soft_clip_avx2.c
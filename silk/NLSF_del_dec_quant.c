@@ -42,6 +42,7 @@ opus_int32 silk_NLSF_del_dec_quant(                             /* O    Returns
     const opus_int              quant_step_size_Q16,            /* I    Quantization step size                      */
     const opus_int16            inv_quant_step_size_Q6,         /* I    Inverse quantization step size              */
     const opus_int32            mu_Q20,                         /* I    R/D tradeoff                                */
+    const opus_int32            RD_bound_Q25,                   /* I    Give up once every state reaches this RD    */
     const opus_int16            order                           /* I    Number of input values                      */
 )
 {
@@ -192,6 +193,16 @@ opus_int32 silk_NLSF_del_dec_quant(                             /* O    Returns
                 ind[ j ][ i ] += silk_RSHIFT( ind_sort[ j ], NLSF_QUANT_DEL_DEC_STATES_LOG2 );
             }
         }
+
+        /* RD values never decrease along a path, so once all states have reached the bound */
+        /* this search can no longer beat the caller's best result                           */
+        min_Q25 = RD_Q25[ 0 ];
+        for( j = 1; j < nStates; j++ ) {
+            min_Q25 = silk_min_32( min_Q25, RD_Q25[ j ] );
+        }
+        if( min_Q25 >= RD_bound_Q25 ) {
+            return silk_int32_MAX;
+        }
     }
 
     /* last sample: find winner, copy indices and return RD value */
@@ -81,10 +81,11 @@ void silk_decode_signs(
     const opus_int              sum_pulses[ MAX_NB_SHELL_BLOCKS ]   /* I    Sum of absolute pulses per block            */
 )
 {
-    opus_int         i, j, p;
+    opus_int         i, j, n, p, s, q;
     opus_uint8       icdf[ 2 ];
     opus_int16       *q_ptr;
     const opus_uint8 *icdf_ptr;
+    opus_uint8       nz[ SHELL_CODEC_FRAME_LENGTH ];
 
     icdf[ 1 ] = 0;
     q_ptr = pulses;
@@ -95,19 +96,17 @@ void silk_decode_signs(
         p = sum_pulses[ i ];
         if( p > 0 ) {
             icdf[ 0 ] = icdf_ptr[ silk_min( p & 0x1F, 6 ) ];
+            /* Gather the positions of the non-zero pulses without branching, most are zero */
+            n = 0;
             for( j = 0; j < SHELL_CODEC_FRAME_LENGTH; j++ ) {
-                if( q_ptr[ j ] > 0 ) {
-                    /* attach sign */
-#if 0
-                    /* conditional implementation */
-                    if( ec_dec_icdf( psRangeDec, icdf, 8 ) == 0 ) {
-                        q_ptr[ j ] = -q_ptr[ j ];
-                    }
-#else
-                    /* implementation with shift, subtraction, multiplication */
-                    q_ptr[ j ] *= silk_dec_map( ec_dec_icdf( psRangeDec, icdf, 8 ) );
-#endif
-                }
+                nz[ n ] = j;
+                n += q_ptr[ j ] > 0;
+            }
+            for( j = 0; j < n; j++ ) {
+                /* attach sign: a decoded 1 keeps the pulse and a 0 negates it, as silk_dec_map() */
+                s = ec_dec_icdf( psRangeDec, icdf, 8 ) - 1;
+                q = q_ptr[ nz[ j ] ];
+                q_ptr[ nz[ j ] ] = ( q ^ s ) - s;
             }
         }
         q_ptr += SHELL_CODEC_FRAME_LENGTH;
@@ -42,8 +42,9 @@ void silk_decode_pulses(
     const opus_int              frame_length                    /* I    Frame length                                */
 )
 {
-    opus_int   i, j, k, iter, abs_q, nLS, RateLevelIndex;
+    opus_int   i, j, k, iter, lsb, nLS, RateLevelIndex;
     opus_int   sum_pulses[ MAX_NB_SHELL_BLOCKS ], nLshifts[ MAX_NB_SHELL_BLOCKS ];
+    opus_int16 lsbs[ SHELL_CODEC_FRAME_LENGTH ];
     opus_int16 *pulses_ptr;
     const opus_uint8 *cdf_ptr;
 
@@ -95,13 +96,17 @@ void silk_decode_pulses(
         if( nLshifts[ i ] > 0 ) {
             nLS = nLshifts[ i ];
             pulses_ptr = &pulses[ silk_SMULBB( i, SHELL_CODEC_FRAME_LENGTH ) ];
+            /* The LSBs come sample by sample, MSB first; gather them apart from the shell
+               output so the merge below is a plain vector loop */
             for( k = 0; k < SHELL_CODEC_FRAME_LENGTH; k++ ) {
-                abs_q = pulses_ptr[ k ];
+                lsb = 0;
                 for( j = 0; j < nLS; j++ ) {
-                    abs_q = silk_LSHIFT( abs_q, 1 );
-                    abs_q += ec_dec_icdf( psRangeDec, silk_lsb_iCDF, 8 );
+                    lsb = silk_LSHIFT( lsb, 1 ) + ec_dec_icdf( psRangeDec, silk_lsb_iCDF, 8 );
                 }
-                pulses_ptr[ k ] = abs_q;
+                lsbs[ k ] = lsb;
+            }
+            for( k = 0; k < SHELL_CODEC_FRAME_LENGTH; k++ ) {
+                pulses_ptr[ k ] = silk_LSHIFT( pulses_ptr[ k ], nLS ) + lsbs[ k ];
             }
             /* Mark the number of pulses non-zero for sign decoding. */
             sum_pulses[ i ] |= nLS << 5;
@@ -0,0 +1,190 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#include <smmintrin.h>
+#ifdef OPUS_CHECK_ASM
+# include <string.h>
+#endif
+#include "main_FIX.h"
+#include "stack_alloc.h"
+
+/* Number of allpass sections handled per pass over the input */
+#define WARPED_BLOCK    8
+
+/* Four lanes of silk_SMULWB( a32, b32 ) */
+static OPUS_INLINE __m128i silk_SMULWB_epi32( __m128i a, __m128i b )
+{
+    __m128i even, odd;
+    even = _mm_srli_epi64( _mm_mul_epi32( a, b ), 16 );
+    odd  = _mm_slli_epi64( _mm_mul_epi32( _mm_srli_epi64( a, 32 ), b ), 16 );
+    return _mm_blend_epi16( even, odd, 0xCC );
+}
+
+/* Adds silk_RSHIFT64( silk_SMULL( y, x << QS ), 2 * QS - QC ) + 2^44 to the
+   even lanes of acc, with x in Q0. The bias keeps the sum non-negative so that a logical
+   shift can stand in for the missing 64-bit arithmetic one; it is removed
+   once at the end. */
+static OPUS_INLINE __m128i calc_corr( __m128i acc, __m128i y, __m128i x )
+{
+    const __m128i bias = _mm_set1_epi64x( (opus_int64)1 << 47 );
+    return _mm_add_epi64( acc, _mm_srli_epi64( _mm_add_epi64( _mm_mul_epi32( y, x ), bias ), 2 * QS - QC - QS ) );
+}
+
+/* Autocorrelations for a warped frequency axis */
+void silk_warped_autocorrelation_FIX_sse4_1(
+          opus_int32                *corr,                                  /* O    Result [order + 1]                                                          */
+          opus_int                  *scale,                                 /* O    Scaling of the correlation vector                                           */
+    const opus_int16                *input,                                 /* I    Input data to correlate                                                     */
+    const opus_int                  warping_Q16,                            /* I    Warping coefficient                                                         */
+    const opus_int                  length,                                 /* I    Length of input                                                             */
+    const opus_int                  order                                   /* I    Correlation order (even)                                                    */
+)
+{
+    opus_int   n, i, b, t, lsh, steps;
+    opus_int64 corr_QC[ MAX_SHAPE_LPC_ORDER + WARPED_BLOCK ];
+    opus_int64 bias_QC;
+    opus_int32 *state_QS, *input_rev;
+    __m128i    xmm_warping_Q16, xmm_acc;
+    VARDECL( opus_int32, state_QST );
+    VARDECL( opus_int32, input_revT );
+    SAVE_STACK;
+
+    /* Order must be even */
+    silk_assert( ( order & 1 ) == 0 );
+    silk_assert( 2 * QS - QC >= 0 );
+    silk_assert( order <= MAX_SHAPE_LPC_ORDER );
+
+    /* The allpass sections run as a wavefront: at step t, lane j of a block
+       of sections b + 1 ... b + WARPED_BLOCK holds the output of section
+       b + j + 1 for sample t - j. That only depends on lanes j - 1 and j of
+       the previous step and lane j - 1 of the step before, so each step is
+       a lane shift and one silk_SMLAWB() per lane, evaluated exactly as in
+       the C code. A block needs length + WARPED_BLOCK - 1 steps.
+
+       state_QS[ n ] is the output of section b for sample n, i.e. the input
+       of the current block. The block overwrites it in place, a few samples
+       behind, with the output of its last section for the next block.
+       Samples outside [ 0, length ) read as zero or are never used. */
+    steps = length + WARPED_BLOCK - 1;
+    ALLOC( state_QST, length + 2 * WARPED_BLOCK, opus_int32 );
+    ALLOC( input_revT, length + 2 * WARPED_BLOCK, opus_int32 );
+    state_QS = state_QST + WARPED_BLOCK;
+    /* input_rev[ -n ] = input[ n ], so that lane j can load sample t - j */
+    input_rev = input_revT + length + WARPED_BLOCK - 1;
+    silk_memset( state_QST, 0, ( length + 2 * WARPED_BLOCK ) * sizeof( opus_int32 ) );
+    silk_memset( input_revT, 0, ( length + 2 * WARPED_BLOCK ) * sizeof( opus_int32 ) );
+    for( n = 0; n < length; n++ ) {
+        state_QS[ n ] = silk_LSHIFT32( (opus_int32)input[ n ], QS );
+        input_rev[ -n ] = input[ n ];
+    }
+
+    /* Section 0 is the input itself */
+    xmm_acc = _mm_setzero_si128();
+    for( n = 0; n < length - 7; n += 8 ) {
+        __m128i xmm_x = _mm_loadu_si128( (__m128i *)&input[ n ] );
+        /* Each pair sum is at most 2^31, so it is taken as unsigned */
+        xmm_x = _mm_madd_epi16( xmm_x, xmm_x );
+        xmm_acc = _mm_add_epi64( xmm_acc, _mm_cvtepu32_epi64( xmm_x ) );
+        xmm_acc = _mm_add_epi64( xmm_acc, _mm_cvtepu32_epi64( _mm_unpackhi_epi64( xmm_x, xmm_x ) ) );
+    }
+    xmm_acc = _mm_add_epi64( xmm_acc, _mm_unpackhi_epi64( xmm_acc, xmm_acc ) );
+    _mm_storel_epi64( (__m128i *)&corr_QC[ 0 ], xmm_acc );
+    for( ; n < length; n++ ) {
+        corr_QC[ 0 ] += silk_SMULL( input[ n ], input[ n ] );
+    }
+    corr_QC[ 0 ] = silk_LSHIFT64( corr_QC[ 0 ], QC );
+
+    xmm_warping_Q16 = _mm_set1_epi32( (opus_int16)warping_Q16 );
+    bias_QC = silk_LSHIFT64( (opus_int64)steps, 47 - ( 2 * QS - QC - QS ) );
+    for( b = 0; b < order; b += WARPED_BLOCK ) {
+        __m128i xmm_P0, xmm_P1, xmm_Q0, xmm_Q1, xmm_S0, xmm_S1, xmm_in;
+        __m128i xmm_acc0, xmm_acc1, xmm_acc2, xmm_acc3;
+        opus_int64 acc_QC[ WARPED_BLOCK ];
+
+        xmm_P0 = xmm_P1 = xmm_Q0 = xmm_Q1 = _mm_setzero_si128();
+        xmm_acc0 = xmm_acc1 = xmm_acc2 = xmm_acc3 = _mm_setzero_si128();
+        for( t = 0; t < steps; t++ ) {
+            /* Previous step shifted up by one lane, with the block input for
+               sample t in lane 0 */
+            xmm_in = _mm_loadu_si128( (__m128i *)&state_QS[ t - 3 ] );
+            xmm_S0 = _mm_alignr_epi8( xmm_P0, xmm_in, 12 );
+            xmm_S1 = _mm_alignr_epi8( xmm_P1, xmm_P0, 12 );
+
+            /* Output of allpass section */
+            xmm_P0 = _mm_add_epi32( xmm_Q0, silk_SMULWB_epi32( _mm_sub_epi32( xmm_P0, xmm_S0 ), xmm_warping_Q16 ) );
+            xmm_P1 = _mm_add_epi32( xmm_Q1, silk_SMULWB_epi32( _mm_sub_epi32( xmm_P1, xmm_S1 ), xmm_warping_Q16 ) );
+            xmm_Q0 = xmm_S0;
+            xmm_Q1 = xmm_S1;
+
+            xmm_acc0 = calc_corr( xmm_acc0, xmm_P0, _mm_loadu_si128( (__m128i *)&input_rev[ -t ] ) );
+            xmm_acc1 = calc_corr( xmm_acc1, _mm_srli_epi64( xmm_P0, 32 ), _mm_loadu_si128( (__m128i *)&input_rev[ -t + 1 ] ) );
+            xmm_acc2 = calc_corr( xmm_acc2, xmm_P1, _mm_loadu_si128( (__m128i *)&input_rev[ -t + 4 ] ) );
+            xmm_acc3 = calc_corr( xmm_acc3, _mm_srli_epi64( xmm_P1, 32 ), _mm_loadu_si128( (__m128i *)&input_rev[ -t + 5 ] ) );
+
+            /* Last section, sample t - 7, becomes the next block's input */
+            state_QS[ t - ( WARPED_BLOCK - 1 ) ] = _mm_extract_epi32( xmm_P1, 3 );
+        }
+        _mm_storeu_si128( (__m128i *)&acc_QC[ 0 ], _mm_unpacklo_epi64( xmm_acc0, xmm_acc1 ) );
+        _mm_storeu_si128( (__m128i *)&acc_QC[ 2 ], _mm_unpackhi_epi64( xmm_acc0, xmm_acc1 ) );
+        _mm_storeu_si128( (__m128i *)&acc_QC[ 4 ], _mm_unpacklo_epi64( xmm_acc2, xmm_acc3 ) );
+        _mm_storeu_si128( (__m128i *)&acc_QC[ 6 ], _mm_unpackhi_epi64( xmm_acc2, xmm_acc3 ) );
+        for( i = 0; i < WARPED_BLOCK; i++ ) {
+            corr_QC[ b + i + 1 ] = acc_QC[ i ] - bias_QC;
+        }
+    }
+
+    lsh = silk_CLZ64( corr_QC[ 0 ] ) - 35;
+    lsh = silk_LIMIT( lsh, -12 - QC, 30 - QC );
+    *scale = -( QC + lsh );
+    silk_assert( *scale >= -30 && *scale <= 12 );
+    if( lsh >= 0 ) {
+        for( i = 0; i < order + 1; i++ ) {
+            corr[ i ] = (opus_int32)silk_CHECK_FIT32( silk_LSHIFT64( corr_QC[ i ], lsh ) );
+        }
+    } else {
+        for( i = 0; i < order + 1; i++ ) {
+            corr[ i ] = (opus_int32)silk_CHECK_FIT32( silk_RSHIFT64( corr_QC[ i ], -lsh ) );
+        }
+    }
+    silk_assert( corr_QC[ 0 ] >= 0 ); /* If breaking, decrease QC*/
+    RESTORE_STACK;
+
+#ifdef OPUS_CHECK_ASM
+    {
+        opus_int32 corr_c[ MAX_SHAPE_LPC_ORDER + 1 ];
+        opus_int   scale_c;
+        silk_warped_autocorrelation_FIX_c( corr_c, &scale_c, input, warping_Q16, length, order );
+        silk_assert( !memcmp( corr_c, corr, sizeof( corr_c[ 0 ] ) * ( order + 1 ) ) );
+        silk_assert( scale_c == *scale );
+    }
+#endif
+}
@@ -0,0 +1,354 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "main_FLP.h"
+#include "stack_alloc.h"
+#include "NSQ_FLP.h"
+
+#ifdef ENABLE_FLOAT_NSQ
+
+/* Floating-point version of silk_NSQ(). It runs the same noise shaping
+   quantizer as the fixed-point code, in the domain of the input scaled by
+   1/Gain, but directly on the float control parameters and input, so none
+   of them need to be converted to Q-format first. Not bit-exact with the
+   fixed-point quantizer. */
+
+static OPUS_INLINE void silk_nsq_scale_states_FLP(
+    const silk_encoder_state        *psEncC,            /* I    Encoder State                               */
+    silk_nsq_state                  *NSQ,               /* I/O  NSQ state                                   */
+    const silk_float                x[],                /* I    Input                                       */
+    silk_float                      x_sc[],             /* O    Input scaled with 1/Gain                    */
+    const silk_float                sLTP[],             /* I    Re-whitened LTP state                       */
+    silk_float                      sLTP_sc[],          /* O    LTP state matching scaled input             */
+    opus_int                        subfr,              /* I    Subframe number                             */
+    const silk_float                LTP_scale,          /* I    LTP state scaling                           */
+    const silk_float                Gains[],            /* I    Quantization gains                          */
+    const opus_int                  pitchL[],           /* I    Pitch lags                                  */
+    const opus_int                  signal_type         /* I    Signal type                                 */
+)
+{
+    opus_int   i, lag;
+    opus_int32 Gain_Q16;
+    silk_float inv_gain, gain_adj;
+
+    lag      = pitchL[ subfr ];
+    inv_gain = 1.0f / silk_max_float( Gains[ subfr ], 1.0f / 65536.0f );
+
+    /* Scale input */
+    for( i = 0; i < psEncC->subfr_length; i++ ) {
+        x_sc[ i ] = x[ i ] * inv_gain;
+    }
+
+    /* After rewhitening the LTP state is un-scaled, so scale with inv_gain */
+    if( NSQ->rewhite_flag ) {
+        if( subfr == 0 ) {
+            /* Do LTP downscaling */
+            inv_gain *= LTP_scale;
+        }
+        for( i = NSQ->sLTP_buf_idx - lag - LTP_ORDER / 2; i < NSQ->sLTP_buf_idx; i++ ) {
+            silk_assert( i < MAX_FRAME_LENGTH );
+            sLTP_sc[ i ] = inv_gain * sLTP[ i ];
+        }
+    }
+
+    /* Adjust for changing gain */
+    Gain_Q16 = silk_float2int( Gains[ subfr ] * 65536.0f );
+    if( Gain_Q16 != NSQ->prev_gain_Q16 ) {
+        gain_adj = (silk_float)NSQ->prev_gain_Q16 / (silk_float)Gain_Q16;
+
+        /* Scale long-term shaping state */
+        for( i = NSQ->sLTP_shp_buf_idx - psEncC->ltp_mem_length; i < NSQ->sLTP_shp_buf_idx; i++ ) {
+            NSQ->sLTP_shp_FLP[ i ] *= gain_adj;
+        }
+
+        /* Scale long-term prediction state */
+        if( signal_type == TYPE_VOICED && NSQ->rewhite_flag == 0 ) {
+            for( i = NSQ->sLTP_buf_idx - lag - LTP_ORDER / 2; i < NSQ->sLTP_buf_idx; i++ ) {
+                sLTP_sc[ i ] *= gain_adj;
+            }
+        }
+
+        NSQ->sLF_AR_shp_FLP *= gain_adj;
+        NSQ->sDiff_shp_FLP  *= gain_adj;
+
+        /* Scale short-term prediction and shaping states */
+        for( i = 0; i < NSQ_LPC_BUF_LENGTH; i++ ) {
+            NSQ->sLPC_FLP[ i ] *= gain_adj;
+        }
+        for( i = 0; i < MAX_SHAPE_LPC_ORDER; i++ ) {
+            NSQ->sAR2_FLP[ i ] *= gain_adj;
+        }
+
+        /* Save gain */
+        NSQ->prev_gain_Q16 = Gain_Q16;
+    }
+}
+
+static OPUS_INLINE void silk_noise_shape_quantizer_FLP(
+    silk_nsq_state                  *NSQ,               /* I/O  NSQ state                                   */
+    opus_int                        signalType,         /* I    Signal type                                 */
+    const silk_float                x_sc[],             /* I    Scaled input                                */
+    opus_int8                       pulses[],           /* O    Quantized pulse signal                      */
+    silk_float                      xq[],               /* O    Quantized output signal                     */
+    silk_float                      sLTP_sc[],          /* I/O  LTP state                                   */
+    const silk_float                a[],                /* I    Short term prediction coefs                 */
+    const silk_float                b[],                /* I    Long term prediction coefs                  */
+    const silk_float                AR_shp[],           /* I    Noise shaping AR coefs                      */
+    opus_int                        lag,                /* I    Pitch lag                                   */
+    silk_float                      HarmShapeGain,      /* I    Long term shaping gain                      */
+    silk_float                      Tilt,               /* I    Spectral tilt                               */
+    silk_float                      LF_MA_shp,          /* I    Low frequency MA shaping coef               */
+    silk_float                      LF_AR_shp,          /* I    Low frequency AR shaping coef               */
+    silk_float                      Gain,               /* I    Quantization gain                           */
+    silk_float                      Lambda,             /* I    Rate/distortion tradeoff                    */
+    silk_float                      offset,             /* I    Quantization offset                         */
+    opus_int                        length,             /* I    Input length                                */
+    opus_int                        shapingLPCOrder,    /* I    Noise shaping AR filter order               */
+    opus_int                        predictLPCOrder     /* I    Prediction filter order                     */
+)
+{
+    opus_int   i, j, q1_Q0;
+    silk_float LTP_pred, LPC_pred, n_AR, n_LF, n_LTP, r, q1, q2, rd1, rd2;
+    silk_float exc, LPC_exc, xq_sc, rdo_offset, tmp;
+    silk_float *psLPC, *shp_lag_ptr, *pred_lag_ptr;
+
+    shp_lag_ptr  = &NSQ->sLTP_shp_FLP[ NSQ->sLTP_shp_buf_idx - lag + HARM_SHAPE_FIR_TAPS / 2 ];
+    pred_lag_ptr = &sLTP_sc[ NSQ->sLTP_buf_idx - lag + LTP_ORDER / 2 ];
+    rdo_offset   = 0.5f * Lambda - 0.5f;
+
+    /* Set up short term AR state */
+    psLPC = &NSQ->sLPC_FLP[ NSQ_LPC_BUF_LENGTH - 1 ];
+
+    for( i = 0; i < length; i++ ) {
+        /* Generate dither */
+        NSQ->rand_seed = silk_RAND( NSQ->rand_seed );
+
+        /* Short-term prediction */
+        LPC_pred = 0.0f;
+        for( j = 0; j < predictLPCOrder; j++ ) {
+            LPC_pred += psLPC[ -j ] * a[ j ];
+        }
+
+        /* Long-term prediction */
+        if( signalType == TYPE_VOICED ) {
+            LTP_pred = pred_lag_ptr[  0 ] * b[ 0 ] + pred_lag_ptr[ -1 ] * b[ 1 ] + pred_lag_ptr[ -2 ] * b[ 2 ]
+                     + pred_lag_ptr[ -3 ] * b[ 3 ] + pred_lag_ptr[ -4 ] * b[ 4 ];
+            pred_lag_ptr++;
+        } else {
+            LTP_pred = 0.0f;
+        }
+
+        /* Noise shape feedback */
+        silk_assert( ( shapingLPCOrder & 1 ) == 0 );   /* check that order is even */
+        for( j = shapingLPCOrder - 1; j > 0; j-- ) {
+            NSQ->sAR2_FLP[ j ] = NSQ->sAR2_FLP[ j - 1 ];
+        }
+        NSQ->sAR2_FLP[ 0 ] = NSQ->sDiff_shp_FLP;
+        n_AR = 0.0f;
+        for( j = 0; j < shapingLPCOrder; j++ ) {
+            n_AR += NSQ->sAR2_FLP[ j ] * AR_shp[ j ];
+        }
+        n_AR += NSQ->sLF_AR_shp_FLP * Tilt;
+
+        n_LF = NSQ->sLTP_shp_FLP[ NSQ->sLTP_shp_buf_idx - 1 ] * LF_MA_shp + NSQ->sLF_AR_shp_FLP * LF_AR_shp;
+
+        silk_assert( lag > 0 || signalType != TYPE_VOICED );
+
+        /* Combine prediction and noise shaping signals */
+        tmp = LPC_pred - n_AR - n_LF;
+        if( lag > 0 ) {
+            /* Symmetric FIR coefficients */
+            n_LTP = HarmShapeGain * ( 0.25f * ( shp_lag_ptr[ 0 ] + shp_lag_ptr[ -2 ] ) + 0.5f * shp_lag_ptr[ -1 ] );
+            shp_lag_ptr++;
+            tmp += LTP_pred - n_LTP;
+        }
+
+        r = x_sc[ i ] - tmp;                                    /* residual error */
+
+        /* Flip sign depending on dither */
+        if( NSQ->rand_seed < 0 ) {
+            r = -r;
+        }
+        r = silk_LIMIT( r, -31.0f, 30.0f );
+
+        /* Find two quantization level candidates and measure their rate-distortion */
+        q1 = r - offset;
+        /* Rounds toward -inf, since q1 > -32 */
+        q1_Q0 = (opus_int)( q1 + 32.0f ) - 32;
+        if( Lambda > 2.0f ) {
+            /* For aggressive RDO, the bias becomes more than one pulse. */
+            if( q1 > rdo_offset ) {
+                q1_Q0 = (opus_int)( q1 - rdo_offset );
+            } else if( q1 < -rdo_offset ) {
+                q1_Q0 = (opus_int)( q1 + rdo_offset + 32.0f ) - 32;
+            } else if( q1 < 0 ) {
+                q1_Q0 = -1;
+            } else {
+                q1_Q0 = 0;
+            }
+        }
+        q1  = silk_nsq_level_FLP( q1_Q0 ) + offset;
+        q2  = silk_nsq_level_FLP( q1_Q0 + 1 ) + offset;
+        rd1 = silk_abs_float( q1 ) * Lambda + ( r - q1 ) * ( r - q1 );
+        rd2 = silk_abs_float( q2 ) * Lambda + ( r - q2 ) * ( r - q2 );
+
+        if( rd2 < rd1 ) {
+            q1 = q2;
+            q1_Q0++;
+        }
+
+        pulses[ i ] = (opus_int8)q1_Q0;
+
+        /* Excitation */
+        exc = q1;
+        if( NSQ->rand_seed < 0 ) {
+            exc = -exc;
+        }
+
+        /* Add predictions */
+        LPC_exc = exc + LTP_pred;
+        xq_sc   = LPC_exc + LPC_pred;
+
+        /* Scale XQ back to normal level before saving */
+        xq[ i ] = silk_LIMIT( xq_sc * Gain, -32768.0f, 32767.0f );
+
+        /* Update states */
+        psLPC++;
+        *psLPC = xq_sc;
+        NSQ->sDiff_shp_FLP  = xq_sc - x_sc[ i ];
+        NSQ->sLF_AR_shp_FLP = NSQ->sDiff_shp_FLP - n_AR;
+
+        NSQ->sLTP_shp_FLP[ NSQ->sLTP_shp_buf_idx ] = NSQ->sLF_AR_shp_FLP - n_LF;
+        sLTP_sc[ NSQ->sLTP_buf_idx ] = LPC_exc;
+        NSQ->sLTP_shp_buf_idx++;
+        NSQ->sLTP_buf_idx++;
+
+        /* Make dither dependent on quantized signal */
+        NSQ->rand_seed = silk_ADD32_ovflw( NSQ->rand_seed, pulses[ i ] );
+    }
+
+    /* Update LPC synth buffer */
+    silk_memcpy( NSQ->sLPC_FLP, &NSQ->sLPC_FLP[ length ], NSQ_LPC_BUF_LENGTH * sizeof( silk_float ) );
+}
+
+void silk_NSQ_FLP(
+    silk_encoder_state_FLP          *psEnc,             /* I    Encoder state FLP                           */
+    silk_encoder_control_FLP        *psEncCtrl,         /* I    Encoder control FLP                         */
+    SideInfoIndices                 *psIndices,         /* I/O  Quantization indices                        */
+    silk_nsq_state                  *NSQ,               /* I/O  Noise Shaping Quantzation state             */
+    opus_int8                       pulses[],           /* O    Quantized pulse signal                      */
+    const silk_float                x[]                 /* I    Prefiltered input signal                    */
+)
+{
+    opus_int            k, lag, start_idx, LSF_interpolation_flag;
+    const silk_encoder_state *psEncC = &psEnc->sCmn;
+    const silk_float    *A, *B, *AR_shp;
+    silk_float          *pxq;
+    VARDECL( silk_float, sLTP_sc );
+    VARDECL( silk_float, sLTP );
+    silk_float          offset, LTP_scale;
+    VARDECL( silk_float, x_sc );
+    SAVE_STACK;
+
+    NSQ->rand_seed = psIndices->Seed;
+
+    /* Set unvoiced lag to the previous one, overwrite later for voiced */
+    lag = NSQ->lagPrev;
+
+    silk_assert( NSQ->prev_gain_Q16 != 0 );
+
+    offset = silk_Quantization_Offsets_Q10[ psIndices->signalType >> 1 ][ psIndices->quantOffsetType ] * ( 1.0f / 1024.0f );
+
+    if( psIndices->signalType == TYPE_VOICED ) {
+        LTP_scale = silk_LTPScales_table_Q14[ psIndices->LTP_scaleIndex ] * ( 1.0f / 16384.0f );
+    } else {
+        LTP_scale = 0.0f;
+    }
+
+    if( psIndices->NLSFInterpCoef_Q2 == 4 ) {
+        LSF_interpolation_flag = 0;
+    } else {
+        LSF_interpolation_flag = 1;
+    }
+
+    ALLOC( sLTP_sc, psEncC->ltp_mem_length + psEncC->frame_length, silk_float );
+    ALLOC( sLTP, psEncC->ltp_mem_length + psEncC->frame_length, silk_float );
+    ALLOC( x_sc, psEncC->subfr_length, silk_float );
+    /* Set up pointers to start of sub frame */
+    NSQ->sLTP_shp_buf_idx = psEncC->ltp_mem_length;
+    NSQ->sLTP_buf_idx     = psEncC->ltp_mem_length;
+    pxq                   = &NSQ->xq_FLP[ psEncC->ltp_mem_length ];
+    for( k = 0; k < psEncC->nb_subfr; k++ ) {
+        A      = psEncCtrl->PredCoef[ ( k >> 1 ) | ( 1 - LSF_interpolation_flag ) ];
+        B      = &psEncCtrl->LTPCoef[ k * LTP_ORDER ];
+        AR_shp = &psEncCtrl->AR[ k * MAX_SHAPE_LPC_ORDER ];
+
+        NSQ->rewhite_flag = 0;
+        if( psIndices->signalType == TYPE_VOICED ) {
+            /* Voiced */
+            lag = psEncCtrl->pitchL[ k ];
+
+            /* Re-whitening */
+            if( ( k & ( 3 - silk_LSHIFT( LSF_interpolation_flag, 1 ) ) ) == 0 ) {
+                /* Rewhiten with new A coefs */
+                start_idx = psEncC->ltp_mem_length - lag - psEncC->predictLPCOrder - LTP_ORDER / 2;
+                silk_assert( start_idx > 0 );
+
+                silk_LPC_analysis_filter_FLP( &sLTP[ start_idx ], A, &NSQ->xq_FLP[ start_idx + k * psEncC->subfr_length ],
+                    psEncC->ltp_mem_length - start_idx, psEncC->predictLPCOrder );
+
+                NSQ->rewhite_flag = 1;
+                NSQ->sLTP_buf_idx = psEncC->ltp_mem_length;
+            }
+        }
+
+        silk_nsq_scale_states_FLP( psEncC, NSQ, x, x_sc, sLTP, sLTP_sc, k, LTP_scale, psEncCtrl->Gains,
+            psEncCtrl->pitchL, psIndices->signalType );
+
+        silk_noise_shape_quantizer_FLP( NSQ, psIndices->signalType, x_sc, pulses, pxq, sLTP_sc, A, B,
+            AR_shp, lag, psEncCtrl->HarmShapeGain[ k ], psEncCtrl->Tilt[ k ], psEncCtrl->LF_MA_shp[ k ],
+            psEncCtrl->LF_AR_shp[ k ], psEncCtrl->Gains[ k ], psEncCtrl->Lambda, offset, psEncC->subfr_length,
+            psEncC->shapingLPCOrder, psEncC->predictLPCOrder );
+
+        x      += psEncC->subfr_length;
+        pulses += psEncC->subfr_length;
+        pxq    += psEncC->subfr_length;
+    }
+
+    /* Update lagPrev for next frame */
+    NSQ->lagPrev = psEncCtrl->pitchL[ psEncC->nb_subfr - 1 ];
+
+    /* Save quantized speech and noise shaping signals */
+    silk_memmove( NSQ->xq_FLP,       &NSQ->xq_FLP[       psEncC->frame_length ], psEncC->ltp_mem_length * sizeof( silk_float ) );
+    silk_memmove( NSQ->sLTP_shp_FLP, &NSQ->sLTP_shp_FLP[ psEncC->frame_length ], psEncC->ltp_mem_length * sizeof( silk_float ) );
+    RESTORE_STACK;
+}
+
+#endif /* ENABLE_FLOAT_NSQ */
@@ -0,0 +1,154 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SILK_NSQ_FLP_H
+#define SILK_NSQ_FLP_H
+
+#include "main_FLP.h"
+
+#ifdef ENABLE_FLOAT_NSQ
+
+#define QUANT_LEVEL_ADJUST_FLP                  ( QUANT_LEVEL_ADJUST_Q10 * ( 1.0f / 1024.0f ) )
+
+/* Penalty added to the rate-distortion of states that lost the decision */
+#define NSQ_DEL_DEC_PENALTY_FLP                 ( ( silk_int32_MAX >> 4 ) * ( 1.0f / 1024.0f ) )
+
+/* Reconstruction level for q_Q0 pulses, before adding the quantization offset */
+static OPUS_INLINE silk_float silk_nsq_level_FLP( opus_int q_Q0 )
+{
+    if( q_Q0 > 0 ) {
+        return (silk_float)q_Q0 - QUANT_LEVEL_ADJUST_FLP;
+    } else if( q_Q0 == 0 ) {
+        return 0.0f;
+    } else {
+        return (silk_float)q_Q0 + QUANT_LEVEL_ADJUST_FLP;
+    }
+}
+
+/* Delayed decision states, with the states interleaved in the innermost */
+/* dimension so that all of them can be updated with one vector.         */
+typedef struct {
+    silk_float sLPC[      MAX_SUB_FRAME_LENGTH + NSQ_LPC_BUF_LENGTH ][ MAX_DEL_DEC_STATES ];
+    opus_int32 RandState[ DECISION_DELAY ][      MAX_DEL_DEC_STATES ];
+    opus_int32 Q[         DECISION_DELAY ][      MAX_DEL_DEC_STATES ];
+    silk_float Xq[        DECISION_DELAY ][      MAX_DEL_DEC_STATES ];
+    silk_float Pred[      DECISION_DELAY ][      MAX_DEL_DEC_STATES ];
+    silk_float Shape[     DECISION_DELAY ][      MAX_DEL_DEC_STATES ];
+    silk_float sAR2[      MAX_SHAPE_LPC_ORDER ][ MAX_DEL_DEC_STATES ];
+    silk_float LF_AR[     MAX_DEL_DEC_STATES ];
+    silk_float Diff[      MAX_DEL_DEC_STATES ];
+    opus_int32 Seed[      MAX_DEL_DEC_STATES ];
+    opus_int32 SeedInit[  MAX_DEL_DEC_STATES ];
+    silk_float RD[        MAX_DEL_DEC_STATES ];
+} NSQ_del_dec_FLP_struct;
+
+/* Best (0) and second best (1) quantization of the current sample */
+typedef struct {
+    opus_int32 Q[         MAX_DEL_DEC_STATES ];
+    silk_float RD[        MAX_DEL_DEC_STATES ];
+    silk_float xq[        MAX_DEL_DEC_STATES ];
+    silk_float LF_AR[     MAX_DEL_DEC_STATES ];
+    silk_float Diff[      MAX_DEL_DEC_STATES ];
+    silk_float sLTP_shp[  MAX_DEL_DEC_STATES ];
+    silk_float LPC_exc[   MAX_DEL_DEC_STATES ];
+} NSQ_sample_FLP_struct;
+
+void silk_noise_shape_quantizer_del_dec_FLP_c(
+    silk_nsq_state                  *NSQ,                   /* I/O  NSQ state                               */
+    NSQ_del_dec_FLP_struct          *psDelDec,              /* I/O  Delayed decision states                 */
+    opus_int                        signalType,             /* I    Signal type                             */
+    const silk_float                x_sc[],                 /* I    Scaled input                            */
+    opus_int8                       pulses[],               /* O    Quantized pulse signal                  */
+    silk_float                      xq[],                   /* O    Quantized output signal                 */
+    silk_float                      sLTP_sc[],              /* I/O  LTP filter state                        */
+    silk_float                      delayedGain[],          /* I/O  Gain delay buffer                       */
+    const silk_float                a[],                    /* I    Short term prediction coefs             */
+    const silk_float                b[],                    /* I    Long term prediction coefs              */
+    const silk_float                AR_shp[],               /* I    Noise shaping coefs                     */
+    opus_int                        lag,                    /* I    Pitch lag                               */
+    silk_float                      HarmShapeGain,          /* I    Long term shaping gain                  */
+    silk_float                      Tilt,                   /* I    Spectral tilt                           */
+    silk_float                      LF_MA_shp,              /* I    Low frequency MA shaping coef           */
+    silk_float                      LF_AR_shp,              /* I    Low frequency AR shaping coef           */
+    silk_float                      Gain,                   /* I    Quantization gain                       */
+    silk_float                      Lambda,                 /* I    Rate/distortion tradeoff                */
+    silk_float                      offset,                 /* I    Quantization offset                     */
+    opus_int                        length,                 /* I    Input length                            */
+    opus_int                        subfr,                  /* I    Subframe number                         */
+    opus_int                        shapingLPCOrder,        /* I    Shaping LPC filter order                */
+    opus_int                        predictLPCOrder,        /* I    Prediction filter order                 */
+    silk_float                      warping,                /* I    Warping coefficient                     */
+    opus_int                        nStatesDelayedDecision, /* I    Number of states in decision tree       */
+    opus_int                        *smpl_buf_idx,          /* I/O  Index to newest samples in buffers      */
+    opus_int                        decisionDelay           /* I    Decision delay                          */
+);
+
+/* Copies state 'from' to state 'to', skipping the first i entries of the */
+/* short-term state that are no longer used in the current subframe.     */
+static OPUS_INLINE void silk_nsq_del_dec_copy_state_FLP(
+    NSQ_del_dec_FLP_struct          *psDelDec,
+    opus_int                        to,
+    opus_int                        from,
+    opus_int                        i
+)
+{
+    opus_int j;
+    for( j = i; j < NSQ_LPC_BUF_LENGTH + i; j++ ) {
+        psDelDec->sLPC[ j ][ to ] = psDelDec->sLPC[ j ][ from ];
+    }
+    for( j = 0; j < DECISION_DELAY; j++ ) {
+        psDelDec->RandState[ j ][ to ] = psDelDec->RandState[ j ][ from ];
+        psDelDec->Q[         j ][ to ] = psDelDec->Q[         j ][ from ];
+        psDelDec->Xq[        j ][ to ] = psDelDec->Xq[        j ][ from ];
+        psDelDec->Pred[      j ][ to ] = psDelDec->Pred[      j ][ from ];
+        psDelDec->Shape[     j ][ to ] = psDelDec->Shape[     j ][ from ];
+    }
+    for( j = 0; j < MAX_SHAPE_LPC_ORDER; j++ ) {
+        psDelDec->sAR2[ j ][ to ] = psDelDec->sAR2[ j ][ from ];
+    }
+    psDelDec->LF_AR[    to ] = psDelDec->LF_AR[    from ];
+    psDelDec->Diff[     to ] = psDelDec->Diff[     from ];
+    psDelDec->Seed[     to ] = psDelDec->Seed[     from ];
+    psDelDec->SeedInit[ to ] = psDelDec->SeedInit[ from ];
+    psDelDec->RD[       to ] = psDelDec->RD[       from ];
+}
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2)
+#include "x86/NSQ_FLP_sse.h"
+#endif
+
+#ifndef OVERRIDE_silk_noise_shape_quantizer_del_dec_FLP
+#define silk_noise_shape_quantizer_del_dec_FLP(NSQ, psDelDec, signalType, x_sc, pulses, xq, sLTP_sc, delayedGain, \
+        a, b, AR_shp, lag, HarmShapeGain, Tilt, LF_MA_shp, LF_AR_shp, Gain, Lambda, offset, length, subfr, \
+        shapingLPCOrder, predictLPCOrder, warping, nStatesDelayedDecision, smpl_buf_idx, decisionDelay, arch) \
+    ((void)(arch), silk_noise_shape_quantizer_del_dec_FLP_c(NSQ, psDelDec, signalType, x_sc, pulses, xq, sLTP_sc, \
+        delayedGain, a, b, AR_shp, lag, HarmShapeGain, Tilt, LF_MA_shp, LF_AR_shp, Gain, Lambda, offset, length, \
+        subfr, shapingLPCOrder, predictLPCOrder, warping, nStatesDelayedDecision, smpl_buf_idx, decisionDelay))
+#endif
+
+#endif /* ENABLE_FLOAT_NSQ */
+
+#endif /* SILK_NSQ_FLP_H */
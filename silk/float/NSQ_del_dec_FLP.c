@@ -0,0 +1,572 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "main_FLP.h"
+#include "stack_alloc.h"
+#include "NSQ_FLP.h"
+
+#ifdef ENABLE_FLOAT_NSQ
+
+/* Floating-point version of silk_NSQ_del_dec(), see silk_NSQ_FLP(). */
+
+static OPUS_INLINE void silk_nsq_del_dec_scale_states_FLP(
+    const silk_encoder_state        *psEncC,                /* I    Encoder State                           */
+    silk_nsq_state                  *NSQ,                   /* I/O  NSQ state                               */
+    NSQ_del_dec_FLP_struct          *psDelDec,              /* I/O  Delayed decision states                 */
+    const silk_float                x[],                    /* I    Input                                   */
+    silk_float                      x_sc[],                 /* O    Input scaled with 1/Gain                */
+    const silk_float                sLTP[],                 /* I    Re-whitened LTP state                   */
+    silk_float                      sLTP_sc[],              /* O    LTP state matching scaled input         */
+    opus_int                        subfr,                  /* I    Subframe number                         */
+    const silk_float                LTP_scale,              /* I    LTP state scaling                       */
+    const silk_float                Gains[],                /* I    Quantization gains                      */
+    const opus_int                  pitchL[],               /* I    Pitch lags                              */
+    const opus_int                  signal_type,            /* I    Signal type                             */
+    const opus_int                  decisionDelay           /* I    Decision delay                          */
+)
+{
+    opus_int   i, k, lag;
+    opus_int32 Gain_Q16;
+    silk_float inv_gain, gain_adj;
+
+    lag      = pitchL[ subfr ];
+    inv_gain = 1.0f / silk_max_float( Gains[ subfr ], 1.0f / 65536.0f );
+
+    /* Scale input */
+    for( i = 0; i < psEncC->subfr_length; i++ ) {
+        x_sc[ i ] = x[ i ] * inv_gain;
+    }
+
+    /* After rewhitening the LTP state is un-scaled, so scale with inv_gain */
+    if( NSQ->rewhite_flag ) {
+        if( subfr == 0 ) {
+            /* Do LTP downscaling */
+            inv_gain *= LTP_scale;
+        }
+        for( i = NSQ->sLTP_buf_idx - lag - LTP_ORDER / 2; i < NSQ->sLTP_buf_idx; i++ ) {
+            silk_assert( i < MAX_FRAME_LENGTH );
+            sLTP_sc[ i ] = inv_gain * sLTP[ i ];
+        }
+    }
+
+    /* Adjust for changing gain */
+    Gain_Q16 = silk_float2int( Gains[ subfr ] * 65536.0f );
+    if( Gain_Q16 != NSQ->prev_gain_Q16 ) {
+        gain_adj = (silk_float)NSQ->prev_gain_Q16 / (silk_float)Gain_Q16;
+
+        /* Scale long-term shaping state */
+        for( i = NSQ->sLTP_shp_buf_idx - psEncC->ltp_mem_length; i < NSQ->sLTP_shp_buf_idx; i++ ) {
+            NSQ->sLTP_shp_FLP[ i ] *= gain_adj;
+        }
+
+        /* Scale long-term prediction state */
+        if( signal_type == TYPE_VOICED && NSQ->rewhite_flag == 0 ) {
+            for( i = NSQ->sLTP_buf_idx - lag - LTP_ORDER / 2; i < NSQ->sLTP_buf_idx - decisionDelay; i++ ) {
+                sLTP_sc[ i ] *= gain_adj;
+            }
+        }
+
+        /* Scale all states, whether in use or not */
+        for( k = 0; k < MAX_DEL_DEC_STATES; k++ ) {
+            psDelDec->LF_AR[ k ] *= gain_adj;
+            psDelDec->Diff[  k ] *= gain_adj;
+            for( i = 0; i < NSQ_LPC_BUF_LENGTH; i++ ) {
+                psDelDec->sLPC[ i ][ k ] *= gain_adj;
+            }
+            for( i = 0; i < MAX_SHAPE_LPC_ORDER; i++ ) {
+                psDelDec->sAR2[ i ][ k ] *= gain_adj;
+            }
+            for( i = 0; i < DECISION_DELAY; i++ ) {
+                psDelDec->Pred[  i ][ k ] *= gain_adj;
+                psDelDec->Shape[ i ][ k ] *= gain_adj;
+            }
+        }
+
+        /* Save gain */
+        NSQ->prev_gain_Q16 = Gain_Q16;
+    }
+}
+
+void silk_NSQ_del_dec_FLP(
+    silk_encoder_state_FLP          *psEnc,             /* I    Encoder state FLP                           */
+    silk_encoder_control_FLP        *psEncCtrl,         /* I    Encoder control FLP                         */
+    SideInfoIndices                 *psIndices,         /* I/O  Quantization indices                        */
+    silk_nsq_state                  *NSQ,               /* I/O  Noise Shaping Quantzation state             */
+    opus_int8                       pulses[],           /* O    Quantized pulse signal                      */
+    const silk_float                x[]                 /* I    Prefiltered input signal                    */
+)
+{
+    opus_int            i, k, lag, start_idx, LSF_interpolation_flag, Winner_ind, subfr;
+    opus_int            last_smple_idx, smpl_buf_idx, decisionDelay;
+    const silk_encoder_state *psEncC = &psEnc->sCmn;
+    const silk_float    *A, *B, *AR_shp;
+    silk_float          *pxq;
+    VARDECL( silk_float, sLTP_sc );
+    VARDECL( silk_float, sLTP );
+    silk_float          offset, LTP_scale, RDmin, Gain;
+    VARDECL( silk_float, x_sc );
+    VARDECL( silk_float, delayedGain );
+    VARDECL( NSQ_del_dec_FLP_struct, psDelDec );
+    SAVE_STACK;
+
+    /* Set unvoiced lag to the previous one, overwrite later for voiced */
+    lag = NSQ->lagPrev;
+
+    silk_assert( NSQ->prev_gain_Q16 != 0 );
+
+    /* Initialize delayed decision states, including the ones not in use */
+    ALLOC( psDelDec, 1, NSQ_del_dec_FLP_struct );
+    silk_memset( psDelDec, 0, sizeof( NSQ_del_dec_FLP_struct ) );
+    for( k = 0; k < MAX_DEL_DEC_STATES; k++ ) {
+        psDelDec->Seed[ k ]      = ( k + psIndices->Seed ) & 3;
+        psDelDec->SeedInit[ k ]  = psDelDec->Seed[ k ];
+        psDelDec->LF_AR[ k ]     = NSQ->sLF_AR_shp_FLP;
+        psDelDec->Diff[ k ]      = NSQ->sDiff_shp_FLP;
+        psDelDec->Shape[ 0 ][ k ] = NSQ->sLTP_shp_FLP[ psEncC->ltp_mem_length - 1 ];
+        for( i = 0; i < NSQ_LPC_BUF_LENGTH; i++ ) {
+            psDelDec->sLPC[ i ][ k ] = NSQ->sLPC_FLP[ i ];
+        }
+        for( i = 0; i < MAX_SHAPE_LPC_ORDER; i++ ) {
+            psDelDec->sAR2[ i ][ k ] = NSQ->sAR2_FLP[ i ];
+        }
+    }
+
+    offset       = silk_Quantization_Offsets_Q10[ psIndices->signalType >> 1 ][ psIndices->quantOffsetType ] * ( 1.0f / 1024.0f );
+    smpl_buf_idx = 0; /* index of oldest samples */
+
+    decisionDelay = silk_min_int( DECISION_DELAY, psEncC->subfr_length );
+
+    /* For voiced frames limit the decision delay to lower than the pitch lag */
+    if( psIndices->signalType == TYPE_VOICED ) {
+        for( k = 0; k < psEncC->nb_subfr; k++ ) {
+            decisionDelay = silk_min_int( decisionDelay, psEncCtrl->pitchL[ k ] - LTP_ORDER / 2 - 1 );
+        }
+        LTP_scale = silk_LTPScales_table_Q14[ psIndices->LTP_scaleIndex ] * ( 1.0f / 16384.0f );
+    } else {
+        if( lag > 0 ) {
+            decisionDelay = silk_min_int( decisionDelay, lag - LTP_ORDER / 2 - 1 );
+        }
+        LTP_scale = 0.0f;
+    }
+
+    if( psIndices->NLSFInterpCoef_Q2 == 4 ) {
+        LSF_interpolation_flag = 0;
+    } else {
+        LSF_interpolation_flag = 1;
+    }
+
+    ALLOC( sLTP_sc, psEncC->ltp_mem_length + psEncC->frame_length, silk_float );
+    ALLOC( sLTP, psEncC->ltp_mem_length + psEncC->frame_length, silk_float );
+    ALLOC( x_sc, psEncC->subfr_length, silk_float );
+    ALLOC( delayedGain, DECISION_DELAY, silk_float );
+    /* Set up pointers to start of sub frame */
+    pxq                   = &NSQ->xq_FLP[ psEncC->ltp_mem_length ];
+    NSQ->sLTP_shp_buf_idx = psEncC->ltp_mem_length;
+    NSQ->sLTP_buf_idx     = psEncC->ltp_mem_length;
+    subfr = 0;
+    for( k = 0; k < psEncC->nb_subfr; k++ ) {
+        A      = psEncCtrl->PredCoef[ ( k >> 1 ) | ( 1 - LSF_interpolation_flag ) ];
+        B      = &psEncCtrl->LTPCoef[ k * LTP_ORDER ];
+        AR_shp = &psEncCtrl->AR[ k * MAX_SHAPE_LPC_ORDER ];
+
+        NSQ->rewhite_flag = 0;
+        if( psIndices->signalType == TYPE_VOICED ) {
+            /* Voiced */
+            lag = psEncCtrl->pitchL[ k ];
+
+            /* Re-whitening */
+            if( ( k & ( 3 - silk_LSHIFT( LSF_interpolation_flag, 1 ) ) ) == 0 ) {
+                if( k == 2 ) {
+                    /* RESET DELAYED DECISIONS */
+                    /* Find winner */
+                    RDmin = psDelDec->RD[ 0 ];
+                    Winner_ind = 0;
+                    for( i = 1; i < psEncC->nStatesDelayedDecision; i++ ) {
+                        if( psDelDec->RD[ i ] < RDmin ) {
+                            RDmin = psDelDec->RD[ i ];
+                            Winner_ind = i;
+                        }
+                    }
+                    for( i = 0; i < psEncC->nStatesDelayedDecision; i++ ) {
+                        if( i != Winner_ind ) {
+                            psDelDec->RD[ i ] += NSQ_DEL_DEC_PENALTY_FLP;
+                        }
+                    }
+
+                    /* Copy final part of signals from winner state to output and long-term filter states */
+                    last_smple_idx = smpl_buf_idx + decisionDelay;
+                    for( i = 0; i < decisionDelay; i++ ) {
+                        last_smple_idx = ( last_smple_idx - 1 ) % DECISION_DELAY;
+                        if( last_smple_idx < 0 ) last_smple_idx += DECISION_DELAY;
+                        pulses[ i - decisionDelay ] = (opus_int8)psDelDec->Q[ last_smple_idx ][ Winner_ind ];
+                        pxq[ i - decisionDelay ] = silk_LIMIT( psDelDec->Xq[ last_smple_idx ][ Winner_ind ] * psEncCtrl->Gains[ 1 ],
+                            -32768.0f, 32767.0f );
+                        NSQ->sLTP_shp_FLP[ NSQ->sLTP_shp_buf_idx - decisionDelay + i ] = psDelDec->Shape[ last_smple_idx ][ Winner_ind ];
+                    }
+
+                    subfr = 0;
+                }
+
+                /* Rewhiten with new A coefs */
+                start_idx = psEncC->ltp_mem_length - lag - psEncC->predictLPCOrder - LTP_ORDER / 2;
+                silk_assert( start_idx > 0 );
+
+                silk_LPC_analysis_filter_FLP( &sLTP[ start_idx ], A, &NSQ->xq_FLP[ start_idx + k * psEncC->subfr_length ],
+                    psEncC->ltp_mem_length - start_idx, psEncC->predictLPCOrder );
+
+                NSQ->sLTP_buf_idx = psEncC->ltp_mem_length;
+                NSQ->rewhite_flag = 1;
+            }
+        }
+
+        silk_nsq_del_dec_scale_states_FLP( psEncC, NSQ, psDelDec, x, x_sc, sLTP, sLTP_sc, k, LTP_scale,
+            psEncCtrl->Gains, psEncCtrl->pitchL, psIndices->signalType, decisionDelay );
+
+        silk_noise_shape_quantizer_del_dec_FLP( NSQ, psDelDec, psIndices->signalType, x_sc, pulses, pxq, sLTP_sc,
+            delayedGain, A, B, AR_shp, lag, psEncCtrl->HarmShapeGain[ k ], psEncCtrl->Tilt[ k ],
+            psEncCtrl->LF_MA_shp[ k ], psEncCtrl->LF_AR_shp[ k ], psEncCtrl->Gains[ k ], psEncCtrl->Lambda, offset,
+            psEncC->subfr_length, subfr++, psEncC->shapingLPCOrder, psEncC->predictLPCOrder,
+            psEncC->warping_Q16 * ( 1.0f / 65536.0f ), psEncC->nStatesDelayedDecision, &smpl_buf_idx, decisionDelay,
+            psEncC->arch );
+
+        x      += psEncC->subfr_length;
+        pulses += psEncC->subfr_length;
+        pxq    += psEncC->subfr_length;
+    }
+
+    /* Find winner */
+    RDmin = psDelDec->RD[ 0 ];
+    Winner_ind = 0;
+    for( k = 1; k < psEncC->nStatesDelayedDecision; k++ ) {
+        if( psDelDec->RD[ k ] < RDmin ) {
+            RDmin = psDelDec->RD[ k ];
+            Winner_ind = k;
+        }
+    }
+
+    /* Copy final part of signals from winner state to output and long-term filter states */
+    psIndices->Seed = psDelDec->SeedInit[ Winner_ind ];
+    last_smple_idx = smpl_buf_idx + decisionDelay;
+    Gain = psEncCtrl->Gains[ psEncC->nb_subfr - 1 ];
+    for( i = 0; i < decisionDelay; i++ ) {
+        last_smple_idx = ( last_smple_idx - 1 ) % DECISION_DELAY;
+        if( last_smple_idx < 0 ) last_smple_idx += DECISION_DELAY;
+
+        pulses[ i - decisionDelay ] = (opus_int8)psDelDec->Q[ last_smple_idx ][ Winner_ind ];
+        pxq[ i - decisionDelay ] = silk_LIMIT( psDelDec->Xq[ last_smple_idx ][ Winner_ind ] * Gain, -32768.0f, 32767.0f );
+        NSQ->sLTP_shp_FLP[ NSQ->sLTP_shp_buf_idx - decisionDelay + i ] = psDelDec->Shape[ last_smple_idx ][ Winner_ind ];
+    }
+    for( i = 0; i < NSQ_LPC_BUF_LENGTH; i++ ) {
+        NSQ->sLPC_FLP[ i ] = psDelDec->sLPC[ psEncC->subfr_length + i ][ Winner_ind ];
+    }
+    for( i = 0; i < MAX_SHAPE_LPC_ORDER; i++ ) {
+        NSQ->sAR2_FLP[ i ] = psDelDec->sAR2[ i ][ Winner_ind ];
+    }
+
+    /* Update states */
+    NSQ->sLF_AR_shp_FLP = psDelDec->LF_AR[ Winner_ind ];
+    NSQ->sDiff_shp_FLP  = psDelDec->Diff[ Winner_ind ];
+    NSQ->lagPrev        = psEncCtrl->pitchL[ psEncC->nb_subfr - 1 ];
+
+    /* Save quantized speech signal */
+    silk_memmove( NSQ->xq_FLP,       &NSQ->xq_FLP[       psEncC->frame_length ], psEncC->ltp_mem_length * sizeof( silk_float ) );
+    silk_memmove( NSQ->sLTP_shp_FLP, &NSQ->sLTP_shp_FLP[ psEncC->frame_length ], psEncC->ltp_mem_length * sizeof( silk_float ) );
+    RESTORE_STACK;
+}
+
+/******************************************/
+/* Noise shape quantizer for one subframe */
+/******************************************/
+void silk_noise_shape_quantizer_del_dec_FLP_c(
+    silk_nsq_state                  *NSQ,                   /* I/O  NSQ state                               */
+    NSQ_del_dec_FLP_struct          *psDelDec,              /* I/O  Delayed decision states                 */
+    opus_int                        signalType,             /* I    Signal type                             */
+    const silk_float                x_sc[],                 /* I    Scaled input                            */
+    opus_int8                       pulses[],               /* O    Quantized pulse signal                  */
+    silk_float                      xq[],                   /* O    Quantized output signal                 */
+    silk_float                      sLTP_sc[],              /* I/O  LTP filter state                        */
+    silk_float                      delayedGain[],          /* I/O  Gain delay buffer                       */
+    const silk_float                a[],                    /* I    Short term prediction coefs             */
+    const silk_float                b[],                    /* I    Long term prediction coefs              */
+    const silk_float                AR_shp[],               /* I    Noise shaping coefs                     */
+    opus_int                        lag,                    /* I    Pitch lag                               */
+    silk_float                      HarmShapeGain,          /* I    Long term shaping gain                  */
+    silk_float                      Tilt,                   /* I    Spectral tilt                           */
+    silk_float                      LF_MA_shp,              /* I    Low frequency MA shaping coef           */
+    silk_float                      LF_AR_shp,              /* I    Low frequency AR shaping coef           */
+    silk_float                      Gain,                   /* I    Quantization gain                       */
+    silk_float                      Lambda,                 /* I    Rate/distortion tradeoff                */
+    silk_float                      offset,                 /* I    Quantization offset                     */
+    opus_int                        length,                 /* I    Input length                            */
+    opus_int                        subfr,                  /* I    Subframe number                         */
+    opus_int                        shapingLPCOrder,        /* I    Shaping LPC filter order                */
+    opus_int                        predictLPCOrder,        /* I    Prediction filter order                 */
+    silk_float                      warping,                /* I    Warping coefficient                     */
+    opus_int                        nStatesDelayedDecision, /* I    Number of states in decision tree       */
+    opus_int                        *smpl_buf_idx,          /* I/O  Index to newest samples in buffers      */
+    opus_int                        decisionDelay           /* I    Decision delay                          */
+)
+{
+    opus_int     i, j, k, Winner_ind, RDmin_ind, RDmax_ind, last_smple_idx, q1_Q0;
+    opus_int32   Winner_rand_state;
+    silk_float   LTP_pred, LPC_pred, n_AR, n_LTP, n_LF, r, rd1, rd2, q1, q2, RDmin, RDmax, rdo_offset;
+    silk_float   exc, LPC_exc, xq_sc, tmp1, tmp2;
+    silk_float   *pred_lag_ptr, *shp_lag_ptr;
+    NSQ_sample_FLP_struct psSampleState[ 2 ];
+    NSQ_sample_FLP_struct *psSS;
+
+    silk_assert( nStatesDelayedDecision > 0 );
+
+    shp_lag_ptr  = &NSQ->sLTP_shp_FLP[ NSQ->sLTP_shp_buf_idx - lag + HARM_SHAPE_FIR_TAPS / 2 ];
+    pred_lag_ptr = &sLTP_sc[ NSQ->sLTP_buf_idx - lag + LTP_ORDER / 2 ];
+    rdo_offset   = 0.5f * Lambda - 0.5f;
+
+    for( i = 0; i < length; i++ ) {
+        /* Perform common calculations used in all states */
+
+        /* Long-term prediction */
+        if( signalType == TYPE_VOICED ) {
+            LTP_pred = pred_lag_ptr[  0 ] * b[ 0 ] + pred_lag_ptr[ -1 ] * b[ 1 ] + pred_lag_ptr[ -2 ] * b[ 2 ]
+                     + pred_lag_ptr[ -3 ] * b[ 3 ] + pred_lag_ptr[ -4 ] * b[ 4 ];
+            pred_lag_ptr++;
+        } else {
+            LTP_pred = 0.0f;
+        }
+
+        /* Long-term shaping */
+        if( lag > 0 ) {
+            /* Symmetric FIR coefficients */
+            n_LTP = LTP_pred - HarmShapeGain * ( 0.25f * ( shp_lag_ptr[ 0 ] + shp_lag_ptr[ -2 ] ) + 0.5f * shp_lag_ptr[ -1 ] );
+            shp_lag_ptr++;
+        } else {
+            n_LTP = 0.0f;
+        }
+
+        for( k = 0; k < nStatesDelayedDecision; k++ ) {
+            /* Generate dither */
+            psDelDec->Seed[ k ] = silk_RAND( psDelDec->Seed[ k ] );
+
+            /* Short-term prediction */
+            LPC_pred = 0.0f;
+            for( j = 0; j < predictLPCOrder; j++ ) {
+                LPC_pred += psDelDec->sLPC[ NSQ_LPC_BUF_LENGTH - 1 + i - j ][ k ] * a[ j ];
+            }
+
+            /* Noise shape feedback */
+            silk_assert( ( shapingLPCOrder & 1 ) == 0 );   /* check that order is even */
+            /* Output of lowpass section */
+            tmp2 = psDelDec->Diff[ k ] + warping * psDelDec->sAR2[ 0 ][ k ];
+            /* Output of allpass section */
+            tmp1 = psDelDec->sAR2[ 0 ][ k ] + warping * ( psDelDec->sAR2[ 1 ][ k ] - tmp2 );
+            psDelDec->sAR2[ 0 ][ k ] = tmp2;
+            n_AR = tmp2 * AR_shp[ 0 ];
+            /* Loop over allpass sections */
+            for( j = 2; j < shapingLPCOrder; j += 2 ) {
+                /* Output of allpass section */
+                tmp2 = psDelDec->sAR2[ j - 1 ][ k ] + warping * ( psDelDec->sAR2[ j + 0 ][ k ] - tmp1 );
+                psDelDec->sAR2[ j - 1 ][ k ] = tmp1;
+                n_AR += tmp1 * AR_shp[ j - 1 ];
+                /* Output of allpass section */
+                tmp1 = psDelDec->sAR2[ j + 0 ][ k ] + warping * ( psDelDec->sAR2[ j + 1 ][ k ] - tmp2 );
+                psDelDec->sAR2[ j + 0 ][ k ] = tmp2;
+                n_AR += tmp2 * AR_shp[ j ];
+            }
+            psDelDec->sAR2[ shapingLPCOrder - 1 ][ k ] = tmp1;
+            n_AR += tmp1 * AR_shp[ shapingLPCOrder - 1 ];
+            n_AR += psDelDec->LF_AR[ k ] * Tilt;
+
+            n_LF = psDelDec->Shape[ *smpl_buf_idx ][ k ] * LF_MA_shp + psDelDec->LF_AR[ k ] * LF_AR_shp;
+
+            /* Input minus prediction plus noise feedback                       */
+            /* r = x[ i ] - LTP_pred - LPC_pred + n_AR + n_Tilt + n_LF + n_LTP  */
+            r = x_sc[ i ] - ( ( n_LTP + LPC_pred ) - ( n_AR + n_LF ) );       /* residual error */
+
+            /* Flip sign depending on dither */
+            if( psDelDec->Seed[ k ] < 0 ) {
+                r = -r;
+            }
+            r = silk_LIMIT( r, -31.0f, 30.0f );
+
+            /* Find two quantization level candidates and measure their rate-distortion */
+            q1 = r - offset;
+            /* Rounds toward -inf, since q1 > -32 */
+            q1_Q0 = (opus_int)( q1 + 32.0f ) - 32;
+            if( Lambda > 2.0f ) {
+                /* For aggressive RDO, the bias becomes more than one pulse. */
+                if( q1 > rdo_offset ) {
+                    q1_Q0 = (opus_int)( q1 - rdo_offset );
+                } else if( q1 < -rdo_offset ) {
+                    q1_Q0 = (opus_int)( q1 + rdo_offset + 32.0f ) - 32;
+                } else if( q1 < 0 ) {
+                    q1_Q0 = -1;
+                } else {
+                    q1_Q0 = 0;
+                }
+            }
+            q1  = silk_nsq_level_FLP( q1_Q0 ) + offset;
+            q2  = silk_nsq_level_FLP( q1_Q0 + 1 ) + offset;
+            rd1 = silk_abs_float( q1 ) * Lambda + ( r - q1 ) * ( r - q1 );
+            rd2 = silk_abs_float( q2 ) * Lambda + ( r - q2 ) * ( r - q2 );
+
+            if( rd1 < rd2 ) {
+                psSampleState[ 0 ].RD[ k ] = psDelDec->RD[ k ] + rd1;
+                psSampleState[ 1 ].RD[ k ] = psDelDec->RD[ k ] + rd2;
+                psSampleState[ 0 ].Q[ k ]  = q1_Q0;
+                psSampleState[ 1 ].Q[ k ]  = q1_Q0 + 1;
+            } else {
+                psSampleState[ 0 ].RD[ k ] = psDelDec->RD[ k ] + rd2;
+                psSampleState[ 1 ].RD[ k ] = psDelDec->RD[ k ] + rd1;
+                psSampleState[ 0 ].Q[ k ]  = q1_Q0 + 1;
+                psSampleState[ 1 ].Q[ k ]  = q1_Q0;
+                tmp1 = q1;
+                q1   = q2;
+                q2   = tmp1;
+            }
+
+            /* Update states for best quantization */
+
+            /* Quantized excitation */
+            exc = psDelDec->Seed[ k ] < 0 ? -q1 : q1;
+
+            /* Add predictions */
+            LPC_exc = exc + LTP_pred;
+            xq_sc   = LPC_exc + LPC_pred;
+
+            /* Update states */
+            psSS = &psSampleState[ 0 ];
+            psSS->Diff[ k ]     = xq_sc - x_sc[ i ];
+            psSS->LF_AR[ k ]    = psSS->Diff[ k ] - n_AR;
+            psSS->sLTP_shp[ k ] = psSS->LF_AR[ k ] - n_LF;
+            psSS->LPC_exc[ k ]  = LPC_exc;
+            psSS->xq[ k ]       = xq_sc;
+
+            /* Update states for second best quantization */
+
+            /* Quantized excitation */
+            exc = psDelDec->Seed[ k ] < 0 ? -q2 : q2;
+
+            /* Add predictions */
+            LPC_exc = exc + LTP_pred;
+            xq_sc   = LPC_exc + LPC_pred;
+
+            /* Update states */
+            psSS = &psSampleState[ 1 ];
+            psSS->Diff[ k ]     = xq_sc - x_sc[ i ];
+            psSS->LF_AR[ k ]    = psSS->Diff[ k ] - n_AR;
+            psSS->sLTP_shp[ k ] = psSS->LF_AR[ k ] - n_LF;
+            psSS->LPC_exc[ k ]  = LPC_exc;
+            psSS->xq[ k ]       = xq_sc;
+        }
+
+        *smpl_buf_idx  = ( *smpl_buf_idx - 1 ) % DECISION_DELAY;
+        if( *smpl_buf_idx < 0 ) *smpl_buf_idx += DECISION_DELAY;
+        last_smple_idx = ( *smpl_buf_idx + decisionDelay ) % DECISION_DELAY;
+
+        /* Find winner */
+        RDmin = psSampleState[ 0 ].RD[ 0 ];
+        Winner_ind = 0;
+        for( k = 1; k < nStatesDelayedDecision; k++ ) {
+            if( psSampleState[ 0 ].RD[ k ] < RDmin ) {
+                RDmin = psSampleState[ 0 ].RD[ k ];
+                Winner_ind = k;
+            }
+        }
+
+        /* Increase RD values of expired states */
+        Winner_rand_state = psDelDec->RandState[ last_smple_idx ][ Winner_ind ];
+        for( k = 0; k < nStatesDelayedDecision; k++ ) {
+            if( psDelDec->RandState[ last_smple_idx ][ k ] != Winner_rand_state ) {
+                psSampleState[ 0 ].RD[ k ] += NSQ_DEL_DEC_PENALTY_FLP;
+                psSampleState[ 1 ].RD[ k ] += NSQ_DEL_DEC_PENALTY_FLP;
+            }
+        }
+
+        /* Find worst in first set and best in second set */
+        RDmax     = psSampleState[ 0 ].RD[ 0 ];
+        RDmin     = psSampleState[ 1 ].RD[ 0 ];
+        RDmax_ind = 0;
+        RDmin_ind = 0;
+        for( k = 1; k < nStatesDelayedDecision; k++ ) {
+            /* find worst in first set */
+            if( psSampleState[ 0 ].RD[ k ] > RDmax ) {
+                RDmax     = psSampleState[ 0 ].RD[ k ];
+                RDmax_ind = k;
+            }
+            /* find best in second set */
+            if( psSampleState[ 1 ].RD[ k ] < RDmin ) {
+                RDmin     = psSampleState[ 1 ].RD[ k ];
+                RDmin_ind = k;
+            }
+        }
+
+        /* Replace a state if best from second set outperforms worst in first set */
+        if( RDmin < RDmax ) {
+            silk_nsq_del_dec_copy_state_FLP( psDelDec, RDmax_ind, RDmin_ind, i );
+            psSampleState[ 0 ].Q[        RDmax_ind ] = psSampleState[ 1 ].Q[        RDmin_ind ];
+            psSampleState[ 0 ].RD[       RDmax_ind ] = psSampleState[ 1 ].RD[       RDmin_ind ];
+            psSampleState[ 0 ].xq[       RDmax_ind ] = psSampleState[ 1 ].xq[       RDmin_ind ];
+            psSampleState[ 0 ].LF_AR[    RDmax_ind ] = psSampleState[ 1 ].LF_AR[    RDmin_ind ];
+            psSampleState[ 0 ].Diff[     RDmax_ind ] = psSampleState[ 1 ].Diff[     RDmin_ind ];
+            psSampleState[ 0 ].sLTP_shp[ RDmax_ind ] = psSampleState[ 1 ].sLTP_shp[ RDmin_ind ];
+            psSampleState[ 0 ].LPC_exc[  RDmax_ind ] = psSampleState[ 1 ].LPC_exc[  RDmin_ind ];
+        }
+
+        /* Write samples from winner to output and long-term filter states */
+        if( subfr > 0 || i >= decisionDelay ) {
+            pulses[  i - decisionDelay ] = (opus_int8)psDelDec->Q[ last_smple_idx ][ Winner_ind ];
+            xq[ i - decisionDelay ] = silk_LIMIT( psDelDec->Xq[ last_smple_idx ][ Winner_ind ] * delayedGain[ last_smple_idx ],
+                -32768.0f, 32767.0f );
+            NSQ->sLTP_shp_FLP[ NSQ->sLTP_shp_buf_idx - decisionDelay ] = psDelDec->Shape[ last_smple_idx ][ Winner_ind ];
+            sLTP_sc[           NSQ->sLTP_buf_idx     - decisionDelay ] = psDelDec->Pred[  last_smple_idx ][ Winner_ind ];
+        }
+        NSQ->sLTP_shp_buf_idx++;
+        NSQ->sLTP_buf_idx++;
+
+        /* Update states */
+        psSS = &psSampleState[ 0 ];
+        for( k = 0; k < nStatesDelayedDecision; k++ ) {
+            psDelDec->LF_AR[ k ]                          = psSS->LF_AR[ k ];
+            psDelDec->Diff[ k ]                           = psSS->Diff[ k ];
+            psDelDec->sLPC[ NSQ_LPC_BUF_LENGTH + i ][ k ] = psSS->xq[ k ];
+            psDelDec->Xq[    *smpl_buf_idx ][ k ]         = psSS->xq[ k ];
+            psDelDec->Q[     *smpl_buf_idx ][ k ]         = psSS->Q[ k ];
+            psDelDec->Pred[  *smpl_buf_idx ][ k ]         = psSS->LPC_exc[ k ];
+            psDelDec->Shape[ *smpl_buf_idx ][ k ]         = psSS->sLTP_shp[ k ];
+            psDelDec->Seed[ k ]                           = silk_ADD32_ovflw( psDelDec->Seed[ k ], psSS->Q[ k ] );
+            psDelDec->RandState[ *smpl_buf_idx ][ k ]     = psDelDec->Seed[ k ];
+            psDelDec->RD[ k ]                             = psSS->RD[ k ];
+        }
+        delayedGain[ *smpl_buf_idx ] = Gain;
+    }
+    /* Update LPC states */
+    silk_memcpy( psDelDec->sLPC, psDelDec->sLPC[ length ], NSQ_LPC_BUF_LENGTH * sizeof( psDelDec->sLPC[ 0 ] ) );
+}
+
+#endif /* ENABLE_FLOAT_NSQ */
@@ -32,6 +32,10 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "float_cast.h"
 #include <math.h>
 
+#if defined(OPUS_X86_MAY_HAVE_SSE2) || defined(OPUS_X86_MAY_HAVE_AVX2)
+#include "x86/SigProc_FLP_sse.h"
+#endif
+
 #ifdef  __cplusplus
 extern "C"
 {
@@ -73,7 +77,8 @@ void silk_autocorrelation_FLP(
     silk_float          *results,           /* O    result (length correlationCount)                            */
     const silk_float    *inputData,         /* I    input data to correlate                                     */
     opus_int            inputDataSize,      /* I    length of input                                             */
-    opus_int            correlationCount    /* I    number of correlation taps to compute                       */
+    opus_int            correlationCount,   /* I    number of correlation taps to compute                       */
+    int                 arch                /* I    Run-time architecture                                       */
 );
 
 opus_int silk_pitch_analysis_core_FLP(      /* O    Voicing estimate: 0 voiced, 1 unvoiced                      */
@@ -105,7 +110,8 @@ silk_float silk_burg_modified_FLP(          /* O    returns residual energy
     const silk_float    minInvGain,         /* I    minimum inverse prediction gain                             */
     const opus_int      subfr_length,       /* I    input signal subframe length (incl. D preceding samples)    */
     const opus_int      nb_subfr,           /* I    number of subframes stacked in x                            */
-    const opus_int      D                   /* I    order                                                       */
+    const opus_int      D,                  /* I    order                                                       */
+    int                 arch                /* I    Run-time architecture                                       */
 );
 
 /* multiply a vector by a constant */
@@ -124,18 +130,28 @@ void silk_scale_copy_vector_FLP(
 );
 
 /* inner product of two silk_float arrays, with result as double */
-double silk_inner_product_FLP(
+double silk_inner_product_FLP_c(
     const silk_float    *data1,
     const silk_float    *data2,
     opus_int            dataSize
 );
 
 /* sum of squares of a silk_float array, with result as double */
-double silk_energy_FLP(
+double silk_energy_FLP_c(
     const silk_float    *data,
     opus_int            dataSize
 );
 
+#if !defined(OVERRIDE_silk_inner_product_FLP)
+#define silk_inner_product_FLP(data1, data2, dataSize, arch) \
+    ((void)(arch),silk_inner_product_FLP_c(data1, data2, dataSize))
+#endif
+
+#if !defined(OVERRIDE_silk_energy_FLP)
+#define silk_energy_FLP(data, dataSize, arch) \
+    ((void)(arch),silk_energy_FLP_c(data, dataSize))
+#endif
+
 /********************************************************************/
 /*                                MACROS                            */
 /********************************************************************/
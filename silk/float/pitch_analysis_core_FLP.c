@@ -58,7 +58,8 @@ static void silk_P_Ana_calc_energy_st3(
     opus_int            start_lag,          /* I start lag                                                      */
     opus_int            sf_length,          /* I sub frame length                                               */
     opus_int            nb_subfr,           /* I number of subframes                                            */
-    opus_int            complexity          /* I Complexity setting                                             */
+    opus_int            complexity,         /* I Complexity setting                                             */
+    int                 arch                /* I Run-time architecture                                          */
 );
 
 /************************************************************/
@@ -87,13 +88,13 @@ opus_int silk_pitch_analysis_core_FLP(      /* O    Voicing estimate: 0 voiced,
     opus_int32 filt_state[ 6 ];
     silk_float threshold, contour_bias;
     silk_float C[ PE_MAX_NB_SUBFR][ (PE_MAX_LAG >> 1) + 5 ];
-    opus_val32 xcorr[ PE_MAX_LAG_MS * 4 - PE_MIN_LAG_MS * 4 + 1 ];
+    opus_val32 xcorr[ ( PE_MAX_LAG >> 1 ) + 5 ];
     silk_float CC[ PE_NB_CBKS_STAGE2_EXT ];
     const silk_float *target_ptr, *basis_ptr;
     double    cross_corr, normalizer, energy, energy_tmp;
     opus_int   d_srch[ PE_D_SRCH_LENGTH ];
     opus_int16 d_comp[ (PE_MAX_LAG >> 1) + 5 ];
-    opus_int   length_d_srch, length_d_comp;
+    opus_int   length_d_srch, length_d_comp, run_start, run_length;
     silk_float Cmax, CCmax, CCmax_b, CCmax_new_b, CCmax_new;
     opus_int   CBimax, CBimax_new, lag, start_lag, end_lag, lag_new;
     opus_int   cbk_size;
@@ -182,8 +183,8 @@ opus_int silk_pitch_analysis_core_FLP(      /* O    Voicing estimate: 0 voiced,
 
         /* Calculate first vector products before loop */
         cross_corr = xcorr[ max_lag_4kHz - min_lag_4kHz ];
-        normalizer = silk_energy_FLP( target_ptr, sf_length_8kHz ) +
-                     silk_energy_FLP( basis_ptr,  sf_length_8kHz ) +
+        normalizer = silk_energy_FLP( target_ptr, sf_length_8kHz, arch ) +
+                     silk_energy_FLP( basis_ptr,  sf_length_8kHz, arch ) +
                      sf_length_8kHz * 4000.0f;
 
         C[ 0 ][ min_lag_4kHz ] += (silk_float)( 2 * cross_corr / normalizer );
@@ -287,16 +288,35 @@ opus_int silk_pitch_analysis_core_FLP(      /* O    Voicing estimate: 0 voiced,
         target_ptr = &frame_8kHz[ PE_LTP_MEM_LENGTH_MS * 8 ];
     }
     for( k = 0; k < nb_subfr; k++ ) {
-        energy_tmp = silk_energy_FLP( target_ptr, sf_length_8kHz ) + 1.0;
-        for( j = 0; j < length_d_comp; j++ ) {
-            d = d_comp[ j ];
-            basis_ptr = target_ptr - d;
-            cross_corr = silk_inner_product_FLP( basis_ptr, target_ptr, sf_length_8kHz );
-            if( cross_corr > 0.0f ) {
-                energy = silk_energy_FLP( basis_ptr, sf_length_8kHz );
-                C[ k ][ d ] = (silk_float)( 2 * cross_corr / ( energy + energy_tmp ) );
-            } else {
-                C[ k ][ d ] = 0.0f;
+        energy_tmp = silk_energy_FLP( target_ptr, sf_length_8kHz, arch ) + 1.0;
+        j = 0;
+        while( j < length_d_comp ) {
+            /* The lags in d_comp are sorted; handle each run of consecutive lags with a */
+            /* single correlation call and a recursively updated basis energy            */
+            run_start = j;
+            while( j + 1 < length_d_comp && d_comp[ j + 1 ] == d_comp[ j ] + 1 ) {
+                j++;
+            }
+            run_length = j - run_start + 1;
+            j++;
+            celt_pitch_xcorr( target_ptr, target_ptr - d_comp[ run_start + run_length - 1 ], xcorr, sf_length_8kHz, run_length, arch );
+
+            basis_ptr = target_ptr - d_comp[ run_start ];
+            energy = silk_energy_FLP( basis_ptr, sf_length_8kHz, arch );
+            for( i = 0; i < run_length; i++ ) {
+                if( i > 0 ) {
+                    /* Slide the basis window one sample back in time */
+                    energy -= basis_ptr[ sf_length_8kHz - 1 ] * (double)basis_ptr[ sf_length_8kHz - 1 ];
+                    basis_ptr--;
+                    energy += basis_ptr[ 0 ] * (double)basis_ptr[ 0 ];
+                }
+                d = d_comp[ run_start + i ];
+                cross_corr = xcorr[ run_length - 1 - i ];
+                if( cross_corr > 0.0f ) {
+                    C[ k ][ d ] = (silk_float)( 2 * cross_corr / ( silk_max_float( energy, 0.0f ) + energy_tmp ) );
+                } else {
+                    C[ k ][ d ] = 0.0f;
+                }
             }
         }
         target_ptr += sf_length_8kHz;
@@ -412,7 +432,7 @@ opus_int silk_pitch_analysis_core_FLP(      /* O    Voicing estimate: 0 voiced,
 
         /* Calculate the correlations and energies needed in stage 3 */
         silk_P_Ana_calc_corr_st3( cross_corr_st3, frame, start_lag, sf_length, nb_subfr, complexity, arch );
-        silk_P_Ana_calc_energy_st3( energies_st3, frame, start_lag, sf_length, nb_subfr, complexity );
+        silk_P_Ana_calc_energy_st3( energies_st3, frame, start_lag, sf_length, nb_subfr, complexity, arch );
 
         lag_counter = 0;
         silk_assert( lag == silk_SAT16( lag ) );
@@ -430,7 +450,7 @@ opus_int silk_pitch_analysis_core_FLP(      /* O    Voicing estimate: 0 voiced,
         }
 
         target_ptr = &frame[ PE_LTP_MEM_LENGTH_MS * Fs_kHz ];
-        energy_tmp = silk_energy_FLP( target_ptr, nb_subfr * sf_length ) + 1.0;
+        energy_tmp = silk_energy_FLP( target_ptr, nb_subfr * sf_length, arch ) + 1.0;
         for( d = start_lag; d <= end_lag; d++ ) {
             for( j = 0; j < nb_cbk_search; j++ ) {
                 cross_corr = 0.0;
@@ -562,7 +582,8 @@ static void silk_P_Ana_calc_energy_st3(
     opus_int            start_lag,          /* I start lag                                                      */
     opus_int            sf_length,          /* I sub frame length                                               */
     opus_int            nb_subfr,           /* I number of subframes                                            */
-    opus_int            complexity          /* I Complexity setting                                             */
+    opus_int            complexity,         /* I Complexity setting                                             */
+    int                 arch                /* I Run-time architecture                                          */
 )
 {
     const silk_float *target_ptr, *basis_ptr;
@@ -594,7 +615,7 @@ static void silk_P_Ana_calc_energy_st3(
 
         /* Calculate the energy for first lag */
         basis_ptr = target_ptr - ( start_lag + matrix_ptr( Lag_range_ptr, k, 0, 2 ) );
-        energy = silk_energy_FLP( basis_ptr, sf_length ) + 1e-3;
+        energy = silk_energy_FLP( basis_ptr, sf_length, arch ) + 1e-3;
         silk_assert( energy >= 0.0 );
         scratch_mem[lag_counter] = (silk_float)energy;
         lag_counter++;
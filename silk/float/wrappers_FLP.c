@@ -102,6 +102,14 @@ void silk_NSQ_wrapper_FLP(
     const silk_float                x[]                                 /* I    Prefiltered input signal                    */
 )
 {
+#ifdef ENABLE_FLOAT_NSQ
+    /* Quantize directly from the float parameters and input */
+    if( psEnc->sCmn.nStatesDelayedDecision > 1 || psEnc->sCmn.warping_Q16 > 0 ) {
+        silk_NSQ_del_dec_FLP( psEnc, psEncCtrl, psIndices, psNSQ, pulses, x );
+    } else {
+        silk_NSQ_FLP( psEnc, psEncCtrl, psIndices, psNSQ, pulses, x );
+    }
+#else
     opus_int     i, j;
     opus_int16   x16[ MAX_FRAME_LENGTH ];
     opus_int32   Gains_Q16[ MAX_NB_SUBFR ];
@@ -167,6 +175,7 @@ void silk_NSQ_wrapper_FLP(
         silk_NSQ( &psEnc->sCmn, psNSQ, psIndices, x16, pulses, PredCoef_Q12[ 0 ], LTPCoef_Q14,
             AR_Q13, HarmShapeGain_Q14, Tilt_Q14, LF_shp_Q14, Gains_Q16, psEncCtrl->pitchL, Lambda_Q10, LTP_scale_Q14, psEnc->sCmn.arch );
     }
+#endif
 }
 
 /***********************************************/
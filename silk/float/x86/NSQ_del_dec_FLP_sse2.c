@@ -0,0 +1,324 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <emmintrin.h>
+#include "main_FLP.h"
+#include "NSQ_FLP.h"
+
+#if defined(ENABLE_FLOAT_NSQ)
+
+/* silk_RAND() on four seeds; SSE2 has no 32-bit low multiply */
+static OPUS_INLINE __m128i silk_RAND_sse2( __m128i seed )
+{
+    __m128i mul, even, odd;
+    mul  = _mm_set1_epi32( RAND_MULTIPLIER );
+    even = _mm_mul_epu32( seed, mul );
+    odd  = _mm_mul_epu32( _mm_srli_epi64( seed, 32 ), mul );
+    even = _mm_unpacklo_epi32( _mm_shuffle_epi32( even, _MM_SHUFFLE( 0, 0, 2, 0 ) ),
+                               _mm_shuffle_epi32( odd,  _MM_SHUFFLE( 0, 0, 2, 0 ) ) );
+    return _mm_add_epi32( even, _mm_set1_epi32( RAND_INCREMENT ) );
+}
+
+/* Same as silk_nsq_level_FLP( q_Q0 ) + offset, for four levels */
+static OPUS_INLINE __m128 silk_nsq_level_FLP_sse2( __m128i q_Q0, __m128 offset )
+{
+    __m128 adj, level;
+    adj   = _mm_set1_ps( QUANT_LEVEL_ADJUST_FLP );
+    level = _mm_sub_ps( _mm_cvtepi32_ps( q_Q0 ),
+                        _mm_and_ps( adj, _mm_castsi128_ps( _mm_cmpgt_epi32( q_Q0, _mm_setzero_si128() ) ) ) );
+    level = _mm_add_ps( level,
+                        _mm_and_ps( adj, _mm_castsi128_ps( _mm_cmplt_epi32( q_Q0, _mm_setzero_si128() ) ) ) );
+    return _mm_add_ps( level, offset );
+}
+
+/* The states are processed four at a time, in the same order of operations */
+/* as silk_noise_shape_quantizer_del_dec_FLP_c() so the results match it.   */
+/* States beyond nStatesDelayedDecision are computed too, but never read.   */
+void silk_noise_shape_quantizer_del_dec_FLP_sse2(
+    silk_nsq_state                  *NSQ,                   /* I/O  NSQ state                               */
+    NSQ_del_dec_FLP_struct          *psDelDec,              /* I/O  Delayed decision states                 */
+    opus_int                        signalType,             /* I    Signal type                             */
+    const silk_float                x_sc[],                 /* I    Scaled input                            */
+    opus_int8                       pulses[],               /* O    Quantized pulse signal                  */
+    silk_float                      xq[],                   /* O    Quantized output signal                 */
+    silk_float                      sLTP_sc[],              /* I/O  LTP filter state                        */
+    silk_float                      delayedGain[],          /* I/O  Gain delay buffer                       */
+    const silk_float                a[],                    /* I    Short term prediction coefs             */
+    const silk_float                b[],                    /* I    Long term prediction coefs              */
+    const silk_float                AR_shp[],               /* I    Noise shaping coefs                     */
+    opus_int                        lag,                    /* I    Pitch lag                               */
+    silk_float                      HarmShapeGain,          /* I    Long term shaping gain                  */
+    silk_float                      Tilt,                   /* I    Spectral tilt                           */
+    silk_float                      LF_MA_shp,              /* I    Low frequency MA shaping coef           */
+    silk_float                      LF_AR_shp,              /* I    Low frequency AR shaping coef           */
+    silk_float                      Gain,                   /* I    Quantization gain                       */
+    silk_float                      Lambda,                 /* I    Rate/distortion tradeoff                */
+    silk_float                      offset,                 /* I    Quantization offset                     */
+    opus_int                        length,                 /* I    Input length                            */
+    opus_int                        subfr,                  /* I    Subframe number                         */
+    opus_int                        shapingLPCOrder,        /* I    Shaping LPC filter order                */
+    opus_int                        predictLPCOrder,        /* I    Prediction filter order                 */
+    silk_float                      warping,                /* I    Warping coefficient                     */
+    opus_int                        nStatesDelayedDecision, /* I    Number of states in decision tree       */
+    opus_int                        *smpl_buf_idx,          /* I/O  Index to newest samples in buffers      */
+    opus_int                        decisionDelay           /* I    Decision delay                          */
+)
+{
+    opus_int     i, j, k, Winner_ind, RDmin_ind, RDmax_ind, last_smple_idx;
+    opus_int32   Winner_rand_state;
+    silk_float   LTP_pred, n_LTP, RDmin, RDmax, rdo_offset;
+    silk_float   *pred_lag_ptr, *shp_lag_ptr;
+    NSQ_sample_FLP_struct psSampleState[ 2 ];
+    __m128       LPC_pred, n_AR, n_LF, r, q1, q2, rd1, rd2, tmp1, tmp2, sAR2_0, sAR2_1, sign, less, RD;
+    __m128       LPC_exc, xq_sc, Diff, LF_AR, x;
+    __m128       warping_4, offset_4, Lambda_4, abs_mask;
+    __m128i      seed, q1_Q0, q2_Q0;
+
+    silk_assert( nStatesDelayedDecision > 0 );
+
+    shp_lag_ptr  = &NSQ->sLTP_shp_FLP[ NSQ->sLTP_shp_buf_idx - lag + HARM_SHAPE_FIR_TAPS / 2 ];
+    pred_lag_ptr = &sLTP_sc[ NSQ->sLTP_buf_idx - lag + LTP_ORDER / 2 ];
+    rdo_offset   = 0.5f * Lambda - 0.5f;
+
+    warping_4 = _mm_set1_ps( warping );
+    offset_4  = _mm_set1_ps( offset );
+    Lambda_4  = _mm_set1_ps( Lambda );
+    abs_mask  = _mm_castsi128_ps( _mm_set1_epi32( 0x7FFFFFFF ) );
+
+    for( i = 0; i < length; i++ ) {
+        /* Perform common calculations used in all states */
+
+        /* Long-term prediction */
+        if( signalType == TYPE_VOICED ) {
+            LTP_pred = pred_lag_ptr[  0 ] * b[ 0 ] + pred_lag_ptr[ -1 ] * b[ 1 ] + pred_lag_ptr[ -2 ] * b[ 2 ]
+                     + pred_lag_ptr[ -3 ] * b[ 3 ] + pred_lag_ptr[ -4 ] * b[ 4 ];
+            pred_lag_ptr++;
+        } else {
+            LTP_pred = 0.0f;
+        }
+
+        /* Long-term shaping */
+        if( lag > 0 ) {
+            /* Symmetric FIR coefficients */
+            n_LTP = LTP_pred - HarmShapeGain * ( 0.25f * ( shp_lag_ptr[ 0 ] + shp_lag_ptr[ -2 ] ) + 0.5f * shp_lag_ptr[ -1 ] );
+            shp_lag_ptr++;
+        } else {
+            n_LTP = 0.0f;
+        }
+
+        /* Generate dither */
+        seed = silk_RAND_sse2( _mm_loadu_si128( (__m128i *)psDelDec->Seed ) );
+        _mm_storeu_si128( (__m128i *)psDelDec->Seed, seed );
+        sign = _mm_castsi128_ps( _mm_and_si128( seed, _mm_set1_epi32( (opus_int32)0x80000000 ) ) );
+
+        /* Short-term prediction */
+        LPC_pred = _mm_setzero_ps();
+        for( j = 0; j < predictLPCOrder; j++ ) {
+            LPC_pred = _mm_add_ps( LPC_pred, _mm_mul_ps( _mm_loadu_ps( psDelDec->sLPC[ NSQ_LPC_BUF_LENGTH - 1 + i - j ] ),
+                _mm_set1_ps( a[ j ] ) ) );
+        }
+
+        /* Noise shape feedback */
+        silk_assert( ( shapingLPCOrder & 1 ) == 0 );   /* check that order is even */
+        Diff   = _mm_loadu_ps( psDelDec->Diff );
+        LF_AR  = _mm_loadu_ps( psDelDec->LF_AR );
+        sAR2_0 = _mm_loadu_ps( psDelDec->sAR2[ 0 ] );
+        sAR2_1 = _mm_loadu_ps( psDelDec->sAR2[ 1 ] );
+        /* Output of lowpass section */
+        tmp2 = _mm_add_ps( Diff, _mm_mul_ps( warping_4, sAR2_0 ) );
+        /* Output of allpass section */
+        tmp1 = _mm_add_ps( sAR2_0, _mm_mul_ps( warping_4, _mm_sub_ps( sAR2_1, tmp2 ) ) );
+        _mm_storeu_ps( psDelDec->sAR2[ 0 ], tmp2 );
+        n_AR = _mm_mul_ps( tmp2, _mm_set1_ps( AR_shp[ 0 ] ) );
+        /* Loop over allpass sections */
+        for( j = 2; j < shapingLPCOrder; j += 2 ) {
+            sAR2_0 = _mm_loadu_ps( psDelDec->sAR2[ j + 0 ] );
+            /* Output of allpass section */
+            tmp2 = _mm_add_ps( sAR2_1, _mm_mul_ps( warping_4, _mm_sub_ps( sAR2_0, tmp1 ) ) );
+            _mm_storeu_ps( psDelDec->sAR2[ j - 1 ], tmp1 );
+            n_AR = _mm_add_ps( n_AR, _mm_mul_ps( tmp1, _mm_set1_ps( AR_shp[ j - 1 ] ) ) );
+            sAR2_1 = _mm_loadu_ps( psDelDec->sAR2[ j + 1 ] );
+            /* Output of allpass section */
+            tmp1 = _mm_add_ps( sAR2_0, _mm_mul_ps( warping_4, _mm_sub_ps( sAR2_1, tmp2 ) ) );
+            _mm_storeu_ps( psDelDec->sAR2[ j + 0 ], tmp2 );
+            n_AR = _mm_add_ps( n_AR, _mm_mul_ps( tmp2, _mm_set1_ps( AR_shp[ j ] ) ) );
+        }
+        _mm_storeu_ps( psDelDec->sAR2[ shapingLPCOrder - 1 ], tmp1 );
+        n_AR = _mm_add_ps( n_AR, _mm_mul_ps( tmp1, _mm_set1_ps( AR_shp[ shapingLPCOrder - 1 ] ) ) );
+        n_AR = _mm_add_ps( n_AR, _mm_mul_ps( LF_AR, _mm_set1_ps( Tilt ) ) );
+
+        n_LF = _mm_add_ps( _mm_mul_ps( _mm_loadu_ps( psDelDec->Shape[ *smpl_buf_idx ] ), _mm_set1_ps( LF_MA_shp ) ),
+                           _mm_mul_ps( LF_AR, _mm_set1_ps( LF_AR_shp ) ) );
+
+        /* Input minus prediction plus noise feedback */
+        x = _mm_set1_ps( x_sc[ i ] );
+        r = _mm_sub_ps( x, _mm_sub_ps( _mm_add_ps( _mm_set1_ps( n_LTP ), LPC_pred ), _mm_add_ps( n_AR, n_LF ) ) );
+
+        /* Flip sign depending on dither */
+        r = _mm_xor_ps( r, sign );
+        r = _mm_min_ps( _mm_max_ps( r, _mm_set1_ps( -31.0f ) ), _mm_set1_ps( 30.0f ) );
+
+        /* Find two quantization level candidates and measure their rate-distortion */
+        q1 = _mm_sub_ps( r, offset_4 );
+        /* Rounds toward -inf, since q1 > -32 */
+        q1_Q0 = _mm_sub_epi32( _mm_cvttps_epi32( _mm_add_ps( q1, _mm_set1_ps( 32.0f ) ) ), _mm_set1_epi32( 32 ) );
+        if( Lambda > 2.0f ) {
+            /* For aggressive RDO, the bias becomes more than one pulse. */
+            __m128 rdo, above, below;
+            __m128i mid;
+            rdo   = _mm_set1_ps( rdo_offset );
+            above = _mm_cmpgt_ps( q1, rdo );
+            below = _mm_cmplt_ps( q1, _mm_xor_ps( rdo, _mm_set1_ps( -0.0f ) ) );
+            /* -1 for negative q1, 0 otherwise */
+            mid   = _mm_castps_si128( _mm_cmplt_ps( q1, _mm_setzero_ps() ) );
+            q1_Q0 = _mm_or_si128( _mm_and_si128( _mm_castps_si128( above ), _mm_cvttps_epi32( _mm_sub_ps( q1, rdo ) ) ),
+                    _mm_or_si128( _mm_and_si128( _mm_castps_si128( below ), _mm_sub_epi32( _mm_cvttps_epi32(
+                        _mm_add_ps( _mm_add_ps( q1, rdo ), _mm_set1_ps( 32.0f ) ) ), _mm_set1_epi32( 32 ) ) ),
+                    _mm_andnot_si128( _mm_castps_si128( _mm_or_ps( above, below ) ), mid ) ) );
+        }
+        q2_Q0 = _mm_add_epi32( q1_Q0, _mm_set1_epi32( 1 ) );
+        q1    = silk_nsq_level_FLP_sse2( q1_Q0, offset_4 );
+        q2    = silk_nsq_level_FLP_sse2( q2_Q0, offset_4 );
+        tmp1  = _mm_sub_ps( r, q1 );
+        rd1   = _mm_add_ps( _mm_mul_ps( _mm_and_ps( q1, abs_mask ), Lambda_4 ), _mm_mul_ps( tmp1, tmp1 ) );
+        tmp2  = _mm_sub_ps( r, q2 );
+        rd2   = _mm_add_ps( _mm_mul_ps( _mm_and_ps( q2, abs_mask ), Lambda_4 ), _mm_mul_ps( tmp2, tmp2 ) );
+
+        /* Sort the two candidates */
+        less  = _mm_cmplt_ps( rd1, rd2 );
+        RD    = _mm_loadu_ps( psDelDec->RD );
+        _mm_storeu_ps( psSampleState[ 0 ].RD, _mm_add_ps( RD, _mm_or_ps( _mm_and_ps( less, rd1 ), _mm_andnot_ps( less, rd2 ) ) ) );
+        _mm_storeu_ps( psSampleState[ 1 ].RD, _mm_add_ps( RD, _mm_or_ps( _mm_and_ps( less, rd2 ), _mm_andnot_ps( less, rd1 ) ) ) );
+        _mm_storeu_si128( (__m128i *)psSampleState[ 0 ].Q, _mm_or_si128( _mm_and_si128( _mm_castps_si128( less ), q1_Q0 ),
+            _mm_andnot_si128( _mm_castps_si128( less ), q2_Q0 ) ) );
+        _mm_storeu_si128( (__m128i *)psSampleState[ 1 ].Q, _mm_or_si128( _mm_and_si128( _mm_castps_si128( less ), q2_Q0 ),
+            _mm_andnot_si128( _mm_castps_si128( less ), q1_Q0 ) ) );
+        tmp1 = _mm_or_ps( _mm_and_ps( less, q1 ), _mm_andnot_ps( less, q2 ) );
+        tmp2 = _mm_or_ps( _mm_and_ps( less, q2 ), _mm_andnot_ps( less, q1 ) );
+
+        /* Update states for best and second best quantization */
+        for( k = 0; k < 2; k++ ) {
+            /* Quantized excitation, with the dither sign */
+            LPC_exc = _mm_add_ps( _mm_xor_ps( k == 0 ? tmp1 : tmp2, sign ), _mm_set1_ps( LTP_pred ) );
+            xq_sc   = _mm_add_ps( LPC_exc, LPC_pred );
+            Diff    = _mm_sub_ps( xq_sc, x );
+            LF_AR   = _mm_sub_ps( Diff, n_AR );
+            _mm_storeu_ps( psSampleState[ k ].Diff, Diff );
+            _mm_storeu_ps( psSampleState[ k ].LF_AR, LF_AR );
+            _mm_storeu_ps( psSampleState[ k ].sLTP_shp, _mm_sub_ps( LF_AR, n_LF ) );
+            _mm_storeu_ps( psSampleState[ k ].LPC_exc, LPC_exc );
+            _mm_storeu_ps( psSampleState[ k ].xq, xq_sc );
+        }
+
+        *smpl_buf_idx  = ( *smpl_buf_idx - 1 ) % DECISION_DELAY;
+        if( *smpl_buf_idx < 0 ) *smpl_buf_idx += DECISION_DELAY;
+        last_smple_idx = ( *smpl_buf_idx + decisionDelay ) % DECISION_DELAY;
+
+        /* Find winner */
+        RDmin = psSampleState[ 0 ].RD[ 0 ];
+        Winner_ind = 0;
+        for( k = 1; k < nStatesDelayedDecision; k++ ) {
+            if( psSampleState[ 0 ].RD[ k ] < RDmin ) {
+                RDmin = psSampleState[ 0 ].RD[ k ];
+                Winner_ind = k;
+            }
+        }
+
+        /* Increase RD values of expired states */
+        Winner_rand_state = psDelDec->RandState[ last_smple_idx ][ Winner_ind ];
+        for( k = 0; k < nStatesDelayedDecision; k++ ) {
+            if( psDelDec->RandState[ last_smple_idx ][ k ] != Winner_rand_state ) {
+                psSampleState[ 0 ].RD[ k ] += NSQ_DEL_DEC_PENALTY_FLP;
+                psSampleState[ 1 ].RD[ k ] += NSQ_DEL_DEC_PENALTY_FLP;
+            }
+        }
+
+        /* Find worst in first set and best in second set */
+        RDmax     = psSampleState[ 0 ].RD[ 0 ];
+        RDmin     = psSampleState[ 1 ].RD[ 0 ];
+        RDmax_ind = 0;
+        RDmin_ind = 0;
+        for( k = 1; k < nStatesDelayedDecision; k++ ) {
+            /* find worst in first set */
+            if( psSampleState[ 0 ].RD[ k ] > RDmax ) {
+                RDmax     = psSampleState[ 0 ].RD[ k ];
+                RDmax_ind = k;
+            }
+            /* find best in second set */
+            if( psSampleState[ 1 ].RD[ k ] < RDmin ) {
+                RDmin     = psSampleState[ 1 ].RD[ k ];
+                RDmin_ind = k;
+            }
+        }
+
+        /* Replace a state if best from second set outperforms worst in first set */
+        if( RDmin < RDmax ) {
+            silk_nsq_del_dec_copy_state_FLP( psDelDec, RDmax_ind, RDmin_ind, i );
+            psSampleState[ 0 ].Q[        RDmax_ind ] = psSampleState[ 1 ].Q[        RDmin_ind ];
+            psSampleState[ 0 ].RD[       RDmax_ind ] = psSampleState[ 1 ].RD[       RDmin_ind ];
+            psSampleState[ 0 ].xq[       RDmax_ind ] = psSampleState[ 1 ].xq[       RDmin_ind ];
+            psSampleState[ 0 ].LF_AR[    RDmax_ind ] = psSampleState[ 1 ].LF_AR[    RDmin_ind ];
+            psSampleState[ 0 ].Diff[     RDmax_ind ] = psSampleState[ 1 ].Diff[     RDmin_ind ];
+            psSampleState[ 0 ].sLTP_shp[ RDmax_ind ] = psSampleState[ 1 ].sLTP_shp[ RDmin_ind ];
+            psSampleState[ 0 ].LPC_exc[  RDmax_ind ] = psSampleState[ 1 ].LPC_exc[  RDmin_ind ];
+        }
+
+        /* Write samples from winner to output and long-term filter states */
+        if( subfr > 0 || i >= decisionDelay ) {
+            pulses[  i - decisionDelay ] = (opus_int8)psDelDec->Q[ last_smple_idx ][ Winner_ind ];
+            xq[ i - decisionDelay ] = silk_LIMIT( psDelDec->Xq[ last_smple_idx ][ Winner_ind ] * delayedGain[ last_smple_idx ],
+                -32768.0f, 32767.0f );
+            NSQ->sLTP_shp_FLP[ NSQ->sLTP_shp_buf_idx - decisionDelay ] = psDelDec->Shape[ last_smple_idx ][ Winner_ind ];
+            sLTP_sc[           NSQ->sLTP_buf_idx     - decisionDelay ] = psDelDec->Pred[  last_smple_idx ][ Winner_ind ];
+        }
+        NSQ->sLTP_shp_buf_idx++;
+        NSQ->sLTP_buf_idx++;
+
+        /* Update states */
+        xq_sc = _mm_loadu_ps( psSampleState[ 0 ].xq );
+        q1_Q0 = _mm_loadu_si128( (__m128i *)psSampleState[ 0 ].Q );
+        seed  = _mm_add_epi32( _mm_loadu_si128( (__m128i *)psDelDec->Seed ), q1_Q0 );
+        _mm_storeu_ps( psDelDec->LF_AR, _mm_loadu_ps( psSampleState[ 0 ].LF_AR ) );
+        _mm_storeu_ps( psDelDec->Diff, _mm_loadu_ps( psSampleState[ 0 ].Diff ) );
+        _mm_storeu_ps( psDelDec->sLPC[ NSQ_LPC_BUF_LENGTH + i ], xq_sc );
+        _mm_storeu_ps( psDelDec->Xq[ *smpl_buf_idx ], xq_sc );
+        _mm_storeu_si128( (__m128i *)psDelDec->Q[ *smpl_buf_idx ], q1_Q0 );
+        _mm_storeu_ps( psDelDec->Pred[ *smpl_buf_idx ], _mm_loadu_ps( psSampleState[ 0 ].LPC_exc ) );
+        _mm_storeu_ps( psDelDec->Shape[ *smpl_buf_idx ], _mm_loadu_ps( psSampleState[ 0 ].sLTP_shp ) );
+        _mm_storeu_si128( (__m128i *)psDelDec->Seed, seed );
+        _mm_storeu_si128( (__m128i *)psDelDec->RandState[ *smpl_buf_idx ], seed );
+        _mm_storeu_ps( psDelDec->RD, _mm_loadu_ps( psSampleState[ 0 ].RD ) );
+        delayedGain[ *smpl_buf_idx ] = Gain;
+    }
+    /* Update LPC states */
+    silk_memcpy( psDelDec->sLPC, psDelDec->sLPC[ length ], NSQ_LPC_BUF_LENGTH * sizeof( psDelDec->sLPC[ 0 ] ) );
+}
+
+#endif
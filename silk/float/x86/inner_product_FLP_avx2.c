@@ -0,0 +1,110 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+#include "SigProc_FLP.h"
+
+/* Same as silk_inner_product_FLP_c(), but keeping eight partial sums in
+   two double vectors. Products of floats are exact in double, so the FMA
+   rounds the same as a separate multiply and add, and only the order of
+   the additions changes. */
+double silk_inner_product_FLP_avx2(
+    const silk_float    *data1,
+    const silk_float    *data2,
+    opus_int            dataSize
+)
+{
+    opus_int i;
+    double   result;
+    __m256d  acc0, acc1;
+    __m128d  sum;
+
+    acc0 = _mm256_setzero_pd();
+    acc1 = _mm256_setzero_pd();
+    for( i = 0; i < dataSize - 7; i += 8 ) {
+        acc0 = _mm256_fmadd_pd( _mm256_cvtps_pd( _mm_loadu_ps( &data1[ i ] ) ),
+                                _mm256_cvtps_pd( _mm_loadu_ps( &data2[ i ] ) ), acc0 );
+        acc1 = _mm256_fmadd_pd( _mm256_cvtps_pd( _mm_loadu_ps( &data1[ i + 4 ] ) ),
+                                _mm256_cvtps_pd( _mm_loadu_ps( &data2[ i + 4 ] ) ), acc1 );
+    }
+    if( i < dataSize - 3 ) {
+        acc0 = _mm256_fmadd_pd( _mm256_cvtps_pd( _mm_loadu_ps( &data1[ i ] ) ),
+                                _mm256_cvtps_pd( _mm_loadu_ps( &data2[ i ] ) ), acc0 );
+        i += 4;
+    }
+    acc0 = _mm256_add_pd( acc0, acc1 );
+    sum = _mm_add_pd( _mm256_castpd256_pd128( acc0 ), _mm256_extractf128_pd( acc0, 1 ) );
+    sum = _mm_add_sd( sum, _mm_unpackhi_pd( sum, sum ) );
+    result = _mm_cvtsd_f64( sum );
+
+    /* add any remaining products */
+    for( ; i < dataSize; i++ ) {
+        result += data1[ i ] * (double)data2[ i ];
+    }
+
+    return result;
+}
+
+double silk_energy_FLP_avx2(
+    const silk_float    *data,
+    opus_int            dataSize
+)
+{
+    opus_int i;
+    double   result;
+    __m256d  acc0, acc1, x;
+    __m128d  sum;
+
+    acc0 = _mm256_setzero_pd();
+    acc1 = _mm256_setzero_pd();
+    for( i = 0; i < dataSize - 7; i += 8 ) {
+        x = _mm256_cvtps_pd( _mm_loadu_ps( &data[ i ] ) );
+        acc0 = _mm256_fmadd_pd( x, x, acc0 );
+        x = _mm256_cvtps_pd( _mm_loadu_ps( &data[ i + 4 ] ) );
+        acc1 = _mm256_fmadd_pd( x, x, acc1 );
+    }
+    if( i < dataSize - 3 ) {
+        x = _mm256_cvtps_pd( _mm_loadu_ps( &data[ i ] ) );
+        acc0 = _mm256_fmadd_pd( x, x, acc0 );
+        i += 4;
+    }
+    acc0 = _mm256_add_pd( acc0, acc1 );
+    sum = _mm_add_pd( _mm256_castpd256_pd128( acc0 ), _mm256_extractf128_pd( acc0, 1 ) );
+    sum = _mm_add_sd( sum, _mm_unpackhi_pd( sum, sum ) );
+    result = _mm_cvtsd_f64( sum );
+
+    /* add any remaining products */
+    for( ; i < dataSize; i++ ) {
+        result += data[ i ] * (double)data[ i ];
+    }
+
+    silk_assert( result >= 0.0 );
+    return result;
+}
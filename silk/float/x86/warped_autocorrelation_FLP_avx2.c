@@ -0,0 +1,115 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+
+#include "main_FLP.h"
+#include "stack_alloc.h"
+
+/* Number of allpass sections handled per pass over the input */
+#define WARPED_BLOCK    8
+
+/* hi shifted up by one lane, with lane 3 of lo shifted into lane 0 */
+static OPUS_INLINE __m256d shift_in_pd( __m256d lo, __m256d hi )
+{
+    return _mm256_shuffle_pd( _mm256_permute2f128_pd( lo, hi, 0x21 ), hi, 0x5 );
+}
+
+/* Same wavefront as silk_warped_autocorrelation_FLP_sse2(), four sections
+   per vector. The FMAs round once where the C code rounds twice, so results
+   can differ from it in the last bits. */
+void silk_warped_autocorrelation_FLP_avx2(
+    silk_float                      *corr,                              /* O    Result [order + 1]                          */
+    const silk_float                *input,                             /* I    Input data to correlate                     */
+    const silk_float                warping,                            /* I    Warping coefficient                         */
+    const opus_int                  length,                             /* I    Length of input                             */
+    const opus_int                  order                               /* I    Correlation order (even)                    */
+)
+{
+    opus_int    n, i, b, t, steps;
+    double      C[ MAX_SHAPE_LPC_ORDER + WARPED_BLOCK ];
+    double      *state, *input_rev;
+    __m256d     ymm_warping;
+    VARDECL( double, stateT );
+    VARDECL( double, input_revT );
+    SAVE_STACK;
+
+    /* Order must be even */
+    silk_assert( ( order & 1 ) == 0 );
+    silk_assert( order <= MAX_SHAPE_LPC_ORDER );
+
+    steps = length + WARPED_BLOCK - 1;
+    ALLOC( stateT, length + 2 * WARPED_BLOCK, double );
+    ALLOC( input_revT, length + 2 * WARPED_BLOCK, double );
+    state = stateT + WARPED_BLOCK;
+    input_rev = input_revT + length + WARPED_BLOCK - 1;
+    for( n = 0; n < length + 2 * WARPED_BLOCK; n++ ) {
+        stateT[ n ] = 0;
+        input_revT[ n ] = 0;
+    }
+    C[ 0 ] = 0;
+    for( n = 0; n < length; n++ ) {
+        state[ n ] = input[ n ];
+        input_rev[ -n ] = input[ n ];
+        C[ 0 ] += state[ n ] * state[ n ];
+    }
+
+    ymm_warping = _mm256_set1_pd( warping );
+    for( b = 0; b < order; b += WARPED_BLOCK ) {
+        __m256d ymm_P0, ymm_P1, ymm_Q0, ymm_Q1, ymm_S0, ymm_S1, ymm_C0, ymm_C1;
+
+        ymm_P0 = ymm_P1 = ymm_Q0 = ymm_Q1 = _mm256_setzero_pd();
+        ymm_C0 = ymm_C1 = _mm256_setzero_pd();
+        for( t = 0; t < steps; t++ ) {
+            ymm_S0 = shift_in_pd( _mm256_loadu_pd( &state[ t - 3 ] ), ymm_P0 );
+            ymm_S1 = shift_in_pd( ymm_P0, ymm_P1 );
+
+            /* Output of allpass section */
+            ymm_P0 = _mm256_fmadd_pd( ymm_warping, _mm256_sub_pd( ymm_P0, ymm_S0 ), ymm_Q0 );
+            ymm_P1 = _mm256_fmadd_pd( ymm_warping, _mm256_sub_pd( ymm_P1, ymm_S1 ), ymm_Q1 );
+            ymm_Q0 = ymm_S0;
+            ymm_Q1 = ymm_S1;
+
+            ymm_C0 = _mm256_fmadd_pd( _mm256_loadu_pd( &input_rev[ -t + 0 ] ), ymm_P0, ymm_C0 );
+            ymm_C1 = _mm256_fmadd_pd( _mm256_loadu_pd( &input_rev[ -t + 4 ] ), ymm_P1, ymm_C1 );
+
+            /* Last section, sample t - 7, becomes the next block's input */
+            _mm_storeh_pd( &state[ t - ( WARPED_BLOCK - 1 ) ], _mm256_extractf128_pd( ymm_P1, 1 ) );
+        }
+        _mm256_storeu_pd( &C[ b + 1 ], ymm_C0 );
+        _mm256_storeu_pd( &C[ b + 5 ], ymm_C1 );
+    }
+
+    /* Copy correlations in silk_float output format */
+    for( i = 0; i < order + 1; i++ ) {
+        corr[ i ] = ( silk_float )C[ i ];
+    }
+    RESTORE_STACK;
+}
@@ -0,0 +1,131 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <emmintrin.h>
+
+#include "main_FLP.h"
+#include "stack_alloc.h"
+
+/* Number of allpass sections handled per pass over the input */
+#define WARPED_BLOCK    8
+
+/* Same as silk_warped_autocorrelation_FLP_c(), evaluated as a wavefront:
+   at step t, lane j of a block of sections b + 1 ... b + WARPED_BLOCK holds
+   the output of section b + j + 1 for sample t - j, which only depends on
+   lanes j - 1 and j of the previous step and lane j - 1 of the step before.
+   Every value goes through the same operations in the same order as in the
+   C code, so the result is bit-exact. */
+void silk_warped_autocorrelation_FLP_sse2(
+    silk_float                      *corr,                              /* O    Result [order + 1]                          */
+    const silk_float                *input,                             /* I    Input data to correlate                     */
+    const silk_float                warping,                            /* I    Warping coefficient                         */
+    const opus_int                  length,                             /* I    Length of input                             */
+    const opus_int                  order                               /* I    Correlation order (even)                    */
+)
+{
+    opus_int    n, i, b, t, steps;
+    double      C[ MAX_SHAPE_LPC_ORDER + WARPED_BLOCK ];
+    double      *state, *input_rev;
+    __m128d     xmm_warping;
+    VARDECL( double, stateT );
+    VARDECL( double, input_revT );
+    SAVE_STACK;
+
+    /* Order must be even */
+    silk_assert( ( order & 1 ) == 0 );
+    silk_assert( order <= MAX_SHAPE_LPC_ORDER );
+
+    /* state[ n ] is the output of section b for sample n, i.e. the input of
+       the current block. The block overwrites it in place, a few samples
+       behind, with the output of its last section for the next block. */
+    steps = length + WARPED_BLOCK - 1;
+    ALLOC( stateT, length + 2 * WARPED_BLOCK, double );
+    ALLOC( input_revT, length + 2 * WARPED_BLOCK, double );
+    state = stateT + WARPED_BLOCK;
+    /* input_rev[ -n ] = input[ n ], so that lane j can load sample t - j */
+    input_rev = input_revT + length + WARPED_BLOCK - 1;
+    for( n = 0; n < length + 2 * WARPED_BLOCK; n++ ) {
+        stateT[ n ] = 0;
+        input_revT[ n ] = 0;
+    }
+    C[ 0 ] = 0;
+    for( n = 0; n < length; n++ ) {
+        state[ n ] = input[ n ];
+        input_rev[ -n ] = input[ n ];
+        C[ 0 ] += state[ n ] * state[ n ];
+    }
+
+    xmm_warping = _mm_set1_pd( warping );
+    for( b = 0; b < order; b += WARPED_BLOCK ) {
+        __m128d xmm_P0, xmm_P1, xmm_P2, xmm_P3, xmm_Q0, xmm_Q1, xmm_Q2, xmm_Q3;
+        __m128d xmm_S0, xmm_S1, xmm_S2, xmm_S3;
+        __m128d xmm_C0, xmm_C1, xmm_C2, xmm_C3;
+
+        xmm_P0 = xmm_P1 = xmm_P2 = xmm_P3 = _mm_setzero_pd();
+        xmm_Q0 = xmm_Q1 = xmm_Q2 = xmm_Q3 = _mm_setzero_pd();
+        xmm_C0 = xmm_C1 = xmm_C2 = xmm_C3 = _mm_setzero_pd();
+        for( t = 0; t < steps; t++ ) {
+            /* Previous step shifted up by one lane, with the block input for
+               sample t in lane 0 */
+            xmm_S0 = _mm_shuffle_pd( _mm_loadu_pd( &state[ t - 1 ] ), xmm_P0, 1 );
+            xmm_S1 = _mm_shuffle_pd( xmm_P0, xmm_P1, 1 );
+            xmm_S2 = _mm_shuffle_pd( xmm_P1, xmm_P2, 1 );
+            xmm_S3 = _mm_shuffle_pd( xmm_P2, xmm_P3, 1 );
+
+            /* Output of allpass section */
+            xmm_P0 = _mm_add_pd( xmm_Q0, _mm_mul_pd( xmm_warping, _mm_sub_pd( xmm_P0, xmm_S0 ) ) );
+            xmm_P1 = _mm_add_pd( xmm_Q1, _mm_mul_pd( xmm_warping, _mm_sub_pd( xmm_P1, xmm_S1 ) ) );
+            xmm_P2 = _mm_add_pd( xmm_Q2, _mm_mul_pd( xmm_warping, _mm_sub_pd( xmm_P2, xmm_S2 ) ) );
+            xmm_P3 = _mm_add_pd( xmm_Q3, _mm_mul_pd( xmm_warping, _mm_sub_pd( xmm_P3, xmm_S3 ) ) );
+            xmm_Q0 = xmm_S0;
+            xmm_Q1 = xmm_S1;
+            xmm_Q2 = xmm_S2;
+            xmm_Q3 = xmm_S3;
+
+            xmm_C0 = _mm_add_pd( xmm_C0, _mm_mul_pd( _mm_loadu_pd( &input_rev[ -t + 0 ] ), xmm_P0 ) );
+            xmm_C1 = _mm_add_pd( xmm_C1, _mm_mul_pd( _mm_loadu_pd( &input_rev[ -t + 2 ] ), xmm_P1 ) );
+            xmm_C2 = _mm_add_pd( xmm_C2, _mm_mul_pd( _mm_loadu_pd( &input_rev[ -t + 4 ] ), xmm_P2 ) );
+            xmm_C3 = _mm_add_pd( xmm_C3, _mm_mul_pd( _mm_loadu_pd( &input_rev[ -t + 6 ] ), xmm_P3 ) );
+
+            /* Last section, sample t - 7, becomes the next block's input */
+            _mm_storeh_pd( &state[ t - ( WARPED_BLOCK - 1 ) ], xmm_P3 );
+        }
+        _mm_storeu_pd( &C[ b + 1 ], xmm_C0 );
+        _mm_storeu_pd( &C[ b + 3 ], xmm_C1 );
+        _mm_storeu_pd( &C[ b + 5 ], xmm_C2 );
+        _mm_storeu_pd( &C[ b + 7 ], xmm_C3 );
+    }
+
+    /* Copy correlations in silk_float output format */
+    for( i = 0; i < order + 1; i++ ) {
+        corr[ i ] = ( silk_float )C[ i ];
+    }
+    RESTORE_STACK;
+}
@@ -342,12 +342,13 @@ opus_int32 silk_NLSF_encode(                                    /* O    Returns
     const opus_int16            *pW_QW,                         /* I    NLSF weight vector [ LPC_ORDER ]            */
     const opus_int              NLSF_mu_Q20,                    /* I    Rate weight for the RD optimization         */
     const opus_int              nSurvivors,                     /* I    Max survivors after first stage             */
-    const opus_int              signalType                      /* I    Signal type: 0/1/2                          */
+    const opus_int              signalType,                     /* I    Signal type: 0/1/2                          */
+    int                         arch                            /* I    Run-time architecture                       */
 );
 
 /* Compute quantization errors for an LPC_order element input vector for a VQ codebook */
-void silk_NLSF_VQ(
-    opus_int32                  err_Q26[],                      /* O    Quantization errors [K]                     */
+void silk_NLSF_VQ_c(
+    opus_int32                  err_Q24[],                      /* O    Quantization errors [K]                     */
     const opus_int16            in_Q15[],                       /* I    Input vectors to be quantized [LPC_order]   */
     const opus_uint8            pCB_Q8[],                       /* I    Codebook vectors [K*LPC_order]              */
     const opus_int16            pWght_Q9[],                     /* I    Codebook weights [K*LPC_order]              */
@@ -355,6 +356,11 @@ void silk_NLSF_VQ(
     const opus_int              LPC_order                       /* I    Number of LPCs                              */
 );
 
+#if !defined(OVERRIDE_silk_NLSF_VQ)
+#define silk_NLSF_VQ(err_Q24, in_Q15, pCB_Q8, pWght_Q9, K, LPC_order, arch) \
+    ((void)(arch),silk_NLSF_VQ_c(err_Q24, in_Q15, pCB_Q8, pWght_Q9, K, LPC_order))
+#endif
+
 /* Delayed-decision quantizer for NLSF residuals */
 opus_int32 silk_NLSF_del_dec_quant(                             /* O    Returns RD value in Q25                     */
     opus_int8                   indices[],                      /* O    Quantization indices [ order ]              */
@@ -366,6 +372,7 @@ opus_int32 silk_NLSF_del_dec_quant(                             /* O    Returns
     const opus_int              quant_step_size_Q16,            /* I    Quantization step size                      */
     const opus_int16            inv_quant_step_size_Q6,         /* I    Inverse quantization step size              */
     const opus_int32            mu_Q20,                         /* I    R/D tradeoff                                */
+    const opus_int32            RD_bound_Q25,                   /* I    Give up once every state reaches this RD    */
     const opus_int16            order                           /* I    Number of input values                      */
 );
 
@@ -430,7 +437,7 @@ void silk_decode_parameters(
 );
 
 /* Core decoder. Performs inverse NSQ operation LTP + LPC */
-void silk_decode_core(
+void silk_decode_core_c(
     silk_decoder_state          *psDec,                         /* I/O  Decoder state                               */
     silk_decoder_control        *psDecCtrl,                     /* I    Decoder control                             */
     opus_int16                  xq[],                           /* O    Decoded speech                              */
@@ -438,6 +445,11 @@ void silk_decode_core(
     int                         arch                            /* I    Run-time architecture                       */
 );
 
+#if !defined(OVERRIDE_silk_decode_core)
+#define silk_decode_core(psDec, psDecCtrl, xq, pulses, arch) \
+    (silk_decode_core_c(psDec, psDecCtrl, xq, pulses, arch))
+#endif
+
 /* Decode quantization indices of excitation (Shell coding) */
 void silk_decode_pulses(
     ec_dec                      *psRangeDec,                    /* I/O  Compressor data structure                   */
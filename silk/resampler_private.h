@@ -46,7 +46,8 @@ void silk_resampler_private_IIR_FIR(
     void                            *SS,            /* I/O  Resampler state             */
     opus_int16                      out[],          /* O    Output signal               */
     const opus_int16                in[],           /* I    Input signal                */
-    opus_int32                      inLen           /* I    Number of input samples     */
+    opus_int32                      inLen,          /* I    Number of input samples     */
+    int                             arch            /* I    Run-time architecture       */
 );
 
 /* Description: Hybrid IIR/FIR polyphase implementation of resampling */
@@ -54,7 +55,8 @@ void silk_resampler_private_down_FIR(
     void                            *SS,            /* I/O  Resampler state             */
     opus_int16                      out[],          /* O    Output signal               */
     const opus_int16                in[],           /* I    Input signal                */
-    opus_int32                      inLen           /* I    Number of input samples     */
+    opus_int32                      inLen,          /* I    Number of input samples     */
+    int                             arch            /* I    Run-time architecture       */
 );
 
 /* Upsample by a factor 2, high quality */
@@ -82,6 +84,39 @@ void silk_resampler_private_AR2(
     opus_int32                      len             /* I    Signal length               */
 );
 
+/* FIR interpolation of the 2x upsampled signal, used by silk_resampler_private_IIR_FIR() */
+opus_int16 *silk_resampler_private_IIR_FIR_INTERPOL_c(
+    opus_int16                      *out,           /* O    Output signal               */
+    opus_int16                      *buf,           /* I    Upsampled input signal      */
+    opus_int32                      max_index_Q16,  /* I    End of the input, Q16       */
+    opus_int32                      index_increment_Q16 /* I Input step per output, Q16 */
+);
+
+/* FIR interpolation of the AR2 filtered signal, used by silk_resampler_private_down_FIR() */
+opus_int16 *silk_resampler_private_down_FIR_INTERPOL_c(
+    opus_int16                      *out,           /* O    Output signal               */
+    opus_int32                      *buf,           /* I    Filtered input signal, Q8   */
+    const opus_int16                *FIR_Coefs,     /* I    FIR coefficients, Q14       */
+    opus_int                        FIR_Order,      /* I    FIR filter order            */
+    opus_int                        FIR_Fracs,      /* I    Number of FIR phases        */
+    opus_int32                      max_index_Q16,  /* I    End of the input, Q16       */
+    opus_int32                      index_increment_Q16 /* I Input step per output, Q16 */
+);
+
+#if defined(OPUS_X86_MAY_HAVE_SSE4_1) || defined(OPUS_X86_MAY_HAVE_AVX2)
+#include "x86/resampler_sse.h"
+#endif
+
+#if !defined(OVERRIDE_silk_resampler_private_IIR_FIR_INTERPOL)
+#define silk_resampler_private_IIR_FIR_INTERPOL(out, buf, max_index_Q16, index_increment_Q16, arch) \
+    ((void)(arch), silk_resampler_private_IIR_FIR_INTERPOL_c(out, buf, max_index_Q16, index_increment_Q16))
+#endif
+
+#if !defined(OVERRIDE_silk_resampler_private_down_FIR_INTERPOL)
+#define silk_resampler_private_down_FIR_INTERPOL(out, buf, FIR_Coefs, FIR_Order, FIR_Fracs, max_index_Q16, index_increment_Q16, arch) \
+    ((void)(arch), silk_resampler_private_down_FIR_INTERPOL_c(out, buf, FIR_Coefs, FIR_Order, FIR_Fracs, max_index_Q16, index_increment_Q16))
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -55,6 +55,15 @@ typedef struct {
     opus_int32                  rand_seed;
     opus_int32                  prev_gain_Q16;
     opus_int                    rewhite_flag;
+#ifdef ENABLE_FLOAT_NSQ
+    /* States of the floating-point quantizer, in the same units as the ones above */
+    silk_float                  xq_FLP[           2 * MAX_FRAME_LENGTH ];
+    silk_float                  sLTP_shp_FLP[     2 * MAX_FRAME_LENGTH ];
+    silk_float                  sLPC_FLP[ MAX_SUB_FRAME_LENGTH + NSQ_LPC_BUF_LENGTH ];
+    silk_float                  sAR2_FLP[ MAX_SHAPE_LPC_ORDER ];
+    silk_float                  sLF_AR_shp_FLP;
+    silk_float                  sDiff_shp_FLP;
+#endif
 } silk_nsq_state;
 
 /********************************/
@@ -0,0 +1,139 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#include <smmintrin.h>
+#include "main.h"
+#include "celt/x86/x86cpu.h"
+
+/* Weighted absolute predictive error of one codebook vector, as four partial sums. in_hi_Q15 and the */
+/* second half of the codebook vector hold elements 8 and up, zero-padded to 8 elements for order 10. */
+static OPUS_INLINE __m128i silk_NLSF_VQ_err_sse4_1(
+    const __m128i               in_lo_Q15,
+    const __m128i               in_hi_Q15,
+    __m128i                     cb_lo_Q8,
+    __m128i                     cb_hi_Q8,
+    const __m128i               w_lo_Q9,
+    const __m128i               w_hi_Q9
+)
+{
+    __m128i diff_lo_Q15, diff_hi_Q15, prod_lo, prod_hi;
+    __m128i diffw0_Q24, diffw1_Q24, diffw2_Q24, diffw3_Q24, err_Q24;
+
+    /* Codebook entries fit in 15 bits after the shift, so the difference stays within 16 bits */
+    cb_lo_Q8 = _mm_slli_epi16( _mm_cvtepu8_epi16( cb_lo_Q8 ), 7 );
+    cb_hi_Q8 = _mm_slli_epi16( _mm_cvtepu8_epi16( cb_hi_Q8 ), 7 );
+    diff_lo_Q15 = _mm_sub_epi16( in_lo_Q15, cb_lo_Q8 );
+    diff_hi_Q15 = _mm_sub_epi16( in_hi_Q15, cb_hi_Q8 );
+
+    /* Full 32-bit products, as silk_SMULBB() */
+    prod_lo = _mm_mullo_epi16( diff_lo_Q15, w_lo_Q9 );
+    prod_hi = _mm_mulhi_epi16( diff_lo_Q15, w_lo_Q9 );
+    diffw0_Q24 = _mm_unpacklo_epi16( prod_lo, prod_hi );
+    diffw1_Q24 = _mm_unpackhi_epi16( prod_lo, prod_hi );
+    prod_lo = _mm_mullo_epi16( diff_hi_Q15, w_hi_Q9 );
+    prod_hi = _mm_mulhi_epi16( diff_hi_Q15, w_hi_Q9 );
+    diffw2_Q24 = _mm_unpacklo_epi16( prod_lo, prod_hi );
+    diffw3_Q24 = _mm_unpackhi_epi16( prod_lo, prod_hi );
+
+    /* Element m is predicted from element m + 1; past the last element the prediction is zero */
+    err_Q24 = _mm_abs_epi32( _mm_sub_epi32( diffw0_Q24,
+        _mm_srai_epi32( _mm_alignr_epi8( diffw1_Q24, diffw0_Q24, 4 ), 1 ) ) );
+    err_Q24 = _mm_add_epi32( err_Q24, _mm_abs_epi32( _mm_sub_epi32( diffw1_Q24,
+        _mm_srai_epi32( _mm_alignr_epi8( diffw2_Q24, diffw1_Q24, 4 ), 1 ) ) ) );
+    err_Q24 = _mm_add_epi32( err_Q24, _mm_abs_epi32( _mm_sub_epi32( diffw2_Q24,
+        _mm_srai_epi32( _mm_alignr_epi8( diffw3_Q24, diffw2_Q24, 4 ), 1 ) ) ) );
+    err_Q24 = _mm_add_epi32( err_Q24, _mm_abs_epi32( _mm_sub_epi32( diffw3_Q24,
+        _mm_srai_epi32( _mm_srli_si128( diffw3_Q24, 4 ), 1 ) ) ) );
+    return err_Q24;
+}
+
+/* Compute quantization errors for an LPC_order element input vector for a VQ codebook */
+void silk_NLSF_VQ_sse4_1(
+    opus_int32                  err_Q24[],                      /* O    Quantization errors [K]                     */
+    const opus_int16            in_Q15[],                       /* I    Input vectors to be quantized [LPC_order]   */
+    const opus_uint8            pCB_Q8[],                       /* I    Codebook vectors [K*LPC_order]              */
+    const opus_int16            pWght_Q9[],                     /* I    Codebook weights [K*LPC_order]              */
+    const opus_int              K,                              /* I    Number of codebook vectors                  */
+    const opus_int              LPC_order                       /* I    Number of LPCs                              */
+)
+{
+    opus_int         i, j;
+    opus_int         hi_offset, hi_shift;
+    __m128i          in_lo_Q15, in_hi_Q15, err_Q24_vec[ 4 ];
+    const opus_int16 *w_Q9_ptr;
+    const opus_uint8 *cb_Q8_ptr;
+
+    if( LPC_order != 16 && LPC_order != 10 ) {
+        silk_NLSF_VQ_c( err_Q24, in_Q15, pCB_Q8, pWght_Q9, K, LPC_order );
+        return;
+    }
+
+    /* Elements 8 and up are loaded from offset hi_offset and moved down by hi_shift bytes, */
+    /* so that for order 10 the loads stay within the vector and the unused lanes are zero. */
+    hi_offset = LPC_order - 8;
+    hi_shift = 16 - LPC_order;
+    in_lo_Q15 = _mm_loadu_si128( (__m128i *)&in_Q15[ 0 ] );
+    in_hi_Q15 = _mm_loadu_si128( (__m128i *)&in_Q15[ hi_offset ] );
+    if( hi_shift ) {
+        in_hi_Q15 = _mm_srli_si128( in_hi_Q15, 12 );
+    }
+
+    /* Loop over codebook, four vectors at a time */
+    cb_Q8_ptr = pCB_Q8;
+    w_Q9_ptr = pWght_Q9;
+    for( i = 0; i < K; i += 4 ) {
+        for( j = 0; j < 4 && i + j < K; j++ ) {
+            __m128i cb_hi_Q8, w_hi_Q9;
+            cb_hi_Q8 = _mm_loadl_epi64( (__m128i *)&cb_Q8_ptr[ hi_offset ] );
+            w_hi_Q9 = _mm_loadu_si128( (__m128i *)&w_Q9_ptr[ hi_offset ] );
+            if( hi_shift ) {
+                cb_hi_Q8 = _mm_srli_si128( cb_hi_Q8, 6 );
+                w_hi_Q9 = _mm_srli_si128( w_hi_Q9, 12 );
+            }
+            err_Q24_vec[ j ] = silk_NLSF_VQ_err_sse4_1( in_lo_Q15, in_hi_Q15,
+                _mm_loadl_epi64( (__m128i *)&cb_Q8_ptr[ 0 ] ), cb_hi_Q8,
+                _mm_loadu_si128( (__m128i *)&w_Q9_ptr[ 0 ] ), w_hi_Q9 );
+            cb_Q8_ptr += LPC_order;
+            w_Q9_ptr += LPC_order;
+        }
+        if( j == 4 ) {
+            _mm_storeu_si128( (__m128i *)&err_Q24[ i ], _mm_hadd_epi32(
+                _mm_hadd_epi32( err_Q24_vec[ 0 ], err_Q24_vec[ 1 ] ),
+                _mm_hadd_epi32( err_Q24_vec[ 2 ], err_Q24_vec[ 3 ] ) ) );
+        } else {
+            while( j-- > 0 ) {
+                __m128i sum = _mm_hadd_epi32( err_Q24_vec[ j ], err_Q24_vec[ j ] );
+                err_Q24[ i + j ] = _mm_cvtsi128_si32( _mm_hadd_epi32( sum, sum ) );
+            }
+        }
+    }
+}
@@ -0,0 +1,118 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef NSQ_FLP_SSE_H
+#define NSQ_FLP_SSE_H
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2)
+
+void silk_noise_shape_quantizer_del_dec_FLP_sse2(
+    silk_nsq_state                  *NSQ,                   /* I/O  NSQ state                               */
+    NSQ_del_dec_FLP_struct          *psDelDec,              /* I/O  Delayed decision states                 */
+    opus_int                        signalType,             /* I    Signal type                             */
+    const silk_float                x_sc[],                 /* I    Scaled input                            */
+    opus_int8                       pulses[],               /* O    Quantized pulse signal                  */
+    silk_float                      xq[],                   /* O    Quantized output signal                 */
+    silk_float                      sLTP_sc[],              /* I/O  LTP filter state                        */
+    silk_float                      delayedGain[],          /* I/O  Gain delay buffer                       */
+    const silk_float                a[],                    /* I    Short term prediction coefs             */
+    const silk_float                b[],                    /* I    Long term prediction coefs              */
+    const silk_float                AR_shp[],               /* I    Noise shaping coefs                     */
+    opus_int                        lag,                    /* I    Pitch lag                               */
+    silk_float                      HarmShapeGain,          /* I    Long term shaping gain                  */
+    silk_float                      Tilt,                   /* I    Spectral tilt                           */
+    silk_float                      LF_MA_shp,              /* I    Low frequency MA shaping coef           */
+    silk_float                      LF_AR_shp,              /* I    Low frequency AR shaping coef           */
+    silk_float                      Gain,                   /* I    Quantization gain                       */
+    silk_float                      Lambda,                 /* I    Rate/distortion tradeoff                */
+    silk_float                      offset,                 /* I    Quantization offset                     */
+    opus_int                        length,                 /* I    Input length                            */
+    opus_int                        subfr,                  /* I    Subframe number                         */
+    opus_int                        shapingLPCOrder,        /* I    Shaping LPC filter order                */
+    opus_int                        predictLPCOrder,        /* I    Prediction filter order                 */
+    silk_float                      warping,                /* I    Warping coefficient                     */
+    opus_int                        nStatesDelayedDecision, /* I    Number of states in decision tree       */
+    opus_int                        *smpl_buf_idx,          /* I/O  Index to newest samples in buffers      */
+    opus_int                        decisionDelay           /* I    Decision delay                          */
+);
+
+#if defined(OPUS_X86_PRESUME_SSE2)
+
+#define OVERRIDE_silk_noise_shape_quantizer_del_dec_FLP
+#define silk_noise_shape_quantizer_del_dec_FLP(NSQ, psDelDec, signalType, x_sc, pulses, xq, sLTP_sc, delayedGain, \
+        a, b, AR_shp, lag, HarmShapeGain, Tilt, LF_MA_shp, LF_AR_shp, Gain, Lambda, offset, length, subfr, \
+        shapingLPCOrder, predictLPCOrder, warping, nStatesDelayedDecision, smpl_buf_idx, decisionDelay, arch) \
+    ((void)(arch), silk_noise_shape_quantizer_del_dec_FLP_sse2(NSQ, psDelDec, signalType, x_sc, pulses, xq, sLTP_sc, \
+        delayedGain, a, b, AR_shp, lag, HarmShapeGain, Tilt, LF_MA_shp, LF_AR_shp, Gain, Lambda, offset, length, \
+        subfr, shapingLPCOrder, predictLPCOrder, warping, nStatesDelayedDecision, smpl_buf_idx, decisionDelay))
+
+#else
+
+#define OVERRIDE_silk_noise_shape_quantizer_del_dec_FLP
+extern void (*const SILK_NOISE_SHAPE_QUANTIZER_DEL_DEC_FLP_IMPL[OPUS_ARCHMASK + 1])(
+    silk_nsq_state                  *NSQ,
+    NSQ_del_dec_FLP_struct          *psDelDec,
+    opus_int                        signalType,
+    const silk_float                x_sc[],
+    opus_int8                       pulses[],
+    silk_float                      xq[],
+    silk_float                      sLTP_sc[],
+    silk_float                      delayedGain[],
+    const silk_float                a[],
+    const silk_float                b[],
+    const silk_float                AR_shp[],
+    opus_int                        lag,
+    silk_float                      HarmShapeGain,
+    silk_float                      Tilt,
+    silk_float                      LF_MA_shp,
+    silk_float                      LF_AR_shp,
+    silk_float                      Gain,
+    silk_float                      Lambda,
+    silk_float                      offset,
+    opus_int                        length,
+    opus_int                        subfr,
+    opus_int                        shapingLPCOrder,
+    opus_int                        predictLPCOrder,
+    silk_float                      warping,
+    opus_int                        nStatesDelayedDecision,
+    opus_int                        *smpl_buf_idx,
+    opus_int                        decisionDelay);
+#define silk_noise_shape_quantizer_del_dec_FLP(NSQ, psDelDec, signalType, x_sc, pulses, xq, sLTP_sc, delayedGain, \
+        a, b, AR_shp, lag, HarmShapeGain, Tilt, LF_MA_shp, LF_AR_shp, Gain, Lambda, offset, length, subfr, \
+        shapingLPCOrder, predictLPCOrder, warping, nStatesDelayedDecision, smpl_buf_idx, decisionDelay, arch) \
+    ((*SILK_NOISE_SHAPE_QUANTIZER_DEL_DEC_FLP_IMPL[(arch) & OPUS_ARCHMASK])(NSQ, psDelDec, signalType, x_sc, pulses, \
+        xq, sLTP_sc, delayedGain, a, b, AR_shp, lag, HarmShapeGain, Tilt, LF_MA_shp, LF_AR_shp, Gain, Lambda, offset, \
+        length, subfr, shapingLPCOrder, predictLPCOrder, warping, nStatesDelayedDecision, smpl_buf_idx, decisionDelay))
+
+#endif
+
+#endif
+
+#endif
@@ -0,0 +1,851 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+#ifdef OPUS_CHECK_ASM
+# include <string.h>
+#endif
+#include "main.h"
+#include "stack_alloc.h"
+
+/* The AVX2 version runs up to 4 delayed decision states side by side, one per */
+/* 32-bit lane. With more states the C function is called.                    */
+#define AVX2_MAX_DEL_DEC_STATES 4
+
+typedef struct {
+    opus_int32 sLPC_Q14[ MAX_SUB_FRAME_LENGTH + NSQ_LPC_BUF_LENGTH ][ AVX2_MAX_DEL_DEC_STATES ];
+    opus_int32 RandState[ DECISION_DELAY ][     AVX2_MAX_DEL_DEC_STATES ];
+    opus_int32 Q_Q10[     DECISION_DELAY ][     AVX2_MAX_DEL_DEC_STATES ];
+    opus_int32 Xq_Q14[    DECISION_DELAY ][     AVX2_MAX_DEL_DEC_STATES ];
+    opus_int32 Pred_Q15[  DECISION_DELAY ][     AVX2_MAX_DEL_DEC_STATES ];
+    opus_int32 Shape_Q14[ DECISION_DELAY ][     AVX2_MAX_DEL_DEC_STATES ];
+    opus_int32 sAR2_Q14[ MAX_SHAPE_LPC_ORDER ][ AVX2_MAX_DEL_DEC_STATES ];
+    opus_int32 LF_AR_Q14[ AVX2_MAX_DEL_DEC_STATES ];
+    opus_int32 Diff_Q14[  AVX2_MAX_DEL_DEC_STATES ];
+    opus_int32 Seed[      AVX2_MAX_DEL_DEC_STATES ];
+    opus_int32 SeedInit[  AVX2_MAX_DEL_DEC_STATES ];
+    opus_int32 RD_Q10[    AVX2_MAX_DEL_DEC_STATES ];
+} NSQ_del_decs_struct;
+
+typedef struct {
+    opus_int32 Q_Q10[        AVX2_MAX_DEL_DEC_STATES ];
+    opus_int32 RD_Q10[       AVX2_MAX_DEL_DEC_STATES ];
+    opus_int32 xq_Q14[       AVX2_MAX_DEL_DEC_STATES ];
+    opus_int32 LF_AR_Q14[    AVX2_MAX_DEL_DEC_STATES ];
+    opus_int32 Diff_Q14[     AVX2_MAX_DEL_DEC_STATES ];
+    opus_int32 sLTP_shp_Q14[ AVX2_MAX_DEL_DEC_STATES ];
+    opus_int32 LPC_exc_Q14[  AVX2_MAX_DEL_DEC_STATES ];
+} NSQ_samples_struct;
+
+static OPUS_INLINE void silk_nsq_del_dec_scale_states_avx2(
+    const silk_encoder_state *psEncC,               /* I    Encoder State                       */
+    silk_nsq_state      *NSQ,                       /* I/O  NSQ state                           */
+    NSQ_del_decs_struct *psDelDec,                  /* I/O  Delayed decision states             */
+    const opus_int16    x16[],                      /* I    Input                               */
+    opus_int32          x_sc_Q10[],                 /* O    Input scaled with 1/Gain in Q10     */
+    const opus_int16    sLTP[],                     /* I    Re-whitened LTP state in Q0         */
+    opus_int32          sLTP_Q15[],                 /* O    LTP state matching scaled input     */
+    opus_int            subfr,                      /* I    Subframe number                     */
+    const opus_int      LTP_scale_Q14,              /* I    LTP state scaling                   */
+    const opus_int32    Gains_Q16[ MAX_NB_SUBFR ],  /* I                                        */
+    const opus_int      pitchL[ MAX_NB_SUBFR ],     /* I    Pitch lag                           */
+    const opus_int      signal_type,                /* I    Signal type                         */
+    const opus_int      decisionDelay               /* I    Decision delay                      */
+);
+
+/******************************************/
+/* Noise shape quantizer for one subframe */
+/******************************************/
+static OPUS_INLINE void silk_noise_shape_quantizer_del_dec_avx2(
+    silk_nsq_state      *NSQ,                   /* I/O  NSQ state                           */
+    NSQ_del_decs_struct *psDelDec,              /* I/O  Delayed decision states             */
+    opus_int            signalType,             /* I    Signal type                         */
+    const opus_int32    x_Q10[],                /* I                                        */
+    opus_int8           pulses[],               /* O                                        */
+    opus_int16          xq[],                   /* O                                        */
+    opus_int32          sLTP_Q15[],             /* I/O  LTP filter state                    */
+    opus_int32          delayedGain_Q10[],      /* I/O  Gain delay buffer                   */
+    const opus_int16    a_Q12[],                /* I    Short term prediction coefs         */
+    const opus_int16    b_Q14[],                /* I    Long term prediction coefs          */
+    const opus_int16    AR_shp_Q13[],           /* I    Noise shaping coefs                 */
+    opus_int            lag,                    /* I    Pitch lag                           */
+    opus_int32          HarmShapeFIRPacked_Q14, /* I                                        */
+    opus_int            Tilt_Q14,               /* I    Spectral tilt                       */
+    opus_int32          LF_shp_Q14,             /* I                                        */
+    opus_int32          Gain_Q16,               /* I                                        */
+    opus_int            Lambda_Q10,             /* I                                        */
+    opus_int            offset_Q10,             /* I                                        */
+    opus_int            length,                 /* I    Input length                        */
+    opus_int            subfr,                  /* I    Subframe number                     */
+    opus_int            shapingLPCOrder,        /* I    Shaping LPC filter order            */
+    opus_int            predictLPCOrder,        /* I    Prediction filter order             */
+    opus_int            warping_Q16,            /* I                                        */
+    opus_int            nStatesDelayedDecision, /* I    Number of states in decision tree   */
+    opus_int            *smpl_buf_idx,          /* I/O  Index to newest samples in buffers  */
+    opus_int            decisionDelay           /* I                                        */
+);
+
+/* ( a * b ) >> 16 in each 32-bit lane, with the factor b repeated in every lane.  */
+/* This is silk_SMULWW(), and silk_SMULWB() when b is a sign-extended 16-bit value. */
+static OPUS_INLINE __m256i silk_mm256_smulww_epi32( __m256i a, __m256i b )
+{
+    __m256i even, odd;
+    even = _mm256_srli_epi64( _mm256_mul_epi32( a, b ), 16 );
+    odd  = _mm256_slli_epi64( _mm256_mul_epi32( _mm256_srli_epi64( a, 32 ), b ), 16 );
+    return _mm256_blend_epi32( even, odd, 0xAA );
+}
+
+static OPUS_INLINE __m128i silk_mm_smulww_epi32( __m128i a, __m128i b )
+{
+    __m128i even, odd;
+    even = _mm_srli_epi64( _mm_mul_epi32( a, b ), 16 );
+    odd  = _mm_slli_epi64( _mm_mul_epi32( _mm_srli_epi64( a, 32 ), b ), 16 );
+    return _mm_blend_epi32( even, odd, 0xA );
+}
+
+/* The noise shaping recursion keeps the four states in the 64-bit lanes of a     */
+/* 256-bit register, so that each silk_SMLAWB() is a single multiply and shift.   */
+/* Only the low 32 bits of each lane are meaningful.                              */
+static OPUS_INLINE __m256i silk_mm256_load_states_epi64( const opus_int32 *in )
+{
+    return _mm256_cvtepi32_epi64( _mm_loadu_si128( (const __m128i *)in ) );
+}
+
+static OPUS_INLINE __m128i silk_mm256_cvtstates_epi32( __m256i x )
+{
+    return _mm256_castsi256_si128( _mm256_permutevar8x32_epi32( x, _mm256_setr_epi32( 0, 2, 4, 6, 0, 2, 4, 6 ) ) );
+}
+
+static OPUS_INLINE void silk_mm256_store_states_epi64( opus_int32 *out, __m256i x )
+{
+    _mm_storeu_si128( (__m128i *)out, silk_mm256_cvtstates_epi32( x ) );
+}
+
+static OPUS_INLINE __m256i silk_mm256_smlawb_epi64( __m256i a, __m256i b, __m256i c )
+{
+    return _mm256_add_epi32( a, _mm256_srli_epi64( _mm256_mul_epi32( b, c ), 16 ) );
+}
+
+static OPUS_INLINE void silk_SMULWW_loop_avx2(
+    const opus_int16 *a,
+    const opus_int32 b,
+    opus_int32       *o,
+    const opus_int   loop_num
+)
+{
+    opus_int i;
+    const __m256i b_256 = _mm256_set1_epi32( b );
+
+    for( i = 0; i < loop_num - 7; i += 8 ) {
+        const __m256i a_256 = _mm256_cvtepi16_epi32( _mm_loadu_si128( (const __m128i *)&a[ i ] ) );
+        _mm256_storeu_si256( (__m256i *)&o[ i ], silk_mm256_smulww_epi32( a_256, b_256 ) );
+    }
+    for( ; i < loop_num; i++ ) {
+        o[ i ] = silk_SMULWW( a[ i ], b );
+    }
+}
+
+static OPUS_INLINE void silk_SMULWW_inplace_avx2(
+    opus_int32       *a,
+    const opus_int32 b,
+    const opus_int   loop_num
+)
+{
+    opus_int i;
+    const __m256i b_256 = _mm256_set1_epi32( b );
+
+    for( i = 0; i < loop_num - 7; i += 8 ) {
+        const __m256i a_256 = _mm256_loadu_si256( (const __m256i *)&a[ i ] );
+        _mm256_storeu_si256( (__m256i *)&a[ i ], silk_mm256_smulww_epi32( a_256, b_256 ) );
+    }
+    for( ; i < loop_num; i++ ) {
+        a[ i ] = silk_SMULWW( b, a[ i ] );
+    }
+}
+
+static OPUS_INLINE void copy_winner_state(
+    const NSQ_del_decs_struct *psDelDec,
+    const opus_int            decisionDelay,
+    const opus_int            smpl_buf_idx,
+    const opus_int            Winner_ind,
+    const opus_int32          gain,
+    const opus_int32          shift,
+    opus_int8 *const          pulses,
+    opus_int16                *pxq,
+    silk_nsq_state            *NSQ
+)
+{
+    opus_int i, last_smple_idx;
+
+    last_smple_idx = smpl_buf_idx + decisionDelay;
+    for( i = 0; i < decisionDelay; i++ ) {
+        last_smple_idx = ( last_smple_idx - 1 ) % DECISION_DELAY;
+        if( last_smple_idx < 0 ) last_smple_idx += DECISION_DELAY;
+        pulses[ i - decisionDelay ] = (opus_int8)silk_RSHIFT_ROUND( psDelDec->Q_Q10[ last_smple_idx ][ Winner_ind ], 10 );
+        pxq[ i - decisionDelay ] = (opus_int16)silk_SAT16( silk_RSHIFT_ROUND(
+            silk_SMULWW( psDelDec->Xq_Q14[ last_smple_idx ][ Winner_ind ], gain ), shift ) );
+        NSQ->sLTP_shp_Q14[ NSQ->sLTP_shp_buf_idx - decisionDelay + i ] = psDelDec->Shape_Q14[ last_smple_idx ][ Winner_ind ];
+    }
+}
+
+void silk_NSQ_del_dec_avx2(
+    const silk_encoder_state    *psEncC,                                    /* I    Encoder State                   */
+    silk_nsq_state              *NSQ,                                       /* I/O  NSQ state                       */
+    SideInfoIndices             *psIndices,                                 /* I/O  Quantization Indices            */
+    const opus_int16            x16[],                                      /* I    Input                           */
+    opus_int8                   pulses[],                                   /* O    Quantized pulse signal          */
+    const opus_int16            PredCoef_Q12[ 2 * MAX_LPC_ORDER ],          /* I    Short term prediction coefs     */
+    const opus_int16            LTPCoef_Q14[ LTP_ORDER * MAX_NB_SUBFR ],    /* I    Long term prediction coefs      */
+    const opus_int16            AR_Q13[ MAX_NB_SUBFR * MAX_SHAPE_LPC_ORDER ], /* I Noise shaping coefs              */
+    const opus_int              HarmShapeGain_Q14[ MAX_NB_SUBFR ],          /* I    Long term shaping coefs         */
+    const opus_int              Tilt_Q14[ MAX_NB_SUBFR ],                   /* I    Spectral tilt                   */
+    const opus_int32            LF_shp_Q14[ MAX_NB_SUBFR ],                 /* I    Low frequency shaping coefs     */
+    const opus_int32            Gains_Q16[ MAX_NB_SUBFR ],                  /* I    Quantization step sizes         */
+    const opus_int              pitchL[ MAX_NB_SUBFR ],                     /* I    Pitch lags                      */
+    const opus_int              Lambda_Q10,                                 /* I    Rate/distortion tradeoff        */
+    const opus_int              LTP_scale_Q14                               /* I    LTP state scaling               */
+)
+{
+#ifdef OPUS_CHECK_ASM
+    silk_nsq_state NSQ_c;
+    SideInfoIndices psIndices_c;
+    opus_int8 pulses_c[ MAX_FRAME_LENGTH ];
+    const opus_int8 *const pulses_a = pulses;
+
+    ( void )pulses_a;
+    silk_memcpy( &NSQ_c, NSQ, sizeof( NSQ_c ) );
+    silk_memcpy( &psIndices_c, psIndices, sizeof( psIndices_c ) );
+    silk_memcpy( pulses_c, pulses, sizeof( pulses_c ) );
+    silk_NSQ_del_dec_c( psEncC, &NSQ_c, &psIndices_c, x16, pulses_c, PredCoef_Q12, LTPCoef_Q14, AR_Q13, HarmShapeGain_Q14, Tilt_Q14, LF_shp_Q14, Gains_Q16,
+                       pitchL, Lambda_Q10, LTP_scale_Q14 );
+#endif
+
+    if( psEncC->nStatesDelayedDecision > AVX2_MAX_DEL_DEC_STATES ) {
+        silk_NSQ_del_dec_c( psEncC, NSQ, psIndices, x16, pulses, PredCoef_Q12, LTPCoef_Q14, AR_Q13, HarmShapeGain_Q14,
+            Tilt_Q14, LF_shp_Q14, Gains_Q16, pitchL, Lambda_Q10, LTP_scale_Q14 );
+    } else {
+        opus_int            i, k, lag, start_idx, LSF_interpolation_flag, Winner_ind, subfr;
+        opus_int            smpl_buf_idx, decisionDelay;
+        const opus_int16    *A_Q12, *B_Q14, *AR_shp_Q13;
+        opus_int16          *pxq;
+        VARDECL( opus_int32, sLTP_Q15 );
+        VARDECL( opus_int16, sLTP );
+        opus_int32          HarmShapeFIRPacked_Q14;
+        opus_int            offset_Q10;
+        opus_int32          RDmin_Q10, Gain_Q10;
+        VARDECL( opus_int32, x_sc_Q10 );
+        VARDECL( opus_int32, delayedGain_Q10 );
+        VARDECL( NSQ_del_decs_struct, psDelDec );
+        SAVE_STACK;
+
+        /* Set unvoiced lag to the previous one, overwrite later for voiced */
+        lag = NSQ->lagPrev;
+
+        silk_assert( NSQ->prev_gain_Q16 != 0 );
+
+        /* Initialize delayed decision states */
+        ALLOC( psDelDec, 1, NSQ_del_decs_struct );
+        silk_memset( psDelDec, 0, sizeof( NSQ_del_decs_struct ) );
+        for( k = 0; k < AVX2_MAX_DEL_DEC_STATES; k++ ) {
+            psDelDec->SeedInit[ k ] = psDelDec->Seed[ k ] = ( k + psIndices->Seed ) & 3;
+        }
+        _mm_storeu_si128( (__m128i *)psDelDec->LF_AR_Q14, _mm_set1_epi32( NSQ->sLF_AR_shp_Q14 ) );
+        _mm_storeu_si128( (__m128i *)psDelDec->Diff_Q14, _mm_set1_epi32( NSQ->sDiff_shp_Q14 ) );
+        _mm_storeu_si128( (__m128i *)psDelDec->Shape_Q14[ 0 ], _mm_set1_epi32( NSQ->sLTP_shp_Q14[ psEncC->ltp_mem_length - 1 ] ) );
+        for( i = 0; i < NSQ_LPC_BUF_LENGTH; i++ ) {
+            _mm_storeu_si128( (__m128i *)psDelDec->sLPC_Q14[ i ], _mm_set1_epi32( NSQ->sLPC_Q14[ i ] ) );
+        }
+        for( i = 0; i < MAX_SHAPE_LPC_ORDER; i++ ) {
+            _mm_storeu_si128( (__m128i *)psDelDec->sAR2_Q14[ i ], _mm_set1_epi32( NSQ->sAR2_Q14[ i ] ) );
+        }
+
+        offset_Q10   = silk_Quantization_Offsets_Q10[ psIndices->signalType >> 1 ][ psIndices->quantOffsetType ];
+        smpl_buf_idx = 0; /* index of oldest samples */
+
+        decisionDelay = silk_min_int( DECISION_DELAY, psEncC->subfr_length );
+
+        /* For voiced frames limit the decision delay to lower than the pitch lag */
+        if( psIndices->signalType == TYPE_VOICED ) {
+            for( k = 0; k < psEncC->nb_subfr; k++ ) {
+                decisionDelay = silk_min_int( decisionDelay, pitchL[ k ] - LTP_ORDER / 2 - 1 );
+            }
+        } else {
+            if( lag > 0 ) {
+                decisionDelay = silk_min_int( decisionDelay, lag - LTP_ORDER / 2 - 1 );
+            }
+        }
+
+        if( psIndices->NLSFInterpCoef_Q2 == 4 ) {
+            LSF_interpolation_flag = 0;
+        } else {
+            LSF_interpolation_flag = 1;
+        }
+
+        ALLOC( sLTP_Q15, psEncC->ltp_mem_length + psEncC->frame_length, opus_int32 );
+        ALLOC( sLTP, psEncC->ltp_mem_length + psEncC->frame_length, opus_int16 );
+        ALLOC( x_sc_Q10, psEncC->subfr_length, opus_int32 );
+        ALLOC( delayedGain_Q10, DECISION_DELAY, opus_int32 );
+        /* Set up pointers to start of sub frame */
+        pxq                   = &NSQ->xq[ psEncC->ltp_mem_length ];
+        NSQ->sLTP_shp_buf_idx = psEncC->ltp_mem_length;
+        NSQ->sLTP_buf_idx     = psEncC->ltp_mem_length;
+        subfr = 0;
+        for( k = 0; k < psEncC->nb_subfr; k++ ) {
+            A_Q12      = &PredCoef_Q12[ ( ( k >> 1 ) | ( 1 - LSF_interpolation_flag ) ) * MAX_LPC_ORDER ];
+            B_Q14      = &LTPCoef_Q14[ k * LTP_ORDER           ];
+            AR_shp_Q13 = &AR_Q13[     k * MAX_SHAPE_LPC_ORDER ];
+
+            /* Noise shape parameters */
+            silk_assert( HarmShapeGain_Q14[ k ] >= 0 );
+            HarmShapeFIRPacked_Q14  =                          silk_RSHIFT( HarmShapeGain_Q14[ k ], 2 );
+            HarmShapeFIRPacked_Q14 |= silk_LSHIFT( (opus_int32)silk_RSHIFT( HarmShapeGain_Q14[ k ], 1 ), 16 );
+
+            NSQ->rewhite_flag = 0;
+            if( psIndices->signalType == TYPE_VOICED ) {
+                /* Voiced */
+                lag = pitchL[ k ];
+
+                /* Re-whitening */
+                if( ( k & ( 3 - silk_LSHIFT( LSF_interpolation_flag, 1 ) ) ) == 0 ) {
+                    if( k == 2 ) {
+                        /* RESET DELAYED DECISIONS */
+                        /* Find winner */
+                        RDmin_Q10 = psDelDec->RD_Q10[ 0 ];
+                        Winner_ind = 0;
+                        for( i = 1; i < psEncC->nStatesDelayedDecision; i++ ) {
+                            if( psDelDec->RD_Q10[ i ] < RDmin_Q10 ) {
+                                RDmin_Q10 = psDelDec->RD_Q10[ i ];
+                                Winner_ind = i;
+                            }
+                        }
+                        for( i = 0; i < psEncC->nStatesDelayedDecision; i++ ) {
+                            if( i != Winner_ind ) {
+                                psDelDec->RD_Q10[ i ] += ( silk_int32_MAX >> 4 );
+                                silk_assert( psDelDec->RD_Q10[ i ] >= 0 );
+                            }
+                        }
+
+                        /* Copy final part of signals from winner state to output and long-term filter states */
+                        copy_winner_state( psDelDec, decisionDelay, smpl_buf_idx, Winner_ind, Gains_Q16[ 1 ], 14, pulses, pxq, NSQ );
+
+                        subfr = 0;
+                    }
+
+                    /* Rewhiten with new A coefs */
+                    start_idx = psEncC->ltp_mem_length - lag - psEncC->predictLPCOrder - LTP_ORDER / 2;
+                    silk_assert( start_idx > 0 );
+
+                    silk_LPC_analysis_filter( &sLTP[ start_idx ], &NSQ->xq[ start_idx + k * psEncC->subfr_length ],
+                        A_Q12, psEncC->ltp_mem_length - start_idx, psEncC->predictLPCOrder, psEncC->arch );
+
+                    NSQ->sLTP_buf_idx = psEncC->ltp_mem_length;
+                    NSQ->rewhite_flag = 1;
+                }
+            }
+
+            silk_nsq_del_dec_scale_states_avx2( psEncC, NSQ, psDelDec, x16, x_sc_Q10, sLTP, sLTP_Q15, k,
+                LTP_scale_Q14, Gains_Q16, pitchL, psIndices->signalType, decisionDelay );
+
+            silk_noise_shape_quantizer_del_dec_avx2( NSQ, psDelDec, psIndices->signalType, x_sc_Q10, pulses, pxq, sLTP_Q15,
+                delayedGain_Q10, A_Q12, B_Q14, AR_shp_Q13, lag, HarmShapeFIRPacked_Q14, Tilt_Q14[ k ], LF_shp_Q14[ k ],
+                Gains_Q16[ k ], Lambda_Q10, offset_Q10, psEncC->subfr_length, subfr++, psEncC->shapingLPCOrder,
+                psEncC->predictLPCOrder, psEncC->warping_Q16, psEncC->nStatesDelayedDecision, &smpl_buf_idx, decisionDelay );
+
+            x16    += psEncC->subfr_length;
+            pulses += psEncC->subfr_length;
+            pxq    += psEncC->subfr_length;
+        }
+
+        /* Find winner */
+        RDmin_Q10 = psDelDec->RD_Q10[ 0 ];
+        Winner_ind = 0;
+        for( k = 1; k < psEncC->nStatesDelayedDecision; k++ ) {
+            if( psDelDec->RD_Q10[ k ] < RDmin_Q10 ) {
+                RDmin_Q10 = psDelDec->RD_Q10[ k ];
+                Winner_ind = k;
+            }
+        }
+
+        /* Copy final part of signals from winner state to output and long-term filter states */
+        psIndices->Seed = psDelDec->SeedInit[ Winner_ind ];
+        Gain_Q10 = silk_RSHIFT32( Gains_Q16[ psEncC->nb_subfr - 1 ], 6 );
+        copy_winner_state( psDelDec, decisionDelay, smpl_buf_idx, Winner_ind, Gain_Q10, 8, pulses, pxq, NSQ );
+
+        for( i = 0; i < NSQ_LPC_BUF_LENGTH; i++ ) {
+            NSQ->sLPC_Q14[ i ] = psDelDec->sLPC_Q14[ i ][ Winner_ind ];
+        }
+        for( i = 0; i < MAX_SHAPE_LPC_ORDER; i++ ) {
+            NSQ->sAR2_Q14[ i ] = psDelDec->sAR2_Q14[ i ][ Winner_ind ];
+        }
+
+        /* Update states */
+        NSQ->sLF_AR_shp_Q14 = psDelDec->LF_AR_Q14[ Winner_ind ];
+        NSQ->sDiff_shp_Q14  = psDelDec->Diff_Q14[ Winner_ind ];
+        NSQ->lagPrev        = pitchL[ psEncC->nb_subfr - 1 ];
+
+        /* Save quantized speech signal */
+        silk_memmove( NSQ->xq,           &NSQ->xq[           psEncC->frame_length ], psEncC->ltp_mem_length * sizeof( opus_int16 ) );
+        silk_memmove( NSQ->sLTP_shp_Q14, &NSQ->sLTP_shp_Q14[ psEncC->frame_length ], psEncC->ltp_mem_length * sizeof( opus_int32 ) );
+        RESTORE_STACK;
+    }
+
+#ifdef OPUS_CHECK_ASM
+    silk_assert( !memcmp( &NSQ_c, NSQ, sizeof( NSQ_c ) ) );
+    silk_assert( !memcmp( &psIndices_c, psIndices, sizeof( psIndices_c ) ) );
+    silk_assert( !memcmp( pulses_c, pulses_a, sizeof( pulses_c ) ) );
+#endif
+}
+
+/* Short-term prediction for all states. Rows i and i + 1 of the LPC state are */
+/* handled together, with their coefficients in the low and high 128 bits.     */
+static OPUS_INLINE __m128i silk_noise_shape_quantizer_short_prediction_avx2(
+    const opus_int32 *buf32,
+    const __m256i    *coef,
+    opus_int         order
+)
+{
+    opus_int j;
+    __m256i  acc;
+
+    silk_assert( order == 10 || order == 16 );
+    acc = silk_mm256_smulww_epi32( _mm256_loadu_si256( (const __m256i *)buf32 ), coef[ 0 ] );
+    if( order == 16 ) {
+        for( j = 1; j < 8; j++ ) {
+            acc = _mm256_add_epi32( acc, silk_mm256_smulww_epi32(
+                _mm256_loadu_si256( (const __m256i *)&buf32[ 2 * j * AVX2_MAX_DEL_DEC_STATES ] ), coef[ j ] ) );
+        }
+    } else {
+        for( j = 1; j < 5; j++ ) {
+            acc = _mm256_add_epi32( acc, silk_mm256_smulww_epi32(
+                _mm256_loadu_si256( (const __m256i *)&buf32[ 2 * j * AVX2_MAX_DEL_DEC_STATES ] ), coef[ j ] ) );
+        }
+    }
+    /* Avoids introducing a bias because silk_SMLAWB() always rounds to -inf */
+    return _mm_add_epi32( _mm_set1_epi32( silk_RSHIFT( order, 1 ) ),
+        _mm_add_epi32( _mm256_castsi256_si128( acc ), _mm256_extracti128_si256( acc, 1 ) ) );
+}
+
+static OPUS_INLINE void silk_noise_shape_quantizer_del_dec_avx2(
+    silk_nsq_state      *NSQ,                   /* I/O  NSQ state                           */
+    NSQ_del_decs_struct *psDelDec,              /* I/O  Delayed decision states             */
+    opus_int            signalType,             /* I    Signal type                         */
+    const opus_int32    x_Q10[],                /* I                                        */
+    opus_int8           pulses[],               /* O                                        */
+    opus_int16          xq[],                   /* O                                        */
+    opus_int32          sLTP_Q15[],             /* I/O  LTP filter state                    */
+    opus_int32          delayedGain_Q10[],      /* I/O  Gain delay buffer                   */
+    const opus_int16    a_Q12[],                /* I    Short term prediction coefs         */
+    const opus_int16    b_Q14[],                /* I    Long term prediction coefs          */
+    const opus_int16    AR_shp_Q13[],           /* I    Noise shaping coefs                 */
+    opus_int            lag,                    /* I    Pitch lag                           */
+    opus_int32          HarmShapeFIRPacked_Q14, /* I                                        */
+    opus_int            Tilt_Q14,               /* I    Spectral tilt                       */
+    opus_int32          LF_shp_Q14,             /* I                                        */
+    opus_int32          Gain_Q16,               /* I                                        */
+    opus_int            Lambda_Q10,             /* I                                        */
+    opus_int            offset_Q10,             /* I                                        */
+    opus_int            length,                 /* I    Input length                        */
+    opus_int            subfr,                  /* I    Subframe number                     */
+    opus_int            shapingLPCOrder,        /* I    Shaping LPC filter order            */
+    opus_int            predictLPCOrder,        /* I    Prediction filter order             */
+    opus_int            warping_Q16,            /* I                                        */
+    opus_int            nStatesDelayedDecision, /* I    Number of states in decision tree   */
+    opus_int            *smpl_buf_idx,          /* I/O  Index to newest samples in buffers  */
+    opus_int            decisionDelay           /* I                                        */
+)
+{
+    opus_int     i, j, k, Winner_ind, RDmin_ind, RDmax_ind, last_smple_idx;
+    opus_int32   Winner_rand_state;
+    opus_int32   LTP_pred_Q14, n_LTP_Q14;
+    opus_int32   RDmin_Q10, RDmax_Q10;
+    opus_int32   Gain_Q10;
+    opus_int32   *pred_lag_ptr, *shp_lag_ptr;
+    __m256i      a_Q12_256[ MAX_LPC_ORDER / 2 ];
+    __m256i      AR_shp_Q13_256[ MAX_SHAPE_LPC_ORDER ];
+    const __m256i warping_Q16_256 = _mm256_set1_epi32( (opus_int16)warping_Q16 );
+    const __m256i Tilt_Q14_256    = _mm256_set1_epi32( (opus_int16)Tilt_Q14 );
+    const __m256i LF_shp_lo_256   = _mm256_set1_epi32( (opus_int16)LF_shp_Q14 );
+    const __m256i LF_shp_hi_256   = _mm256_set1_epi32( LF_shp_Q14 >> 16 );
+    /* silk_SMULBB() and silk_SMLABB() only use the low 16 bits of Lambda_Q10 */
+    const __m128i Lambda_Q10_128  = _mm_set1_epi32( (opus_uint16)Lambda_Q10 );
+    NSQ_samples_struct psSampleState[ 2 ];
+
+    silk_assert( nStatesDelayedDecision > 0 );
+    silk_assert( ( shapingLPCOrder & 1 ) == 0 );   /* check that order is even */
+
+    shp_lag_ptr  = &NSQ->sLTP_shp_Q14[ NSQ->sLTP_shp_buf_idx - lag + HARM_SHAPE_FIR_TAPS / 2 ];
+    pred_lag_ptr = &sLTP_Q15[ NSQ->sLTP_buf_idx - lag + LTP_ORDER / 2 ];
+    Gain_Q10     = silk_RSHIFT( Gain_Q16, 6 );
+
+    /* The prediction reads LPC state rows i + 16 - order to i + 15, oldest first */
+    for( j = 0; j < ( predictLPCOrder >> 1 ); j++ ) {
+        a_Q12_256[ j ] = _mm256_setr_epi32(
+            a_Q12[ predictLPCOrder - 1 - 2 * j ], 0, a_Q12[ predictLPCOrder - 1 - 2 * j ], 0,
+            a_Q12[ predictLPCOrder - 2 - 2 * j ], 0, a_Q12[ predictLPCOrder - 2 - 2 * j ], 0 );
+    }
+    for( j = 0; j < shapingLPCOrder; j++ ) {
+        AR_shp_Q13_256[ j ] = _mm256_set1_epi32( AR_shp_Q13[ j ] );
+    }
+
+    for( i = 0; i < length; i++ ) {
+        __m128i Seed_128, LPC_pred_Q14_128, n_AR_Q14_128, n_LF_Q14_128;
+        __m128i sign_128, r_Q10_128, tmp1_128, tmp2_128;
+        __m128i q1_Q10_128, q2_Q10_128, rd1_Q10_128, rd2_Q10_128;
+        __m256i tmp1_256, tmp2_256, n_AR_Q14_256, n_LF_Q14_256, LF_AR_Q14_256;
+
+        /* Perform common calculations used in all states */
+
+        /* Long-term prediction */
+        if( signalType == TYPE_VOICED ) {
+            /* Unrolled loop */
+            /* Avoids introducing a bias because silk_SMLAWB() always rounds to -inf */
+            LTP_pred_Q14 = 2;
+            LTP_pred_Q14 = silk_SMLAWB( LTP_pred_Q14, pred_lag_ptr[  0 ], b_Q14[ 0 ] );
+            LTP_pred_Q14 = silk_SMLAWB( LTP_pred_Q14, pred_lag_ptr[ -1 ], b_Q14[ 1 ] );
+            LTP_pred_Q14 = silk_SMLAWB( LTP_pred_Q14, pred_lag_ptr[ -2 ], b_Q14[ 2 ] );
+            LTP_pred_Q14 = silk_SMLAWB( LTP_pred_Q14, pred_lag_ptr[ -3 ], b_Q14[ 3 ] );
+            LTP_pred_Q14 = silk_SMLAWB( LTP_pred_Q14, pred_lag_ptr[ -4 ], b_Q14[ 4 ] );
+            LTP_pred_Q14 = silk_LSHIFT( LTP_pred_Q14, 1 );                          /* Q13 -> Q14 */
+            pred_lag_ptr++;
+        } else {
+            LTP_pred_Q14 = 0;
+        }
+
+        /* Long-term shaping */
+        if( lag > 0 ) {
+            /* Symmetric, packed FIR coefficients */
+            n_LTP_Q14 = silk_SMULWB( silk_ADD32( shp_lag_ptr[ 0 ], shp_lag_ptr[ -2 ] ), HarmShapeFIRPacked_Q14 );
+            n_LTP_Q14 = silk_SMLAWT( n_LTP_Q14, shp_lag_ptr[ -1 ],                      HarmShapeFIRPacked_Q14 );
+            n_LTP_Q14 = silk_SUB_LSHIFT32( LTP_pred_Q14, n_LTP_Q14, 2 );            /* Q12 -> Q14 */
+            shp_lag_ptr++;
+        } else {
+            n_LTP_Q14 = 0;
+        }
+
+        /* Generate dither */
+        Seed_128 = _mm_loadu_si128( (__m128i *)psDelDec->Seed );
+        Seed_128 = _mm_add_epi32( _mm_mullo_epi32( Seed_128, _mm_set1_epi32( RAND_MULTIPLIER ) ), _mm_set1_epi32( RAND_INCREMENT ) );
+        _mm_storeu_si128( (__m128i *)psDelDec->Seed, Seed_128 );
+
+        /* Short-term prediction */
+        LPC_pred_Q14_128 = silk_noise_shape_quantizer_short_prediction_avx2(
+            psDelDec->sLPC_Q14[ NSQ_LPC_BUF_LENGTH - predictLPCOrder + i ], a_Q12_256, predictLPCOrder );
+        LPC_pred_Q14_128 = _mm_slli_epi32( LPC_pred_Q14_128, 4 );                  /* Q10 -> Q14 */
+
+        /* Noise shape feedback */
+        /* Output of lowpass section */
+        tmp2_256 = silk_mm256_smlawb_epi64( silk_mm256_load_states_epi64( psDelDec->Diff_Q14 ),
+            silk_mm256_load_states_epi64( psDelDec->sAR2_Q14[ 0 ] ), warping_Q16_256 );
+        /* Output of allpass section */
+        tmp1_256 = _mm256_sub_epi32( silk_mm256_load_states_epi64( psDelDec->sAR2_Q14[ 1 ] ), tmp2_256 );
+        tmp1_256 = silk_mm256_smlawb_epi64( silk_mm256_load_states_epi64( psDelDec->sAR2_Q14[ 0 ] ), tmp1_256, warping_Q16_256 );
+        silk_mm256_store_states_epi64( psDelDec->sAR2_Q14[ 0 ], tmp2_256 );
+        n_AR_Q14_256 = silk_mm256_smlawb_epi64( _mm256_set1_epi32( silk_RSHIFT( shapingLPCOrder, 1 ) ), tmp2_256, AR_shp_Q13_256[ 0 ] );
+        /* Loop over allpass sections */
+        for( j = 2; j < shapingLPCOrder; j += 2 ) {
+            /* Output of allpass section */
+            tmp2_256 = _mm256_sub_epi32( silk_mm256_load_states_epi64( psDelDec->sAR2_Q14[ j + 0 ] ), tmp1_256 );
+            tmp2_256 = silk_mm256_smlawb_epi64( silk_mm256_load_states_epi64( psDelDec->sAR2_Q14[ j - 1 ] ), tmp2_256, warping_Q16_256 );
+            silk_mm256_store_states_epi64( psDelDec->sAR2_Q14[ j - 1 ], tmp1_256 );
+            n_AR_Q14_256 = silk_mm256_smlawb_epi64( n_AR_Q14_256, tmp1_256, AR_shp_Q13_256[ j - 1 ] );
+            /* Output of allpass section */
+            tmp1_256 = _mm256_sub_epi32( silk_mm256_load_states_epi64( psDelDec->sAR2_Q14[ j + 1 ] ), tmp2_256 );
+            tmp1_256 = silk_mm256_smlawb_epi64( silk_mm256_load_states_epi64( psDelDec->sAR2_Q14[ j + 0 ] ), tmp1_256, warping_Q16_256 );
+            silk_mm256_store_states_epi64( psDelDec->sAR2_Q14[ j + 0 ], tmp2_256 );
+            n_AR_Q14_256 = silk_mm256_smlawb_epi64( n_AR_Q14_256, tmp2_256, AR_shp_Q13_256[ j ] );
+        }
+        silk_mm256_store_states_epi64( psDelDec->sAR2_Q14[ shapingLPCOrder - 1 ], tmp1_256 );
+        n_AR_Q14_256 = silk_mm256_smlawb_epi64( n_AR_Q14_256, tmp1_256, AR_shp_Q13_256[ shapingLPCOrder - 1 ] );
+
+        LF_AR_Q14_256 = silk_mm256_load_states_epi64( psDelDec->LF_AR_Q14 );
+        n_AR_Q14_256 = _mm256_slli_epi32( n_AR_Q14_256, 1 );                                           /* Q11 -> Q12 */
+        n_AR_Q14_256 = silk_mm256_smlawb_epi64( n_AR_Q14_256, LF_AR_Q14_256, Tilt_Q14_256 );            /* Q12 */
+        n_AR_Q14_128 = _mm_slli_epi32( silk_mm256_cvtstates_epi32( n_AR_Q14_256 ), 2 );                /* Q12 -> Q14 */
+
+        n_LF_Q14_256 = _mm256_srli_epi64( _mm256_mul_epi32(
+            silk_mm256_load_states_epi64( psDelDec->Shape_Q14[ *smpl_buf_idx ] ), LF_shp_lo_256 ), 16 ); /* Q12 */
+        n_LF_Q14_256 = silk_mm256_smlawb_epi64( n_LF_Q14_256, LF_AR_Q14_256, LF_shp_hi_256 );          /* Q12 */
+        n_LF_Q14_128 = _mm_slli_epi32( silk_mm256_cvtstates_epi32( n_LF_Q14_256 ), 2 );                /* Q12 -> Q14 */
+
+        /* Input minus prediction plus noise feedback                       */
+        /* r = x[ i ] - LTP_pred - LPC_pred + n_AR + n_Tilt + n_LF + n_LTP  */
+        tmp1_128 = _mm_add_epi32( n_AR_Q14_128, n_LF_Q14_128 );                        /* Q14 */
+        tmp2_128 = _mm_add_epi32( _mm_set1_epi32( n_LTP_Q14 ), LPC_pred_Q14_128 );    /* Q13 */
+        tmp1_128 = _mm_sub_epi32( tmp2_128, tmp1_128 );                                /* Q13 */
+        tmp1_128 = _mm_srai_epi32( _mm_add_epi32( _mm_srai_epi32( tmp1_128, 3 ), _mm_set1_epi32( 1 ) ), 1 ); /* Q10 */
+        r_Q10_128 = _mm_sub_epi32( _mm_set1_epi32( x_Q10[ i ] ), tmp1_128 );          /* residual error Q10 */
+
+        /* Flip sign depending on dither */
+        sign_128 = _mm_srai_epi32( Seed_128, 31 );
+        r_Q10_128 = _mm_sub_epi32( _mm_xor_si128( r_Q10_128, sign_128 ), sign_128 );
+        r_Q10_128 = _mm_max_epi32( r_Q10_128, _mm_set1_epi32( -( 31 << 10 ) ) );
+        r_Q10_128 = _mm_min_epi32( r_Q10_128, _mm_set1_epi32( 30 << 10 ) );
+
+        /* Find two quantization level candidates and measure their rate-distortion */
+        {
+            __m128i q1_Q0_128, eq0_128, eqm1_128, ltm1_128, neg_128, rr_Q10_128, t_128;
+
+            q1_Q10_128 = _mm_sub_epi32( r_Q10_128, _mm_set1_epi32( offset_Q10 ) );
+            q1_Q0_128 = _mm_srai_epi32( q1_Q10_128, 10 );
+            if( Lambda_Q10 > 2048 ) {
+                /* For aggressive RDO, the bias becomes more than one pulse. */
+                const opus_int32 rdo_offset = Lambda_Q10/2 - 512;
+                const __m128i greaterThanRdo = _mm_cmpgt_epi32( q1_Q10_128, _mm_set1_epi32( rdo_offset ) );
+                const __m128i lessThanMinusRdo = _mm_cmplt_epi32( q1_Q10_128, _mm_set1_epi32( -rdo_offset ) );
+                q1_Q0_128 = _mm_srai_epi32( q1_Q10_128, 31 );
+                q1_Q0_128 = _mm_blendv_epi8( q1_Q0_128,
+                    _mm_srai_epi32( _mm_sub_epi32( q1_Q10_128, _mm_set1_epi32( rdo_offset ) ), 10 ), greaterThanRdo );
+                q1_Q0_128 = _mm_blendv_epi8( q1_Q0_128,
+                    _mm_srai_epi32( _mm_add_epi32( q1_Q10_128, _mm_set1_epi32( rdo_offset ) ), 10 ), lessThanMinusRdo );
+            }
+            eq0_128  = _mm_cmpeq_epi32( q1_Q0_128, _mm_setzero_si128() );
+            eqm1_128 = _mm_cmpeq_epi32( q1_Q0_128, _mm_set1_epi32( -1 ) );
+            ltm1_128 = _mm_cmplt_epi32( q1_Q0_128, _mm_set1_epi32( -1 ) );
+            neg_128  = _mm_srai_epi32( q1_Q0_128, 31 );
+
+            q1_Q10_128 = _mm_add_epi32( _mm_slli_epi32( q1_Q0_128, 10 ), _mm_blendv_epi8(
+                _mm_set1_epi32( offset_Q10 - QUANT_LEVEL_ADJUST_Q10 ), _mm_set1_epi32( offset_Q10 + QUANT_LEVEL_ADJUST_Q10 ), ltm1_128 ) );
+            q1_Q10_128 = _mm_blendv_epi8( q1_Q10_128, _mm_set1_epi32( offset_Q10 ), eq0_128 );
+            q1_Q10_128 = _mm_blendv_epi8( q1_Q10_128, _mm_set1_epi32( offset_Q10 - ( 1024 - QUANT_LEVEL_ADJUST_Q10 ) ), eqm1_128 );
+            q2_Q10_128 = _mm_add_epi32( q1_Q10_128, _mm_set1_epi32( 1024 ) );
+            q2_Q10_128 = _mm_sub_epi32( q2_Q10_128, _mm_and_si128( _mm_or_si128( eq0_128, eqm1_128 ), _mm_set1_epi32( QUANT_LEVEL_ADJUST_Q10 ) ) );
+
+            /* rd = SMLABB( SMULBB( +-q, Lambda_Q10 ), rr, rr ), as one multiply-add of 16-bit pairs */
+            rr_Q10_128 = _mm_slli_epi32( _mm_sub_epi32( r_Q10_128, q1_Q10_128 ), 16 );
+            t_128 = _mm_sub_epi32( _mm_xor_si128( q1_Q10_128, neg_128 ), neg_128 );
+            rd1_Q10_128 = _mm_madd_epi16( _mm_blend_epi16( t_128, rr_Q10_128, 0xAA ), _mm_blend_epi16( Lambda_Q10_128, rr_Q10_128, 0xAA ) );
+            rd1_Q10_128 = _mm_srai_epi32( rd1_Q10_128, 10 );
+
+            rr_Q10_128 = _mm_slli_epi32( _mm_sub_epi32( r_Q10_128, q2_Q10_128 ), 16 );
+            t_128 = _mm_sub_epi32( _mm_xor_si128( q2_Q10_128, ltm1_128 ), ltm1_128 );
+            rd2_Q10_128 = _mm_madd_epi16( _mm_blend_epi16( t_128, rr_Q10_128, 0xAA ), _mm_blend_epi16( Lambda_Q10_128, rr_Q10_128, 0xAA ) );
+            rd2_Q10_128 = _mm_srai_epi32( rd2_Q10_128, 10 );
+
+            tmp2_128 = _mm_loadu_si128( (__m128i *)psDelDec->RD_Q10 );
+            _mm_storeu_si128( (__m128i *)psSampleState[ 0 ].RD_Q10, _mm_add_epi32( tmp2_128, _mm_min_epi32( rd1_Q10_128, rd2_Q10_128 ) ) );
+            _mm_storeu_si128( (__m128i *)psSampleState[ 1 ].RD_Q10, _mm_add_epi32( tmp2_128, _mm_max_epi32( rd1_Q10_128, rd2_Q10_128 ) ) );
+            t_128 = _mm_cmplt_epi32( rd1_Q10_128, rd2_Q10_128 );
+            tmp1_128 = _mm_blendv_epi8( q2_Q10_128, q1_Q10_128, t_128 );
+            tmp2_128 = _mm_blendv_epi8( q1_Q10_128, q2_Q10_128, t_128 );
+            _mm_storeu_si128( (__m128i *)psSampleState[ 0 ].Q_Q10, tmp1_128 );
+            _mm_storeu_si128( (__m128i *)psSampleState[ 1 ].Q_Q10, tmp2_128 );
+        }
+
+        for( k = 0; k < 2; k++ ) {
+            /* Update states for best and second best quantization */
+            __m128i exc_Q14_128, LPC_exc_Q14_128, xq_Q14_128, Diff_Q14_128, sLF_AR_shp_Q14_128;
+
+            /* Quantized excitation */
+            exc_Q14_128 = _mm_slli_epi32( k ? tmp2_128 : tmp1_128, 4 );
+            exc_Q14_128 = _mm_sub_epi32( _mm_xor_si128( exc_Q14_128, sign_128 ), sign_128 );
+
+            /* Add predictions */
+            LPC_exc_Q14_128 = _mm_add_epi32( exc_Q14_128, _mm_set1_epi32( LTP_pred_Q14 ) );
+            xq_Q14_128      = _mm_add_epi32( LPC_exc_Q14_128, LPC_pred_Q14_128 );
+
+            /* Update states */
+            Diff_Q14_128 = _mm_sub_epi32( xq_Q14_128, _mm_set1_epi32( silk_LSHIFT32( x_Q10[ i ], 4 ) ) );
+            sLF_AR_shp_Q14_128 = _mm_sub_epi32( Diff_Q14_128, n_AR_Q14_128 );
+            _mm_storeu_si128( (__m128i *)psSampleState[ k ].Diff_Q14, Diff_Q14_128 );
+            _mm_storeu_si128( (__m128i *)psSampleState[ k ].sLTP_shp_Q14, _mm_sub_epi32( sLF_AR_shp_Q14_128, n_LF_Q14_128 ) );
+            _mm_storeu_si128( (__m128i *)psSampleState[ k ].LF_AR_Q14, sLF_AR_shp_Q14_128 );
+            _mm_storeu_si128( (__m128i *)psSampleState[ k ].LPC_exc_Q14, LPC_exc_Q14_128 );
+            _mm_storeu_si128( (__m128i *)psSampleState[ k ].xq_Q14, xq_Q14_128 );
+        }
+
+        *smpl_buf_idx = *smpl_buf_idx ? ( *smpl_buf_idx - 1 ) : ( DECISION_DELAY - 1 );
+        last_smple_idx = *smpl_buf_idx + decisionDelay;
+        if( last_smple_idx >= DECISION_DELAY ) last_smple_idx -= DECISION_DELAY;
+
+        /* Find winner */
+        RDmin_Q10 = psSampleState[ 0 ].RD_Q10[ 0 ];
+        Winner_ind = 0;
+        for( k = 1; k < nStatesDelayedDecision; k++ ) {
+            if( psSampleState[ 0 ].RD_Q10[ k ] < RDmin_Q10 ) {
+                RDmin_Q10 = psSampleState[ 0 ].RD_Q10[ k ];
+                Winner_ind = k;
+            }
+        }
+
+        /* Increase RD values of expired states */
+        Winner_rand_state = psDelDec->RandState[ last_smple_idx ][ Winner_ind ];
+        tmp1_128 = _mm_cmpeq_epi32( _mm_loadu_si128( (__m128i *)psDelDec->RandState[ last_smple_idx ] ), _mm_set1_epi32( Winner_rand_state ) );
+        tmp1_128 = _mm_andnot_si128( tmp1_128, _mm_set1_epi32( silk_int32_MAX >> 4 ) );
+        _mm_storeu_si128( (__m128i *)psSampleState[ 0 ].RD_Q10,
+            _mm_add_epi32( _mm_loadu_si128( (__m128i *)psSampleState[ 0 ].RD_Q10 ), tmp1_128 ) );
+        _mm_storeu_si128( (__m128i *)psSampleState[ 1 ].RD_Q10,
+            _mm_add_epi32( _mm_loadu_si128( (__m128i *)psSampleState[ 1 ].RD_Q10 ), tmp1_128 ) );
+
+        /* Find worst in first set and best in second set */
+        RDmax_Q10 = psSampleState[ 0 ].RD_Q10[ 0 ];
+        RDmin_Q10 = psSampleState[ 1 ].RD_Q10[ 0 ];
+        RDmax_ind = 0;
+        RDmin_ind = 0;
+        for( k = 1; k < nStatesDelayedDecision; k++ ) {
+            /* find worst in first set */
+            if( psSampleState[ 0 ].RD_Q10[ k ] > RDmax_Q10 ) {
+                RDmax_Q10 = psSampleState[ 0 ].RD_Q10[ k ];
+                RDmax_ind = k;
+            }
+            /* find best in second set */
+            if( psSampleState[ 1 ].RD_Q10[ k ] < RDmin_Q10 ) {
+                RDmin_Q10 = psSampleState[ 1 ].RD_Q10[ k ];
+                RDmin_ind = k;
+            }
+        }
+
+        /* Replace a state if best from second set outperforms worst in first set */
+        if( RDmin_Q10 < RDmax_Q10 ) {
+            opus_int32 (*ptr)[ AVX2_MAX_DEL_DEC_STATES ] = psDelDec->RandState;
+            const int numOthers = (int)( ( sizeof( NSQ_del_decs_struct ) - sizeof( ( (NSQ_del_decs_struct *)0 )->sLPC_Q14 ) )
+                / ( AVX2_MAX_DEL_DEC_STATES * sizeof( opus_int32 ) ) );
+            /* Rows up to i of the LPC state are not read again, and rows from        */
+            /* NSQ_LPC_BUF_LENGTH + i onwards are written before they are read, so   */
+            /* only the rows in between are copied.                                  */
+            for( j = i + 1; j < i + NSQ_LPC_BUF_LENGTH; j++ ) {
+                psDelDec->sLPC_Q14[ j ][ RDmax_ind ] = psDelDec->sLPC_Q14[ j ][ RDmin_ind ];
+            }
+            for( j = 0; j < numOthers; j++ ) {
+                ptr[ j ][ RDmax_ind ] = ptr[ j ][ RDmin_ind ];
+            }
+
+            psSampleState[ 0 ].Q_Q10[ RDmax_ind ] = psSampleState[ 1 ].Q_Q10[ RDmin_ind ];
+            psSampleState[ 0 ].RD_Q10[ RDmax_ind ] = psSampleState[ 1 ].RD_Q10[ RDmin_ind ];
+            psSampleState[ 0 ].xq_Q14[ RDmax_ind ] = psSampleState[ 1 ].xq_Q14[ RDmin_ind ];
+            psSampleState[ 0 ].LF_AR_Q14[ RDmax_ind ] = psSampleState[ 1 ].LF_AR_Q14[ RDmin_ind ];
+            psSampleState[ 0 ].Diff_Q14[ RDmax_ind ] = psSampleState[ 1 ].Diff_Q14[ RDmin_ind ];
+            psSampleState[ 0 ].sLTP_shp_Q14[ RDmax_ind ] = psSampleState[ 1 ].sLTP_shp_Q14[ RDmin_ind ];
+            psSampleState[ 0 ].LPC_exc_Q14[ RDmax_ind ] = psSampleState[ 1 ].LPC_exc_Q14[ RDmin_ind ];
+        }
+
+        /* Write samples from winner to output and long-term filter states */
+        if( subfr > 0 || i >= decisionDelay ) {
+            pulses[  i - decisionDelay ] = (opus_int8)silk_RSHIFT_ROUND( psDelDec->Q_Q10[ last_smple_idx ][ Winner_ind ], 10 );
+            xq[ i - decisionDelay ] = (opus_int16)silk_SAT16( silk_RSHIFT_ROUND(
+                silk_SMULWW( psDelDec->Xq_Q14[ last_smple_idx ][ Winner_ind ], delayedGain_Q10[ last_smple_idx ] ), 8 ) );
+            NSQ->sLTP_shp_Q14[ NSQ->sLTP_shp_buf_idx - decisionDelay ] = psDelDec->Shape_Q14[ last_smple_idx ][ Winner_ind ];
+            sLTP_Q15[          NSQ->sLTP_buf_idx     - decisionDelay ] = psDelDec->Pred_Q15[  last_smple_idx ][ Winner_ind ];
+        }
+        NSQ->sLTP_shp_buf_idx++;
+        NSQ->sLTP_buf_idx++;
+
+        /* Update states */
+        tmp1_128 = _mm_loadu_si128( (__m128i *)psSampleState[ 0 ].xq_Q14 );
+        _mm_storeu_si128( (__m128i *)psDelDec->LF_AR_Q14, _mm_loadu_si128( (__m128i *)psSampleState[ 0 ].LF_AR_Q14 ) );
+        _mm_storeu_si128( (__m128i *)psDelDec->Diff_Q14, _mm_loadu_si128( (__m128i *)psSampleState[ 0 ].Diff_Q14 ) );
+        _mm_storeu_si128( (__m128i *)psDelDec->sLPC_Q14[ NSQ_LPC_BUF_LENGTH + i ], tmp1_128 );
+        _mm_storeu_si128( (__m128i *)psDelDec->Xq_Q14[ *smpl_buf_idx ], tmp1_128 );
+        tmp1_128 = _mm_loadu_si128( (__m128i *)psSampleState[ 0 ].Q_Q10 );
+        _mm_storeu_si128( (__m128i *)psDelDec->Q_Q10[ *smpl_buf_idx ], tmp1_128 );
+        _mm_storeu_si128( (__m128i *)psDelDec->Pred_Q15[ *smpl_buf_idx ],
+            _mm_slli_epi32( _mm_loadu_si128( (__m128i *)psSampleState[ 0 ].LPC_exc_Q14 ), 1 ) );
+        _mm_storeu_si128( (__m128i *)psDelDec->Shape_Q14[ *smpl_buf_idx ], _mm_loadu_si128( (__m128i *)psSampleState[ 0 ].sLTP_shp_Q14 ) );
+        tmp1_128 = _mm_srai_epi32( _mm_add_epi32( _mm_srai_epi32( tmp1_128, 9 ), _mm_set1_epi32( 1 ) ), 1 );
+        tmp1_128 = _mm_add_epi32( _mm_loadu_si128( (__m128i *)psDelDec->Seed ), tmp1_128 );
+        _mm_storeu_si128( (__m128i *)psDelDec->Seed, tmp1_128 );
+        _mm_storeu_si128( (__m128i *)psDelDec->RandState[ *smpl_buf_idx ], tmp1_128 );
+        _mm_storeu_si128( (__m128i *)psDelDec->RD_Q10, _mm_loadu_si128( (__m128i *)psSampleState[ 0 ].RD_Q10 ) );
+        delayedGain_Q10[ *smpl_buf_idx ] = Gain_Q10;
+    }
+    /* Update LPC states */
+    silk_memcpy( psDelDec->sLPC_Q14[ 0 ], psDelDec->sLPC_Q14[ length ], AVX2_MAX_DEL_DEC_STATES * NSQ_LPC_BUF_LENGTH * sizeof( opus_int32 ) );
+}
+
+static OPUS_INLINE void silk_nsq_del_dec_scale_states_avx2(
+    const silk_encoder_state *psEncC,               /* I    Encoder State                       */
+    silk_nsq_state      *NSQ,                       /* I/O  NSQ state                           */
+    NSQ_del_decs_struct *psDelDec,                  /* I/O  Delayed decision states             */
+    const opus_int16    x16[],                      /* I    Input                               */
+    opus_int32          x_sc_Q10[],                 /* O    Input scaled with 1/Gain in Q10     */
+    const opus_int16    sLTP[],                     /* I    Re-whitened LTP state in Q0         */
+    opus_int32          sLTP_Q15[],                 /* O    LTP state matching scaled input     */
+    opus_int            subfr,                      /* I    Subframe number                     */
+    const opus_int      LTP_scale_Q14,              /* I    LTP state scaling                   */
+    const opus_int32    Gains_Q16[ MAX_NB_SUBFR ],  /* I                                        */
+    const opus_int      pitchL[ MAX_NB_SUBFR ],     /* I    Pitch lag                           */
+    const opus_int      signal_type,                /* I    Signal type                         */
+    const opus_int      decisionDelay               /* I    Decision delay                      */
+)
+{
+    opus_int            lag;
+    opus_int32          gain_adj_Q16, inv_gain_Q31, inv_gain_Q26;
+
+    lag          = pitchL[ subfr ];
+    inv_gain_Q31 = silk_INVERSE32_varQ( silk_max( Gains_Q16[ subfr ], 1 ), 47 );
+    silk_assert( inv_gain_Q31 != 0 );
+
+    /* Scale input */
+    inv_gain_Q26 = silk_RSHIFT_ROUND( inv_gain_Q31, 5 );
+    silk_SMULWW_loop_avx2( x16, inv_gain_Q26, x_sc_Q10, psEncC->subfr_length );
+
+    /* After rewhitening the LTP state is un-scaled, so scale with inv_gain_Q16 */
+    if( NSQ->rewhite_flag ) {
+        if( subfr == 0 ) {
+            /* Do LTP downscaling */
+            inv_gain_Q31 = silk_LSHIFT( silk_SMULWB( inv_gain_Q31, LTP_scale_Q14 ), 2 );
+        }
+        silk_SMULWW_loop_avx2( sLTP + NSQ->sLTP_buf_idx - lag - LTP_ORDER / 2, inv_gain_Q31,
+            sLTP_Q15 + NSQ->sLTP_buf_idx - lag - LTP_ORDER / 2, lag + LTP_ORDER / 2 );
+    }
+
+    /* Adjust for changing gain */
+    if( Gains_Q16[ subfr ] != NSQ->prev_gain_Q16 ) {
+        gain_adj_Q16 = silk_DIV32_varQ( NSQ->prev_gain_Q16, Gains_Q16[ subfr ], 16 );
+
+        /* Scale long-term shaping state */
+        silk_SMULWW_inplace_avx2( NSQ->sLTP_shp_Q14 + NSQ->sLTP_shp_buf_idx - psEncC->ltp_mem_length,
+            gain_adj_Q16, psEncC->ltp_mem_length );
+
+        /* Scale long-term prediction state */
+        if( signal_type == TYPE_VOICED && NSQ->rewhite_flag == 0 ) {
+            silk_SMULWW_inplace_avx2( sLTP_Q15 + NSQ->sLTP_buf_idx - lag - LTP_ORDER / 2,
+                gain_adj_Q16, lag + LTP_ORDER / 2 - decisionDelay );
+        }
+
+        /* Scale scalar states */
+        {
+            const __m128i gain_adj_Q16_128 = _mm_set1_epi32( gain_adj_Q16 );
+            _mm_storeu_si128( (__m128i *)psDelDec->LF_AR_Q14,
+                silk_mm_smulww_epi32( _mm_loadu_si128( (__m128i *)psDelDec->LF_AR_Q14 ), gain_adj_Q16_128 ) );
+            _mm_storeu_si128( (__m128i *)psDelDec->Diff_Q14,
+                silk_mm_smulww_epi32( _mm_loadu_si128( (__m128i *)psDelDec->Diff_Q14 ), gain_adj_Q16_128 ) );
+        }
+
+        /* Scale short-term prediction and shaping states */
+        silk_SMULWW_inplace_avx2( psDelDec->sLPC_Q14[ 0 ], gain_adj_Q16, NSQ_LPC_BUF_LENGTH * AVX2_MAX_DEL_DEC_STATES );
+        silk_SMULWW_inplace_avx2( psDelDec->sAR2_Q14[ 0 ], gain_adj_Q16, MAX_SHAPE_LPC_ORDER * AVX2_MAX_DEL_DEC_STATES );
+        silk_SMULWW_inplace_avx2( psDelDec->Pred_Q15[ 0 ], gain_adj_Q16, DECISION_DELAY * AVX2_MAX_DEL_DEC_STATES );
+        silk_SMULWW_inplace_avx2( psDelDec->Shape_Q14[ 0 ], gain_adj_Q16, DECISION_DELAY * AVX2_MAX_DEL_DEC_STATES );
+
+        /* Save inverse gain */
+        NSQ->prev_gain_Q16 = Gains_Q16[ subfr ];
+    }
+}
@@ -89,6 +89,38 @@ extern opus_int64 (*const SILK_INNER_PROD16_ALIGNED_64_IMPL[OPUS_ARCHMASK + 1])(
 #  define silk_inner_prod16_aligned_64(inVec1, inVec2, len, arch) \
     ((*SILK_INNER_PROD16_ALIGNED_64_IMPL[(arch) & OPUS_ARCHMASK])(inVec1, inVec2, len))
 
+#endif
+
+#  define OVERRIDE_silk_biquad_alt_stride2
+
+void silk_biquad_alt_stride2_sse4_1(
+    const opus_int16            *in,                /* I     input signal                                               */
+    const opus_int32            *B_Q28,             /* I     MA coefficients [3]                                        */
+    const opus_int32            *A_Q28,             /* I     AR coefficients [2]                                        */
+    opus_int32                  *S,                 /* I/O   State vector [4]                                           */
+    opus_int16                  *out,               /* O     output signal                                              */
+    const opus_int32            len                 /* I     signal length (must be even)                               */
+);
+
+#if defined(OPUS_X86_PRESUME_SSE4_1)
+
+#define silk_biquad_alt_stride2(in, B_Q28, A_Q28, S, out, len, arch) \
+    ((void)(arch), silk_biquad_alt_stride2_sse4_1(in, B_Q28, A_Q28, S, out, len))
+
+#else
+
+extern void (*const SILK_BIQUAD_ALT_STRIDE2_IMPL[OPUS_ARCHMASK + 1])(
+    const opus_int16            *in,                /* I     input signal                                               */
+    const opus_int32            *B_Q28,             /* I     MA coefficients [3]                                        */
+    const opus_int32            *A_Q28,             /* I     AR coefficients [2]                                        */
+    opus_int32                  *S,                 /* I/O   State vector [4]                                           */
+    opus_int16                  *out,               /* O     output signal                                              */
+    const opus_int32            len                 /* I     signal length (must be even)                               */
+);
+
+#  define silk_biquad_alt_stride2(in, B_Q28, A_Q28, S, out, len, arch) \
+    ((*SILK_BIQUAD_ALT_STRIDE2_IMPL[(arch) & OPUS_ARCHMASK])(in, B_Q28, A_Q28, S, out, len))
+
 #endif
 #endif
 #endif
@@ -0,0 +1,133 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SIGPROC_FLP_SSE_H
+#define SIGPROC_FLP_SSE_H
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2)
+double silk_inner_product_FLP_sse2(
+    const silk_float    *data1,
+    const silk_float    *data2,
+    opus_int            dataSize
+);
+
+double silk_energy_FLP_sse2(
+    const silk_float    *data,
+    opus_int            dataSize
+);
+
+void silk_warped_autocorrelation_FLP_sse2(
+    silk_float          *corr,
+    const silk_float    *input,
+    const silk_float    warping,
+    const opus_int      length,
+    const opus_int      order
+);
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+double silk_inner_product_FLP_avx2(
+    const silk_float    *data1,
+    const silk_float    *data2,
+    opus_int            dataSize
+);
+
+double silk_energy_FLP_avx2(
+    const silk_float    *data,
+    opus_int            dataSize
+);
+
+void silk_warped_autocorrelation_FLP_avx2(
+    silk_float          *corr,
+    const silk_float    *input,
+    const silk_float    warping,
+    const opus_int      length,
+    const opus_int      order
+);
+#endif
+
+#if defined(OPUS_X86_PRESUME_AVX2)
+
+#define OVERRIDE_silk_inner_product_FLP
+#define silk_inner_product_FLP(data1, data2, dataSize, arch) \
+    ((void)(arch),silk_inner_product_FLP_avx2(data1, data2, dataSize))
+
+#define OVERRIDE_silk_energy_FLP
+#define silk_energy_FLP(data, dataSize, arch) \
+    ((void)(arch),silk_energy_FLP_avx2(data, dataSize))
+
+#define OVERRIDE_silk_warped_autocorrelation_FLP
+#define silk_warped_autocorrelation_FLP(corr, input, warping, length, order, arch) \
+    ((void)(arch),silk_warped_autocorrelation_FLP_avx2(corr, input, warping, length, order))
+
+#elif defined(OPUS_X86_PRESUME_SSE2) && !defined(OPUS_X86_MAY_HAVE_AVX2)
+
+#define OVERRIDE_silk_inner_product_FLP
+#define silk_inner_product_FLP(data1, data2, dataSize, arch) \
+    ((void)(arch),silk_inner_product_FLP_sse2(data1, data2, dataSize))
+
+#define OVERRIDE_silk_energy_FLP
+#define silk_energy_FLP(data, dataSize, arch) \
+    ((void)(arch),silk_energy_FLP_sse2(data, dataSize))
+
+#define OVERRIDE_silk_warped_autocorrelation_FLP
+#define silk_warped_autocorrelation_FLP(corr, input, warping, length, order, arch) \
+    ((void)(arch),silk_warped_autocorrelation_FLP_sse2(corr, input, warping, length, order))
+
+#else
+
+#define OVERRIDE_silk_inner_product_FLP
+extern double (*const SILK_INNER_PRODUCT_FLP_IMPL[OPUS_ARCHMASK + 1])(
+    const silk_float    *data1,
+    const silk_float    *data2,
+    opus_int            dataSize);
+#define silk_inner_product_FLP(data1, data2, dataSize, arch) \
+    ((*SILK_INNER_PRODUCT_FLP_IMPL[(arch) & OPUS_ARCHMASK])(data1, data2, dataSize))
+
+#define OVERRIDE_silk_energy_FLP
+extern double (*const SILK_ENERGY_FLP_IMPL[OPUS_ARCHMASK + 1])(
+    const silk_float    *data,
+    opus_int            dataSize);
+#define silk_energy_FLP(data, dataSize, arch) \
+    ((*SILK_ENERGY_FLP_IMPL[(arch) & OPUS_ARCHMASK])(data, dataSize))
+
+#define OVERRIDE_silk_warped_autocorrelation_FLP
+extern void (*const SILK_WARPED_AUTOCORRELATION_FLP_IMPL[OPUS_ARCHMASK + 1])(
+    silk_float          *corr,
+    const silk_float    *input,
+    const silk_float    warping,
+    const opus_int      length,
+    const opus_int      order);
+#define silk_warped_autocorrelation_FLP(corr, input, warping, length, order, arch) \
+    ((*SILK_WARPED_AUTOCORRELATION_FLP_IMPL[(arch) & OPUS_ARCHMASK])(corr, input, warping, length, order))
+
+#endif
+
+#endif
@@ -35,108 +35,137 @@
 #include "main.h"
 #include "celt/x86/x86cpu.h"
 
+/* silk_SMLAWB() on four lanes, for c32 within 16 bits */
+static OPUS_INLINE __m128i silk_SMLAWB_epi32( __m128i a32, __m128i b32, __m128i c32 )
+{
+    __m128i even, odd;
+    even = _mm_srli_epi64( _mm_mul_epi32( b32, c32 ), 16 );
+    odd = _mm_slli_epi64( _mm_mul_epi32( _mm_srli_epi64( b32, 32 ), _mm_srli_epi64( c32, 32 ) ), 16 );
+    return _mm_add_epi32( a32, _mm_blend_epi16( even, odd, 0xCC ) );
+}
+
+/* Element j of codebook rows 0 and 1 taken from the first 16 bytes of a group of four rows, and of rows 2 */
+/* and 3 from the 16 bytes at offset 4, sign-extended to 32 bits */
+#define VQ_CB_EPI32( cb_lo, cb_hi, j ) \
+    _mm_srai_epi32( _mm_blend_epi16( \
+        _mm_shuffle_epi8( cb_lo, _mm_setr_epi8( -1, -1, -1, j, -1, -1, -1, 5 + j, -1, -1, -1, 6 + j, -1, -1, -1, 11 + j ) ), \
+        _mm_shuffle_epi8( cb_hi, _mm_setr_epi8( -1, -1, -1, j, -1, -1, -1, 5 + j, -1, -1, -1, 6 + j, -1, -1, -1, 11 + j ) ), \
+        0xF0 ), 24 )
+
 /* Entropy constrained matrix-weighted VQ, hard-coded to 5-element vectors, for a single input data vector */
 void silk_VQ_WMat_EC_sse4_1(
     opus_int8                   *ind,                           /* O    index of best codebook vector               */
-    opus_int32                  *rate_dist_Q14,                 /* O    best weighted quant error + mu * rate       */
+    opus_int32                  *res_nrg_Q15,                   /* O    best residual energy                        */
+    opus_int32                  *rate_dist_Q8,                  /* O    best total bitrate                          */
     opus_int                    *gain_Q7,                       /* O    sum of absolute LTP coefficients            */
-    const opus_int16            *in_Q14,                        /* I    input vector to be quantized                */
-    const opus_int32            *W_Q18,                         /* I    weighting matrix                            */
+    const opus_int32            *XX_Q17,                        /* I    correlation matrix                          */
+    const opus_int32            *xX_Q17,                        /* I    correlation vector                          */
     const opus_int8             *cb_Q7,                         /* I    codebook                                    */
     const opus_uint8            *cb_gain_Q7,                    /* I    codebook effective gain                     */
     const opus_uint8            *cl_Q5,                         /* I    code length for each codebook vector        */
-    const opus_int              mu_Q9,                          /* I    tradeoff betw. weighted error and rate      */
+    const opus_int              subfr_len,                      /* I    number of samples per subframe              */
     const opus_int32            max_gain_Q7,                    /* I    maximum sum of absolute LTP coefficients    */
-    opus_int                    L                               /* I    number of vectors in codebook               */
+    const opus_int              L                               /* I    number of vectors in codebook               */
 )
 {
-    opus_int   k, gain_tmp_Q7;
+    opus_int   j, k, gain_tmp_Q7;
     const opus_int8 *cb_row_Q7;
-    opus_int16 diff_Q14[ 5 ];
-    opus_int32 sum1_Q14, sum2_Q16;
+    opus_int32 sum1_Q15[ 4 ];
+    opus_int32 bits_res_Q8, bits_tot_Q8;
+    __m128i    neg_xX_Q24[ 5 ];
+    __m128i    cb_lo, cb_hi, cb0_Q7, cb1_Q7, cb2_Q7, cb3_Q7, cb4_Q7;
+    __m128i    sum1_Q15_vec, sum2_Q24;
+
+    /* The codebook is scored four vectors at a time */
+    if( L & 3 ) {
+        silk_VQ_WMat_EC_c( ind, res_nrg_Q15, rate_dist_Q8, gain_Q7, XX_Q17, xX_Q17, cb_Q7, cb_gain_Q7, cl_Q5,
+            subfr_len, max_gain_Q7, L );
+        return;
+    }
+
+    /* Negate and convert to new Q domain */
+    for( j = 0; j < 5; j++ ) {
+        neg_xX_Q24[ j ] = _mm_set1_epi32( -silk_LSHIFT32( xX_Q17[ j ], 7 ) );
+    }
 
-    __m128i C_tmp1, C_tmp2, C_tmp3, C_tmp4, C_tmp5;
     /* Loop over codebook */
-    *rate_dist_Q14 = silk_int32_MAX;
+    *rate_dist_Q8 = silk_int32_MAX;
+    *res_nrg_Q15 = silk_int32_MAX;
     cb_row_Q7 = cb_Q7;
-    for( k = 0; k < L; k++ ) {
-        gain_tmp_Q7 = cb_gain_Q7[k];
-
-        diff_Q14[ 0 ] = in_Q14[ 0 ] - silk_LSHIFT( cb_row_Q7[ 0 ], 7 );
-
-        C_tmp1 = OP_CVTEPI16_EPI32_M64( &in_Q14[ 1 ] );
-        C_tmp2 = OP_CVTEPI8_EPI32_M32( &cb_row_Q7[ 1 ] );
-        C_tmp2 = _mm_slli_epi32( C_tmp2, 7 );
-        C_tmp1 = _mm_sub_epi32( C_tmp1, C_tmp2 );
-
-        diff_Q14[ 1 ] = _mm_extract_epi16( C_tmp1, 0 );
-        diff_Q14[ 2 ] = _mm_extract_epi16( C_tmp1, 2 );
-        diff_Q14[ 3 ] = _mm_extract_epi16( C_tmp1, 4 );
-        diff_Q14[ 4 ] = _mm_extract_epi16( C_tmp1, 6 );
-
-        /* Weighted rate */
-        sum1_Q14 = silk_SMULBB( mu_Q9, cl_Q5[ k ] );
-
-        /* Penalty for too large gain */
-        sum1_Q14 = silk_ADD_LSHIFT32( sum1_Q14, silk_max( silk_SUB32( gain_tmp_Q7, max_gain_Q7 ), 0 ), 10 );
-
-        silk_assert( sum1_Q14 >= 0 );
-
-        /* first row of W_Q18 */
-        C_tmp3 = _mm_loadu_si128( (__m128i *)(&W_Q18[ 1 ] ) );
-        C_tmp4 = _mm_mul_epi32( C_tmp3, C_tmp1 );
-        C_tmp4 = _mm_srli_si128( C_tmp4, 2 );
-
-        C_tmp1 = _mm_shuffle_epi32( C_tmp1, _MM_SHUFFLE( 0, 3, 2, 1 ) ); /* shift right 4 bytes */
-        C_tmp3 = _mm_shuffle_epi32( C_tmp3, _MM_SHUFFLE( 0, 3, 2, 1 ) ); /* shift right 4 bytes */
-
-        C_tmp5 = _mm_mul_epi32( C_tmp3, C_tmp1 );
-        C_tmp5 = _mm_srli_si128( C_tmp5, 2 );
-
-        C_tmp5 = _mm_add_epi32( C_tmp4, C_tmp5 );
-        C_tmp5 = _mm_slli_epi32( C_tmp5, 1 );
-
-        C_tmp5 = _mm_add_epi32( C_tmp5, _mm_shuffle_epi32( C_tmp5, _MM_SHUFFLE( 0, 0, 0, 2 ) ) );
-        sum2_Q16 = _mm_cvtsi128_si32( C_tmp5 );
-
-        sum2_Q16 = silk_SMLAWB( sum2_Q16, W_Q18[  0 ], diff_Q14[ 0 ] );
-        sum1_Q14 = silk_SMLAWB( sum1_Q14, sum2_Q16,    diff_Q14[ 0 ] );
-
-        /* second row of W_Q18 */
-        sum2_Q16 = silk_SMULWB(           W_Q18[  7 ], diff_Q14[ 2 ] );
-        sum2_Q16 = silk_SMLAWB( sum2_Q16, W_Q18[  8 ], diff_Q14[ 3 ] );
-        sum2_Q16 = silk_SMLAWB( sum2_Q16, W_Q18[  9 ], diff_Q14[ 4 ] );
-        sum2_Q16 = silk_LSHIFT( sum2_Q16, 1 );
-        sum2_Q16 = silk_SMLAWB( sum2_Q16, W_Q18[  6 ], diff_Q14[ 1 ] );
-        sum1_Q14 = silk_SMLAWB( sum1_Q14, sum2_Q16,    diff_Q14[ 1 ] );
-
-        /* third row of W_Q18 */
-        sum2_Q16 = silk_SMULWB(           W_Q18[ 13 ], diff_Q14[ 3 ] );
-        sum2_Q16 = silk_SMLAWB( sum2_Q16, W_Q18[ 14 ], diff_Q14[ 4 ] );
-        sum2_Q16 = silk_LSHIFT( sum2_Q16, 1 );
-        sum2_Q16 = silk_SMLAWB( sum2_Q16, W_Q18[ 12 ], diff_Q14[ 2 ] );
-        sum1_Q14 = silk_SMLAWB( sum1_Q14, sum2_Q16,    diff_Q14[ 2 ] );
-
-        /* fourth row of W_Q18 */
-        sum2_Q16 = silk_SMULWB(           W_Q18[ 19 ], diff_Q14[ 4 ] );
-        sum2_Q16 = silk_LSHIFT( sum2_Q16, 1 );
-        sum2_Q16 = silk_SMLAWB( sum2_Q16, W_Q18[ 18 ], diff_Q14[ 3 ] );
-        sum1_Q14 = silk_SMLAWB( sum1_Q14, sum2_Q16,    diff_Q14[ 3 ] );
-
-        /* last row of W_Q18 */
-        sum2_Q16 = silk_SMULWB(           W_Q18[ 24 ], diff_Q14[ 4 ] );
-        sum1_Q14 = silk_SMLAWB( sum1_Q14, sum2_Q16,    diff_Q14[ 4 ] );
-
-        silk_assert( sum1_Q14 >= 0 );
-
-        /* find best */
-        if( sum1_Q14 < *rate_dist_Q14 ) {
-            *rate_dist_Q14 = sum1_Q14;
-            *ind = (opus_int8)k;
-            *gain_Q7 = gain_tmp_Q7;
+    /* In things go really bad, at least *ind is set to something safe. */
+    *ind = 0;
+    for( k = 0; k < L; k += 4 ) {
+        cb_lo = _mm_loadu_si128( (__m128i *)&cb_row_Q7[ 0 ] );
+        cb_hi = _mm_loadu_si128( (__m128i *)&cb_row_Q7[ 4 ] );
+        cb0_Q7 = VQ_CB_EPI32( cb_lo, cb_hi, 0 );
+        cb1_Q7 = VQ_CB_EPI32( cb_lo, cb_hi, 1 );
+        cb2_Q7 = VQ_CB_EPI32( cb_lo, cb_hi, 2 );
+        cb3_Q7 = VQ_CB_EPI32( cb_lo, cb_hi, 3 );
+        cb4_Q7 = VQ_CB_EPI32( cb_lo, cb_hi, 4 );
+
+        /* Quantization error: 1 - 2 * xX * cb + cb' * XX * cb */
+        sum1_Q15_vec = _mm_set1_epi32( SILK_FIX_CONST( 1.001, 15 ) );
+
+        /* first row of XX_Q17 */
+        sum2_Q24 = _mm_add_epi32( neg_xX_Q24[ 0 ], _mm_mullo_epi32( _mm_set1_epi32( XX_Q17[ 1 ] ), cb1_Q7 ) );
+        sum2_Q24 = _mm_add_epi32( sum2_Q24, _mm_mullo_epi32( _mm_set1_epi32( XX_Q17[ 2 ] ), cb2_Q7 ) );
+        sum2_Q24 = _mm_add_epi32( sum2_Q24, _mm_mullo_epi32( _mm_set1_epi32( XX_Q17[ 3 ] ), cb3_Q7 ) );
+        sum2_Q24 = _mm_add_epi32( sum2_Q24, _mm_mullo_epi32( _mm_set1_epi32( XX_Q17[ 4 ] ), cb4_Q7 ) );
+        sum2_Q24 = _mm_slli_epi32( sum2_Q24, 1 );
+        sum2_Q24 = _mm_add_epi32( sum2_Q24, _mm_mullo_epi32( _mm_set1_epi32( XX_Q17[ 0 ] ), cb0_Q7 ) );
+        sum1_Q15_vec = silk_SMLAWB_epi32( sum1_Q15_vec, sum2_Q24, cb0_Q7 );
+
+        /* second row of XX_Q17 */
+        sum2_Q24 = _mm_add_epi32( neg_xX_Q24[ 1 ], _mm_mullo_epi32( _mm_set1_epi32( XX_Q17[ 7 ] ), cb2_Q7 ) );
+        sum2_Q24 = _mm_add_epi32( sum2_Q24, _mm_mullo_epi32( _mm_set1_epi32( XX_Q17[ 8 ] ), cb3_Q7 ) );
+        sum2_Q24 = _mm_add_epi32( sum2_Q24, _mm_mullo_epi32( _mm_set1_epi32( XX_Q17[ 9 ] ), cb4_Q7 ) );
+        sum2_Q24 = _mm_slli_epi32( sum2_Q24, 1 );
+        sum2_Q24 = _mm_add_epi32( sum2_Q24, _mm_mullo_epi32( _mm_set1_epi32( XX_Q17[ 6 ] ), cb1_Q7 ) );
+        sum1_Q15_vec = silk_SMLAWB_epi32( sum1_Q15_vec, sum2_Q24, cb1_Q7 );
+
+        /* third row of XX_Q17 */
+        sum2_Q24 = _mm_add_epi32( neg_xX_Q24[ 2 ], _mm_mullo_epi32( _mm_set1_epi32( XX_Q17[ 13 ] ), cb3_Q7 ) );
+        sum2_Q24 = _mm_add_epi32( sum2_Q24, _mm_mullo_epi32( _mm_set1_epi32( XX_Q17[ 14 ] ), cb4_Q7 ) );
+        sum2_Q24 = _mm_slli_epi32( sum2_Q24, 1 );
+        sum2_Q24 = _mm_add_epi32( sum2_Q24, _mm_mullo_epi32( _mm_set1_epi32( XX_Q17[ 12 ] ), cb2_Q7 ) );
+        sum1_Q15_vec = silk_SMLAWB_epi32( sum1_Q15_vec, sum2_Q24, cb2_Q7 );
+
+        /* fourth row of XX_Q17 */
+        sum2_Q24 = _mm_add_epi32( neg_xX_Q24[ 3 ], _mm_mullo_epi32( _mm_set1_epi32( XX_Q17[ 19 ] ), cb4_Q7 ) );
+        sum2_Q24 = _mm_slli_epi32( sum2_Q24, 1 );
+        sum2_Q24 = _mm_add_epi32( sum2_Q24, _mm_mullo_epi32( _mm_set1_epi32( XX_Q17[ 18 ] ), cb3_Q7 ) );
+        sum1_Q15_vec = silk_SMLAWB_epi32( sum1_Q15_vec, sum2_Q24, cb3_Q7 );
+
+        /* last row of XX_Q17 */
+        sum2_Q24 = _mm_slli_epi32( neg_xX_Q24[ 4 ], 1 );
+        sum2_Q24 = _mm_add_epi32( sum2_Q24, _mm_mullo_epi32( _mm_set1_epi32( XX_Q17[ 24 ] ), cb4_Q7 ) );
+        sum1_Q15_vec = silk_SMLAWB_epi32( sum1_Q15_vec, sum2_Q24, cb4_Q7 );
+
+        _mm_storeu_si128( (__m128i *)sum1_Q15, sum1_Q15_vec );
+
+        /* find best, in codebook order */
+        for( j = 0; j < 4; j++ ) {
+            opus_int32 penalty;
+            gain_tmp_Q7 = cb_gain_Q7[ k + j ];
+
+            /* Penalty for too large gain */
+            penalty = silk_LSHIFT32( silk_max( silk_SUB32( gain_tmp_Q7, max_gain_Q7 ), 0 ), 11 );
+
+            if( sum1_Q15[ j ] >= 0 ) {
+                /* Translate residual energy to bits using high-rate assumption (6 dB ==> 1 bit/sample) */
+                bits_res_Q8 = silk_SMULBB( subfr_len, silk_lin2log( sum1_Q15[ j ] + penalty) - (15 << 7) );
+                /* In the following line we reduce the codelength component by half ("-1"); seems to slghtly improve quality */
+                bits_tot_Q8 = silk_ADD_LSHIFT32( bits_res_Q8, cl_Q5[ k + j ], 3-1 );
+                if( bits_tot_Q8 <= *rate_dist_Q8 ) {
+                    *rate_dist_Q8 = bits_tot_Q8;
+                    *res_nrg_Q15 = sum1_Q15[ j ] + penalty;
+                    *ind = (opus_int8)( k + j );
+                    *gain_Q7 = gain_tmp_Q7;
+                }
+            }
         }
 
-        /* Go to next cbk vector */
-        cb_row_Q7 += LTP_ORDER;
+        /* Go to next group of cbk vectors */
+        cb_row_Q7 += 4 * LTP_ORDER;
     }
 }
@@ -0,0 +1,132 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#include <smmintrin.h>
+#ifdef OPUS_CHECK_ASM
+# include <string.h>
+# include "stack_alloc.h"
+#endif
+#include "SigProc_FIX.h"
+
+/* silk_SMULWB( a32, b32 ) for the low 32 bits of each 64-bit lane. Bits 16..47
+   of the product are what the scalar macro keeps; the upper half of each lane
+   is left as garbage and never used. */
+static OPUS_INLINE __m128i silk_SMULWB_epi64( __m128i a, __m128i b )
+{
+    return _mm_srli_epi64( _mm_mul_epi32( a, b ), 16 );
+}
+
+/* silk_RSHIFT_ROUND( silk_SMULWB( a32, b32 ), 14 ), straight from the 64-bit
+   product. */
+static OPUS_INLINE __m128i silk_SMULWB_RSHIFT_ROUND14_epi64( __m128i a, __m128i b )
+{
+    __m128i t;
+    t = _mm_srli_epi64( _mm_mul_epi32( a, b ), 16 + 13 );
+    t = _mm_add_epi32( t, _mm_set1_epi32( 1 ) );
+    return _mm_srai_epi32( t, 1 );
+}
+
+/* Same as silk_biquad_alt_stride2_c(). The two interleaved channels live in
+   the low halves of the two 64-bit lanes, so every silk_SMULWB() is a single
+   _mm_mul_epi32(). */
+void silk_biquad_alt_stride2_sse4_1(
+    const opus_int16            *in,                /* I     input signal                                               */
+    const opus_int32            *B_Q28,             /* I     MA coefficients [3]                                        */
+    const opus_int32            *A_Q28,             /* I     AR coefficients [2]                                        */
+    opus_int32                  *S,                 /* I/O   State vector [4]                                           */
+    opus_int16                  *out,               /* O     output signal                                              */
+    const opus_int32            len                 /* I     signal length (must be even)                               */
+)
+{
+    /* DIRECT FORM II TRANSPOSED (uses 2 element state vector) */
+    opus_int   k;
+    opus_int32 A0_U_Q28, A0_L_Q28, A1_U_Q28, A1_L_Q28;
+    __m128i    xmm_A0_U, xmm_A0_L, xmm_A1_U, xmm_A1_L, xmm_B0, xmm_B1, xmm_B2;
+    __m128i    xmm_S0, xmm_S1, xmm_in, xmm_out32_Q14, xmm_out;
+
+#ifdef OPUS_CHECK_ASM
+    opus_int32 S_c[ 4 ];
+    VARDECL( opus_int16, out_c );
+    SAVE_STACK;
+    ALLOC( out_c, 2 * len, opus_int16 );
+
+    silk_memcpy( &S_c, S, sizeof( S_c ) );
+    silk_biquad_alt_stride2_c( in, B_Q28, A_Q28, S_c, out_c, len );
+#endif
+
+    /* Negate A_Q28 values and split in two parts */
+    A0_L_Q28 = ( -A_Q28[ 0 ] ) & 0x00003FFF;        /* lower part */
+    A0_U_Q28 = silk_RSHIFT( -A_Q28[ 0 ], 14 );      /* upper part */
+    A1_L_Q28 = ( -A_Q28[ 1 ] ) & 0x00003FFF;        /* lower part */
+    A1_U_Q28 = silk_RSHIFT( -A_Q28[ 1 ], 14 );      /* upper part */
+
+    /* silk_SMULWB() only looks at the low 16 bits of its second operand */
+    xmm_A0_L = _mm_set1_epi32( (opus_int16)A0_L_Q28 );
+    xmm_A0_U = _mm_set1_epi32( (opus_int16)A0_U_Q28 );
+    xmm_A1_L = _mm_set1_epi32( (opus_int16)A1_L_Q28 );
+    xmm_A1_U = _mm_set1_epi32( (opus_int16)A1_U_Q28 );
+    xmm_B0   = _mm_set1_epi32( B_Q28[ 0 ] );
+    xmm_B1   = _mm_set1_epi32( B_Q28[ 1 ] );
+    xmm_B2   = _mm_set1_epi32( B_Q28[ 2 ] );
+
+    /* xmm_S0 = S[ 0 ], x, S[ 2 ], x; xmm_S1 = S[ 1 ], x, S[ 3 ], x */
+    xmm_S0 = _mm_loadu_si128( (__m128i *)S );
+    xmm_S1 = _mm_srli_epi64( xmm_S0, 32 );
+
+    for( k = 0; k < len; k++ ) {
+        /* S[ 0 ], S[ 1 ], S[ 2 ], S[ 3 ]: Q12 */
+        xmm_in = _mm_set_epi32( 0, in[ 2 * k + 1 ], 0, in[ 2 * k + 0 ] );
+        xmm_out32_Q14 = _mm_slli_epi32( _mm_add_epi32( xmm_S0, silk_SMULWB_epi64( xmm_B0, xmm_in ) ), 2 );
+
+        xmm_S0 = _mm_add_epi32( xmm_S1, silk_SMULWB_RSHIFT_ROUND14_epi64( xmm_out32_Q14, xmm_A0_L ) );
+        xmm_S0 = _mm_add_epi32( xmm_S0, silk_SMULWB_epi64( xmm_out32_Q14, xmm_A0_U ) );
+        xmm_S0 = _mm_add_epi32( xmm_S0, silk_SMULWB_epi64( xmm_B1, xmm_in ) );
+
+        xmm_S1 = silk_SMULWB_RSHIFT_ROUND14_epi64( xmm_out32_Q14, xmm_A1_L );
+        xmm_S1 = _mm_add_epi32( xmm_S1, silk_SMULWB_epi64( xmm_out32_Q14, xmm_A1_U ) );
+        xmm_S1 = _mm_add_epi32( xmm_S1, silk_SMULWB_epi64( xmm_B2, xmm_in ) );
+
+        /* Scale back to Q0 and saturate */
+        xmm_out = _mm_srai_epi32( _mm_add_epi32( xmm_out32_Q14, _mm_set1_epi32( (1<<14) - 1 ) ), 14 );
+        xmm_out = _mm_packs_epi32( xmm_out, xmm_out );
+        out[ 2 * k + 0 ] = (opus_int16)_mm_extract_epi16( xmm_out, 0 );
+        out[ 2 * k + 1 ] = (opus_int16)_mm_extract_epi16( xmm_out, 2 );
+    }
+
+    _mm_storeu_si128( (__m128i *)S, _mm_blend_epi16( xmm_S0, _mm_slli_epi64( xmm_S1, 32 ), 0xCC ) );
+
+#ifdef OPUS_CHECK_ASM
+    silk_assert( !memcmp( S_c, S, sizeof( S_c ) ) );
+    silk_assert( !memcmp( out_c, out, 2 * len * sizeof( opus_int16 ) ) );
+    RESTORE_STACK;
+#endif
+}
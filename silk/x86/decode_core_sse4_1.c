@@ -0,0 +1,353 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#include <smmintrin.h>
+#ifdef OPUS_CHECK_ASM
+# include <string.h>
+#endif
+#include "main.h"
+#include "stack_alloc.h"
+
+/* Four lanes of silk_SMULWW( a, b ). Bits 16..47 of each 64-bit product are
+   exactly what silk_SMULWB()/silk_SMULWW() keep, so this is bit-exact with
+   the scalar macros for 16-bit (sign-extended) and 32-bit b alike. */
+static OPUS_INLINE __m128i silk_SMULWW_epi32( __m128i a, __m128i b )
+{
+    __m128i even, odd;
+    even = _mm_srli_epi64( _mm_mul_epi32( a, b ), 16 );
+    odd  = _mm_mul_epi32( _mm_srli_epi64( a, 32 ), _mm_srli_epi64( b, 32 ) );
+    odd  = _mm_slli_epi64( odd, 16 );
+    return _mm_blend_epi16( even, odd, 0xCC );
+}
+
+/* acc + silk_SMULWB( x, coef ) for a broadcast x, with the odd lanes of coef
+   already shifted down into coef_odd */
+static OPUS_INLINE __m128i silk_SMLAWB_bcast_epi32( __m128i acc, __m128i x, __m128i coef, __m128i coef_odd )
+{
+    __m128i even, odd;
+    even = _mm_srli_epi64( _mm_mul_epi32( x, coef ), 16 );
+    odd  = _mm_slli_epi64( _mm_mul_epi32( x, coef_odd ), 16 );
+    return _mm_add_epi32( acc, _mm_blend_epi16( even, odd, 0xCC ) );
+}
+
+/**********************************************************/
+/* Core decoder. Performs inverse NSQ operation LTP + LPC */
+/**********************************************************/
+void silk_decode_core_sse4_1(
+    silk_decoder_state          *psDec,                         /* I/O  Decoder state                               */
+    silk_decoder_control        *psDecCtrl,                     /* I    Decoder control                             */
+    opus_int16                  xq[],                           /* O    Decoded speech                              */
+    const opus_int16            pulses[ MAX_FRAME_LENGTH ],     /* I    Pulse signal                                */
+    int                         arch                            /* I    Run-time architecture                       */
+)
+{
+    opus_int   i, k, t, lag = 0, start_idx, sLTP_buf_idx, NLSF_interpolation_flag, signalType, nVec;
+    opus_int16 *A_Q12, *B_Q14, *pxq, A_Q12_tmp[ MAX_LPC_ORDER ];
+    VARDECL( opus_int16, sLTP );
+    VARDECL( opus_int32, sLTP_Q15 );
+    opus_int32 LTP_pred_Q13, LPC_pred_Q10, Gain_Q10, inv_gain_Q31, gain_adj_Q16, rand_seed, offset_Q10;
+    opus_int32 *pred_lag_ptr, *pexc_Q14, *pres_Q14;
+    opus_int32 LPC_pred_Q10_1, LPC_pred_Q10_2, LPC_pred_Q10_3, sLPC_Q14_0, sLPC_Q14_1, sLPC_Q14_2, sLPC_Q14_3;
+    VARDECL( opus_int32, res_Q14 );
+    VARDECL( opus_int32, sLPC_Q14 );
+    __m128i xmm_A_Q12[ MAX_LPC_ORDER ], xmm_A_Q12_odd[ MAX_LPC_ORDER ], xmm_B_Q14[ LTP_ORDER ], xmm_Gain_Q10;
+    __m128i xmm_acc, xmm_tmp, xmm_H0, xmm_H1, xmm_H2, xmm_H3;
+#ifdef OPUS_CHECK_ASM
+    silk_decoder_state psDec_c;
+    opus_int16 xq_c[ MAX_FRAME_LENGTH ];
+#endif
+    SAVE_STACK;
+
+#ifdef OPUS_CHECK_ASM
+    silk_memcpy( &psDec_c, psDec, sizeof( psDec_c ) );
+    silk_decode_core_c( &psDec_c, psDecCtrl, xq_c, pulses, arch );
+#endif
+
+    silk_assert( psDec->prev_gain_Q16 != 0 );
+
+    ALLOC( sLTP, psDec->ltp_mem_length, opus_int16 );
+    ALLOC( sLTP_Q15, psDec->ltp_mem_length + psDec->frame_length, opus_int32 );
+    ALLOC( res_Q14, psDec->subfr_length, opus_int32 );
+    ALLOC( sLPC_Q14, psDec->subfr_length + MAX_LPC_ORDER, opus_int32 );
+
+    offset_Q10 = silk_Quantization_Offsets_Q10[ psDec->indices.signalType >> 1 ][ psDec->indices.quantOffsetType ];
+
+    if( psDec->indices.NLSFInterpCoef_Q2 < 1 << 2 ) {
+        NLSF_interpolation_flag = 1;
+    } else {
+        NLSF_interpolation_flag = 0;
+    }
+
+    /* Decode excitation */
+    rand_seed = psDec->indices.Seed;
+    for( i = 0; i < psDec->frame_length; i++ ) {
+        rand_seed = silk_RAND( rand_seed );
+        psDec->exc_Q14[ i ] = silk_LSHIFT( (opus_int32)pulses[ i ], 14 );
+        if( psDec->exc_Q14[ i ] > 0 ) {
+            psDec->exc_Q14[ i ] -= QUANT_LEVEL_ADJUST_Q10 << 4;
+        } else
+        if( psDec->exc_Q14[ i ] < 0 ) {
+            psDec->exc_Q14[ i ] += QUANT_LEVEL_ADJUST_Q10 << 4;
+        }
+        psDec->exc_Q14[ i ] += offset_Q10 << 4;
+        if( rand_seed < 0 ) {
+           psDec->exc_Q14[ i ] = -psDec->exc_Q14[ i ];
+        }
+
+        rand_seed = silk_ADD32_ovflw( rand_seed, pulses[ i ] );
+    }
+
+    /* Copy LPC state */
+    silk_memcpy( sLPC_Q14, psDec->sLPC_Q14_buf, MAX_LPC_ORDER * sizeof( opus_int32 ) );
+
+    pexc_Q14 = psDec->exc_Q14;
+    pxq      = xq;
+    sLTP_buf_idx = psDec->ltp_mem_length;
+    /* Loop over subframes */
+    for( k = 0; k < psDec->nb_subfr; k++ ) {
+        pres_Q14 = res_Q14;
+        A_Q12 = psDecCtrl->PredCoef_Q12[ k >> 1 ];
+
+        /* Preload LPC coeficients to array on stack. Gives small performance gain */
+        silk_memcpy( A_Q12_tmp, A_Q12, psDec->LPC_order * sizeof( opus_int16 ) );
+        B_Q14        = &psDecCtrl->LTPCoef_Q14[ k * LTP_ORDER ];
+        signalType   = psDec->indices.signalType;
+
+        Gain_Q10     = silk_RSHIFT( psDecCtrl->Gains_Q16[ k ], 6 );
+        inv_gain_Q31 = silk_INVERSE32_varQ( psDecCtrl->Gains_Q16[ k ], 47 );
+
+        /* Calculate gain adjustment factor */
+        if( psDecCtrl->Gains_Q16[ k ] != psDec->prev_gain_Q16 ) {
+            gain_adj_Q16 =  silk_DIV32_varQ( psDec->prev_gain_Q16, psDecCtrl->Gains_Q16[ k ], 16 );
+
+            /* Scale short term state */
+            for( i = 0; i < MAX_LPC_ORDER; i++ ) {
+                sLPC_Q14[ i ] = silk_SMULWW( gain_adj_Q16, sLPC_Q14[ i ] );
+            }
+        } else {
+            gain_adj_Q16 = (opus_int32)1 << 16;
+        }
+
+        /* Save inv_gain */
+        silk_assert( inv_gain_Q31 != 0 );
+        psDec->prev_gain_Q16 = psDecCtrl->Gains_Q16[ k ];
+
+        /* Avoid abrupt transition from voiced PLC to unvoiced normal decoding */
+        if( psDec->lossCnt && psDec->prevSignalType == TYPE_VOICED &&
+            psDec->indices.signalType != TYPE_VOICED && k < MAX_NB_SUBFR/2 ) {
+
+            silk_memset( B_Q14, 0, LTP_ORDER * sizeof( opus_int16 ) );
+            B_Q14[ LTP_ORDER/2 ] = SILK_FIX_CONST( 0.25, 14 );
+
+            signalType = TYPE_VOICED;
+            psDecCtrl->pitchL[ k ] = psDec->lagPrev;
+        }
+
+        if( signalType == TYPE_VOICED ) {
+            /* Voiced */
+            lag = psDecCtrl->pitchL[ k ];
+
+            /* Re-whitening */
+            if( k == 0 || ( k == 2 && NLSF_interpolation_flag ) ) {
+                /* Rewhiten with new A coefs */
+                start_idx = psDec->ltp_mem_length - lag - psDec->LPC_order - LTP_ORDER / 2;
+                silk_assert( start_idx > 0 );
+
+                if( k == 2 ) {
+                    silk_memcpy( &psDec->outBuf[ psDec->ltp_mem_length ], xq, 2 * psDec->subfr_length * sizeof( opus_int16 ) );
+                }
+
+                silk_LPC_analysis_filter( &sLTP[ start_idx ], &psDec->outBuf[ start_idx + k * psDec->subfr_length ],
+                    A_Q12, psDec->ltp_mem_length - start_idx, psDec->LPC_order, arch );
+
+                /* After rewhitening the LTP state is unscaled */
+                if( k == 0 ) {
+                    /* Do LTP downscaling to reduce inter-packet dependency */
+                    inv_gain_Q31 = silk_LSHIFT( silk_SMULWB( inv_gain_Q31, psDecCtrl->LTP_scale_Q14 ), 2 );
+                }
+                for( i = 0; i < lag + LTP_ORDER/2; i++ ) {
+                    sLTP_Q15[ sLTP_buf_idx - i - 1 ] = silk_SMULWB( inv_gain_Q31, sLTP[ psDec->ltp_mem_length - i - 1 ] );
+                }
+            } else {
+                /* Update LTP state when Gain changes */
+                if( gain_adj_Q16 != (opus_int32)1 << 16 ) {
+                    for( i = 0; i < lag + LTP_ORDER/2; i++ ) {
+                        sLTP_Q15[ sLTP_buf_idx - i - 1 ] = silk_SMULWW( gain_adj_Q16, sLTP_Q15[ sLTP_buf_idx - i - 1 ] );
+                    }
+                }
+            }
+        }
+
+        /* Long-term prediction */
+        if( signalType == TYPE_VOICED ) {
+            /* Set up pointer */
+            pred_lag_ptr = &sLTP_Q15[ sLTP_buf_idx - lag + LTP_ORDER / 2 ];
+
+            /* Four outputs at a time, as long as the newest tap of the last one
+               refers to a sample written by an earlier group */
+            nVec = lag >= LTP_ORDER / 2 + 4 ? psDec->subfr_length & ~3 : 0;
+            for( t = 0; t < LTP_ORDER; t++ ) {
+                xmm_B_Q14[ t ] = _mm_set1_epi32( B_Q14[ t ] );
+            }
+            for( i = 0; i < nVec; i += 4 ) {
+                /* Avoids introducing a bias because silk_SMLAWB() always rounds to -inf */
+                xmm_acc = _mm_set1_epi32( 2 );
+                for( t = 0; t < LTP_ORDER; t++ ) {
+                    xmm_tmp = _mm_loadu_si128( (__m128i *)&pred_lag_ptr[ i - t ] );
+                    xmm_acc = _mm_add_epi32( xmm_acc, silk_SMULWW_epi32( xmm_tmp, xmm_B_Q14[ t ] ) );
+                }
+
+                /* Generate LPC excitation */
+                xmm_tmp = _mm_add_epi32( _mm_loadu_si128( (__m128i *)&pexc_Q14[ i ] ), _mm_slli_epi32( xmm_acc, 1 ) );
+                _mm_storeu_si128( (__m128i *)&pres_Q14[ i ], xmm_tmp );
+
+                /* Update states */
+                _mm_storeu_si128( (__m128i *)&sLTP_Q15[ sLTP_buf_idx + i ], _mm_slli_epi32( xmm_tmp, 1 ) );
+            }
+            for( ; i < psDec->subfr_length; i++ ) {
+                LTP_pred_Q13 = 2;
+                for( t = 0; t < LTP_ORDER; t++ ) {
+                    LTP_pred_Q13 = silk_SMLAWB( LTP_pred_Q13, pred_lag_ptr[ i - t ], B_Q14[ t ] );
+                }
+                pres_Q14[ i ] = silk_ADD_LSHIFT32( pexc_Q14[ i ], LTP_pred_Q13, 1 );
+                sLTP_Q15[ sLTP_buf_idx + i ] = silk_LSHIFT( pres_Q14[ i ], 1 );
+            }
+            sLTP_buf_idx += psDec->subfr_length;
+        } else {
+            pres_Q14 = pexc_Q14;
+        }
+
+        /* Short-term prediction, four outputs at a time. The 16 previous outputs
+           stay in registers (xmm_H0 holds the newest four) and each of them is
+           multiplied by the coefficients it has for all four new outputs:
+           lane j of xmm_A_Q12[ t ] is the tap output i + j applies to sample
+           i - 1 - t. Outputs of the same group depend on each other, so those
+           few taps are added one by one */
+        silk_assert( psDec->LPC_order == 10 || psDec->LPC_order == 16 );
+        for( t = 0; t < MAX_LPC_ORDER; t++ ) {
+            xmm_A_Q12[ t ] = _mm_set_epi32( t + 3 < psDec->LPC_order ? A_Q12_tmp[ t + 3 ] : 0,
+                                            t + 2 < psDec->LPC_order ? A_Q12_tmp[ t + 2 ] : 0,
+                                            t + 1 < psDec->LPC_order ? A_Q12_tmp[ t + 1 ] : 0,
+                                            t     < psDec->LPC_order ? A_Q12_tmp[ t ]     : 0 );
+            xmm_A_Q12_odd[ t ] = _mm_srli_epi64( xmm_A_Q12[ t ], 32 );
+        }
+        xmm_H3 = _mm_loadu_si128( (__m128i *)&sLPC_Q14[ MAX_LPC_ORDER - 16 ] );
+        xmm_H2 = _mm_loadu_si128( (__m128i *)&sLPC_Q14[ MAX_LPC_ORDER - 12 ] );
+        xmm_H1 = _mm_loadu_si128( (__m128i *)&sLPC_Q14[ MAX_LPC_ORDER - 8 ] );
+        xmm_H0 = _mm_loadu_si128( (__m128i *)&sLPC_Q14[ MAX_LPC_ORDER - 4 ] );
+        nVec = psDec->subfr_length & ~3;
+        for( i = 0; i < nVec; i += 4 ) {
+            /* Avoids introducing a bias because silk_SMLAWB() always rounds to -inf */
+            xmm_acc = _mm_set1_epi32( silk_RSHIFT( psDec->LPC_order, 1 ) );
+            if( psDec->LPC_order > 12 ) {
+                xmm_acc = silk_SMLAWB_bcast_epi32( xmm_acc, _mm_shuffle_epi32( xmm_H3, 0xFF ), xmm_A_Q12[ 12 ], xmm_A_Q12_odd[ 12 ] );
+                xmm_acc = silk_SMLAWB_bcast_epi32( xmm_acc, _mm_shuffle_epi32( xmm_H3, 0xAA ), xmm_A_Q12[ 13 ], xmm_A_Q12_odd[ 13 ] );
+                xmm_acc = silk_SMLAWB_bcast_epi32( xmm_acc, _mm_shuffle_epi32( xmm_H3, 0x55 ), xmm_A_Q12[ 14 ], xmm_A_Q12_odd[ 14 ] );
+                xmm_acc = silk_SMLAWB_bcast_epi32( xmm_acc, _mm_shuffle_epi32( xmm_H3, 0x00 ), xmm_A_Q12[ 15 ], xmm_A_Q12_odd[ 15 ] );
+            }
+            xmm_acc = silk_SMLAWB_bcast_epi32( xmm_acc, _mm_shuffle_epi32( xmm_H2, 0xFF ), xmm_A_Q12[ 8 ], xmm_A_Q12_odd[ 8 ] );
+            xmm_acc = silk_SMLAWB_bcast_epi32( xmm_acc, _mm_shuffle_epi32( xmm_H2, 0xAA ), xmm_A_Q12[ 9 ], xmm_A_Q12_odd[ 9 ] );
+            xmm_acc = silk_SMLAWB_bcast_epi32( xmm_acc, _mm_shuffle_epi32( xmm_H2, 0x55 ), xmm_A_Q12[ 10 ], xmm_A_Q12_odd[ 10 ] );
+            xmm_acc = silk_SMLAWB_bcast_epi32( xmm_acc, _mm_shuffle_epi32( xmm_H2, 0x00 ), xmm_A_Q12[ 11 ], xmm_A_Q12_odd[ 11 ] );
+            xmm_acc = silk_SMLAWB_bcast_epi32( xmm_acc, _mm_shuffle_epi32( xmm_H1, 0xFF ), xmm_A_Q12[ 4 ], xmm_A_Q12_odd[ 4 ] );
+            xmm_acc = silk_SMLAWB_bcast_epi32( xmm_acc, _mm_shuffle_epi32( xmm_H1, 0xAA ), xmm_A_Q12[ 5 ], xmm_A_Q12_odd[ 5 ] );
+            xmm_acc = silk_SMLAWB_bcast_epi32( xmm_acc, _mm_shuffle_epi32( xmm_H1, 0x55 ), xmm_A_Q12[ 6 ], xmm_A_Q12_odd[ 6 ] );
+            xmm_acc = silk_SMLAWB_bcast_epi32( xmm_acc, _mm_shuffle_epi32( xmm_H1, 0x00 ), xmm_A_Q12[ 7 ], xmm_A_Q12_odd[ 7 ] );
+            /* The newest group is summed separately so it joins the chain last */
+            xmm_tmp = _mm_setzero_si128();
+            xmm_tmp = silk_SMLAWB_bcast_epi32( xmm_tmp, _mm_shuffle_epi32( xmm_H0, 0x00 ), xmm_A_Q12[ 3 ], xmm_A_Q12_odd[ 3 ] );
+            xmm_tmp = silk_SMLAWB_bcast_epi32( xmm_tmp, _mm_shuffle_epi32( xmm_H0, 0x55 ), xmm_A_Q12[ 2 ], xmm_A_Q12_odd[ 2 ] );
+            xmm_tmp = silk_SMLAWB_bcast_epi32( xmm_tmp, _mm_shuffle_epi32( xmm_H0, 0xAA ), xmm_A_Q12[ 1 ], xmm_A_Q12_odd[ 1 ] );
+            xmm_tmp = silk_SMLAWB_bcast_epi32( xmm_tmp, _mm_shuffle_epi32( xmm_H0, 0xFF ), xmm_A_Q12[ 0 ], xmm_A_Q12_odd[ 0 ] );
+            xmm_acc = _mm_add_epi32( xmm_acc, xmm_tmp );
+
+            /* Add prediction to LPC excitation */
+            LPC_pred_Q10   = _mm_cvtsi128_si32( xmm_acc );
+            LPC_pred_Q10_1 = _mm_extract_epi32( xmm_acc, 1 );
+            LPC_pred_Q10_2 = _mm_extract_epi32( xmm_acc, 2 );
+            LPC_pred_Q10_3 = _mm_extract_epi32( xmm_acc, 3 );
+            sLPC_Q14_0 = silk_ADD_SAT32( pres_Q14[ i ], silk_LSHIFT_SAT32( LPC_pred_Q10, 4 ) );
+            LPC_pred_Q10_2 = silk_SMLAWB( LPC_pred_Q10_2, sLPC_Q14_0, A_Q12_tmp[ 1 ] );
+            LPC_pred_Q10_3 = silk_SMLAWB( LPC_pred_Q10_3, sLPC_Q14_0, A_Q12_tmp[ 2 ] );
+            LPC_pred_Q10_1 = silk_SMLAWB( LPC_pred_Q10_1, sLPC_Q14_0, A_Q12_tmp[ 0 ] );
+            sLPC_Q14_1 = silk_ADD_SAT32( pres_Q14[ i + 1 ], silk_LSHIFT_SAT32( LPC_pred_Q10_1, 4 ) );
+            LPC_pred_Q10_3 = silk_SMLAWB( LPC_pred_Q10_3, sLPC_Q14_1, A_Q12_tmp[ 1 ] );
+            LPC_pred_Q10_2 = silk_SMLAWB( LPC_pred_Q10_2, sLPC_Q14_1, A_Q12_tmp[ 0 ] );
+            sLPC_Q14_2 = silk_ADD_SAT32( pres_Q14[ i + 2 ], silk_LSHIFT_SAT32( LPC_pred_Q10_2, 4 ) );
+            LPC_pred_Q10_3 = silk_SMLAWB( LPC_pred_Q10_3, sLPC_Q14_2, A_Q12_tmp[ 0 ] );
+            sLPC_Q14_3 = silk_ADD_SAT32( pres_Q14[ i + 3 ], silk_LSHIFT_SAT32( LPC_pred_Q10_3, 4 ) );
+
+            /* Update states */
+            xmm_H3 = xmm_H2;
+            xmm_H2 = xmm_H1;
+            xmm_H1 = xmm_H0;
+            xmm_H0 = _mm_set_epi32( sLPC_Q14_3, sLPC_Q14_2, sLPC_Q14_1, sLPC_Q14_0 );
+            _mm_storeu_si128( (__m128i *)&sLPC_Q14[ MAX_LPC_ORDER + i ], xmm_H0 );
+        }
+        for( ; i < psDec->subfr_length; i++ ) {
+            LPC_pred_Q10 = silk_RSHIFT( psDec->LPC_order, 1 );
+            for( t = 0; t < psDec->LPC_order; t++ ) {
+                LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i - t - 1 ], A_Q12_tmp[ t ] );
+            }
+            sLPC_Q14[ MAX_LPC_ORDER + i ] = silk_ADD_SAT32( pres_Q14[ i ], silk_LSHIFT_SAT32( LPC_pred_Q10, 4 ) );
+        }
+
+        /* Scale with gain */
+        xmm_Gain_Q10 = _mm_set1_epi32( Gain_Q10 );
+        nVec = psDec->subfr_length & ~7;
+        for( i = 0; i < nVec; i += 8 ) {
+            xmm_acc = silk_SMULWW_epi32( _mm_loadu_si128( (__m128i *)&sLPC_Q14[ MAX_LPC_ORDER + i ] ), xmm_Gain_Q10 );
+            xmm_tmp = silk_SMULWW_epi32( _mm_loadu_si128( (__m128i *)&sLPC_Q14[ MAX_LPC_ORDER + i + 4 ] ), xmm_Gain_Q10 );
+            /* silk_RSHIFT_ROUND( x, 8 ), then silk_SAT16() through the saturating pack */
+            xmm_acc = _mm_srai_epi32( _mm_add_epi32( _mm_srai_epi32( xmm_acc, 7 ), _mm_set1_epi32( 1 ) ), 1 );
+            xmm_tmp = _mm_srai_epi32( _mm_add_epi32( _mm_srai_epi32( xmm_tmp, 7 ), _mm_set1_epi32( 1 ) ), 1 );
+            _mm_storeu_si128( (__m128i *)&pxq[ i ], _mm_packs_epi32( xmm_acc, xmm_tmp ) );
+        }
+        for( ; i < psDec->subfr_length; i++ ) {
+            pxq[ i ] = (opus_int16)silk_SAT16( silk_RSHIFT_ROUND( silk_SMULWW( sLPC_Q14[ MAX_LPC_ORDER + i ], Gain_Q10 ), 8 ) );
+        }
+
+        /* Update LPC filter state */
+        silk_memcpy( sLPC_Q14, &sLPC_Q14[ psDec->subfr_length ], MAX_LPC_ORDER * sizeof( opus_int32 ) );
+        pexc_Q14 += psDec->subfr_length;
+        pxq      += psDec->subfr_length;
+    }
+
+    /* Save LPC state */
+    silk_memcpy( psDec->sLPC_Q14_buf, sLPC_Q14, MAX_LPC_ORDER * sizeof( opus_int32 ) );
+
+#ifdef OPUS_CHECK_ASM
+    silk_assert( !memcmp( &psDec_c, psDec, sizeof( psDec_c ) ) );
+    silk_assert( !memcmp( xq_c, xq, psDec->frame_length * sizeof( opus_int16 ) ) );
+#endif
+    RESTORE_STACK;
+}
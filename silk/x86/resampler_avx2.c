@@ -0,0 +1,197 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+
+#ifdef OPUS_CHECK_ASM
+# include <string.h>
+# include "stack_alloc.h"
+#endif
+#include "SigProc_FIX.h"
+#include "resampler_private.h"
+
+/* Eight lanes of silk_SMULWB(), bit-exact with the 64-bit product */
+static OPUS_INLINE __m256i silk_mm256_smulwb_epi32( __m256i a, __m256i b )
+{
+    __m256i hi, lo;
+    hi = _mm256_mullo_epi32( _mm256_srai_epi32( a, 16 ), b );
+    lo = _mm256_mullo_epi32( _mm256_and_si256( a, _mm256_set1_epi32( 0xFFFF ) ), b );
+    return _mm256_add_epi32( hi, _mm256_srai_epi32( lo, 16 ) );
+}
+
+static OPUS_INLINE __m128i silk_mm_smulwb_epi32( __m128i a, __m128i b )
+{
+    __m128i hi, lo;
+    hi = _mm_mullo_epi32( _mm_srai_epi32( a, 16 ), b );
+    lo = _mm_mullo_epi32( _mm_and_si128( a, _mm_set1_epi32( 0xFFFF ) ), b );
+    return _mm_add_epi32( hi, _mm_srai_epi32( lo, 16 ) );
+}
+
+/* Sums the lanes within each 128-bit half of four vectors. With v[ k ] holding
+   outputs k and k + 4 in its low and high halves, this returns the sums of
+   outputs 0 to 7 in order. */
+static OPUS_INLINE __m256i silk_mm256_hsum4x2_epi32( const __m256i *v )
+{
+    return _mm256_hadd_epi32( _mm256_hadd_epi32( v[ 0 ], v[ 1 ] ), _mm256_hadd_epi32( v[ 2 ], v[ 3 ] ) );
+}
+
+/* silk_SAT16( silk_RSHIFT_ROUND( x, shift ) ) for eight values */
+static OPUS_INLINE __m128i silk_mm256_rshift_round_sat16( __m256i x, int shift )
+{
+    x = _mm256_srai_epi32( _mm256_add_epi32( _mm256_srai_epi32( x, shift - 1 ), _mm256_set1_epi32( 1 ) ), 1 );
+    return _mm_packs_epi32( _mm256_castsi256_si128( x ), _mm256_extracti128_si256( x, 1 ) );
+}
+
+/* Reduces the partial sums of up to eight outputs and stores n of them */
+static OPUS_INLINE opus_int16 *silk_resampler_store8_avx2( opus_int16 *out, __m128i *x, opus_int n, int shift )
+{
+    opus_int   i;
+    __m256i    acc[ 4 ];
+    __m128i    res;
+    opus_int16 tmp[ 8 ];
+
+    for( i = n; i < 8; i++ ) {
+        x[ i ] = _mm_setzero_si128();
+    }
+    for( i = 0; i < 4; i++ ) {
+        acc[ i ] = _mm256_inserti128_si256( _mm256_castsi128_si256( x[ i ] ), x[ i + 4 ], 1 );
+    }
+    res = silk_mm256_rshift_round_sat16( silk_mm256_hsum4x2_epi32( acc ), shift );
+    if( n == 8 ) {
+        _mm_storeu_si128( (__m128i *)out, res );
+    } else {
+        _mm_storeu_si128( (__m128i *)tmp, res );
+        silk_memcpy( out, tmp, n * sizeof( opus_int16 ) );
+    }
+    return out + n;
+}
+
+#define REVERSE_EPI32( x ) _mm_shuffle_epi32( x, _MM_SHUFFLE( 0, 1, 2, 3 ) )
+#define REVERSE_EPI32_256( x ) _mm256_permutevar8x32_epi32( x, _mm256_set_epi32( 0, 1, 2, 3, 4, 5, 6, 7 ) )
+
+/* Partial sums of one output of silk_resampler_private_down_FIR_INTERPOL_c(),
+   see silk_resampler_private_down_FIR_INTERPOL_sse4_1() for the layout of W */
+static OPUS_INLINE __m128i silk_resampler_down_FIR_sum_avx2(
+    const opus_int32                *buf_ptr,
+    const opus_int32                *W,
+    opus_int                        FIR_Order
+)
+{
+    __m256i    sum;
+    __m128i    sum4;
+    opus_int32 tail;
+
+    switch( FIR_Order ) {
+        case RESAMPLER_DOWN_ORDER_FIR0:
+            sum = silk_mm256_smulwb_epi32( _mm256_loadu_si256( (const __m256i *)&buf_ptr[ 0 ] ), _mm256_loadu_si256( (const __m256i *)&W[ 0 ] ) );
+            sum = _mm256_add_epi32( sum, silk_mm256_smulwb_epi32( _mm256_loadu_si256( (const __m256i *)&buf_ptr[ 8 ] ), _mm256_loadu_si256( (const __m256i *)&W[ 8 ] ) ) );
+            sum4 = _mm_setzero_si128();
+            tail = silk_SMULWB( buf_ptr[ 16 ], W[ 16 ] );
+            tail = silk_SMLAWB( tail, buf_ptr[ 17 ], W[ 17 ] );
+            break;
+        case RESAMPLER_DOWN_ORDER_FIR1:
+            sum = silk_mm256_smulwb_epi32( _mm256_add_epi32( _mm256_loadu_si256( (const __m256i *)&buf_ptr[ 0 ] ),
+                REVERSE_EPI32_256( _mm256_loadu_si256( (const __m256i *)&buf_ptr[ 16 ] ) ) ), _mm256_loadu_si256( (const __m256i *)&W[ 0 ] ) );
+            sum4 = silk_mm_smulwb_epi32( _mm_add_epi32( _mm_loadu_si128( (const __m128i *)&buf_ptr[ 8 ] ),
+                REVERSE_EPI32( _mm_loadu_si128( (const __m128i *)&buf_ptr[ 12 ] ) ) ), _mm_loadu_si128( (const __m128i *)&W[ 8 ] ) );
+            tail = 0;
+            break;
+        case RESAMPLER_DOWN_ORDER_FIR2:
+            sum = silk_mm256_smulwb_epi32( _mm256_add_epi32( _mm256_loadu_si256( (const __m256i *)&buf_ptr[ 0 ] ),
+                REVERSE_EPI32_256( _mm256_loadu_si256( (const __m256i *)&buf_ptr[ 28 ] ) ) ), _mm256_loadu_si256( (const __m256i *)&W[ 0 ] ) );
+            sum = _mm256_add_epi32( sum, silk_mm256_smulwb_epi32( _mm256_add_epi32( _mm256_loadu_si256( (const __m256i *)&buf_ptr[ 8 ] ),
+                REVERSE_EPI32_256( _mm256_loadu_si256( (const __m256i *)&buf_ptr[ 20 ] ) ) ), _mm256_loadu_si256( (const __m256i *)&W[ 8 ] ) ) );
+            sum4 = _mm_setzero_si128();
+            tail = silk_SMULWB( silk_ADD32( buf_ptr[ 16 ], buf_ptr[ 19 ] ), W[ 16 ] );
+            tail = silk_SMLAWB( tail, silk_ADD32( buf_ptr[ 17 ], buf_ptr[ 18 ] ), W[ 17 ] );
+            break;
+        default:
+            silk_assert( 0 );
+            return _mm_setzero_si128();
+    }
+    sum4 = _mm_add_epi32( sum4, _mm_cvtsi32_si128( tail ) );
+    return _mm_add_epi32( sum4, _mm_add_epi32( _mm256_castsi256_si128( sum ), _mm256_extracti128_si256( sum, 1 ) ) );
+}
+
+opus_int16 *silk_resampler_private_down_FIR_INTERPOL_avx2(
+    opus_int16                      *out,
+    opus_int32                      *buf,
+    const opus_int16                *FIR_Coefs,
+    opus_int                        FIR_Order,
+    opus_int                        FIR_Fracs,
+    opus_int32                      max_index_Q16,
+    opus_int32                      index_increment_Q16
+)
+{
+    opus_int32 index_Q16, interpol_ind;
+    opus_int   i, j, n, stride;
+    opus_int32 W[ 3 * RESAMPLER_DOWN_ORDER_FIR0 ];
+    __m128i    x[ 8 ];
+#ifdef OPUS_CHECK_ASM
+    opus_int16 *const out_a = out;
+    opus_int16 *out_end_c;
+    VARDECL( opus_int16, out_c );
+    SAVE_STACK;
+    ALLOC( out_c, ( max_index_Q16 + index_increment_Q16 - 1 ) / index_increment_Q16, opus_int16 );
+    out_end_c = silk_resampler_private_down_FIR_INTERPOL_c( out_c, buf, FIR_Coefs, FIR_Order, FIR_Fracs, max_index_Q16, index_increment_Q16 );
+#endif
+
+    if( FIR_Order == RESAMPLER_DOWN_ORDER_FIR0 ) {
+        silk_assert( FIR_Fracs <= 3 );
+        stride = RESAMPLER_DOWN_ORDER_FIR0;
+        for( i = 0; i < FIR_Fracs; i++ ) {
+            for( j = 0; j < RESAMPLER_DOWN_ORDER_FIR0 / 2; j++ ) {
+                W[ i * stride + j ] = FIR_Coefs[ RESAMPLER_DOWN_ORDER_FIR0 / 2 * i + j ];
+                W[ i * stride + RESAMPLER_DOWN_ORDER_FIR0 - 1 - j ] =
+                    FIR_Coefs[ RESAMPLER_DOWN_ORDER_FIR0 / 2 * ( FIR_Fracs - 1 - i ) + j ];
+            }
+        }
+    } else {
+        stride = 0;
+        for( j = 0; j < FIR_Order / 2; j++ ) {
+            W[ j ] = FIR_Coefs[ j ];
+        }
+    }
+
+    for( index_Q16 = 0; index_Q16 < max_index_Q16; ) {
+        for( n = 0; n < 8 && index_Q16 < max_index_Q16; n++, index_Q16 += index_increment_Q16 ) {
+            interpol_ind = stride ? silk_SMULWB( index_Q16 & 0xFFFF, FIR_Fracs ) : 0;
+            x[ n ] = silk_resampler_down_FIR_sum_avx2( buf + silk_RSHIFT( index_Q16, 16 ), &W[ interpol_ind * stride ], FIR_Order );
+        }
+        out = silk_resampler_store8_avx2( out, x, n, 6 );
+    }
+#ifdef OPUS_CHECK_ASM
+    silk_assert( out_end_c - out_c == out - out_a );
+    silk_assert( !memcmp( out_c, out_a, ( out - out_a ) * sizeof( opus_int16 ) ) );
+    RESTORE_STACK;
+#endif
+    return out;
+}
@@ -0,0 +1,241 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#include <smmintrin.h>
+
+#ifdef OPUS_CHECK_ASM
+# include <string.h>
+# include "stack_alloc.h"
+#endif
+#include "SigProc_FIX.h"
+#include "resampler_private.h"
+
+/* Four lanes of silk_SMULWB(). The 32-bit operand is split into its signed
+   upper and unsigned lower halves, as in the 32-bit fallback of the macro,
+   so the result is bit-exact with the 64-bit product. */
+static OPUS_INLINE __m128i silk_mm_smulwb_epi32( __m128i a, __m128i b )
+{
+    __m128i hi, lo;
+    hi = _mm_mullo_epi32( _mm_srai_epi32( a, 16 ), b );
+    lo = _mm_mullo_epi32( _mm_and_si128( a, _mm_set1_epi32( 0xFFFF ) ), b );
+    return _mm_add_epi32( hi, _mm_srai_epi32( lo, 16 ) );
+}
+
+/* Sums the lanes of four vectors: returns { sum(a), sum(b), sum(c), sum(d) } */
+static OPUS_INLINE __m128i silk_mm_hsum4_epi32( __m128i a, __m128i b, __m128i c, __m128i d )
+{
+    return _mm_hadd_epi32( _mm_hadd_epi32( a, b ), _mm_hadd_epi32( c, d ) );
+}
+
+/* silk_SAT16( silk_RSHIFT_ROUND( x, shift ) ) for eight values */
+static OPUS_INLINE __m128i silk_mm_rshift_round_sat16( __m128i lo, __m128i hi, int shift )
+{
+    const __m128i one = _mm_set1_epi32( 1 );
+    lo = _mm_srai_epi32( _mm_add_epi32( _mm_srai_epi32( lo, shift - 1 ), one ), 1 );
+    hi = _mm_srai_epi32( _mm_add_epi32( _mm_srai_epi32( hi, shift - 1 ), one ), 1 );
+    return _mm_packs_epi32( lo, hi );
+}
+
+#define REVERSE_EPI32( x ) _mm_shuffle_epi32( x, _MM_SHUFFLE( 0, 1, 2, 3 ) )
+
+opus_int16 *silk_resampler_private_IIR_FIR_INTERPOL_sse4_1(
+    opus_int16                      *out,
+    opus_int16                      *buf,
+    opus_int32                      max_index_Q16,
+    opus_int32                      index_increment_Q16
+)
+{
+    opus_int32 index_Q16;
+    opus_int   i, n;
+    __m128i    coefs[ 12 ], acc[ 8 ], res;
+    opus_int16 tmp[ 8 ];
+#ifdef OPUS_CHECK_ASM
+    opus_int16 *const out_a = out;
+    opus_int16 *out_end_c;
+    VARDECL( opus_int16, out_c );
+    SAVE_STACK;
+    ALLOC( out_c, ( max_index_Q16 + index_increment_Q16 - 1 ) / index_increment_Q16, opus_int16 );
+    out_end_c = silk_resampler_private_IIR_FIR_INTERPOL_c( out_c, buf, max_index_Q16, index_increment_Q16 );
+#endif
+
+    /* Gather both halves of each symmetric 8-tap phase into one vector, in buffer order */
+    for( i = 0; i < 12; i++ ) {
+        __m128i fwd = _mm_loadl_epi64( (const __m128i *)silk_resampler_frac_FIR_12[ i ] );
+        __m128i bwd = _mm_loadl_epi64( (const __m128i *)silk_resampler_frac_FIR_12[ 11 - i ] );
+        coefs[ i ] = _mm_unpacklo_epi64( fwd, _mm_shufflelo_epi16( bwd, _MM_SHUFFLE( 0, 1, 2, 3 ) ) );
+    }
+
+    /* Eight outputs per iteration; the 16x16 products are exact, as with silk_SMLABB() */
+    for( index_Q16 = 0; index_Q16 < max_index_Q16; ) {
+        for( n = 0; n < 8 && index_Q16 < max_index_Q16; n++, index_Q16 += index_increment_Q16 ) {
+            opus_int32 table_index = silk_SMULWB( index_Q16 & 0xFFFF, 12 );
+            acc[ n ] = _mm_madd_epi16( _mm_loadu_si128( (const __m128i *)&buf[ index_Q16 >> 16 ] ), coefs[ table_index ] );
+        }
+        for( i = n; i < 8; i++ ) {
+            acc[ i ] = _mm_setzero_si128();
+        }
+        res = silk_mm_rshift_round_sat16( silk_mm_hsum4_epi32( acc[ 0 ], acc[ 1 ], acc[ 2 ], acc[ 3 ] ),
+                                          silk_mm_hsum4_epi32( acc[ 4 ], acc[ 5 ], acc[ 6 ], acc[ 7 ] ), 15 );
+        if( n == 8 ) {
+            _mm_storeu_si128( (__m128i *)out, res );
+        } else {
+            _mm_storeu_si128( (__m128i *)tmp, res );
+            silk_memcpy( out, tmp, n * sizeof( opus_int16 ) );
+        }
+        out += n;
+    }
+#ifdef OPUS_CHECK_ASM
+    silk_assert( out_end_c - out_c == out - out_a );
+    silk_assert( !memcmp( out_c, out_a, ( out - out_a ) * sizeof( opus_int16 ) ) );
+    RESTORE_STACK;
+#endif
+    return out;
+}
+
+/* Partial sums of one output of silk_resampler_private_down_FIR_INTERPOL_c(). W holds
+   the sign-extended coefficients in buffer order, see below. */
+static OPUS_INLINE __m128i silk_resampler_down_FIR_sum_sse4_1(
+    const opus_int32                *buf_ptr,
+    const opus_int32                *W,
+    opus_int                        FIR_Order
+)
+{
+    __m128i    sum;
+    opus_int32 tail;
+
+    switch( FIR_Order ) {
+        case RESAMPLER_DOWN_ORDER_FIR0:
+            sum = silk_mm_smulwb_epi32( _mm_loadu_si128( (const __m128i *)&buf_ptr[ 0 ] ), _mm_loadu_si128( (const __m128i *)&W[ 0 ] ) );
+            sum = _mm_add_epi32( sum, silk_mm_smulwb_epi32( _mm_loadu_si128( (const __m128i *)&buf_ptr[ 4 ] ), _mm_loadu_si128( (const __m128i *)&W[ 4 ] ) ) );
+            sum = _mm_add_epi32( sum, silk_mm_smulwb_epi32( _mm_loadu_si128( (const __m128i *)&buf_ptr[ 8 ] ), _mm_loadu_si128( (const __m128i *)&W[ 8 ] ) ) );
+            sum = _mm_add_epi32( sum, silk_mm_smulwb_epi32( _mm_loadu_si128( (const __m128i *)&buf_ptr[ 12 ] ), _mm_loadu_si128( (const __m128i *)&W[ 12 ] ) ) );
+            tail = silk_SMULWB( buf_ptr[ 16 ], W[ 16 ] );
+            tail = silk_SMLAWB( tail, buf_ptr[ 17 ], W[ 17 ] );
+            break;
+        case RESAMPLER_DOWN_ORDER_FIR1:
+            sum = silk_mm_smulwb_epi32( _mm_add_epi32( _mm_loadu_si128( (const __m128i *)&buf_ptr[ 0 ] ),
+                REVERSE_EPI32( _mm_loadu_si128( (const __m128i *)&buf_ptr[ 20 ] ) ) ), _mm_loadu_si128( (const __m128i *)&W[ 0 ] ) );
+            sum = _mm_add_epi32( sum, silk_mm_smulwb_epi32( _mm_add_epi32( _mm_loadu_si128( (const __m128i *)&buf_ptr[ 4 ] ),
+                REVERSE_EPI32( _mm_loadu_si128( (const __m128i *)&buf_ptr[ 16 ] ) ) ), _mm_loadu_si128( (const __m128i *)&W[ 4 ] ) ) );
+            sum = _mm_add_epi32( sum, silk_mm_smulwb_epi32( _mm_add_epi32( _mm_loadu_si128( (const __m128i *)&buf_ptr[ 8 ] ),
+                REVERSE_EPI32( _mm_loadu_si128( (const __m128i *)&buf_ptr[ 12 ] ) ) ), _mm_loadu_si128( (const __m128i *)&W[ 8 ] ) ) );
+            tail = 0;
+            break;
+        case RESAMPLER_DOWN_ORDER_FIR2:
+            sum = silk_mm_smulwb_epi32( _mm_add_epi32( _mm_loadu_si128( (const __m128i *)&buf_ptr[ 0 ] ),
+                REVERSE_EPI32( _mm_loadu_si128( (const __m128i *)&buf_ptr[ 32 ] ) ) ), _mm_loadu_si128( (const __m128i *)&W[ 0 ] ) );
+            sum = _mm_add_epi32( sum, silk_mm_smulwb_epi32( _mm_add_epi32( _mm_loadu_si128( (const __m128i *)&buf_ptr[ 4 ] ),
+                REVERSE_EPI32( _mm_loadu_si128( (const __m128i *)&buf_ptr[ 28 ] ) ) ), _mm_loadu_si128( (const __m128i *)&W[ 4 ] ) ) );
+            sum = _mm_add_epi32( sum, silk_mm_smulwb_epi32( _mm_add_epi32( _mm_loadu_si128( (const __m128i *)&buf_ptr[ 8 ] ),
+                REVERSE_EPI32( _mm_loadu_si128( (const __m128i *)&buf_ptr[ 24 ] ) ) ), _mm_loadu_si128( (const __m128i *)&W[ 8 ] ) ) );
+            sum = _mm_add_epi32( sum, silk_mm_smulwb_epi32( _mm_add_epi32( _mm_loadu_si128( (const __m128i *)&buf_ptr[ 12 ] ),
+                REVERSE_EPI32( _mm_loadu_si128( (const __m128i *)&buf_ptr[ 20 ] ) ) ), _mm_loadu_si128( (const __m128i *)&W[ 12 ] ) ) );
+            tail = silk_SMULWB( silk_ADD32( buf_ptr[ 16 ], buf_ptr[ 19 ] ), W[ 16 ] );
+            tail = silk_SMLAWB( tail, silk_ADD32( buf_ptr[ 17 ], buf_ptr[ 18 ] ), W[ 17 ] );
+            break;
+        default:
+            silk_assert( 0 );
+            return _mm_setzero_si128();
+    }
+    return _mm_add_epi32( sum, _mm_cvtsi32_si128( tail ) );
+}
+
+opus_int16 *silk_resampler_private_down_FIR_INTERPOL_sse4_1(
+    opus_int16                      *out,
+    opus_int32                      *buf,
+    const opus_int16                *FIR_Coefs,
+    opus_int                        FIR_Order,
+    opus_int                        FIR_Fracs,
+    opus_int32                      max_index_Q16,
+    opus_int32                      index_increment_Q16
+)
+{
+    opus_int32 index_Q16, interpol_ind;
+    opus_int   i, j, n, stride;
+    opus_int32 W[ 3 * RESAMPLER_DOWN_ORDER_FIR0 ];
+    __m128i    acc[ 8 ], res;
+    opus_int16 tmp[ 8 ];
+#ifdef OPUS_CHECK_ASM
+    opus_int16 *const out_a = out;
+    opus_int16 *out_end_c;
+    VARDECL( opus_int16, out_c );
+    SAVE_STACK;
+    ALLOC( out_c, ( max_index_Q16 + index_increment_Q16 - 1 ) / index_increment_Q16, opus_int16 );
+    out_end_c = silk_resampler_private_down_FIR_INTERPOL_c( out_c, buf, FIR_Coefs, FIR_Order, FIR_Fracs, max_index_Q16, index_increment_Q16 );
+#endif
+
+    /* Expand the coefficients to 32 bits. For the polyphase filter, each phase
+       stores the forward half followed by the mirrored half of the opposite
+       phase, so that a single weight vector lines up with buf_ptr[ 0..17 ]. */
+    if( FIR_Order == RESAMPLER_DOWN_ORDER_FIR0 ) {
+        silk_assert( FIR_Fracs <= 3 );
+        stride = RESAMPLER_DOWN_ORDER_FIR0;
+        for( i = 0; i < FIR_Fracs; i++ ) {
+            for( j = 0; j < RESAMPLER_DOWN_ORDER_FIR0 / 2; j++ ) {
+                W[ i * stride + j ] = FIR_Coefs[ RESAMPLER_DOWN_ORDER_FIR0 / 2 * i + j ];
+                W[ i * stride + RESAMPLER_DOWN_ORDER_FIR0 - 1 - j ] =
+                    FIR_Coefs[ RESAMPLER_DOWN_ORDER_FIR0 / 2 * ( FIR_Fracs - 1 - i ) + j ];
+            }
+        }
+    } else {
+        stride = 0;
+        for( j = 0; j < FIR_Order / 2; j++ ) {
+            W[ j ] = FIR_Coefs[ j ];
+        }
+    }
+
+    for( index_Q16 = 0; index_Q16 < max_index_Q16; ) {
+        for( n = 0; n < 8 && index_Q16 < max_index_Q16; n++, index_Q16 += index_increment_Q16 ) {
+            interpol_ind = stride ? silk_SMULWB( index_Q16 & 0xFFFF, FIR_Fracs ) : 0;
+            acc[ n ] = silk_resampler_down_FIR_sum_sse4_1( buf + silk_RSHIFT( index_Q16, 16 ), &W[ interpol_ind * stride ], FIR_Order );
+        }
+        for( i = n; i < 8; i++ ) {
+            acc[ i ] = _mm_setzero_si128();
+        }
+        res = silk_mm_rshift_round_sat16( silk_mm_hsum4_epi32( acc[ 0 ], acc[ 1 ], acc[ 2 ], acc[ 3 ] ),
+                                          silk_mm_hsum4_epi32( acc[ 4 ], acc[ 5 ], acc[ 6 ], acc[ 7 ] ), 6 );
+        if( n == 8 ) {
+            _mm_storeu_si128( (__m128i *)out, res );
+        } else {
+            _mm_storeu_si128( (__m128i *)tmp, res );
+            silk_memcpy( out, tmp, n * sizeof( opus_int16 ) );
+        }
+        out += n;
+    }
+#ifdef OPUS_CHECK_ASM
+    silk_assert( out_end_c - out_c == out - out_a );
+    silk_assert( !memcmp( out_c, out_a, ( out - out_a ) * sizeof( opus_int16 ) ) );
+    RESTORE_STACK;
+#endif
+    return out;
+}
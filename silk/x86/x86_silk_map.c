@@ -66,6 +66,35 @@ opus_int (*const SILK_VAD_GETSA_Q8_IMPL[ OPUS_ARCHMASK + 1 ] )(
   MAY_HAVE_SSE4_1( silk_VAD_GetSA_Q8 )  /* avx */
 };
 
+void (*const SILK_DECODE_CORE_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    silk_decoder_state          *psDec,                         /* I/O  Decoder state                               */
+    silk_decoder_control        *psDecCtrl,                     /* I    Decoder control                             */
+    opus_int16                  xq[],                           /* O    Decoded speech                              */
+    const opus_int16            pulses[ MAX_FRAME_LENGTH ],     /* I    Pulse signal                                */
+    int                         arch                            /* I    Run-time architecture                       */
+) = {
+  silk_decode_core_c,                  /* non-sse */
+  silk_decode_core_c,
+  silk_decode_core_c,
+  MAY_HAVE_SSE4_1( silk_decode_core ), /* sse4.1 */
+  MAY_HAVE_SSE4_1( silk_decode_core )  /* avx */
+};
+
+void (*const SILK_BIQUAD_ALT_STRIDE2_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    const opus_int16            *in,                /* I     input signal                                               */
+    const opus_int32            *B_Q28,             /* I     MA coefficients [3]                                        */
+    const opus_int32            *A_Q28,             /* I     AR coefficients [2]                                        */
+    opus_int32                  *S,                 /* I/O   State vector [4]                                           */
+    opus_int16                  *out,               /* O     output signal                                              */
+    const opus_int32            len                 /* I     signal length (must be even)                               */
+) = {
+  silk_biquad_alt_stride2_c,                  /* non-sse */
+  silk_biquad_alt_stride2_c,
+  silk_biquad_alt_stride2_c,
+  MAY_HAVE_SSE4_1( silk_biquad_alt_stride2 ), /* sse4.1 */
+  MAY_HAVE_SSE4_1( silk_biquad_alt_stride2 )  /* avx */
+};
+
 #if 0 /* FIXME: SSE disabled until the NSQ code gets updated. */
 void (*const SILK_NSQ_IMPL[ OPUS_ARCHMASK + 1 ] )(
     const silk_encoder_state    *psEncC,                                    /* I    Encoder State                   */
@@ -92,19 +121,19 @@ void (*const SILK_NSQ_IMPL[ OPUS_ARCHMASK + 1 ] )(
 };
 #endif
 
-#if 0 /* FIXME: SSE disabled until silk_VQ_WMat_EC_sse4_1() gets updated. */
 void (*const SILK_VQ_WMAT_EC_IMPL[ OPUS_ARCHMASK + 1 ] )(
     opus_int8                   *ind,                           /* O    index of best codebook vector               */
-    opus_int32                  *rate_dist_Q14,                 /* O    best weighted quant error + mu * rate       */
+    opus_int32                  *res_nrg_Q15,                   /* O    best residual energy                        */
+    opus_int32                  *rate_dist_Q8,                  /* O    best total bitrate                          */
     opus_int                    *gain_Q7,                       /* O    sum of absolute LTP coefficients            */
-    const opus_int16            *in_Q14,                        /* I    input vector to be quantized                */
-    const opus_int32            *W_Q18,                         /* I    weighting matrix                            */
+    const opus_int32            *XX_Q17,                        /* I    correlation matrix                          */
+    const opus_int32            *xX_Q17,                        /* I    correlation vector                          */
     const opus_int8             *cb_Q7,                         /* I    codebook                                    */
     const opus_uint8            *cb_gain_Q7,                    /* I    codebook effective gain                     */
     const opus_uint8            *cl_Q5,                         /* I    code length for each codebook vector        */
-    const opus_int              mu_Q9,                          /* I    tradeoff betw. weighted error and rate      */
+    const opus_int              subfr_len,                      /* I    number of samples per subframe              */
     const opus_int32            max_gain_Q7,                    /* I    maximum sum of absolute LTP coefficients    */
-    opus_int                    L                               /* I    number of vectors in codebook               */
+    const opus_int              L                               /* I    number of vectors in codebook               */
 ) = {
   silk_VQ_WMat_EC_c,                  /* non-sse */
   silk_VQ_WMat_EC_c,
@@ -112,18 +141,111 @@ void (*const SILK_VQ_WMAT_EC_IMPL[ OPUS_ARCHMASK + 1 ] )(
   MAY_HAVE_SSE4_1( silk_VQ_WMat_EC ), /* sse4.1 */
   MAY_HAVE_SSE4_1( silk_VQ_WMat_EC )  /* avx */
 };
+
+void (*const SILK_NLSF_VQ_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    opus_int32                  err_Q24[],                      /* O    Quantization errors [K]                     */
+    const opus_int16            in_Q15[],                       /* I    Input vectors to be quantized [LPC_order]   */
+    const opus_uint8            pCB_Q8[],                       /* I    Codebook vectors [K*LPC_order]              */
+    const opus_int16            pWght_Q9[],                     /* I    Codebook weights [K*LPC_order]              */
+    const opus_int              K,                              /* I    Number of codebook vectors                  */
+    const opus_int              LPC_order                       /* I    Number of LPCs                              */
+) = {
+  silk_NLSF_VQ_c,                  /* non-sse */
+  silk_NLSF_VQ_c,
+  silk_NLSF_VQ_c,
+  MAY_HAVE_SSE4_1( silk_NLSF_VQ ), /* sse4.1 */
+  MAY_HAVE_SSE4_1( silk_NLSF_VQ )  /* avx */
+};
+
+#if defined(FIXED_POINT)
+
+void (*const SILK_BURG_MODIFIED_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    opus_int32                  *res_nrg,           /* O    Residual energy                                             */
+    opus_int                    *res_nrg_Q,         /* O    Residual energy Q value                                     */
+    opus_int32                  A_Q16[],            /* O    Prediction coefficients (length order)                      */
+    const opus_int16            x[],                /* I    Input signal, length: nb_subfr * ( D + subfr_length )       */
+    const opus_int32            minInvGain_Q30,     /* I    Inverse of max prediction gain                              */
+    const opus_int              subfr_length,       /* I    Input signal subframe length (incl. D preceding samples)    */
+    const opus_int              nb_subfr,           /* I    Number of subframes stacked in x                            */
+    const opus_int              D,                  /* I    Order                                                       */
+    int                         arch                /* I    Run-time architecture                                       */
+) = {
+  silk_burg_modified_c,                  /* non-sse */
+  silk_burg_modified_c,
+  silk_burg_modified_c,
+  MAY_HAVE_SSE4_1( silk_burg_modified ), /* sse4.1 */
+  MAY_HAVE_SSE4_1( silk_burg_modified )  /* avx */
+};
+
+void (*const SILK_WARPED_AUTOCORRELATION_FIX_IMPL[ OPUS_ARCHMASK + 1 ] )(
+          opus_int32                *corr,                                  /* O    Result [order + 1]                                                          */
+          opus_int                  *scale,                                 /* O    Scaling of the correlation vector                                           */
+    const opus_int16                *input,                                 /* I    Input data to correlate                                                     */
+    const opus_int                  warping_Q16,                            /* I    Warping coefficient                                                         */
+    const opus_int                  length,                                 /* I    Length of input                                                             */
+    const opus_int                  order                                   /* I    Correlation order (even)                                                    */
+) = {
+  silk_warped_autocorrelation_FIX_c,                  /* non-sse */
+  silk_warped_autocorrelation_FIX_c,
+  silk_warped_autocorrelation_FIX_c,
+  MAY_HAVE_SSE4_1( silk_warped_autocorrelation_FIX ), /* sse4.1 */
+  MAY_HAVE_SSE4_1( silk_warped_autocorrelation_FIX )  /* avx */
+};
+
+#endif
 #endif
 
-#if 0 /* FIXME: SSE disabled until the NSQ code gets updated. */
+#include "resampler_private.h"
+
+#if !defined(OPUS_X86_PRESUME_SSE4_1)
+
+opus_int16 *(*const SILK_RESAMPLER_PRIVATE_IIR_FIR_INTERPOL_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    opus_int16                      *out,
+    opus_int16                      *buf,
+    opus_int32                      max_index_Q16,
+    opus_int32                      index_increment_Q16
+) = {
+  silk_resampler_private_IIR_FIR_INTERPOL_c,                  /* non-sse */
+  silk_resampler_private_IIR_FIR_INTERPOL_c,
+  silk_resampler_private_IIR_FIR_INTERPOL_c,
+  MAY_HAVE_SSE4_1( silk_resampler_private_IIR_FIR_INTERPOL ), /* sse4.1 */
+  MAY_HAVE_SSE4_1( silk_resampler_private_IIR_FIR_INTERPOL )  /* avx */
+};
+
+#endif
+
+#if (defined(OPUS_X86_MAY_HAVE_SSE4_1) && !defined(OPUS_X86_PRESUME_SSE4_1)) || \
+ (defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(OPUS_X86_PRESUME_AVX2))
+
+opus_int16 *(*const SILK_RESAMPLER_PRIVATE_DOWN_FIR_INTERPOL_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    opus_int16                      *out,
+    opus_int32                      *buf,
+    const opus_int16                *FIR_Coefs,
+    opus_int                        FIR_Order,
+    opus_int                        FIR_Fracs,
+    opus_int32                      max_index_Q16,
+    opus_int32                      index_increment_Q16
+) = {
+  silk_resampler_private_down_FIR_INTERPOL_c,                  /* non-sse */
+  silk_resampler_private_down_FIR_INTERPOL_c,
+  silk_resampler_private_down_FIR_INTERPOL_c,
+  MAY_HAVE_SSE4_1( silk_resampler_private_down_FIR_INTERPOL ), /* sse4.1 */
+  MAY_HAVE_AVX2( silk_resampler_private_down_FIR_INTERPOL )    /* avx */
+};
+
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(OPUS_X86_PRESUME_AVX2)
+
 void (*const SILK_NSQ_DEL_DEC_IMPL[ OPUS_ARCHMASK + 1 ] )(
     const silk_encoder_state    *psEncC,                                    /* I    Encoder State                   */
     silk_nsq_state              *NSQ,                                       /* I/O  NSQ state                       */
     SideInfoIndices             *psIndices,                                 /* I/O  Quantization Indices            */
-    const opus_int32            x_Q3[],                                     /* I    Prefiltered input signal        */
+    const opus_int16            x16[],                                      /* I    Input                           */
     opus_int8                   pulses[],                                   /* O    Quantized pulse signal          */
     const opus_int16            PredCoef_Q12[ 2 * MAX_LPC_ORDER ],          /* I    Short term prediction coefs     */
     const opus_int16            LTPCoef_Q14[ LTP_ORDER * MAX_NB_SUBFR ],    /* I    Long term prediction coefs      */
-    const opus_int16            AR2_Q13[ MAX_NB_SUBFR * MAX_SHAPE_LPC_ORDER ], /* I Noise shaping coefs             */
+    const opus_int16            AR_Q13[ MAX_NB_SUBFR * MAX_SHAPE_LPC_ORDER ], /* I Noise shaping coefs              */
     const opus_int              HarmShapeGain_Q14[ MAX_NB_SUBFR ],          /* I    Long term shaping coefs         */
     const opus_int              Tilt_Q14[ MAX_NB_SUBFR ],                   /* I    Spectral tilt                   */
     const opus_int32            LF_shp_Q14[ MAX_NB_SUBFR ],                 /* I    Low frequency shaping coefs     */
@@ -135,30 +257,98 @@ void (*const SILK_NSQ_DEL_DEC_IMPL[ OPUS_ARCHMASK + 1 ] )(
   silk_NSQ_del_dec_c,                  /* non-sse */
   silk_NSQ_del_dec_c,
   silk_NSQ_del_dec_c,
-  MAY_HAVE_SSE4_1( silk_NSQ_del_dec ), /* sse4.1 */
-  MAY_HAVE_SSE4_1( silk_NSQ_del_dec )  /* avx */
+  silk_NSQ_del_dec_c,                  /* sse4.1 */
+  MAY_HAVE_AVX2( silk_NSQ_del_dec )    /* avx */
 };
+
 #endif
 
-#if defined(FIXED_POINT)
+#if !defined(FIXED_POINT)
 
-void (*const SILK_BURG_MODIFIED_IMPL[ OPUS_ARCHMASK + 1 ] )(
-    opus_int32                  *res_nrg,           /* O    Residual energy                                             */
-    opus_int                    *res_nrg_Q,         /* O    Residual energy Q value                                     */
-    opus_int32                  A_Q16[],            /* O    Prediction coefficients (length order)                      */
-    const opus_int16            x[],                /* I    Input signal, length: nb_subfr * ( D + subfr_length )       */
-    const opus_int32            minInvGain_Q30,     /* I    Inverse of max prediction gain                              */
-    const opus_int              subfr_length,       /* I    Input signal subframe length (incl. D preceding samples)    */
-    const opus_int              nb_subfr,           /* I    Number of subframes stacked in x                            */
-    const opus_int              D,                  /* I    Order                                                       */
-    int                         arch                /* I    Run-time architecture                                       */
+#include "float/main_FLP.h"
+
+#if (defined(OPUS_X86_MAY_HAVE_SSE2) && !defined(OPUS_X86_PRESUME_SSE2)) || \
+ (defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(OPUS_X86_PRESUME_AVX2))
+
+double (*const SILK_INNER_PRODUCT_FLP_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    const silk_float    *data1,
+    const silk_float    *data2,
+    opus_int            dataSize
 ) = {
-  silk_burg_modified_c,                  /* non-sse */
-  silk_burg_modified_c,
-  silk_burg_modified_c,
-  MAY_HAVE_SSE4_1( silk_burg_modified ), /* sse4.1 */
-  MAY_HAVE_SSE4_1( silk_burg_modified )  /* avx */
+  silk_inner_product_FLP_c,                  /* non-sse */
+  silk_inner_product_FLP_c,
+  MAY_HAVE_SSE2( silk_inner_product_FLP ),   /* sse2 */
+  MAY_HAVE_SSE2( silk_inner_product_FLP ),   /* sse4.1 */
+  MAY_HAVE_AVX2( silk_inner_product_FLP )    /* avx */
+};
+
+double (*const SILK_ENERGY_FLP_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    const silk_float    *data,
+    opus_int            dataSize
+) = {
+  silk_energy_FLP_c,                  /* non-sse */
+  silk_energy_FLP_c,
+  MAY_HAVE_SSE2( silk_energy_FLP ),   /* sse2 */
+  MAY_HAVE_SSE2( silk_energy_FLP ),   /* sse4.1 */
+  MAY_HAVE_AVX2( silk_energy_FLP )    /* avx */
+};
+
+void (*const SILK_WARPED_AUTOCORRELATION_FLP_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    silk_float          *corr,
+    const silk_float    *input,
+    const silk_float    warping,
+    const opus_int      length,
+    const opus_int      order
+) = {
+  silk_warped_autocorrelation_FLP_c,                  /* non-sse */
+  silk_warped_autocorrelation_FLP_c,
+  MAY_HAVE_SSE2( silk_warped_autocorrelation_FLP ),   /* sse2 */
+  MAY_HAVE_SSE2( silk_warped_autocorrelation_FLP ),   /* sse4.1 */
+  MAY_HAVE_AVX2( silk_warped_autocorrelation_FLP )    /* avx */
+};
+
+#endif
+
+#if defined(ENABLE_FLOAT_NSQ) && defined(OPUS_X86_MAY_HAVE_SSE2) && !defined(OPUS_X86_PRESUME_SSE2)
+
+#include "NSQ_FLP.h"
+
+void (*const SILK_NOISE_SHAPE_QUANTIZER_DEL_DEC_FLP_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    silk_nsq_state                  *NSQ,                   /* I/O  NSQ state                               */
+    NSQ_del_dec_FLP_struct          *psDelDec,              /* I/O  Delayed decision states                 */
+    opus_int                        signalType,             /* I    Signal type                             */
+    const silk_float                x_sc[],                 /* I    Scaled input                            */
+    opus_int8                       pulses[],               /* O    Quantized pulse signal                  */
+    silk_float                      xq[],                   /* O    Quantized output signal                 */
+    silk_float                      sLTP_sc[],              /* I/O  LTP filter state                        */
+    silk_float                      delayedGain[],          /* I/O  Gain delay buffer                       */
+    const silk_float                a[],                    /* I    Short term prediction coefs             */
+    const silk_float                b[],                    /* I    Long term prediction coefs              */
+    const silk_float                AR_shp[],               /* I    Noise shaping coefs                     */
+    opus_int                        lag,                    /* I    Pitch lag                               */
+    silk_float                      HarmShapeGain,          /* I    Long term shaping gain                  */
+    silk_float                      Tilt,                   /* I    Spectral tilt                           */
+    silk_float                      LF_MA_shp,              /* I    Low frequency MA shaping coef           */
+    silk_float                      LF_AR_shp,              /* I    Low frequency AR shaping coef           */
+    silk_float                      Gain,                   /* I    Quantization gain                       */
+    silk_float                      Lambda,                 /* I    Rate/distortion tradeoff                */
+    silk_float                      offset,                 /* I    Quantization offset                     */
+    opus_int                        length,                 /* I    Input length                            */
+    opus_int                        subfr,                  /* I    Subframe number                         */
+    opus_int                        shapingLPCOrder,        /* I    Shaping LPC filter order                */
+    opus_int                        predictLPCOrder,        /* I    Prediction filter order                 */
+    silk_float                      warping,                /* I    Warping coefficient                     */
+    opus_int                        nStatesDelayedDecision, /* I    Number of states in decision tree       */
+    opus_int                        *smpl_buf_idx,          /* I/O  Index to newest samples in buffers      */
+    opus_int                        decisionDelay           /* I    Decision delay                          */
+) = {
+  silk_noise_shape_quantizer_del_dec_FLP_c,                  /* non-sse */
+  silk_noise_shape_quantizer_del_dec_FLP_c,
+  MAY_HAVE_SSE2( silk_noise_shape_quantizer_del_dec_FLP ),   /* sse2 */
+  MAY_HAVE_SSE2( silk_noise_shape_quantizer_del_dec_FLP ),   /* sse4.1 */
+  MAY_HAVE_SSE2( silk_noise_shape_quantizer_del_dec_FLP )    /* avx */
 };
 
 #endif
+
 #endif
@@ -22,6 +22,9 @@ silk/resampler_rom.h \
 silk/resampler_structs.h \
 silk/SigProc_FIX.h \
 silk/x86/SigProc_FIX_sse.h \
+silk/x86/SigProc_FLP_sse.h \
+silk/x86/NSQ_FLP_sse.h \
+silk/x86/resampler_sse.h \
 silk/arm/biquad_alt_arm.h \
 silk/arm/LPC_inv_pred_gain_arm.h \
 silk/arm/macros_armv4.h \
@@ -37,6 +40,7 @@ silk/fixed/arm/warped_autocorrelation_FIX_arm.h \
 silk/fixed/mips/noise_shape_analysis_FIX_mipsr1.h \
 silk/fixed/mips/warped_autocorrelation_FIX_mipsr1.h \
 silk/float/main_FLP.h \
+silk/float/NSQ_FLP.h \
 silk/float/structs_FLP.h \
 silk/float/SigProc_FLP.h \
 silk/mips/macros_mipsr1.h \
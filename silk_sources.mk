@@ -81,7 +81,15 @@ SILK_SOURCES_SSE4_1 = silk/x86/NSQ_sse4_1.c \
 silk/x86/NSQ_del_dec_sse4_1.c \
 silk/x86/x86_silk_map.c \
 silk/x86/VAD_sse4_1.c \
-silk/x86/VQ_WMat_EC_sse4_1.c
+silk/x86/decode_core_sse4_1.c \
+silk/x86/biquad_alt_sse4_1.c \
+silk/x86/NLSF_VQ_sse4_1.c \
+silk/x86/VQ_WMat_EC_sse4_1.c \
+silk/x86/resampler_sse4_1.c
+
+SILK_SOURCES_AVX2 = \
+silk/x86/NSQ_del_dec_avx2.c \
+silk/x86/resampler_avx2.c
 
 SILK_SOURCES_ARM_NEON_INTR = \
 silk/arm/arm_silk_map.c \
@@ -116,7 +124,8 @@ silk/fixed/schur64_FIX.c \
 silk/fixed/schur_FIX.c
 
 SILK_SOURCES_FIXED_SSE4_1 = silk/fixed/x86/vector_ops_FIX_sse4_1.c \
-silk/fixed/x86/burg_modified_FIX_sse4_1.c
+silk/fixed/x86/burg_modified_FIX_sse4_1.c \
+silk/fixed/x86/warped_autocorrelation_FIX_sse4_1.c
 
 SILK_SOURCES_FIXED_ARM_NEON_INTR = \
 silk/fixed/arm/warped_autocorrelation_FIX_neon_intr.c
@@ -133,6 +142,8 @@ silk/float/LPC_analysis_filter_FLP.c \
 silk/float/LTP_analysis_filter_FLP.c \
 silk/float/LTP_scale_ctrl_FLP.c \
 silk/float/noise_shape_analysis_FLP.c \
+silk/float/NSQ_FLP.c \
+silk/float/NSQ_del_dec_FLP.c \
 silk/float/process_gains_FLP.c \
 silk/float/regularize_correlations_FLP.c \
 silk/float/residual_energy_FLP.c \
@@ -150,3 +161,12 @@ silk/float/scale_copy_vector_FLP.c \
 silk/float/scale_vector_FLP.c \
 silk/float/schur_FLP.c \
 silk/float/sort_FLP.c
+
+SILK_SOURCES_FLOAT_SSE2 = \
+silk/float/x86/inner_product_FLP_sse2.c \
+silk/float/x86/NSQ_del_dec_FLP_sse2.c \
+silk/float/x86/warped_autocorrelation_FLP_sse2.c
+
+SILK_SOURCES_FLOAT_AVX2 = \
+silk/float/x86/inner_product_FLP_avx2.c \
+silk/float/x86/warped_autocorrelation_FLP_avx2.c
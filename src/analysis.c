@@ -110,11 +110,12 @@ static const int tbands[NB_TBANDS+1] = {
 
 #define NB_TONAL_SKIP_BANDS 9
 
-static opus_val32 silk_resampler_down2_hp(
-    opus_val32                  *S,                 /* I/O  State vector [ 2 ]                                          */
+opus_val32 silk_resampler_down2_hp_c(
+    opus_val32                  *S,                 /* I/O  State vector [ 3 ]                                          */
     opus_val32                  *out,               /* O    Output signal [ floor(len/2) ]                              */
     const opus_val32            *in,                /* I    Input signal [ len ]                                        */
-    int                         inLen               /* I    Number of input samples                                     */
+    int                         inLen,              /* I    Number of input samples                                     */
+    opus_val32                  scale               /* I    Gain applied to the input                                   */
 )
 {
     int k, len2 = inLen/2;
@@ -123,7 +124,7 @@ static opus_val32 silk_resampler_down2_hp(
     /* Internal variables and state are in Q10 format */
     for( k = 0; k < len2; k++ ) {
         /* Convert to Q10 */
-        in32 = in[ 2 * k ];
+        in32 = in[ 2 * k ]*scale;
 
         /* All-pass section for even input sample */
         Y      = SUB32( in32, S[ 0 ] );
@@ -132,7 +133,7 @@ static opus_val32 silk_resampler_down2_hp(
         S[ 0 ] = ADD32( in32, X );
         out32_hp = out32;
         /* Convert to Q10 */
-        in32 = in[ 2 * k + 1 ];
+        in32 = in[ 2 * k + 1 ]*scale;
 
         /* All-pass section for odd input sample, and add to output of previous section */
         Y      = SUB32( in32, S[ 1 ] );
@@ -158,7 +159,7 @@ static opus_val32 silk_resampler_down2_hp(
     return (opus_val32)hp_ener;
 }
 
-static opus_val32 downmix_and_resample(downmix_func downmix, const void *_x, opus_val32 *y, opus_val32 S[3], int subframe, int offset, int c1, int c2, int C, int Fs)
+static opus_val32 downmix_and_resample(downmix_func downmix, const void *_x, opus_val32 *y, opus_val32 S[3], int subframe, int offset, int c1, int c2, int C, int Fs, int arch)
 {
    VARDECL(opus_val32, tmp);
    opus_val32 scale;
@@ -177,7 +178,7 @@ static opus_val32 downmix_and_resample(downmix_func downmix, const void *_x, opu
    }
    ALLOC(tmp, subframe, opus_val32);
 
-   downmix(_x, tmp, subframe, offset, c1, c2, C);
+   downmix(_x, tmp, subframe, offset, c1, c2, C, arch);
 #ifdef FIXED_POINT
    scale = (1<<SIG_SHIFT);
 #else
@@ -187,13 +188,13 @@ static opus_val32 downmix_and_resample(downmix_func downmix, const void *_x, opu
       scale /= C;
    else if (c2>-1)
       scale /= 2;
-   for (j=0;j<subframe;j++)
-      tmp[j] *= scale;
+   /* The scaling is applied along with the resampling. */
    if (Fs == 48000)
    {
-      ret = silk_resampler_down2_hp(S, y, tmp, subframe);
+      ret = silk_resampler_down2_hp(S, y, tmp, subframe, scale, arch);
    } else if (Fs == 24000) {
-      OPUS_COPY(y, tmp, subframe);
+      for (j=0;j<subframe;j++)
+         y[j] = tmp[j]*scale;
    } else if (Fs == 16000) {
       VARDECL(opus_val32, tmp3x);
       ALLOC(tmp3x, 3*subframe, opus_val32);
@@ -206,7 +207,7 @@ static opus_val32 downmix_and_resample(downmix_func downmix, const void *_x, opu
          tmp3x[3*j+1] = tmp[j];
          tmp3x[3*j+2] = tmp[j];
       }
-      silk_resampler_down2_hp(S, y, tmp3x, 3*subframe);
+      silk_resampler_down2_hp(S, y, tmp3x, 3*subframe, scale, arch);
    }
    RESTORE_STACK;
    return ret;
@@ -404,6 +405,56 @@ static const float std_feature_bias[9] = {
 #define SCALE_ENER(e) (e)
 #endif
 
+void tonality_analysis_bins_c(const kiss_fft_cpx *out, float *A, float *dA,
+      float *d2A, float *tonality, float *tonality2, float *noisiness,
+      float *binE, int start, int N)
+{
+    int i;
+    const float pi4 = (float)(M_PI*M_PI*M_PI*M_PI);
+    for (i=start;i<N/2;i++)
+    {
+       float X1r, X2r, X1i, X2i;
+       float angle, d_angle, d2_angle;
+       float angle2, d_angle2, d2_angle2;
+       float mod1, mod2, avg_mod;
+       X1r = (float)out[i].r+out[N-i].r;
+       X1i = (float)out[i].i-out[N-i].i;
+       X2r = (float)out[i].i+out[N-i].i;
+       X2i = (float)out[N-i].r-out[i].r;
+
+       angle = (float)(.5f/M_PI)*fast_atan2f(X1i, X1r);
+       d_angle = angle - A[i];
+       d2_angle = d_angle - dA[i];
+
+       angle2 = (float)(.5f/M_PI)*fast_atan2f(X2i, X2r);
+       d_angle2 = angle2 - angle;
+       d2_angle2 = d_angle2 - d_angle;
+
+       mod1 = d2_angle - (float)float2int(d2_angle);
+       noisiness[i] = ABS16(mod1);
+       mod1 *= mod1;
+       mod1 *= mod1;
+
+       mod2 = d2_angle2 - (float)float2int(d2_angle2);
+       noisiness[i] += ABS16(mod2);
+       mod2 *= mod2;
+       mod2 *= mod2;
+
+       avg_mod = .25f*(d2A[i]+mod1+2*mod2);
+       /* This introduces an extra delay of 2 frames in the detection. */
+       tonality[i] = 1.f/(1.f+40.f*16.f*pi4*avg_mod)-.015f;
+       /* No delay on this detection, but it's less reliable. */
+       tonality2[i] = 1.f/(1.f+40.f*16.f*pi4*mod2)-.015f;
+
+       A[i] = angle2;
+       dA[i] = d_angle2;
+       d2A[i] = mod2;
+
+       binE[i] = out[i].r*(float)out[i].r + out[N-i].r*(float)out[N-i].r
+               + out[i].i*(float)out[i].i + out[N-i].i*(float)out[N-i].i;
+    }
+}
+
 static void tonality_analysis(TonalityAnalysisState *tonal, const CELTMode *celt_mode, const void *x, int len, int offset, int c1, int c2, int C, int lsb_depth, downmix_func downmix)
 {
     int i, b;
@@ -416,6 +467,7 @@ static void tonality_analysis(TonalityAnalysisState *tonal, const CELTMode *celt
     float * OPUS_RESTRICT d2A = tonal->d2_angle;
     VARDECL(float, tonality);
     VARDECL(float, noisiness);
+    VARDECL(float, binE);
     float band_tonality[NB_TBANDS];
     float logE[NB_TBANDS];
     float BFCC[8];
@@ -424,7 +476,6 @@ static void tonality_analysis(TonalityAnalysisState *tonal, const CELTMode *celt
     float max_frame_tonality;
     /*float tw_sum=0;*/
     float frame_noisiness;
-    const float pi4 = (float)(M_PI*M_PI*M_PI*M_PI);
     float slope=0;
     float frame_stationarity;
     float relativeE;
@@ -469,7 +520,8 @@ static void tonality_analysis(TonalityAnalysisState *tonal, const CELTMode *celt
        tonal->mem_fill = 240;
     tonal->hp_ener_accum += (float)downmix_and_resample(downmix, x,
           &tonal->inmem[tonal->mem_fill], tonal->downmix_state,
-          IMIN(len, ANALYSIS_BUF_SIZE-tonal->mem_fill), offset, c1, c2, C, tonal->Fs);
+          IMIN(len, ANALYSIS_BUF_SIZE-tonal->mem_fill), offset, c1, c2, C, tonal->Fs,
+          tonal->arch);
     if (tonal->mem_fill+len < ANALYSIS_BUF_SIZE)
     {
        tonal->mem_fill += len;
@@ -486,6 +538,7 @@ static void tonality_analysis(TonalityAnalysisState *tonal, const CELTMode *celt
     ALLOC(out, 480, kiss_fft_cpx);
     ALLOC(tonality, 240, float);
     ALLOC(noisiness, 240, float);
+    ALLOC(binE, 240, float);
     for (i=0;i<N2;i++)
     {
        float w = analysis_window[i];
@@ -498,7 +551,8 @@ static void tonality_analysis(TonalityAnalysisState *tonal, const CELTMode *celt
     remaining = len - (ANALYSIS_BUF_SIZE-tonal->mem_fill);
     tonal->hp_ener_accum = (float)downmix_and_resample(downmix, x,
           &tonal->inmem[240], tonal->downmix_state, remaining,
-          offset+ANALYSIS_BUF_SIZE-tonal->mem_fill, c1, c2, C, tonal->Fs);
+          offset+ANALYSIS_BUF_SIZE-tonal->mem_fill, c1, c2, C, tonal->Fs,
+          tonal->arch);
     tonal->mem_fill = 240 + remaining;
     opus_fft(kfft, in, out, tonal->arch);
 #ifndef FIXED_POINT
@@ -511,45 +565,8 @@ static void tonality_analysis(TonalityAnalysisState *tonal, const CELTMode *celt
     }
 #endif
 
-    for (i=1;i<N2;i++)
-    {
-       float X1r, X2r, X1i, X2i;
-       float angle, d_angle, d2_angle;
-       float angle2, d_angle2, d2_angle2;
-       float mod1, mod2, avg_mod;
-       X1r = (float)out[i].r+out[N-i].r;
-       X1i = (float)out[i].i-out[N-i].i;
-       X2r = (float)out[i].i+out[N-i].i;
-       X2i = (float)out[N-i].r-out[i].r;
-
-       angle = (float)(.5f/M_PI)*fast_atan2f(X1i, X1r);
-       d_angle = angle - A[i];
-       d2_angle = d_angle - dA[i];
-
-       angle2 = (float)(.5f/M_PI)*fast_atan2f(X2i, X2r);
-       d_angle2 = angle2 - angle;
-       d2_angle2 = d_angle2 - d_angle;
-
-       mod1 = d2_angle - (float)float2int(d2_angle);
-       noisiness[i] = ABS16(mod1);
-       mod1 *= mod1;
-       mod1 *= mod1;
-
-       mod2 = d2_angle2 - (float)float2int(d2_angle2);
-       noisiness[i] += ABS16(mod2);
-       mod2 *= mod2;
-       mod2 *= mod2;
-
-       avg_mod = .25f*(d2A[i]+mod1+2*mod2);
-       /* This introduces an extra delay of 2 frames in the detection. */
-       tonality[i] = 1.f/(1.f+40.f*16.f*pi4*avg_mod)-.015f;
-       /* No delay on this detection, but it's less reliable. */
-       tonality2[i] = 1.f/(1.f+40.f*16.f*pi4*mod2)-.015f;
-
-       A[i] = angle2;
-       dA[i] = d_angle2;
-       d2A[i] = mod2;
-    }
+    tonality_analysis_bins(out, A, dA, d2A, tonality, tonality2, noisiness,
+          binE, 1, N, tonal->arch);
     for (i=2;i<N2-1;i++)
     {
        float tt = MIN32(tonality2[i], MAX32(tonality2[i-1], tonality2[i+1]));
@@ -579,11 +596,7 @@ static void tonality_analysis(TonalityAnalysisState *tonal, const CELTMode *celt
        X2r = 2*(float)out[0].i;
        E = X1r*X1r + X2r*X2r;
        for (i=1;i<4;i++)
-       {
-          float binE = out[i].r*(float)out[i].r + out[N-i].r*(float)out[N-i].r
-                     + out[i].i*(float)out[i].i + out[N-i].i*(float)out[N-i].i;
-          E += binE;
-       }
+          E += binE[i];
        E = SCALE_ENER(E);
        band_log2[0] = .5f*1.442695f*(float)log(E+1e-10f);
     }
@@ -594,12 +607,10 @@ static void tonality_analysis(TonalityAnalysisState *tonal, const CELTMode *celt
        float stationarity;
        for (i=tbands[b];i<tbands[b+1];i++)
        {
-          float binE = out[i].r*(float)out[i].r + out[N-i].r*(float)out[N-i].r
-                     + out[i].i*(float)out[i].i + out[N-i].i*(float)out[N-i].i;
-          binE = SCALE_ENER(binE);
-          E += binE;
-          tE += binE*MAX32(0, tonality[i]);
-          nE += binE*2.f*(.5f-noisiness[i]);
+          float E_i = SCALE_ENER(binE[i]);
+          E += E_i;
+          tE += E_i*MAX32(0, tonality[i]);
+          nE += E_i*2.f*(.5f-noisiness[i]);
        }
 #ifndef FIXED_POINT
        /* Check for extreme band energies that could cause NaNs later. */
@@ -731,11 +742,7 @@ static void tonality_analysis(TonalityAnalysisState *tonal, const CELTMode *celt
        band_start = tbands[b];
        band_end = tbands[b+1];
        for (i=band_start;i<band_end;i++)
-       {
-          float binE = out[i].r*(float)out[i].r + out[N-i].r*(float)out[N-i].r
-                     + out[i].i*(float)out[i].i + out[N-i].i*(float)out[N-i].i;
-          E += binE;
-       }
+          E += binE[i];
        E = SCALE_ENER(E);
        maxE = MAX32(maxE, E);
        tonal->meanE[b] = MAX32((1-alphaE2)*tonal->meanE[b], E);
@@ -859,9 +866,9 @@ static void tonality_analysis(TonalityAnalysisState *tonal, const CELTMode *celt
     features[23] = info->tonality_slope + 0.069216f;
     features[24] = tonal->lowECount - 0.067930f;
 
-    compute_dense(&layer0, layer_out, features);
-    compute_gru(&layer1, tonal->rnn_state, layer_out);
-    compute_dense(&layer2, frame_probs, tonal->rnn_state);
+    compute_dense(&layer0, layer_out, features, tonal->arch);
+    compute_gru(&layer1, tonal->rnn_state, layer_out, tonal->arch);
+    compute_dense(&layer2, frame_probs, tonal->rnn_state, tonal->arch);
 
     /* Probability of speech or music vs noise */
     info->activity_probability = frame_probs[1];
@@ -29,6 +29,7 @@
 #define ANALYSIS_H
 
 #include "celt.h"
+#include "kiss_fft.h"
 #include "opus_private.h"
 #include "mlp.h"
 
@@ -99,4 +100,30 @@ void run_analysis(TonalityAnalysisState *analysis, const CELTMode *celt_mode, co
                  int analysis_frame_size, int frame_size, int c1, int c2, int C, opus_int32 Fs,
                  int lsb_depth, downmix_func downmix, AnalysisInfo *analysis_info);
 
+/* Phase-derivative tonality and noisiness of the FFT bins start...N/2-1,
+   along with their unscaled energies. Updates the angle history in A,
+   dA and d2A. */
+void tonality_analysis_bins_c(const kiss_fft_cpx *out, float *A, float *dA,
+      float *d2A, float *tonality, float *tonality2, float *noisiness,
+      float *binE, int start, int N);
+
+/* 2:1 decimation of in*scale with the all-pass pair of the SILK
+   resampler, returning the energy of the complementary high band. */
+opus_val32 silk_resampler_down2_hp_c(opus_val32 *S, opus_val32 *out,
+      const opus_val32 *in, int inLen, opus_val32 scale);
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2) || defined(OPUS_X86_MAY_HAVE_AVX2)
+#include "x86/analysis_sse.h"
+#endif
+
+#ifndef OVERRIDE_TONALITY_ANALYSIS_BINS
+#define tonality_analysis_bins(out, A, dA, d2A, tonality, tonality2, noisiness, binE, start, N, arch) \
+    ((void)(arch), tonality_analysis_bins_c(out, A, dA, d2A, tonality, tonality2, noisiness, binE, start, N))
+#endif
+
+#ifndef OVERRIDE_SILK_RESAMPLER_DOWN2_HP
+#define silk_resampler_down2_hp(S, out, in, inLen, scale, arch) \
+    ((void)(arch), silk_resampler_down2_hp_c(S, out, in, inLen, scale))
+#endif
+
 #endif
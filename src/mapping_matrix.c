@@ -41,19 +41,48 @@
 
 int mapping_matrix_get_size(int rows, int cols)
 {
-  return align(sizeof(MappingMatrix)) + rows * cols * sizeof(opus_int16);
+  int stride;
+  int size;
+  stride = MAPPING_MATRIX_STRIDE(rows);
+  size = align(sizeof(MappingMatrix)) + align(rows * cols * sizeof(opus_int16))
+    + align(stride * cols * sizeof(opus_int16));
+#ifndef DISABLE_FLOAT_API
+  size += stride * cols * sizeof(float);
+#endif
+  return size;
 }
 
 opus_int16 *mapping_matrix_get_data(const MappingMatrix *matrix)
 {
-  return (opus_int16*)(void *)(matrix + align(sizeof(MappingMatrix)));
+  return (opus_int16*)(void *)((char *)matrix + align(sizeof(MappingMatrix)));
+}
+
+const opus_int16 *mapping_matrix_get_padded_data_short(const MappingMatrix *matrix)
+{
+  return (const opus_int16*)(void *)((char *)mapping_matrix_get_data(matrix) +
+    align(matrix->rows * matrix->cols * sizeof(opus_int16)));
+}
+
+#ifndef DISABLE_FLOAT_API
+const float *mapping_matrix_get_padded_data_float(const MappingMatrix *matrix)
+{
+  return (const float*)(const void *)((const char *)
+    mapping_matrix_get_padded_data_short(matrix) +
+    align(MAPPING_MATRIX_STRIDE(matrix->rows) * matrix->cols * sizeof(opus_int16)));
 }
+#endif
 
 void mapping_matrix_init(MappingMatrix * const matrix,
   int rows, int cols, int gain, const opus_int16 *data, opus_int32 data_size)
 {
   int i;
+  int row, col;
+  int stride;
   opus_int16 *ptr;
+  opus_int16 *padded;
+#ifndef DISABLE_FLOAT_API
+  float *padded_float;
+#endif
 
 #if !defined(ENABLE_ASSERTIONS)
   (void)data_size;
@@ -68,46 +97,67 @@ void mapping_matrix_init(MappingMatrix * const matrix,
   {
      ptr[i] = data[i];
   }
+
+  /* Keep copies with padded columns (and pre-scaled floats) so the multiply
+     can work on whole vectors of rows without converting each cell for
+     every sample. */
+  stride = MAPPING_MATRIX_STRIDE(rows);
+  padded = (opus_int16 *)mapping_matrix_get_padded_data_short(matrix);
+#ifndef DISABLE_FLOAT_API
+  padded_float = (float *)mapping_matrix_get_padded_data_float(matrix);
+#endif
+  for (col = 0; col < cols; col++)
+  {
+    for (row = 0; row < stride; row++)
+    {
+      opus_int16 cell = row < rows ? data[MATRIX_INDEX(rows, row, col)] : 0;
+      padded[MATRIX_INDEX(stride, row, col)] = cell;
+#ifndef DISABLE_FLOAT_API
+      padded_float[MATRIX_INDEX(stride, row, col)] = (0.000030518f)*(float)cell;
+#endif
+    }
+  }
 }
 
 #ifndef DISABLE_FLOAT_API
-void mapping_matrix_multiply_float(const MappingMatrix *matrix,
-                                   const float *input, int input_rows,
-                                   float *output, int output_rows,
-                                   int frame_size)
+void mapping_matrix_multiply_float_c(const MappingMatrix *matrix,
+                                     const float *input, int input_rows,
+                                     float *output, int output_rows,
+                                     int frame_size)
 {
   /* Matrix data is ordered col-wise.
    * Input (x) is [n x k], output (y) is [m x k], matrix (M) is [m x n]:
    *   y = M x
    */
-  opus_int16* matrix_data;
+  const float *matrix_data;
   int i, row, col;
-  float matrix_cell, input_sample;
+  int stride;
 
   celt_assert(input_rows <= matrix->cols && output_rows <= matrix->rows);
 
-  matrix_data = mapping_matrix_get_data(matrix);
+  matrix_data = mapping_matrix_get_padded_data_float(matrix);
+  stride = MAPPING_MATRIX_STRIDE(matrix->rows);
 
   for (i = 0; i < frame_size; i++)
   {
     for (row = 0; row < output_rows; row++)
     {
-      output[MATRIX_INDEX(output_rows, row, i)] = 0;
+      float tmp = 0;
       for (col = 0; col < input_rows; col++)
       {
-        matrix_cell = (0.000030518f)*(float)matrix_data[MATRIX_INDEX(matrix->rows, row, col)];
-        input_sample = input[MATRIX_INDEX(input_rows, col, i)];
-        output[MATRIX_INDEX(output_rows, row, i)] += matrix_cell * input_sample;
+        tmp += matrix_data[MATRIX_INDEX(stride, row, col)] *
+          input[MATRIX_INDEX(input_rows, col, i)];
       }
+      output[MATRIX_INDEX(output_rows, row, i)] = tmp;
     }
   }
 }
 #endif /* DISABLE_FLOAT_API */
 
-void mapping_matrix_multiply_short(const MappingMatrix *matrix,
-                                   const opus_int16 *input, int input_rows,
-                                   opus_int16 *output, int output_rows,
-                                   int frame_size)
+void mapping_matrix_multiply_short_c(const MappingMatrix *matrix,
+                                     const opus_int16 *input, int input_rows,
+                                     opus_int16 *output, int output_rows,
+                                     int frame_size)
 {
   /* Matrix data is ordered col-wise.
    * Input (x) is [n x k], output (y) is [m x k], matrix (M) is [m x n]:
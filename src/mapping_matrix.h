@@ -47,13 +47,24 @@ typedef struct MappingMatrix
     int rows;
     int cols;
     int gain; /* in dB. S7.8-format. */
-    /* Matrix cell data goes here using col-wise ordering. */
+    /* Matrix cell data goes here using col-wise ordering, followed by the
+       same cells with each column padded to MAPPING_MATRIX_STRIDE(rows)
+       entries, both as opus_int16 and (with the float API) as float. */
 } MappingMatrix;
 
+/* Number of entries per column in the padded copies of the matrix. */
+#define MAPPING_MATRIX_STRIDE(rows) (((rows) + 7) & ~7)
+
 int mapping_matrix_get_size(int rows, int cols);
 
 opus_int16 *mapping_matrix_get_data(const MappingMatrix *matrix);
 
+const opus_int16 *mapping_matrix_get_padded_data_short(const MappingMatrix *matrix);
+
+#ifndef DISABLE_FLOAT_API
+const float *mapping_matrix_get_padded_data_float(const MappingMatrix *matrix);
+#endif
+
 void mapping_matrix_init(
     MappingMatrix * const st,
     int rows,
@@ -64,7 +75,7 @@ void mapping_matrix_init(
 );
 
 #ifndef DISABLE_FLOAT_API
-void mapping_matrix_multiply_float(
+void mapping_matrix_multiply_float_c(
     const MappingMatrix *matrix,
     const float *input,
     int input_rows,
@@ -74,7 +85,7 @@ void mapping_matrix_multiply_float(
 );
 #endif /* DISABLE_FLOAT_API */
 
-void mapping_matrix_multiply_short(
+void mapping_matrix_multiply_short_c(
     const MappingMatrix *matrix,
     const opus_int16 *input,
     int input_rows,
@@ -83,6 +94,24 @@ void mapping_matrix_multiply_short(
     int frame_size
 );
 
+#if defined(OPUS_X86_MAY_HAVE_SSE2) || defined(OPUS_X86_MAY_HAVE_AVX2)
+#include "x86/mapping_matrix_sse.h"
+#endif
+
+#ifndef OVERRIDE_MAPPING_MATRIX_MULTIPLY_FLOAT
+#define mapping_matrix_multiply_float(matrix, input, input_rows, output, \
+      output_rows, frame_size, arch) \
+    ((void)(arch), mapping_matrix_multiply_float_c(matrix, input, input_rows, \
+      output, output_rows, frame_size))
+#endif
+
+#ifndef OVERRIDE_MAPPING_MATRIX_MULTIPLY_SHORT
+#define mapping_matrix_multiply_short(matrix, input, input_rows, output, \
+      output_rows, frame_size, arch) \
+    ((void)(arch), mapping_matrix_multiply_short_c(matrix, input, input_rows, \
+      output, output_rows, frame_size))
+#endif
+
 /* Pre-computed mixing and demixing matrices for 1st to 3rd-order ambisonics.
  *   foa: first-order ambisonics
  *   soa: second-order ambisonics
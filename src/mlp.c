@@ -69,7 +69,7 @@ static OPUS_INLINE float sigmoid_approx(float x)
    return .5f + .5f*tansig_approx(.5f*x);
 }
 
-void compute_dense(const DenseLayer *layer, float *output, const float *input)
+void compute_dense_c(const DenseLayer *layer, float *output, const float *input)
 {
    int i, j;
    int N, M;
@@ -94,7 +94,7 @@ void compute_dense(const DenseLayer *layer, float *output, const float *input)
    }
 }
 
-void compute_gru(const GRULayer *gru, float *state, const float *input)
+void compute_gru_c(const GRULayer *gru, float *state, const float *input)
 {
    int i, j;
    int N, M;
@@ -53,8 +53,22 @@ extern const DenseLayer layer0;
 extern const GRULayer layer1;
 extern const DenseLayer layer2;
 
-void compute_dense(const DenseLayer *layer, float *output, const float *input);
+void compute_dense_c(const DenseLayer *layer, float *output, const float *input);
 
-void compute_gru(const GRULayer *gru, float *state, const float *input);
+void compute_gru_c(const GRULayer *gru, float *state, const float *input);
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2) || defined(OPUS_X86_MAY_HAVE_AVX2)
+#include "x86/mlp_sse.h"
+#endif
+
+#ifndef OVERRIDE_COMPUTE_DENSE
+#define compute_dense(layer, output, input, arch) \
+    ((void)(arch), compute_dense_c(layer, output, input))
+#endif
+
+#ifndef OVERRIDE_COMPUTE_GRU
+#define compute_gru(gru, state, input, arch) \
+    ((void)(arch), compute_gru_c(gru, state, input))
+#endif
 
 #endif /* _MLP_H_ */
@@ -31,13 +31,35 @@
 
 #include "opus.h"
 #include "opus_private.h"
+#include "cpu_support.h"
 
 #ifndef DISABLE_FLOAT_API
-OPUS_EXPORT void opus_pcm_soft_clip(float *_x, int N, int C, float *declip_mem)
+int opus_limit2_checkwithin1_c(float *x, int len)
+{
+   int i;
+   int within1=1;
+   for (i=0;i<len;i++)
+   {
+      x[i] = MAX16(-2.f, MIN16(2.f, x[i]));
+      if (x[i]>1 || x[i]<-1)
+         within1 = 0;
+   }
+   return within1;
+}
+
+void soft_clip_curve_c(float *x, int N, int C, float a)
+{
+   int i;
+   for (i=0;i<N;i++)
+      x[i*C] = x[i*C]+a*x[i*C]*x[i*C];
+}
+
+void opus_pcm_soft_clip_impl(float *_x, int N, int C, float *declip_mem, int arch)
 {
    int c;
    int i;
    float *x;
+   int within1;
 
    if (C<1 || N<1 || !_x || !declip_mem) return;
 
@@ -45,8 +67,7 @@ OPUS_EXPORT void opus_pcm_soft_clip(float *_x, int N, int C, float *declip_mem)
       non-linearity can handle. At the point where the signal reaches +/-2,
       the derivative will be zero anyway, so this doesn't introduce any
       discontinuity in the derivative. */
-   for (i=0;i<N*C;i++)
-      _x[i] = MAX16(-2.f, MIN16(2.f, _x[i]));
+   within1 = opus_limit2_checkwithin1(_x, N*C, arch);
    for (c=0;c<C;c++)
    {
       float a;
@@ -63,6 +84,12 @@ OPUS_EXPORT void opus_pcm_soft_clip(float *_x, int N, int C, float *declip_mem)
             break;
          x[i*C] = x[i*C]+a*x[i*C]*x[i*C];
       }
+      /* Nothing left to clip; the curve above only ever shrinks samples. */
+      if (within1)
+      {
+         declip_mem[c] = 0;
+         continue;
+      }
 
       curr=0;
       x0 = x[0];
@@ -111,8 +138,7 @@ OPUS_EXPORT void opus_pcm_soft_clip(float *_x, int N, int C, float *declip_mem)
          if (x[i*C]>0)
             a = -a;
          /* Apply soft clipping */
-         for (i=start;i<end;i++)
-            x[i*C] = x[i*C]+a*x[i*C]*x[i*C];
+         soft_clip_curve(x+start*C, end-start, C, a, arch);
 
          if (special && peak_pos>=2)
          {
@@ -135,6 +161,11 @@ OPUS_EXPORT void opus_pcm_soft_clip(float *_x, int N, int C, float *declip_mem)
       declip_mem[c] = a;
    }
 }
+
+OPUS_EXPORT void opus_pcm_soft_clip(float *_x, int N, int C, float *declip_mem)
+{
+   opus_pcm_soft_clip_impl(_x, N, C, declip_mem, opus_select_arch());
+}
 #endif
 
 int encode_size(int size, unsigned char *data)
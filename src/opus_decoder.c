@@ -228,6 +228,10 @@ static int opus_decode_frame(OpusDecoder *st, const unsigned char *data,
    opus_uint32 redundant_rng = 0;
    int celt_accum;
    ALLOC_STACK;
+#if !defined(VAR_ARRAYS) && !defined(USE_ALLOCA)
+   if (global_stack==NULL)
+      return OPUS_ALLOC_FAIL;
+#endif
 
    silk_dec = (char*)st+st->silk_dec_offset;
    celt_dec = (CELTDecoder*)((char*)st+st->celt_dec_offset);
@@ -701,7 +705,7 @@ int opus_decode_native(OpusDecoder *st, const unsigned char *data,
       OPUS_PRINT_INT(nb_samples);
 #ifndef FIXED_POINT
    if (soft_clip)
-      opus_pcm_soft_clip(pcm, nb_samples, st->channels, st->softclip_mem);
+      opus_pcm_soft_clip_impl(pcm, nb_samples, st->channels, st->softclip_mem, st->arch);
    else
       st->softclip_mem[0]=st->softclip_mem[1]=0;
 #endif
@@ -726,6 +730,10 @@ int opus_decode_float(OpusDecoder *st, const unsigned char *data,
    int ret, i;
    int nb_samples;
    ALLOC_STACK;
+#if !defined(VAR_ARRAYS) && !defined(USE_ALLOCA)
+   if (global_stack==NULL)
+      return OPUS_ALLOC_FAIL;
+#endif
 
    if(frame_size<=0)
    {
@@ -762,6 +770,10 @@ int opus_decode(OpusDecoder *st, const unsigned char *data,
    int ret, i;
    int nb_samples;
    ALLOC_STACK;
+#if !defined(VAR_ARRAYS) && !defined(USE_ALLOCA)
+   if (global_stack==NULL)
+      return OPUS_ALLOC_FAIL;
+#endif
 
    if(frame_size<=0)
    {
@@ -581,12 +581,29 @@ static opus_int32 user_bitrate_to_bitrate(OpusEncoder *st, int frame_size, int m
 #define PCM2VAL(x) SCALEIN(x)
 #endif
 
-void downmix_float(const void *_x, opus_val32 *y, int subframe, int offset, int c1, int c2, int C)
+void downmix_sum_float_c(const float *x, opus_val32 *y, int subframe, int C)
+{
+   int j, c;
+   for (j=0;j<subframe;j++)
+      y[j] = PCM2VAL(x[j*C]);
+   for (c=1;c<C;c++)
+   {
+      for (j=0;j<subframe;j++)
+         y[j] += PCM2VAL(x[j*C+c]);
+   }
+}
+
+void downmix_float(const void *_x, opus_val32 *y, int subframe, int offset, int c1, int c2, int C, int arch)
 {
    const float *x;
    int j;
 
    x = (const float *)_x;
+   if (c1==0 && c2==-2)
+   {
+      downmix_sum_float(x+offset*C, y, subframe, C, arch);
+      return;
+   }
    for (j=0;j<subframe;j++)
       y[j] = PCM2VAL(x[(j+offset)*C+c1]);
    if (c2>-1)
@@ -605,12 +622,29 @@ void downmix_float(const void *_x, opus_val32 *y, int subframe, int offset, int
 }
 #endif
 
-void downmix_int(const void *_x, opus_val32 *y, int subframe, int offset, int c1, int c2, int C)
+void downmix_sum_int_c(const opus_int16 *x, opus_val32 *y, int subframe, int C)
+{
+   int j, c;
+   for (j=0;j<subframe;j++)
+      y[j] = x[j*C];
+   for (c=1;c<C;c++)
+   {
+      for (j=0;j<subframe;j++)
+         y[j] += x[j*C+c];
+   }
+}
+
+void downmix_int(const void *_x, opus_val32 *y, int subframe, int offset, int c1, int c2, int C, int arch)
 {
    const opus_int16 *x;
    int j;
 
    x = (const opus_int16 *)_x;
+   if (c1==0 && c2==-2)
+   {
+      downmix_sum_int(x+offset*C, y, subframe, C, arch);
+      return;
+   }
    for (j=0;j<subframe;j++)
       y[j] = x[(j+offset)*C+c1];
    if (c2>-1)
@@ -1118,6 +1152,10 @@ opus_int32 opus_encode_native(OpusEncoder *st, const opus_val16 *pcm, int frame_
     VARDECL(opus_val16, tmp_prefill);
 
     ALLOC_STACK;
+#if !defined(VAR_ARRAYS) && !defined(USE_ALLOCA)
+    if (global_stack==NULL)
+       return OPUS_ALLOC_FAIL;
+#endif
 
     max_data_bytes = IMIN(1276, out_data_bytes);
 
@@ -2194,6 +2232,10 @@ opus_int32 opus_encode_float(OpusEncoder *st, const float *pcm, int analysis_fra
    int frame_size;
    VARDECL(opus_int16, in);
    ALLOC_STACK;
+#if !defined(VAR_ARRAYS) && !defined(USE_ALLOCA)
+   if (global_stack==NULL)
+      return OPUS_ALLOC_FAIL;
+#endif
 
    frame_size = frame_size_select(analysis_frame_size, st->variable_duration, st->Fs);
    if (frame_size <= 0)
@@ -2229,6 +2271,10 @@ opus_int32 opus_encode(OpusEncoder *st, const opus_int16 *pcm, int analysis_fram
    int frame_size;
    VARDECL(float, in);
    ALLOC_STACK;
+#if !defined(VAR_ARRAYS) && !defined(USE_ALLOCA)
+   if (global_stack==NULL)
+      return OPUS_ALLOC_FAIL;
+#endif
 
    frame_size = frame_size_select(analysis_frame_size, st->variable_duration, st->Fs);
    if (frame_size <= 0)
@@ -192,6 +192,10 @@ static int opus_multistream_decode_native(
    int do_plc=0;
    VARDECL(opus_val16, buf);
    ALLOC_STACK;
+#if !defined(VAR_ARRAYS) && !defined(USE_ALLOCA)
+   if (global_stack==NULL)
+      return OPUS_ALLOC_FAIL;
+#endif
 
    /* Limit frame_size to avoid excessive stack allocations. */
    opus_multistream_decoder_ctl(st, OPUS_GET_SAMPLE_RATE(&Fs));
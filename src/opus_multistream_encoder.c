@@ -275,7 +275,7 @@ void surround_analysis(const CELTMode *celt_mode, const void *pcm, opus_val16 *b
       celt_assert(nb_frames*freq_size == frame_size);
       OPUS_COPY(in, mem+c*overlap, overlap);
       (*copy_channel_in)(x, 1, pcm, channels, c, len);
-      celt_preemphasis(x, in+overlap, frame_size, 1, upsample, celt_mode->preemph, preemph_mem+c, 0);
+      celt_preemphasis(x, in+overlap, frame_size, 1, upsample, celt_mode->preemph, preemph_mem+c, 0, arch);
 #ifndef FIXED_POINT
       {
          opus_val32 sum;
@@ -895,6 +895,10 @@ static int opus_multistream_encode_native
    opus_int32 rate_sum;
    opus_int32 smallest_packet;
    ALLOC_STACK;
+#if !defined(VAR_ARRAYS) && !defined(USE_ALLOCA)
+   if (global_stack==NULL)
+      return OPUS_ALLOC_FAIL;
+#endif
 
    if (st->mapping_type == MAPPING_TYPE_SURROUND)
    {
@@ -117,9 +117,45 @@ int get_mono_channel(const ChannelLayout *layout, int stream_id, int prev);
 #define OPUS_SET_FORCE_MODE_REQUEST    11002
 #define OPUS_SET_FORCE_MODE(x) OPUS_SET_FORCE_MODE_REQUEST, __opus_check_int(x)
 
-typedef void (*downmix_func)(const void *, opus_val32 *, int, int, int, int, int);
-void downmix_float(const void *_x, opus_val32 *sub, int subframe, int offset, int c1, int c2, int C);
-void downmix_int(const void *_x, opus_val32 *sub, int subframe, int offset, int c1, int c2, int C);
+typedef void (*downmix_func)(const void *, opus_val32 *, int, int, int, int, int, int);
+void downmix_float(const void *_x, opus_val32 *sub, int subframe, int offset, int c1, int c2, int C, int arch);
+void downmix_int(const void *_x, opus_val32 *sub, int subframe, int offset, int c1, int c2, int C, int arch);
+
+/* Sum of all C channels of interleaved PCM, for downmix_float() and
+   downmix_int() when the whole input is downmixed. */
+void downmix_sum_float_c(const float *x, opus_val32 *y, int subframe, int C);
+void downmix_sum_int_c(const opus_int16 *x, opus_val32 *y, int subframe, int C);
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2) || defined(OPUS_X86_MAY_HAVE_AVX2)
+#include "x86/downmix_sse.h"
+#endif
+
+#ifndef OVERRIDE_DOWNMIX_SUM
+#define downmix_sum_float(x, y, subframe, C, arch) \
+    ((void)(arch), downmix_sum_float_c(x, y, subframe, C))
+#define downmix_sum_int(x, y, subframe, C, arch) \
+    ((void)(arch), downmix_sum_int_c(x, y, subframe, C))
+#endif
+
+#ifndef DISABLE_FLOAT_API
+void opus_pcm_soft_clip_impl(float *_x, int N, int C, float *declip_mem, int arch);
+
+/* Saturates x to +/-2 and returns 1 if no sample is outside +/-1. */
+int opus_limit2_checkwithin1_c(float *x, int len);
+/* Applies x += a*x^2 to N samples of one channel of interleaved PCM. */
+void soft_clip_curve_c(float *x, int N, int C, float a);
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2) || defined(OPUS_X86_MAY_HAVE_AVX2)
+#include "x86/soft_clip_sse.h"
+#endif
+
+#ifndef OVERRIDE_SOFT_CLIP
+#define opus_limit2_checkwithin1(x, len, arch) \
+    ((void)(arch), opus_limit2_checkwithin1_c(x, len))
+#define soft_clip_curve(x, N, C, a, arch) \
+    ((void)(arch), soft_clip_curve_c(x, N, C, a))
+#endif
+#endif
 
 int encode_size(int size, unsigned char *data);
 
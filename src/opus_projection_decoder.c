@@ -29,6 +29,7 @@
 #include "config.h"
 #endif
 
+#include "cpu_support.h"
 #include "mathops.h"
 #include "os_support.h"
 #include "opus_private.h"
@@ -43,6 +44,7 @@
 struct OpusProjectionDecoder
 {
   int demixing_matrix_size_in_bytes;
+  int arch;
   /* Encoder states go here */
 };
 
@@ -82,6 +84,10 @@ int opus_projection_decoder_init(OpusProjectionDecoder *st, opus_int32 Fs,
   unsigned char mapping[255];
   VARDECL(opus_int16, buf);
   ALLOC_STACK;
+#if !defined(VAR_ARRAYS) && !defined(USE_ALLOCA)
+  if (global_stack==NULL)
+    return OPUS_ALLOC_FAIL;
+#endif
 
   /* Verify supplied matrix size. */
   nb_input_streams = streams + coupled_streams;
@@ -106,6 +112,8 @@ int opus_projection_decoder_init(OpusProjectionDecoder *st, opus_int32 Fs,
   mapping_matrix_init(get_demixing_matrix(st), nb_input_streams, channels, 0,
     buf, demixing_matrix_size);
 
+  st->arch = opus_select_arch();
+
   /* Set trivial mapping so each input channel pairs with a matrix column. */
   for (i = 0; i < channels; i++)
   {
@@ -166,6 +174,10 @@ int opus_projection_decode(OpusProjectionDecoder *st, const unsigned char *data,
   int ret;
   VARDECL(opus_int16, buf);
   ALLOC_STACK;
+#if !defined(VAR_ARRAYS) && !defined(USE_ALLOCA)
+  if (global_stack==NULL)
+    return OPUS_ALLOC_FAIL;
+#endif
 
   ms_decoder = get_multistream_decoder(st);
   ALLOC(buf, (ms_decoder->layout.nb_streams + ms_decoder->layout.nb_coupled_streams) *
@@ -178,7 +190,7 @@ int opus_projection_decode(OpusProjectionDecoder *st, const unsigned char *data,
   matrix = get_demixing_matrix(st);
   mapping_matrix_multiply_short(matrix, buf,
     ms_decoder->layout.nb_streams + ms_decoder->layout.nb_coupled_streams,
-    pcm, ms_decoder->layout.nb_channels, frame_size);
+    pcm, ms_decoder->layout.nb_channels, frame_size, st->arch);
   RESTORE_STACK;
   return frame_size;
 }
@@ -196,6 +208,10 @@ int opus_projection_decode_float(OpusProjectionDecoder *st, const unsigned char
   int ret;
   VARDECL(float, buf);
   ALLOC_STACK;
+#if !defined(VAR_ARRAYS) && !defined(USE_ALLOCA)
+  if (global_stack==NULL)
+    return OPUS_ALLOC_FAIL;
+#endif
 
   ms_decoder = get_multistream_decoder(st);
   ALLOC(buf, (ms_decoder->layout.nb_streams + ms_decoder->layout.nb_coupled_streams) *
@@ -208,7 +224,7 @@ int opus_projection_decode_float(OpusProjectionDecoder *st, const unsigned char
   matrix = get_demixing_matrix(st);
   mapping_matrix_multiply_float(matrix, buf,
     ms_decoder->layout.nb_streams + ms_decoder->layout.nb_coupled_streams,
-    pcm, ms_decoder->layout.nb_channels, frame_size);
+    pcm, ms_decoder->layout.nb_channels, frame_size, st->arch);
   RESTORE_STACK;
   return frame_size;
 }
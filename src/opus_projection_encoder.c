@@ -29,6 +29,7 @@
 #include "config.h"
 #endif
 
+#include "cpu_support.h"
 #include "mathops.h"
 #include "os_support.h"
 #include "opus_private.h"
@@ -44,6 +45,7 @@ struct OpusProjectionEncoder
 {
   int mixing_matrix_size_in_bytes;
   int demixing_matrix_size_in_bytes;
+  int arch;
   /* Encoder states go here */
 };
 
@@ -222,6 +224,8 @@ int opus_projection_ambisonics_encoder_init(OpusProjectionEncoder *st, opus_int3
     mapping[i] = i;
   }
 
+  st->arch = opus_select_arch();
+
   /* Initialize multistream encoder with provided settings. */
   ms_encoder = get_multistream_encoder(st);
   ret = opus_multistream_encoder_init(ms_encoder, Fs, channels, nb_streams,
@@ -277,6 +281,10 @@ int opus_projection_encode(OpusProjectionEncoder *st, const opus_int16 *pcm,
   int ret;
   VARDECL(opus_int16, buf);
   ALLOC_STACK;
+#if !defined(VAR_ARRAYS) && !defined(USE_ALLOCA)
+  if (global_stack==NULL)
+    return OPUS_ALLOC_FAIL;
+#endif
 
   matrix = get_mixing_matrix(st);
   ms_encoder = get_multistream_encoder(st);
@@ -285,7 +293,7 @@ int opus_projection_encode(OpusProjectionEncoder *st, const opus_int16 *pcm,
   mapping_matrix_multiply_short(matrix, pcm,
     ms_encoder->layout.nb_channels, buf,
     ms_encoder->layout.nb_streams + ms_encoder->layout.nb_coupled_streams,
-    frame_size);
+    frame_size, st->arch);
   ret = opus_multistream_encode(ms_encoder, buf, frame_size, data, max_data_bytes);
   RESTORE_STACK;
   return ret;
@@ -304,6 +312,10 @@ int opus_projection_encode_float(OpusProjectionEncoder *st, const float *pcm,
   int ret;
   VARDECL(float, buf);
   ALLOC_STACK;
+#if !defined(VAR_ARRAYS) && !defined(USE_ALLOCA)
+  if (global_stack==NULL)
+    return OPUS_ALLOC_FAIL;
+#endif
 
   matrix = get_mixing_matrix(st);
   ms_encoder = get_multistream_encoder(st);
@@ -312,7 +324,7 @@ int opus_projection_encode_float(OpusProjectionEncoder *st, const float *pcm,
   mapping_matrix_multiply_float(matrix, pcm,
     ms_encoder->layout.nb_channels, buf,
     ms_encoder->layout.nb_streams + ms_encoder->layout.nb_coupled_streams,
-    frame_size);
+    frame_size, st->arch);
   ret = opus_multistream_encode_float(ms_encoder, buf, frame_size, data, max_data_bytes);
   RESTORE_STACK;
   return ret;
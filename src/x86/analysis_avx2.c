@@ -0,0 +1,257 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+#include "opus_types.h"
+#include "opus_defines.h"
+#include "arch.h"
+#include "mathops.h"
+#include "../analysis.h"
+
+#ifndef M_PI
+#define M_PI 3.141592653
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+
+#define cA 0.43157974f
+#define cB 0.67848403f
+#define cC 0.08595542f
+#define cE ((float)PI/2)
+
+/* Same steps as fast_atan2f(), eight values at a time. */
+static OPUS_INLINE __m256 fast_atan2f_avx2(__m256 y, __m256 x)
+{
+   __m256 x2, y2, xy, p, q, swap, den, t, sy, sxy, r0, r1, r, zero;
+   zero = _mm256_setzero_ps();
+   x2 = _mm256_mul_ps(x, x);
+   y2 = _mm256_mul_ps(y, y);
+   xy = _mm256_mul_ps(x, y);
+   /* Both branches are the same rational function with x2 and y2
+      swapped, so evaluate it once on the selected pair. */
+   swap = _mm256_cmp_ps(x2, y2, _CMP_LT_OQ);
+   p = _mm256_blendv_ps(x2, y2, swap);
+   q = _mm256_blendv_ps(y2, x2, swap);
+   den = _mm256_mul_ps(_mm256_add_ps(p, _mm256_mul_ps(_mm256_set1_ps(cB), q)),
+         _mm256_add_ps(p, _mm256_mul_ps(_mm256_set1_ps(cC), q)));
+   t = _mm256_div_ps(_mm256_mul_ps(xy,
+         _mm256_add_ps(p, _mm256_mul_ps(_mm256_set1_ps(cA), q))), den);
+   sy = _mm256_or_ps(_mm256_set1_ps(cE), _mm256_and_ps(
+         _mm256_cmp_ps(y, zero, _CMP_LT_OQ), _mm256_set1_ps(-0.f)));
+   sxy = _mm256_or_ps(_mm256_set1_ps(cE), _mm256_and_ps(
+         _mm256_cmp_ps(xy, zero, _CMP_LT_OQ), _mm256_set1_ps(-0.f)));
+   r0 = _mm256_sub_ps(sy, t);
+   r1 = _mm256_sub_ps(_mm256_add_ps(t, sy), sxy);
+   r = _mm256_blendv_ps(r1, r0, swap);
+   /* For very small values, we don't care about the answer. */
+   return _mm256_andnot_ps(_mm256_cmp_ps(_mm256_add_ps(x2, y2),
+         _mm256_set1_ps(1e-18f), _CMP_LT_OQ), r);
+}
+
+#undef cA
+#undef cB
+#undef cC
+#undef cE
+
+/* Loads four bins as {r, i, r, i, ...}. */
+static OPUS_INLINE __m256 load_cpx_avx2(const kiss_fft_cpx *x)
+{
+#ifdef FIXED_POINT
+   return _mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i*)(const void*)x));
+#else
+   return _mm256_loadu_ps((const float*)x);
+#endif
+}
+
+void tonality_analysis_bins_avx2(const kiss_fft_cpx *out, float *A, float *dA,
+      float *d2A, float *tonality, float *tonality2, float *noisiness,
+      float *binE, int start, int N)
+{
+   int i;
+   const float pi4 = (float)(M_PI*M_PI*M_PI*M_PI);
+   const __m256 scale = _mm256_set1_ps((float)(.5f/M_PI));
+   const __m256 k = _mm256_set1_ps(40.f*16.f*pi4);
+   const __m256 one = _mm256_set1_ps(1.f);
+   const __m256 offset = _mm256_set1_ps(.015f);
+   const __m256 sign = _mm256_set1_ps(-0.f);
+   /* Undo the lane interleaving of _mm256_shuffle_ps(), in increasing order
+      for bins i+j and decreasing order for bins N-i-j. */
+   const __m256i fwd = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+   const __m256i rev = _mm256_setr_epi32(7, 6, 3, 2, 5, 4, 1, 0);
+   for (i=start;i<N/2-7;i+=8)
+   {
+      __m256 v0, v1, re, im, mre, mim;
+      __m256 X1r, X1i, X2r, X2i;
+      __m256 angle, d_angle, d2_angle;
+      __m256 angle2, d_angle2, d2_angle2;
+      __m256 mod1, mod2, avg_mod;
+      v0 = load_cpx_avx2(&out[i]);
+      v1 = load_cpx_avx2(&out[i+4]);
+      re = _mm256_permutevar8x32_ps(_mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0)), fwd);
+      im = _mm256_permutevar8x32_ps(_mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1)), fwd);
+      v0 = load_cpx_avx2(&out[N-i-7]);
+      v1 = load_cpx_avx2(&out[N-i-3]);
+      mre = _mm256_permutevar8x32_ps(_mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0)), rev);
+      mim = _mm256_permutevar8x32_ps(_mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1)), rev);
+      X1r = _mm256_add_ps(re, mre);
+      X1i = _mm256_sub_ps(im, mim);
+      X2r = _mm256_add_ps(im, mim);
+      X2i = _mm256_sub_ps(mre, re);
+
+      angle = _mm256_mul_ps(scale, fast_atan2f_avx2(X1i, X1r));
+      d_angle = _mm256_sub_ps(angle, _mm256_loadu_ps(&A[i]));
+      d2_angle = _mm256_sub_ps(d_angle, _mm256_loadu_ps(&dA[i]));
+
+      angle2 = _mm256_mul_ps(scale, fast_atan2f_avx2(X2i, X2r));
+      d_angle2 = _mm256_sub_ps(angle2, angle);
+      d2_angle2 = _mm256_sub_ps(d_angle2, d_angle);
+
+      mod1 = _mm256_sub_ps(d2_angle, _mm256_round_ps(d2_angle, _MM_FROUND_TO_NEAREST_INT|_MM_FROUND_NO_EXC));
+      mod2 = _mm256_sub_ps(d2_angle2, _mm256_round_ps(d2_angle2, _MM_FROUND_TO_NEAREST_INT|_MM_FROUND_NO_EXC));
+      _mm256_storeu_ps(&noisiness[i], _mm256_add_ps(_mm256_andnot_ps(sign, mod1),
+            _mm256_andnot_ps(sign, mod2)));
+      mod1 = _mm256_mul_ps(mod1, mod1);
+      mod1 = _mm256_mul_ps(mod1, mod1);
+      mod2 = _mm256_mul_ps(mod2, mod2);
+      mod2 = _mm256_mul_ps(mod2, mod2);
+
+      avg_mod = _mm256_mul_ps(_mm256_set1_ps(.25f), _mm256_add_ps(
+            _mm256_add_ps(_mm256_loadu_ps(&d2A[i]), mod1), _mm256_add_ps(mod2, mod2)));
+      _mm256_storeu_ps(&tonality[i], _mm256_sub_ps(_mm256_div_ps(one,
+            _mm256_add_ps(one, _mm256_mul_ps(k, avg_mod))), offset));
+      _mm256_storeu_ps(&tonality2[i], _mm256_sub_ps(_mm256_div_ps(one,
+            _mm256_add_ps(one, _mm256_mul_ps(k, mod2))), offset));
+
+      _mm256_storeu_ps(&A[i], angle2);
+      _mm256_storeu_ps(&dA[i], d_angle2);
+      _mm256_storeu_ps(&d2A[i], mod2);
+
+      _mm256_storeu_ps(&binE[i], _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+            _mm256_mul_ps(re, re), _mm256_mul_ps(mre, mre)), _mm256_mul_ps(im, im)),
+            _mm256_mul_ps(mim, mim)));
+   }
+   tonality_analysis_bins_c(out, A, dA, d2A, tonality, tonality2, noisiness,
+         binE, i, N);
+}
+
+#ifndef FIXED_POINT
+
+static OPUS_INLINE __m256 rotate_up_ps(__m256 x, int n)
+{
+   return _mm256_permutevar8x32_ps(x, _mm256_and_si256(_mm256_sub_epi32(
+         _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(n)),
+         _mm256_set1_epi32(7)));
+}
+
+/* Coefficient r^n in lanes n and up, zero below. */
+static OPUS_INLINE __m256 scan_coef_ps(float rn, int n)
+{
+   return _mm256_and_ps(_mm256_set1_ps(rn), _mm256_castsi256_ps(_mm256_cmpgt_epi32(
+         _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(n-1))));
+}
+
+/* States seen by eight consecutive inputs u of the all-pass section
+   S' = u + a*(u - S), starting from *S (in all lanes), which is advanced.
+   The recursion is linear, so it is solved with a log-step scan. */
+static OPUS_INLINE __m256 allpass_states_avx2(__m256 u, __m256 *S, float a)
+{
+   __m256 T;
+   const float r = -a;
+   const float r2 = r*r;
+   const float r4 = r2*r2;
+   T = _mm256_add_ps(u, _mm256_mul_ps(_mm256_set1_ps(a), u));
+   T = _mm256_add_ps(T, _mm256_mul_ps(scan_coef_ps(r, 1), rotate_up_ps(T, 1)));
+   T = _mm256_add_ps(T, _mm256_mul_ps(scan_coef_ps(r2, 2), rotate_up_ps(T, 2)));
+   T = _mm256_add_ps(T, _mm256_mul_ps(scan_coef_ps(r4, 4), rotate_up_ps(T, 4)));
+   T = _mm256_add_ps(T, _mm256_mul_ps(_mm256_setr_ps(r, r2, r2*r, r4, r4*r,
+         r4*r2, r4*r2*r, r4*r4), *S));
+   u = _mm256_blend_ps(rotate_up_ps(T, 1), *S, 1);
+   *S = _mm256_permutevar8x32_ps(T, _mm256_set1_epi32(7));
+   return u;
+}
+
+opus_val32 silk_resampler_down2_hp_avx2(opus_val32 *S, opus_val32 *out,
+      const opus_val32 *in, int inLen, opus_val32 scale)
+{
+   int k;
+   __m256 S0, S1, S2, acc, sc;
+   __m128 acc4;
+   const float a0 = QCONST16(0.6074371f, 15);
+   const float a1 = QCONST16(0.15063f, 15);
+   /* Undoes the lane interleaving of _mm256_shuffle_ps(). */
+   const __m256i fwd = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+   S0 = _mm256_set1_ps(S[0]);
+   S1 = _mm256_set1_ps(S[1]);
+   S2 = _mm256_set1_ps(S[2]);
+   acc = _mm256_setzero_ps();
+   sc = _mm256_set1_ps(scale);
+   for (k=0;k<inLen/2-7;k+=8)
+   {
+      __m256 x0, x1, e, o, P, X, out32, out32_hp;
+      x0 = _mm256_loadu_ps(&in[2*k]);
+      x1 = _mm256_loadu_ps(&in[2*k+8]);
+      e = _mm256_mul_ps(_mm256_permutevar8x32_ps(
+            _mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(2, 0, 2, 0)), fwd), sc);
+      o = _mm256_mul_ps(_mm256_permutevar8x32_ps(
+            _mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(3, 1, 3, 1)), fwd), sc);
+
+      /* All-pass section for even input sample */
+      P = allpass_states_avx2(e, &S0, a0);
+      X = _mm256_mul_ps(_mm256_set1_ps(a0), _mm256_sub_ps(e, P));
+      out32 = _mm256_add_ps(P, X);
+      out32_hp = out32;
+
+      /* All-pass section for odd input sample, and add to output of previous section */
+      P = allpass_states_avx2(o, &S1, a1);
+      X = _mm256_mul_ps(_mm256_set1_ps(a1), _mm256_sub_ps(o, P));
+      out32 = _mm256_add_ps(_mm256_add_ps(out32, P), X);
+
+      o = _mm256_xor_ps(o, _mm256_set1_ps(-0.f));
+      P = allpass_states_avx2(o, &S2, a1);
+      X = _mm256_mul_ps(_mm256_set1_ps(a1), _mm256_sub_ps(o, P));
+      out32_hp = _mm256_add_ps(_mm256_add_ps(out32_hp, P), X);
+
+      acc = _mm256_add_ps(acc, _mm256_mul_ps(out32_hp, out32_hp));
+      _mm256_storeu_ps(&out[k], _mm256_mul_ps(_mm256_set1_ps(.5f), out32));
+   }
+   S[0] = _mm256_cvtss_f32(S0);
+   S[1] = _mm256_cvtss_f32(S1);
+   S[2] = _mm256_cvtss_f32(S2);
+   acc4 = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+   acc4 = _mm_add_ps(acc4, _mm_movehl_ps(acc4, acc4));
+   acc4 = _mm_add_ss(acc4, _mm_shuffle_ps(acc4, acc4, _MM_SHUFFLE(1, 1, 1, 1)));
+   return _mm_cvtss_f32(acc4) + silk_resampler_down2_hp_c(S, out+k, in+2*k,
+         inLen-2*k, scale);
+}
+
+#endif /* FIXED_POINT */
+
+#endif
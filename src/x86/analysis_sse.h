@@ -0,0 +1,97 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef ANALYSIS_SSE_H
+#define ANALYSIS_SSE_H
+
+#include "cpu_support.h"
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2)
+void tonality_analysis_bins_sse2(const kiss_fft_cpx *out, float *A, float *dA,
+      float *d2A, float *tonality, float *tonality2, float *noisiness,
+      float *binE, int start, int N);
+
+# ifndef FIXED_POINT
+opus_val32 silk_resampler_down2_hp_sse2(opus_val32 *S, opus_val32 *out,
+      const opus_val32 *in, int inLen, opus_val32 scale);
+# endif
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+void tonality_analysis_bins_avx2(const kiss_fft_cpx *out, float *A, float *dA,
+      float *d2A, float *tonality, float *tonality2, float *noisiness,
+      float *binE, int start, int N);
+
+# ifndef FIXED_POINT
+opus_val32 silk_resampler_down2_hp_avx2(opus_val32 *S, opus_val32 *out,
+      const opus_val32 *in, int inLen, opus_val32 scale);
+# endif
+#endif
+
+#if defined(OPUS_X86_PRESUME_AVX2)
+#define OVERRIDE_TONALITY_ANALYSIS_BINS
+#define tonality_analysis_bins(out, A, dA, d2A, tonality, tonality2, noisiness, binE, start, N, arch) \
+    ((void)(arch), tonality_analysis_bins_avx2(out, A, dA, d2A, tonality, tonality2, noisiness, binE, start, N))
+# ifndef FIXED_POINT
+#define OVERRIDE_SILK_RESAMPLER_DOWN2_HP
+#define silk_resampler_down2_hp(S, out, in, inLen, scale, arch) \
+    ((void)(arch), silk_resampler_down2_hp_avx2(S, out, in, inLen, scale))
+# endif
+
+#elif defined(OPUS_X86_PRESUME_SSE2) && !defined(OPUS_X86_MAY_HAVE_AVX2)
+#define OVERRIDE_TONALITY_ANALYSIS_BINS
+#define tonality_analysis_bins(out, A, dA, d2A, tonality, tonality2, noisiness, binE, start, N, arch) \
+    ((void)(arch), tonality_analysis_bins_sse2(out, A, dA, d2A, tonality, tonality2, noisiness, binE, start, N))
+# ifndef FIXED_POINT
+#define OVERRIDE_SILK_RESAMPLER_DOWN2_HP
+#define silk_resampler_down2_hp(S, out, in, inLen, scale, arch) \
+    ((void)(arch), silk_resampler_down2_hp_sse2(S, out, in, inLen, scale))
+# endif
+
+#else
+#define OVERRIDE_TONALITY_ANALYSIS_BINS
+
+extern void (*const TONALITY_ANALYSIS_BINS_IMPL[OPUS_ARCHMASK + 1])(
+      const kiss_fft_cpx *out, float *A, float *dA, float *d2A,
+      float *tonality, float *tonality2, float *noisiness, float *binE,
+      int start, int N);
+#define tonality_analysis_bins(out, A, dA, d2A, tonality, tonality2, noisiness, binE, start, N, arch) \
+    ((*TONALITY_ANALYSIS_BINS_IMPL[(arch) & OPUS_ARCHMASK])(out, A, dA, d2A, tonality, tonality2, noisiness, binE, start, N))
+
+# ifndef FIXED_POINT
+#define OVERRIDE_SILK_RESAMPLER_DOWN2_HP
+
+extern opus_val32 (*const SILK_RESAMPLER_DOWN2_HP_IMPL[OPUS_ARCHMASK + 1])(
+      opus_val32 *S, opus_val32 *out, const opus_val32 *in, int inLen,
+      opus_val32 scale);
+#define silk_resampler_down2_hp(S, out, in, inLen, scale, arch) \
+    ((*SILK_RESAMPLER_DOWN2_HP_IMPL[(arch) & OPUS_ARCHMASK])(S, out, in, inLen, scale))
+# endif
+
+#endif
+
+#endif
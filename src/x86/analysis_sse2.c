@@ -0,0 +1,233 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#include "opus_types.h"
+#include "opus_defines.h"
+#include "arch.h"
+#include "mathops.h"
+#include "../analysis.h"
+
+#ifndef M_PI
+#define M_PI 3.141592653
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2)
+
+#define cA 0.43157974f
+#define cB 0.67848403f
+#define cC 0.08595542f
+#define cE ((float)PI/2)
+
+/* Same steps as fast_atan2f(), four values at a time. */
+static OPUS_INLINE __m128 fast_atan2f_sse2(__m128 y, __m128 x)
+{
+   __m128 x2, y2, xy, p, q, swap, den, t, sy, sxy, r0, r1, r, zero;
+   zero = _mm_setzero_ps();
+   x2 = _mm_mul_ps(x, x);
+   y2 = _mm_mul_ps(y, y);
+   xy = _mm_mul_ps(x, y);
+   /* Both branches are the same rational function with x2 and y2
+      swapped, so evaluate it once on the selected pair. */
+   swap = _mm_cmplt_ps(x2, y2);
+   p = _mm_or_ps(_mm_and_ps(swap, y2), _mm_andnot_ps(swap, x2));
+   q = _mm_or_ps(_mm_and_ps(swap, x2), _mm_andnot_ps(swap, y2));
+   den = _mm_mul_ps(_mm_add_ps(p, _mm_mul_ps(_mm_set1_ps(cB), q)),
+         _mm_add_ps(p, _mm_mul_ps(_mm_set1_ps(cC), q)));
+   t = _mm_div_ps(_mm_mul_ps(xy, _mm_add_ps(p, _mm_mul_ps(_mm_set1_ps(cA), q))), den);
+   sy = _mm_or_ps(_mm_set1_ps(cE), _mm_and_ps(_mm_cmplt_ps(y, zero), _mm_set1_ps(-0.f)));
+   sxy = _mm_or_ps(_mm_set1_ps(cE), _mm_and_ps(_mm_cmplt_ps(xy, zero), _mm_set1_ps(-0.f)));
+   r0 = _mm_sub_ps(sy, t);
+   r1 = _mm_sub_ps(_mm_add_ps(t, sy), sxy);
+   r = _mm_or_ps(_mm_and_ps(swap, r0), _mm_andnot_ps(swap, r1));
+   /* For very small values, we don't care about the answer. */
+   return _mm_andnot_ps(_mm_cmplt_ps(_mm_add_ps(x2, y2), _mm_set1_ps(1e-18f)), r);
+}
+
+#undef cA
+#undef cB
+#undef cC
+#undef cE
+
+/* Loads two bins as {r, i, r, i}. */
+static OPUS_INLINE __m128 load_cpx_sse2(const kiss_fft_cpx *x)
+{
+#ifdef FIXED_POINT
+   return _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)(const void*)x));
+#else
+   return _mm_loadu_ps((const float*)x);
+#endif
+}
+
+void tonality_analysis_bins_sse2(const kiss_fft_cpx *out, float *A, float *dA,
+      float *d2A, float *tonality, float *tonality2, float *noisiness,
+      float *binE, int start, int N)
+{
+   int i;
+   const float pi4 = (float)(M_PI*M_PI*M_PI*M_PI);
+   const __m128 scale = _mm_set1_ps((float)(.5f/M_PI));
+   const __m128 k = _mm_set1_ps(40.f*16.f*pi4);
+   const __m128 one = _mm_set1_ps(1.f);
+   const __m128 offset = _mm_set1_ps(.015f);
+   const __m128 sign = _mm_set1_ps(-0.f);
+   for (i=start;i<N/2-3;i+=4)
+   {
+      __m128 v0, v1, re, im, mre, mim;
+      __m128 X1r, X1i, X2r, X2i;
+      __m128 angle, d_angle, d2_angle;
+      __m128 angle2, d_angle2, d2_angle2;
+      __m128 mod1, mod2, avg_mod;
+      /* Bins i...i+3 and N-i...N-i-3, in that order. */
+      v0 = load_cpx_sse2(&out[i]);
+      v1 = load_cpx_sse2(&out[i+2]);
+      re = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0));
+      im = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1));
+      v0 = load_cpx_sse2(&out[N-i-3]);
+      v1 = load_cpx_sse2(&out[N-i-1]);
+      mre = _mm_shuffle_ps(v1, v0, _MM_SHUFFLE(0, 2, 0, 2));
+      mim = _mm_shuffle_ps(v1, v0, _MM_SHUFFLE(1, 3, 1, 3));
+      X1r = _mm_add_ps(re, mre);
+      X1i = _mm_sub_ps(im, mim);
+      X2r = _mm_add_ps(im, mim);
+      X2i = _mm_sub_ps(mre, re);
+
+      angle = _mm_mul_ps(scale, fast_atan2f_sse2(X1i, X1r));
+      d_angle = _mm_sub_ps(angle, _mm_loadu_ps(&A[i]));
+      d2_angle = _mm_sub_ps(d_angle, _mm_loadu_ps(&dA[i]));
+
+      angle2 = _mm_mul_ps(scale, fast_atan2f_sse2(X2i, X2r));
+      d_angle2 = _mm_sub_ps(angle2, angle);
+      d2_angle2 = _mm_sub_ps(d_angle2, d_angle);
+
+      mod1 = _mm_sub_ps(d2_angle, _mm_cvtepi32_ps(_mm_cvtps_epi32(d2_angle)));
+      mod2 = _mm_sub_ps(d2_angle2, _mm_cvtepi32_ps(_mm_cvtps_epi32(d2_angle2)));
+      _mm_storeu_ps(&noisiness[i], _mm_add_ps(_mm_andnot_ps(sign, mod1),
+            _mm_andnot_ps(sign, mod2)));
+      mod1 = _mm_mul_ps(mod1, mod1);
+      mod1 = _mm_mul_ps(mod1, mod1);
+      mod2 = _mm_mul_ps(mod2, mod2);
+      mod2 = _mm_mul_ps(mod2, mod2);
+
+      avg_mod = _mm_mul_ps(_mm_set1_ps(.25f), _mm_add_ps(
+            _mm_add_ps(_mm_loadu_ps(&d2A[i]), mod1), _mm_add_ps(mod2, mod2)));
+      _mm_storeu_ps(&tonality[i], _mm_sub_ps(_mm_div_ps(one,
+            _mm_add_ps(one, _mm_mul_ps(k, avg_mod))), offset));
+      _mm_storeu_ps(&tonality2[i], _mm_sub_ps(_mm_div_ps(one,
+            _mm_add_ps(one, _mm_mul_ps(k, mod2))), offset));
+
+      _mm_storeu_ps(&A[i], angle2);
+      _mm_storeu_ps(&dA[i], d_angle2);
+      _mm_storeu_ps(&d2A[i], mod2);
+
+      _mm_storeu_ps(&binE[i], _mm_add_ps(_mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(re, re), _mm_mul_ps(mre, mre)), _mm_mul_ps(im, im)),
+            _mm_mul_ps(mim, mim)));
+   }
+   tonality_analysis_bins_c(out, A, dA, d2A, tonality, tonality2, noisiness,
+         binE, i, N);
+}
+
+#ifndef FIXED_POINT
+
+static OPUS_INLINE __m128 shift_up_ps(__m128 x, int bytes)
+{
+   return _mm_castsi128_ps(bytes==4 ? _mm_slli_si128(_mm_castps_si128(x), 4)
+         : _mm_slli_si128(_mm_castps_si128(x), 8));
+}
+
+/* States seen by four consecutive inputs u of the all-pass section
+   S' = u + a*(u - S), starting from *S (in all lanes), which is advanced.
+   The recursion is linear, so it is solved with a log-step scan. */
+static OPUS_INLINE __m128 allpass_states_sse2(__m128 u, __m128 *S, float a)
+{
+   __m128 T;
+   const float r = -a;
+   T = _mm_add_ps(u, _mm_mul_ps(_mm_set1_ps(a), u));
+   T = _mm_add_ps(T, _mm_mul_ps(_mm_set1_ps(r), shift_up_ps(T, 4)));
+   T = _mm_add_ps(T, _mm_mul_ps(_mm_set1_ps(r*r), shift_up_ps(T, 8)));
+   T = _mm_add_ps(T, _mm_mul_ps(_mm_setr_ps(r, r*r, r*r*r, r*r*r*r), *S));
+   u = _mm_move_ss(shift_up_ps(T, 4), *S);
+   *S = _mm_shuffle_ps(T, T, _MM_SHUFFLE(3, 3, 3, 3));
+   return u;
+}
+
+opus_val32 silk_resampler_down2_hp_sse2(opus_val32 *S, opus_val32 *out,
+      const opus_val32 *in, int inLen, opus_val32 scale)
+{
+   int k;
+   __m128 S0, S1, S2, acc, sc;
+   const float a0 = QCONST16(0.6074371f, 15);
+   const float a1 = QCONST16(0.15063f, 15);
+   S0 = _mm_set1_ps(S[0]);
+   S1 = _mm_set1_ps(S[1]);
+   S2 = _mm_set1_ps(S[2]);
+   acc = _mm_setzero_ps();
+   sc = _mm_set1_ps(scale);
+   for (k=0;k<inLen/2-3;k+=4)
+   {
+      __m128 x0, x1, e, o, P, X, out32, out32_hp;
+      x0 = _mm_loadu_ps(&in[2*k]);
+      x1 = _mm_loadu_ps(&in[2*k+4]);
+      e = _mm_mul_ps(_mm_shuffle_ps(x0, x1, _MM_SHUFFLE(2, 0, 2, 0)), sc);
+      o = _mm_mul_ps(_mm_shuffle_ps(x0, x1, _MM_SHUFFLE(3, 1, 3, 1)), sc);
+
+      /* All-pass section for even input sample */
+      P = allpass_states_sse2(e, &S0, a0);
+      X = _mm_mul_ps(_mm_set1_ps(a0), _mm_sub_ps(e, P));
+      out32 = _mm_add_ps(P, X);
+      out32_hp = out32;
+
+      /* All-pass section for odd input sample, and add to output of previous section */
+      P = allpass_states_sse2(o, &S1, a1);
+      X = _mm_mul_ps(_mm_set1_ps(a1), _mm_sub_ps(o, P));
+      out32 = _mm_add_ps(_mm_add_ps(out32, P), X);
+
+      o = _mm_xor_ps(o, _mm_set1_ps(-0.f));
+      P = allpass_states_sse2(o, &S2, a1);
+      X = _mm_mul_ps(_mm_set1_ps(a1), _mm_sub_ps(o, P));
+      out32_hp = _mm_add_ps(_mm_add_ps(out32_hp, P), X);
+
+      acc = _mm_add_ps(acc, _mm_mul_ps(out32_hp, out32_hp));
+      _mm_storeu_ps(&out[k], _mm_mul_ps(_mm_set1_ps(.5f), out32));
+   }
+   S[0] = _mm_cvtss_f32(S0);
+   S[1] = _mm_cvtss_f32(S1);
+   S[2] = _mm_cvtss_f32(S2);
+   acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+   acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(1, 1, 1, 1)));
+   return _mm_cvtss_f32(acc) + silk_resampler_down2_hp_c(S, out+k, in+2*k,
+         inLen-2*k, scale);
+}
+
+#endif /* FIXED_POINT */
+
+#endif
@@ -0,0 +1,74 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef DOWNMIX_SSE_H
+#define DOWNMIX_SSE_H
+
+#include "cpu_support.h"
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2)
+void downmix_sum_float_sse2(const float *x, opus_val32 *y, int subframe, int C);
+
+void downmix_sum_int_sse2(const opus_int16 *x, opus_val32 *y, int subframe, int C);
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+void downmix_sum_float_avx2(const float *x, opus_val32 *y, int subframe, int C);
+
+void downmix_sum_int_avx2(const opus_int16 *x, opus_val32 *y, int subframe, int C);
+#endif
+
+#if defined(OPUS_X86_PRESUME_AVX2)
+#define OVERRIDE_DOWNMIX_SUM
+#define downmix_sum_float(x, y, subframe, C, arch) \
+    ((void)(arch), downmix_sum_float_avx2(x, y, subframe, C))
+#define downmix_sum_int(x, y, subframe, C, arch) \
+    ((void)(arch), downmix_sum_int_avx2(x, y, subframe, C))
+
+#elif defined(OPUS_X86_PRESUME_SSE2) && !defined(OPUS_X86_MAY_HAVE_AVX2)
+#define OVERRIDE_DOWNMIX_SUM
+#define downmix_sum_float(x, y, subframe, C, arch) \
+    ((void)(arch), downmix_sum_float_sse2(x, y, subframe, C))
+#define downmix_sum_int(x, y, subframe, C, arch) \
+    ((void)(arch), downmix_sum_int_sse2(x, y, subframe, C))
+
+#else
+#define OVERRIDE_DOWNMIX_SUM
+
+extern void (*const DOWNMIX_SUM_FLOAT_IMPL[OPUS_ARCHMASK + 1])(
+      const float *x, opus_val32 *y, int subframe, int C);
+#define downmix_sum_float(x, y, subframe, C, arch) \
+    ((*DOWNMIX_SUM_FLOAT_IMPL[(arch) & OPUS_ARCHMASK])(x, y, subframe, C))
+
+extern void (*const DOWNMIX_SUM_INT_IMPL[OPUS_ARCHMASK + 1])(
+      const opus_int16 *x, opus_val32 *y, int subframe, int C);
+#define downmix_sum_int(x, y, subframe, C, arch) \
+    ((*DOWNMIX_SUM_INT_IMPL[(arch) & OPUS_ARCHMASK])(x, y, subframe, C))
+
+#endif
+
+#endif
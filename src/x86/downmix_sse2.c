@@ -0,0 +1,133 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#include "opus_types.h"
+#include "opus_defines.h"
+#include "arch.h"
+#include "../opus_private.h"
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2)
+
+#ifndef DISABLE_FLOAT_API
+
+/* PCM2VAL() on four values. */
+static OPUS_INLINE __m128 pcm2val_sse2(__m128 x)
+{
+   x = _mm_mul_ps(x, _mm_set1_ps(CELT_SIG_SCALE));
+#ifdef FIXED_POINT
+   /* Same saturation as FLOAT2INT16(), NaN included. */
+   x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-32768.f)), _mm_set1_ps(32767.f));
+   return _mm_castsi128_ps(_mm_cvtps_epi32(x));
+#else
+   return x;
+#endif
+}
+
+static OPUS_INLINE __m128 add_val32_sse2(__m128 a, __m128 b)
+{
+#ifdef FIXED_POINT
+   return _mm_castsi128_ps(_mm_add_epi32(_mm_castps_si128(a), _mm_castps_si128(b)));
+#else
+   return _mm_add_ps(a, b);
+#endif
+}
+
+void downmix_sum_float_sse2(const float *x, opus_val32 *y, int subframe, int C)
+{
+   int j;
+   if (C==1)
+   {
+      for (j=0;j<subframe-3;j+=4)
+         _mm_storeu_ps((float*)(void*)&y[j], pcm2val_sse2(_mm_loadu_ps(&x[j])));
+   } else if (C==2)
+   {
+      for (j=0;j<subframe-3;j+=4)
+      {
+         __m128 x0, x1;
+         x0 = _mm_loadu_ps(&x[2*j]);
+         x1 = _mm_loadu_ps(&x[2*j+4]);
+         _mm_storeu_ps((float*)(void*)&y[j], add_val32_sse2(
+               pcm2val_sse2(_mm_shuffle_ps(x0, x1, _MM_SHUFFLE(2, 0, 2, 0))),
+               pcm2val_sse2(_mm_shuffle_ps(x0, x1, _MM_SHUFFLE(3, 1, 3, 1)))));
+      }
+   } else {
+      downmix_sum_float_c(x, y, subframe, C);
+      return;
+   }
+   downmix_sum_float_c(x+j*C, y+j, subframe-j, C);
+}
+
+#endif /* DISABLE_FLOAT_API */
+
+void downmix_sum_int_sse2(const opus_int16 *x, opus_val32 *y, int subframe, int C)
+{
+   int j;
+   if (C==1)
+   {
+      for (j=0;j<subframe-7;j+=8)
+      {
+         __m128i v, lo, hi;
+         v = _mm_loadu_si128((const __m128i*)(const void*)&x[j]);
+         lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+         hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+#ifdef FIXED_POINT
+         _mm_storeu_si128((__m128i*)(void*)&y[j], lo);
+         _mm_storeu_si128((__m128i*)(void*)&y[j+4], hi);
+#else
+         _mm_storeu_ps(&y[j], _mm_cvtepi32_ps(lo));
+         _mm_storeu_ps(&y[j+4], _mm_cvtepi32_ps(hi));
+#endif
+      }
+   } else if (C==2)
+   {
+      for (j=0;j<subframe-3;j+=4)
+      {
+         __m128i v, sum;
+         v = _mm_loadu_si128((const __m128i*)(const void*)&x[2*j]);
+         /* The sum of two 16-bit samples is exact in float too. */
+         sum = _mm_add_epi32(_mm_srai_epi32(_mm_slli_epi32(v, 16), 16),
+               _mm_srai_epi32(v, 16));
+#ifdef FIXED_POINT
+         _mm_storeu_si128((__m128i*)(void*)&y[j], sum);
+#else
+         _mm_storeu_ps(&y[j], _mm_cvtepi32_ps(sum));
+#endif
+      }
+   } else {
+      downmix_sum_int_c(x, y, subframe, C);
+      return;
+   }
+   downmix_sum_int_c(x+j*C, y+j, subframe-j, C);
+}
+
+#endif
@@ -0,0 +1,102 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef MAPPING_MATRIX_SSE_H
+#define MAPPING_MATRIX_SSE_H
+
+#include "cpu_support.h"
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2)
+# ifndef DISABLE_FLOAT_API
+void mapping_matrix_multiply_float_sse2(const MappingMatrix *matrix,
+      const float *input, int input_rows, float *output, int output_rows,
+      int frame_size);
+# endif
+
+void mapping_matrix_multiply_short_sse2(const MappingMatrix *matrix,
+      const opus_int16 *input, int input_rows, opus_int16 *output,
+      int output_rows, int frame_size);
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+# ifndef DISABLE_FLOAT_API
+void mapping_matrix_multiply_float_avx2(const MappingMatrix *matrix,
+      const float *input, int input_rows, float *output, int output_rows,
+      int frame_size);
+# endif
+
+void mapping_matrix_multiply_short_avx2(const MappingMatrix *matrix,
+      const opus_int16 *input, int input_rows, opus_int16 *output,
+      int output_rows, int frame_size);
+#endif
+
+#if defined(OPUS_X86_PRESUME_AVX2)
+#define OVERRIDE_MAPPING_MATRIX_MULTIPLY_FLOAT
+#define OVERRIDE_MAPPING_MATRIX_MULTIPLY_SHORT
+#define mapping_matrix_multiply_float(matrix, input, input_rows, output, \
+      output_rows, frame_size, arch) \
+    ((void)(arch), mapping_matrix_multiply_float_avx2(matrix, input, \
+      input_rows, output, output_rows, frame_size))
+#define mapping_matrix_multiply_short(matrix, input, input_rows, output, \
+      output_rows, frame_size, arch) \
+    ((void)(arch), mapping_matrix_multiply_short_avx2(matrix, input, \
+      input_rows, output, output_rows, frame_size))
+
+#elif defined(OPUS_X86_PRESUME_SSE2) && !defined(OPUS_X86_MAY_HAVE_AVX2)
+#define OVERRIDE_MAPPING_MATRIX_MULTIPLY_FLOAT
+#define OVERRIDE_MAPPING_MATRIX_MULTIPLY_SHORT
+#define mapping_matrix_multiply_float(matrix, input, input_rows, output, \
+      output_rows, frame_size, arch) \
+    ((void)(arch), mapping_matrix_multiply_float_sse2(matrix, input, \
+      input_rows, output, output_rows, frame_size))
+#define mapping_matrix_multiply_short(matrix, input, input_rows, output, \
+      output_rows, frame_size, arch) \
+    ((void)(arch), mapping_matrix_multiply_short_sse2(matrix, input, \
+      input_rows, output, output_rows, frame_size))
+
+#else
+#define OVERRIDE_MAPPING_MATRIX_MULTIPLY_FLOAT
+#define OVERRIDE_MAPPING_MATRIX_MULTIPLY_SHORT
+
+extern void (*const MAPPING_MATRIX_MULTIPLY_FLOAT_IMPL[OPUS_ARCHMASK + 1])(
+      const MappingMatrix *matrix, const float *input, int input_rows,
+      float *output, int output_rows, int frame_size);
+#define mapping_matrix_multiply_float(matrix, input, input_rows, output, \
+      output_rows, frame_size, arch) \
+    ((*MAPPING_MATRIX_MULTIPLY_FLOAT_IMPL[(arch) & OPUS_ARCHMASK])(matrix, \
+      input, input_rows, output, output_rows, frame_size))
+
+extern void (*const MAPPING_MATRIX_MULTIPLY_SHORT_IMPL[OPUS_ARCHMASK + 1])(
+      const MappingMatrix *matrix, const opus_int16 *input, int input_rows,
+      opus_int16 *output, int output_rows, int frame_size);
+#define mapping_matrix_multiply_short(matrix, input, input_rows, output, \
+      output_rows, frame_size, arch) \
+    ((*MAPPING_MATRIX_MULTIPLY_SHORT_IMPL[(arch) & OPUS_ARCHMASK])(matrix, \
+      input, input_rows, output, output_rows, frame_size))
+
+#endif
+
+#endif
@@ -0,0 +1,143 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#include "opus_types.h"
+#include "arch.h"
+#include "../mapping_matrix.h"
+
+#if defined(ENABLE_EXPERIMENTAL_AMBISONICS) && defined(OPUS_X86_MAY_HAVE_SSE2)
+
+/* The matrix columns are padded to a multiple of 8 rows, so each sample is
+   computed a whole vector of output rows at a time. Rows past output_rows
+   land in the next sample's slots, which get overwritten when that sample
+   is computed; only the end of the buffer needs a partial store. */
+
+#ifndef DISABLE_FLOAT_API
+void mapping_matrix_multiply_float_sse2(const MappingMatrix *matrix,
+                                        const float *input, int input_rows,
+                                        float *output, int output_rows,
+                                        int frame_size)
+{
+  const float *matrix_data;
+  int i, row, col;
+  int stride;
+  int end;
+
+  celt_assert(input_rows <= matrix->cols && output_rows <= matrix->rows);
+
+  matrix_data = mapping_matrix_get_padded_data_float(matrix);
+  stride = MAPPING_MATRIX_STRIDE(matrix->rows);
+  end = frame_size * output_rows;
+
+  for (i = 0; i < frame_size; i++)
+  {
+    const float *x = &input[i * input_rows];
+    float *y = &output[i * output_rows];
+    for (row = 0; row < output_rows; row += 4)
+    {
+      __m128 sum = _mm_setzero_ps();
+      for (col = 0; col < input_rows; col++)
+      {
+        sum = _mm_add_ps(sum, _mm_mul_ps(
+          _mm_loadu_ps(&matrix_data[col * stride + row]), _mm_set1_ps(x[col])));
+      }
+      if (i * output_rows + row + 4 <= end)
+        _mm_storeu_ps(&y[row], sum);
+      else
+      {
+        int k;
+        float tmp[4];
+        _mm_storeu_ps(tmp, sum);
+        for (k = 0; k < output_rows - row; k++)
+          y[row + k] = tmp[k];
+      }
+    }
+  }
+}
+#endif /* DISABLE_FLOAT_API */
+
+void mapping_matrix_multiply_short_sse2(const MappingMatrix *matrix,
+                                        const opus_int16 *input, int input_rows,
+                                        opus_int16 *output, int output_rows,
+                                        int frame_size)
+{
+  const opus_int16 *matrix_data;
+  int i, row, col;
+  int stride;
+  int end;
+
+  celt_assert(input_rows <= matrix->cols && output_rows <= matrix->rows);
+
+  matrix_data = mapping_matrix_get_padded_data_short(matrix);
+  stride = MAPPING_MATRIX_STRIDE(matrix->rows);
+  end = frame_size * output_rows;
+
+  for (i = 0; i < frame_size; i++)
+  {
+    const opus_int16 *x = &input[i * input_rows];
+    opus_int16 *y = &output[i * output_rows];
+    for (row = 0; row < output_rows; row += 8)
+    {
+      __m128i sum0, sum1, out;
+      sum0 = sum1 = _mm_setzero_si128();
+      for (col = 0; col < input_rows; col++)
+      {
+        __m128i m, xv, lo, hi;
+        m = _mm_loadu_si128((const __m128i *)&matrix_data[col * stride + row]);
+        xv = _mm_set1_epi16(x[col]);
+        /* Full 32-bit products, each shifted before accumulating. */
+        lo = _mm_mullo_epi16(m, xv);
+        hi = _mm_mulhi_epi16(m, xv);
+        sum0 = _mm_add_epi32(sum0, _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 8));
+        sum1 = _mm_add_epi32(sum1, _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 8));
+      }
+      sum0 = _mm_srai_epi32(_mm_add_epi32(sum0, _mm_set1_epi32(64)), 7);
+      sum1 = _mm_srai_epi32(_mm_add_epi32(sum1, _mm_set1_epi32(64)), 7);
+      /* Wrap to 16 bits like the cast in the C code, rather than saturate. */
+      sum0 = _mm_srai_epi32(_mm_slli_epi32(sum0, 16), 16);
+      sum1 = _mm_srai_epi32(_mm_slli_epi32(sum1, 16), 16);
+      out = _mm_packs_epi32(sum0, sum1);
+      if (i * output_rows + row + 8 <= end)
+        _mm_storeu_si128((__m128i *)&y[row], out);
+      else
+      {
+        int k;
+        opus_int16 tmp[8];
+        _mm_storeu_si128((__m128i *)tmp, out);
+        for (k = 0; k < output_rows - row; k++)
+          y[row + k] = tmp[k];
+      }
+    }
+  }
+}
+
+#endif
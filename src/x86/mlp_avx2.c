@@ -0,0 +1,178 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+#include "opus_types.h"
+#include "opus_defines.h"
+#include "arch.h"
+#include "../tansig_table.h"
+#include "../mlp.h"
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+
+/* Same steps as tansig_approx(), eight values at a time. Unlike the SSE2
+   version, the correction term is computed with FMA so the result can
+   differ from the C code in the last bit. */
+static OPUS_INLINE __m256 tansig8(__m256 x)
+{
+   __m256 hi, lo, neg, y, dy, one;
+   __m256i i;
+   one = _mm256_set1_ps(1.f);
+   /* Tests are reversed to catch NaNs */
+   hi = _mm256_cmp_ps(x, _mm256_set1_ps(8.f), _CMP_NLT_UQ);
+   lo = _mm256_cmp_ps(x, _mm256_set1_ps(-8.f), _CMP_NGT_UQ);
+   neg = _mm256_and_ps(_mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ),
+         _mm256_set1_ps(-0.f));
+   /* Work on |x|, with saturated lanes replaced by zero. */
+   x = _mm256_andnot_ps(_mm256_or_ps(hi, lo),
+         _mm256_andnot_ps(_mm256_set1_ps(-0.f), x));
+   i = _mm256_cvttps_epi32(_mm256_fmadd_ps(_mm256_set1_ps(25.f), x,
+         _mm256_set1_ps(.5f)));
+   x = _mm256_fnmadd_ps(_mm256_set1_ps(.04f), _mm256_cvtepi32_ps(i), x);
+   y = _mm256_i32gather_ps(tansig_table, i, 4);
+   dy = _mm256_fnmadd_ps(y, y, one);
+   y = _mm256_fmadd_ps(_mm256_mul_ps(x, dy), _mm256_fnmadd_ps(y, x, one), y);
+   y = _mm256_or_ps(y, neg);
+   y = _mm256_blendv_ps(y, _mm256_set1_ps(-1.f), lo);
+   return _mm256_blendv_ps(y, one, hi);
+}
+
+/* Scales y[] by WEIGHTS_SCALE and applies the activation in place. */
+static void activation_avx2(float *y, int N, int sigmoid)
+{
+   int i;
+   __m256 scale, half;
+   scale = _mm256_set1_ps(WEIGHTS_SCALE);
+   half = _mm256_set1_ps(.5f);
+   for (i=0;i<N;i+=8)
+   {
+      int k;
+      float tmp[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+      __m256 x;
+      for (k=0;k<8 && i+k<N;k++)
+         tmp[k] = y[i+k];
+      x = _mm256_mul_ps(scale, _mm256_loadu_ps(tmp));
+      if (sigmoid)
+         x = _mm256_fmadd_ps(half, tansig8(_mm256_mul_ps(half, x)), half);
+      else
+         x = tansig8(x);
+      _mm256_storeu_ps(tmp, x);
+      for (k=0;k<8 && i+k<N;k++)
+         y[i+k] = tmp[k];
+   }
+}
+
+/* out[i] += sum_j w[j*stride + i]*x[j]*x2[j] for i<N. The weights for one
+   input are contiguous across neurons, so each input updates eight (then
+   four) neurons at once. */
+static void gemv_accum_avx2(float *out, const opus_int16 *w, int stride,
+      int N, const float *x, const float *x2, int M)
+{
+   int i, j;
+   for (i=0;i<N-7;i+=8)
+   {
+      __m256 sum = _mm256_loadu_ps(&out[i]);
+      for (j=0;j<M;j++)
+      {
+         __m256 wj = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(
+               _mm_loadu_si128((const __m128i*)&w[j*stride + i])));
+         __m256 xj = _mm256_set1_ps(x2 ? x[j]*x2[j] : x[j]);
+         sum = _mm256_fmadd_ps(wj, xj, sum);
+      }
+      _mm256_storeu_ps(&out[i], sum);
+   }
+   for (;i<N-3;i+=4)
+   {
+      __m128 sum = _mm_loadu_ps(&out[i]);
+      for (j=0;j<M;j++)
+      {
+         __m128 wj = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(
+               _mm_loadl_epi64((const __m128i*)&w[j*stride + i])));
+         __m128 xj = _mm_set1_ps(x2 ? x[j]*x2[j] : x[j]);
+         sum = _mm_fmadd_ps(wj, xj, sum);
+      }
+      _mm_storeu_ps(&out[i], sum);
+   }
+   for (;i<N;i++)
+   {
+      float sum = out[i];
+      for (j=0;j<M;j++)
+         sum += w[j*stride + i]*(x2 ? x[j]*x2[j] : x[j]);
+      out[i] = sum;
+   }
+}
+
+void compute_dense_avx2(const DenseLayer *layer, float *output, const float *input)
+{
+   int i;
+   int N, M;
+   M = layer->nb_inputs;
+   N = layer->nb_neurons;
+   for (i=0;i<N;i++)
+      output[i] = layer->bias[i];
+   gemv_accum_avx2(output, layer->input_weights, N, N, input, NULL, M);
+   activation_avx2(output, N, layer->sigmoid);
+}
+
+void compute_gru_avx2(const GRULayer *gru, float *state, const float *input)
+{
+   int i;
+   int N, M;
+   int stride;
+   float zr[2*MAX_NEURONS];
+   float h[MAX_NEURONS];
+   M = gru->nb_inputs;
+   N = gru->nb_neurons;
+   stride = 3*N;
+   /* Update and reset gates together, since their weights are adjacent. */
+   for (i=0;i<2*N;i++)
+      zr[i] = gru->bias[i];
+   gemv_accum_avx2(zr, gru->input_weights, stride, 2*N, input, NULL, M);
+   gemv_accum_avx2(zr, gru->recurrent_weights, stride, 2*N, state, NULL, N);
+   activation_avx2(zr, 2*N, 1);
+   /* Output */
+   for (i=0;i<N;i++)
+      h[i] = gru->bias[2*N + i];
+   gemv_accum_avx2(h, &gru->input_weights[2*N], stride, N, input, NULL, M);
+   gemv_accum_avx2(h, &gru->recurrent_weights[2*N], stride, N, state, &zr[N], N);
+   activation_avx2(h, N, 0);
+   for (i=0;i<N-7;i+=8)
+   {
+      __m256 z = _mm256_loadu_ps(&zr[i]);
+      __m256 s = _mm256_loadu_ps(&state[i]);
+      __m256 t = _mm256_loadu_ps(&h[i]);
+      /* z*state + (1-z)*h == h + z*(state - h) */
+      _mm256_storeu_ps(&state[i], _mm256_fmadd_ps(z, _mm256_sub_ps(s, t), t));
+   }
+   for (;i<N;i++)
+      state[i] = zr[i]*state[i] + (1-zr[i])*h[i];
+}
+
+#endif
@@ -0,0 +1,76 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef MLP_SSE_H
+#define MLP_SSE_H
+
+#include "cpu_support.h"
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2)
+void compute_dense_sse2(const DenseLayer *layer, float *output, const float *input);
+
+void compute_gru_sse2(const GRULayer *gru, float *state, const float *input);
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+void compute_dense_avx2(const DenseLayer *layer, float *output, const float *input);
+
+void compute_gru_avx2(const GRULayer *gru, float *state, const float *input);
+#endif
+
+#if defined(OPUS_X86_PRESUME_AVX2)
+#define OVERRIDE_COMPUTE_DENSE
+#define OVERRIDE_COMPUTE_GRU
+#define compute_dense(layer, output, input, arch) \
+    ((void)(arch), compute_dense_avx2(layer, output, input))
+#define compute_gru(gru, state, input, arch) \
+    ((void)(arch), compute_gru_avx2(gru, state, input))
+
+#elif defined(OPUS_X86_PRESUME_SSE2) && !defined(OPUS_X86_MAY_HAVE_AVX2)
+#define OVERRIDE_COMPUTE_DENSE
+#define OVERRIDE_COMPUTE_GRU
+#define compute_dense(layer, output, input, arch) \
+    ((void)(arch), compute_dense_sse2(layer, output, input))
+#define compute_gru(gru, state, input, arch) \
+    ((void)(arch), compute_gru_sse2(gru, state, input))
+
+#else
+#define OVERRIDE_COMPUTE_DENSE
+#define OVERRIDE_COMPUTE_GRU
+
+extern void (*const COMPUTE_DENSE_IMPL[OPUS_ARCHMASK + 1])(
+      const DenseLayer *layer, float *output, const float *input);
+#define compute_dense(layer, output, input, arch) \
+    ((*COMPUTE_DENSE_IMPL[(arch) & OPUS_ARCHMASK])(layer, output, input))
+
+extern void (*const COMPUTE_GRU_IMPL[OPUS_ARCHMASK + 1])(
+      const GRULayer *gru, float *state, const float *input);
+#define compute_gru(gru, state, input, arch) \
+    ((*COMPUTE_GRU_IMPL[(arch) & OPUS_ARCHMASK])(gru, state, input))
+
+#endif
+
+#endif
@@ -0,0 +1,181 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#include "opus_types.h"
+#include "opus_defines.h"
+#include "arch.h"
+#include "../tansig_table.h"
+#include "../mlp.h"
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2)
+
+/* Same steps as tansig_approx(), four values at a time. */
+static OPUS_INLINE __m128 tansig4(__m128 x)
+{
+   __m128 hi, lo, neg, y, dy, one;
+   __m128i i;
+   int idx[4];
+   one = _mm_set1_ps(1.f);
+   /* Tests are reversed to catch NaNs */
+   hi = _mm_cmpnlt_ps(x, _mm_set1_ps(8.f));
+   lo = _mm_cmpngt_ps(x, _mm_set1_ps(-8.f));
+   neg = _mm_and_ps(_mm_cmplt_ps(x, _mm_setzero_ps()), _mm_set1_ps(-0.f));
+   /* Work on |x|, with saturated lanes replaced by zero. */
+   x = _mm_andnot_ps(_mm_or_ps(hi, lo), _mm_andnot_ps(_mm_set1_ps(-0.f), x));
+   i = _mm_cvttps_epi32(_mm_add_ps(_mm_set1_ps(.5f), _mm_mul_ps(_mm_set1_ps(25.f), x)));
+   x = _mm_sub_ps(x, _mm_mul_ps(_mm_set1_ps(.04f), _mm_cvtepi32_ps(i)));
+   _mm_storeu_si128((__m128i*)idx, i);
+   y = _mm_setr_ps(tansig_table[idx[0]], tansig_table[idx[1]],
+         tansig_table[idx[2]], tansig_table[idx[3]]);
+   dy = _mm_sub_ps(one, _mm_mul_ps(y, y));
+   y = _mm_add_ps(y, _mm_mul_ps(_mm_mul_ps(x, dy), _mm_sub_ps(one, _mm_mul_ps(y, x))));
+   y = _mm_or_ps(y, neg);
+   y = _mm_or_ps(_mm_and_ps(lo, _mm_set1_ps(-1.f)), _mm_andnot_ps(lo, y));
+   return _mm_or_ps(_mm_and_ps(hi, one), _mm_andnot_ps(hi, y));
+}
+
+/* Scales y[] by WEIGHTS_SCALE and applies the activation in place. */
+static void activation_sse2(float *y, int N, int sigmoid)
+{
+   int i;
+   __m128 scale, half;
+   scale = _mm_set1_ps(WEIGHTS_SCALE);
+   half = _mm_set1_ps(.5f);
+   for (i=0;i<N;i+=4)
+   {
+      int k;
+      float tmp[4] = {0, 0, 0, 0};
+      __m128 x;
+      for (k=0;k<4 && i+k<N;k++)
+         tmp[k] = y[i+k];
+      x = _mm_mul_ps(scale, _mm_loadu_ps(tmp));
+      if (sigmoid)
+         x = _mm_add_ps(half, _mm_mul_ps(half, tansig4(_mm_mul_ps(half, x))));
+      else
+         x = tansig4(x);
+      _mm_storeu_ps(tmp, x);
+      for (k=0;k<4 && i+k<N;k++)
+         y[i+k] = tmp[k];
+   }
+}
+
+static OPUS_INLINE __m128 load_weights4(const opus_int16 *w)
+{
+   __m128i x = _mm_loadl_epi64((const __m128i*)w);
+   return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16));
+}
+
+/* out[i] += sum_j w[j*stride + i]*x[j]*x2[j] for i<N, in the same order as
+   the C code. The weights for one input are contiguous across neurons, so
+   each input updates four neurons at once. */
+static void gemv_accum_sse2(float *out, const opus_int16 *w, int stride,
+      int N, const float *x, const float *x2, int M)
+{
+   int i, j;
+   for (i=0;i<N-3;i+=4)
+   {
+      __m128 sum = _mm_loadu_ps(&out[i]);
+      if (x2)
+      {
+         for (j=0;j<M;j++)
+         {
+            __m128 t = _mm_mul_ps(load_weights4(&w[j*stride + i]), _mm_set1_ps(x[j]));
+            sum = _mm_add_ps(sum, _mm_mul_ps(t, _mm_set1_ps(x2[j])));
+         }
+      } else {
+         for (j=0;j<M;j++)
+            sum = _mm_add_ps(sum, _mm_mul_ps(load_weights4(&w[j*stride + i]), _mm_set1_ps(x[j])));
+      }
+      _mm_storeu_ps(&out[i], sum);
+   }
+   for (;i<N;i++)
+   {
+      float sum = out[i];
+      if (x2)
+      {
+         for (j=0;j<M;j++)
+            sum += w[j*stride + i]*x[j]*x2[j];
+      } else {
+         for (j=0;j<M;j++)
+            sum += w[j*stride + i]*x[j];
+      }
+      out[i] = sum;
+   }
+}
+
+void compute_dense_sse2(const DenseLayer *layer, float *output, const float *input)
+{
+   int i;
+   int N, M;
+   M = layer->nb_inputs;
+   N = layer->nb_neurons;
+   for (i=0;i<N;i++)
+      output[i] = layer->bias[i];
+   gemv_accum_sse2(output, layer->input_weights, N, N, input, NULL, M);
+   activation_sse2(output, N, layer->sigmoid);
+}
+
+void compute_gru_sse2(const GRULayer *gru, float *state, const float *input)
+{
+   int i;
+   int N, M;
+   int stride;
+   float zr[2*MAX_NEURONS];
+   float h[MAX_NEURONS];
+   __m128 one;
+   M = gru->nb_inputs;
+   N = gru->nb_neurons;
+   stride = 3*N;
+   /* Update and reset gates together, since their weights are adjacent. */
+   for (i=0;i<2*N;i++)
+      zr[i] = gru->bias[i];
+   gemv_accum_sse2(zr, gru->input_weights, stride, 2*N, input, NULL, M);
+   gemv_accum_sse2(zr, gru->recurrent_weights, stride, 2*N, state, NULL, N);
+   activation_sse2(zr, 2*N, 1);
+   /* Output */
+   for (i=0;i<N;i++)
+      h[i] = gru->bias[2*N + i];
+   gemv_accum_sse2(h, &gru->input_weights[2*N], stride, N, input, NULL, M);
+   gemv_accum_sse2(h, &gru->recurrent_weights[2*N], stride, N, state, &zr[N], N);
+   activation_sse2(h, N, 0);
+   one = _mm_set1_ps(1.f);
+   for (i=0;i<N-3;i+=4)
+   {
+      __m128 z = _mm_loadu_ps(&zr[i]);
+      _mm_storeu_ps(&state[i], _mm_add_ps(_mm_mul_ps(z, _mm_loadu_ps(&state[i])),
+            _mm_mul_ps(_mm_sub_ps(one, z), _mm_loadu_ps(&h[i]))));
+   }
+   for (;i<N;i++)
+      state[i] = zr[i]*state[i] + (1-zr[i])*h[i];
+}
+
+#endif
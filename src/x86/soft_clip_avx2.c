@@ -0,0 +1,93 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+#include "opus_types.h"
+#include "opus_defines.h"
+#include "arch.h"
+#include "../opus_private.h"
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(DISABLE_FLOAT_API)
+
+int opus_limit2_checkwithin1_avx2(float *x, int len)
+{
+   int i;
+   __m256 over;
+   const __m256 two = _mm256_set1_ps(2.f);
+   const __m256 one = _mm256_set1_ps(1.f);
+   over = _mm256_setzero_ps();
+   for (i=0;i<len-7;i+=8)
+   {
+      __m256 v;
+      /* Operand order matches MAX16(-2, MIN16(2, x)), NaN included. */
+      v = _mm256_max_ps(_mm256_set1_ps(-2.f),
+            _mm256_min_ps(two, _mm256_loadu_ps(&x[i])));
+      _mm256_storeu_ps(&x[i], v);
+      over = _mm256_or_ps(over, _mm256_or_ps(_mm256_cmp_ps(v, one, _CMP_GT_OQ),
+            _mm256_cmp_ps(v, _mm256_set1_ps(-1.f), _CMP_LT_OQ)));
+   }
+   /* The tail has to be saturated whatever the vector part found. */
+   return opus_limit2_checkwithin1_c(x+i, len-i) && _mm256_movemask_ps(over)==0;
+}
+
+void soft_clip_curve_avx2(float *x, int N, int C, float a)
+{
+   int i;
+   const __m256 a8 = _mm256_set1_ps(a);
+   if (C==1)
+   {
+      for (i=0;i<N-7;i+=8)
+      {
+         __m256 v = _mm256_loadu_ps(&x[i]);
+         _mm256_storeu_ps(&x[i], _mm256_add_ps(v, _mm256_mul_ps(_mm256_mul_ps(a8, v), v)));
+      }
+   } else if (C==2)
+   {
+      /* Four frames per vector with the other channel written back unchanged.
+         The last frame is left to the C code so that the load never reads
+         past the end of the buffer when x points to the second channel. */
+      for (i=0;i<N-4;i+=4)
+      {
+         __m256 v, y;
+         v = _mm256_loadu_ps(&x[2*i]);
+         y = _mm256_add_ps(v, _mm256_mul_ps(_mm256_mul_ps(a8, v), v));
+         _mm256_storeu_ps(&x[2*i], _mm256_blend_ps(v, y, 0x55));
+      }
+   } else {
+      soft_clip_curve_c(x, N, C, a);
+      return;
+   }
+   soft_clip_curve_c(x+i*C, N-i, C, a);
+}
+
+#endif
@@ -0,0 +1,75 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+
+#ifndef SOFT_CLIP_SSE_H
+#define SOFT_CLIP_SSE_H
+
+#include "cpu_support.h"
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2)
+int opus_limit2_checkwithin1_sse2(float *x, int len);
+
+void soft_clip_curve_sse2(float *x, int N, int C, float a);
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+int opus_limit2_checkwithin1_avx2(float *x, int len);
+
+void soft_clip_curve_avx2(float *x, int N, int C, float a);
+#endif
+
+#if defined(OPUS_X86_PRESUME_AVX2)
+#define OVERRIDE_SOFT_CLIP
+#define opus_limit2_checkwithin1(x, len, arch) \
+    ((void)(arch), opus_limit2_checkwithin1_avx2(x, len))
+#define soft_clip_curve(x, N, C, a, arch) \
+    ((void)(arch), soft_clip_curve_avx2(x, N, C, a))
+
+#elif defined(OPUS_X86_PRESUME_SSE2) && !defined(OPUS_X86_MAY_HAVE_AVX2)
+#define OVERRIDE_SOFT_CLIP
+#define opus_limit2_checkwithin1(x, len, arch) \
+    ((void)(arch), opus_limit2_checkwithin1_sse2(x, len))
+#define soft_clip_curve(x, N, C, a, arch) \
+    ((void)(arch), soft_clip_curve_sse2(x, N, C, a))
+
+#else
+#define OVERRIDE_SOFT_CLIP
+
+extern int (*const OPUS_LIMIT2_CHECKWITHIN1_IMPL[OPUS_ARCHMASK + 1])(
+      float *x, int len);
+#define opus_limit2_checkwithin1(x, len, arch) \
+    ((*OPUS_LIMIT2_CHECKWITHIN1_IMPL[(arch) & OPUS_ARCHMASK])(x, len))
+
+extern void (*const SOFT_CLIP_CURVE_IMPL[OPUS_ARCHMASK + 1])(
+      float *x, int N, int C, float a);
+#define soft_clip_curve(x, N, C, a, arch) \
+    ((*SOFT_CLIP_CURVE_IMPL[(arch) & OPUS_ARCHMASK])(x, N, C, a))
+
+#endif
+
+#endif
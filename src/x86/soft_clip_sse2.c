@@ -0,0 +1,95 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#include "opus_types.h"
+#include "opus_defines.h"
+#include "arch.h"
+#include "../opus_private.h"
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2) && !defined(DISABLE_FLOAT_API)
+
+int opus_limit2_checkwithin1_sse2(float *x, int len)
+{
+   int i;
+   __m128 over;
+   const __m128 two = _mm_set1_ps(2.f);
+   const __m128 one = _mm_set1_ps(1.f);
+   over = _mm_setzero_ps();
+   for (i=0;i<len-3;i+=4)
+   {
+      __m128 v;
+      /* Operand order matches MAX16(-2, MIN16(2, x)), NaN included. */
+      v = _mm_max_ps(_mm_set1_ps(-2.f),
+            _mm_min_ps(two, _mm_loadu_ps(&x[i])));
+      _mm_storeu_ps(&x[i], v);
+      over = _mm_or_ps(over, _mm_or_ps(_mm_cmpgt_ps(v, one),
+            _mm_cmplt_ps(v, _mm_set1_ps(-1.f))));
+   }
+   /* The tail has to be saturated whatever the vector part found. */
+   return opus_limit2_checkwithin1_c(x+i, len-i) && _mm_movemask_ps(over)==0;
+}
+
+void soft_clip_curve_sse2(float *x, int N, int C, float a)
+{
+   int i;
+   const __m128 a4 = _mm_set1_ps(a);
+   if (C==1)
+   {
+      for (i=0;i<N-3;i+=4)
+      {
+         __m128 v = _mm_loadu_ps(&x[i]);
+         _mm_storeu_ps(&x[i], _mm_add_ps(v, _mm_mul_ps(_mm_mul_ps(a4, v), v)));
+      }
+   } else if (C==2)
+   {
+      /* Two frames per vector with the other channel written back unchanged.
+         The last frame is left to the C code so that the load never reads
+         past the end of the buffer when x points to the second channel. */
+      const __m128 mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, 0, -1));
+      for (i=0;i<N-2;i+=2)
+      {
+         __m128 v, y;
+         v = _mm_loadu_ps(&x[2*i]);
+         y = _mm_add_ps(v, _mm_mul_ps(_mm_mul_ps(a4, v), v));
+         _mm_storeu_ps(&x[2*i], _mm_or_ps(_mm_and_ps(mask, y), _mm_andnot_ps(mask, v)));
+      }
+   } else {
+      soft_clip_curve_c(x, N, C, a);
+      return;
+   }
+   soft_clip_curve_c(x+i*C, N-i, C, a);
+}
+
+#endif
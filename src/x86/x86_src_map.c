@@ -0,0 +1,207 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "x86/x86cpu.h"
+#include "../mlp.h"
+#include "../analysis.h"
+#include "../mapping_matrix.h"
+#include "../opus_private.h"
+
+#if defined(OPUS_HAVE_RTCD)
+
+#ifndef DISABLE_FLOAT_API
+
+#if (defined(OPUS_X86_MAY_HAVE_SSE2) && !defined(OPUS_X86_PRESUME_SSE2)) || \
+ (defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(OPUS_X86_PRESUME_AVX2))
+
+void (*const COMPUTE_DENSE_IMPL[OPUS_ARCHMASK + 1])(
+      const DenseLayer *layer,
+      float            *output,
+      const float      *input
+) = {
+  compute_dense_c,                /* non-sse */
+  compute_dense_c,
+  MAY_HAVE_SSE2(compute_dense),
+  MAY_HAVE_SSE2(compute_dense),
+  MAY_HAVE_AVX2(compute_dense)    /* avx2    */
+};
+
+void (*const COMPUTE_GRU_IMPL[OPUS_ARCHMASK + 1])(
+      const GRULayer *gru,
+      float          *state,
+      const float    *input
+) = {
+  compute_gru_c,                  /* non-sse */
+  compute_gru_c,
+  MAY_HAVE_SSE2(compute_gru),
+  MAY_HAVE_SSE2(compute_gru),
+  MAY_HAVE_AVX2(compute_gru)      /* avx2    */
+};
+
+void (*const TONALITY_ANALYSIS_BINS_IMPL[OPUS_ARCHMASK + 1])(
+      const kiss_fft_cpx *out,
+      float              *A,
+      float              *dA,
+      float              *d2A,
+      float              *tonality,
+      float              *tonality2,
+      float              *noisiness,
+      float              *binE,
+      int                 start,
+      int                 N
+) = {
+  tonality_analysis_bins_c,                /* non-sse */
+  tonality_analysis_bins_c,
+  MAY_HAVE_SSE2(tonality_analysis_bins),
+  MAY_HAVE_SSE2(tonality_analysis_bins),
+  MAY_HAVE_AVX2(tonality_analysis_bins)    /* avx2    */
+};
+
+# ifndef FIXED_POINT
+opus_val32 (*const SILK_RESAMPLER_DOWN2_HP_IMPL[OPUS_ARCHMASK + 1])(
+      opus_val32       *S,
+      opus_val32       *out,
+      const opus_val32 *in,
+      int               inLen,
+      opus_val32        scale
+) = {
+  silk_resampler_down2_hp_c,                /* non-sse */
+  silk_resampler_down2_hp_c,
+  MAY_HAVE_SSE2(silk_resampler_down2_hp),
+  MAY_HAVE_SSE2(silk_resampler_down2_hp),
+  MAY_HAVE_AVX2(silk_resampler_down2_hp)    /* avx2    */
+};
+# endif
+
+#endif
+
+#endif /* DISABLE_FLOAT_API */
+
+#if (defined(OPUS_X86_MAY_HAVE_SSE2) && !defined(OPUS_X86_PRESUME_SSE2)) || \
+ (defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(OPUS_X86_PRESUME_AVX2))
+
+#ifndef DISABLE_FLOAT_API
+void (*const DOWNMIX_SUM_FLOAT_IMPL[OPUS_ARCHMASK + 1])(
+      const float *x,
+      opus_val32  *y,
+      int          subframe,
+      int          C
+) = {
+  downmix_sum_float_c,                /* non-sse */
+  downmix_sum_float_c,
+  MAY_HAVE_SSE2(downmix_sum_float),
+  MAY_HAVE_SSE2(downmix_sum_float),
+  MAY_HAVE_AVX2(downmix_sum_float)    /* avx2    */
+};
+#endif
+
+void (*const DOWNMIX_SUM_INT_IMPL[OPUS_ARCHMASK + 1])(
+      const opus_int16 *x,
+      opus_val32       *y,
+      int               subframe,
+      int               C
+) = {
+  downmix_sum_int_c,                /* non-sse */
+  downmix_sum_int_c,
+  MAY_HAVE_SSE2(downmix_sum_int),
+  MAY_HAVE_SSE2(downmix_sum_int),
+  MAY_HAVE_AVX2(downmix_sum_int)    /* avx2    */
+};
+
+#ifndef DISABLE_FLOAT_API
+int (*const OPUS_LIMIT2_CHECKWITHIN1_IMPL[OPUS_ARCHMASK + 1])(
+      float *x,
+      int    len
+) = {
+  opus_limit2_checkwithin1_c,                /* non-sse */
+  opus_limit2_checkwithin1_c,
+  MAY_HAVE_SSE2(opus_limit2_checkwithin1),
+  MAY_HAVE_SSE2(opus_limit2_checkwithin1),
+  MAY_HAVE_AVX2(opus_limit2_checkwithin1)    /* avx2    */
+};
+
+void (*const SOFT_CLIP_CURVE_IMPL[OPUS_ARCHMASK + 1])(
+      float *x,
+      int    N,
+      int    C,
+      float  a
+) = {
+  soft_clip_curve_c,                /* non-sse */
+  soft_clip_curve_c,
+  MAY_HAVE_SSE2(soft_clip_curve),
+  MAY_HAVE_SSE2(soft_clip_curve),
+  MAY_HAVE_AVX2(soft_clip_curve)    /* avx2    */
+};
+#endif
+
+#endif
+
+#ifdef ENABLE_EXPERIMENTAL_AMBISONICS
+
+#if (defined(OPUS_X86_MAY_HAVE_SSE2) && !defined(OPUS_X86_PRESUME_SSE2)) || \
+ (defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(OPUS_X86_PRESUME_AVX2))
+
+#ifndef DISABLE_FLOAT_API
+void (*const MAPPING_MATRIX_MULTIPLY_FLOAT_IMPL[OPUS_ARCHMASK + 1])(
+      const MappingMatrix *matrix,
+      const float         *input,
+      int                  input_rows,
+      float               *output,
+      int                  output_rows,
+      int                  frame_size
+) = {
+  mapping_matrix_multiply_float_c,                /* non-sse */
+  mapping_matrix_multiply_float_c,
+  MAY_HAVE_SSE2(mapping_matrix_multiply_float),
+  MAY_HAVE_SSE2(mapping_matrix_multiply_float),
+  MAY_HAVE_AVX2(mapping_matrix_multiply_float)    /* avx2    */
+};
+#endif
+
+void (*const MAPPING_MATRIX_MULTIPLY_SHORT_IMPL[OPUS_ARCHMASK + 1])(
+      const MappingMatrix *matrix,
+      const opus_int16    *input,
+      int                  input_rows,
+      opus_int16          *output,
+      int                  output_rows,
+      int                  frame_size
+) = {
+  mapping_matrix_multiply_short_c,                /* non-sse */
+  mapping_matrix_multiply_short_c,
+  MAY_HAVE_SSE2(mapping_matrix_multiply_short),
+  MAY_HAVE_SSE2(mapping_matrix_multiply_short),
+  MAY_HAVE_AVX2(mapping_matrix_multiply_short)    /* avx2    */
+};
+
+#endif
+
+#endif /* ENABLE_EXPERIMENTAL_AMBISONICS */
+
+#endif /* OPUS_HAVE_RTCD */
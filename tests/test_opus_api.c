@@ -1750,6 +1750,187 @@ int test_repacketizer_api(void)
    return cfgs;
 }
 
+int test_scratch_arena_api(void)
+{
+   OpusEncoder *enc;
+   OpusDecoder *dec;
+   opus_int16 pcm[960*2];
+   unsigned char packet[1276];
+   char *arena;
+   opus_int32 size;
+   int err,len,cfgs;
+   cfgs=0;
+   fprintf(stdout,"\n  Scratch arena tests\n");
+   fprintf(stdout,"  ---------------------------------------------------\n");
+
+   size=opus_scratch_arena_get_size();
+   cfgs++;
+   if(size==0)
+   {
+      if(opus_scratch_arena_init(NULL,0)!=OPUS_UNIMPLEMENTED)test_failed();
+      opus_scratch_arena_release();
+      cfgs+=2;
+      fprintf(stdout,"    Not a scratch arena build .................... OK.\n");
+      return cfgs;
+   }
+
+   if(opus_scratch_arena_init(NULL,size-1)!=OPUS_BAD_ARG)test_failed();
+   cfgs++;
+   arena=malloc(size);
+   if(arena==NULL)test_failed();
+   if(opus_scratch_arena_init(arena,size)!=OPUS_OK)test_failed();
+   cfgs++;
+   enc=opus_encoder_create(48000,2,OPUS_APPLICATION_AUDIO,&err);
+   if(err!=OPUS_OK||enc==NULL)test_failed();
+   dec=opus_decoder_create(48000,2,&err);
+   if(err!=OPUS_OK||dec==NULL)test_failed();
+   cfgs+=2;
+   memset(pcm,0,sizeof(pcm));
+   len=opus_encode(enc,pcm,960,packet,sizeof(packet));
+   if(len<=0)test_failed();
+   if(opus_decode(dec,packet,len,pcm,960,0)!=960)test_failed();
+   cfgs+=2;
+   opus_scratch_arena_release();
+   free(arena);
+   cfgs++;
+   fprintf(stdout,"    Caller-supplied arena ........................ OK.\n");
+
+   if(opus_scratch_arena_init(NULL,size)!=OPUS_OK)test_failed();
+   len=opus_encode(enc,pcm,960,packet,sizeof(packet));
+   if(len<=0)test_failed();
+   if(opus_decode(dec,packet,len,pcm,960,0)!=960)test_failed();
+   opus_scratch_arena_release();
+   opus_scratch_arena_release();
+   cfgs+=5;
+   fprintf(stdout,"    Library-allocated arena ...................... OK.\n");
+   opus_encoder_destroy(enc);
+   opus_decoder_destroy(dec);
+   fprintf(stdout,"                       All scratch arena tests passed\n");
+   fprintf(stdout,"                            (%7d API invocations)\n",cfgs);
+
+   return cfgs;
+}
+
+static int alloc_count;
+static int alloc_fail;
+
+static void *counting_alloc(void *user_data, size_t size)
+{
+   if(user_data!=&alloc_count)test_failed();
+   if(alloc_fail)return NULL;
+   alloc_count++;
+   return malloc(size);
+}
+
+static void counting_free(void *user_data, void *ptr)
+{
+   if(user_data!=&alloc_count)test_failed();
+   if(ptr==NULL)test_failed();
+   alloc_count--;
+   free(ptr);
+}
+
+int test_allocator_api(void)
+{
+   OpusDecoder *dec;
+   OpusEncoder *enc;
+   OpusRepacketizer *rp;
+   OpusMSDecoder *msdec;
+   OpusMSEncoder *msenc;
+   unsigned char mapping[256] = {0,1};
+   int err,cfgs;
+   cfgs=0;
+   fprintf(stdout,"\n  Custom allocator tests\n");
+   fprintf(stdout,"  ---------------------------------------------------\n");
+
+   if(opus_set_allocator(counting_alloc,NULL,&alloc_count)!=OPUS_BAD_ARG)test_failed();
+   cfgs++;
+   if(opus_set_allocator(NULL,counting_free,&alloc_count)!=OPUS_BAD_ARG)test_failed();
+   cfgs++;
+   fprintf(stdout,"    opus_set_allocator() bad args ................ OK.\n");
+
+   alloc_count=0;
+   alloc_fail=0;
+   /* Scratch arenas are released through the allocator, so drop this
+      thread's before installing one */
+   opus_scratch_arena_release();
+   if(opus_set_allocator(counting_alloc,counting_free,&alloc_count)!=OPUS_OK)test_failed();
+   cfgs++;
+   dec=opus_decoder_create(48000,2,&err);
+   if(err!=OPUS_OK||dec==NULL)test_failed();
+   cfgs++;
+   enc=opus_encoder_create(48000,2,OPUS_APPLICATION_AUDIO,&err);
+   if(err!=OPUS_OK||enc==NULL)test_failed();
+   cfgs++;
+   msdec=opus_multistream_decoder_create(48000,2,1,1,mapping,&err);
+   if(err!=OPUS_OK||msdec==NULL)test_failed();
+   cfgs++;
+   msenc=opus_multistream_encoder_create(48000,2,1,1,mapping,OPUS_APPLICATION_AUDIO,&err);
+   if(err!=OPUS_OK||msenc==NULL)test_failed();
+   cfgs++;
+   rp=opus_repacketizer_create();
+   if(rp==NULL)test_failed();
+   cfgs++;
+   if(alloc_count<5)test_failed();
+   opus_decoder_destroy(dec);
+   opus_encoder_destroy(enc);
+   opus_multistream_decoder_destroy(msdec);
+   opus_multistream_encoder_destroy(msenc);
+   opus_repacketizer_destroy(rp);
+   if(alloc_count!=0)test_failed();
+   cfgs+=5;
+   fprintf(stdout,"    *_create()/*_destroy() via allocator ......... OK.\n");
+
+   alloc_fail=1;
+   dec=opus_decoder_create(48000,2,&err);
+   if(dec!=NULL||err!=OPUS_ALLOC_FAIL)test_failed();
+   cfgs++;
+   enc=opus_encoder_create(48000,2,OPUS_APPLICATION_AUDIO,&err);
+   if(enc!=NULL||err!=OPUS_ALLOC_FAIL)test_failed();
+   cfgs++;
+   if(opus_repacketizer_create()!=NULL)test_failed();
+   cfgs++;
+   alloc_fail=0;
+   fprintf(stdout,"    allocator failure ............................ OK.\n");
+
+   if(opus_scratch_arena_get_size()>0)
+   {
+      /* A thread whose scratch arena cannot be allocated gets an error */
+      opus_int16 pcm[960*2];
+      unsigned char packet[1276];
+      dec=opus_decoder_create(48000,2,&err);
+      if(err!=OPUS_OK||dec==NULL)test_failed();
+      enc=opus_encoder_create(48000,2,OPUS_APPLICATION_AUDIO,&err);
+      if(err!=OPUS_OK||enc==NULL)test_failed();
+      memset(pcm,0,sizeof(pcm));
+      alloc_fail=1;
+      if(opus_decode(dec,NULL,0,pcm,960,0)!=OPUS_ALLOC_FAIL)test_failed();
+      if(opus_encode(enc,pcm,960,packet,1276)!=OPUS_ALLOC_FAIL)test_failed();
+      alloc_fail=0;
+      if(opus_decode(dec,NULL,0,pcm,960,0)!=960)test_failed();
+      if(opus_encode(enc,pcm,960,packet,1276)<=0)test_failed();
+      opus_scratch_arena_release();
+      opus_encoder_destroy(enc);
+      opus_decoder_destroy(dec);
+      if(alloc_count!=0)test_failed();
+      cfgs+=8;
+      fprintf(stdout,"    scratch arena allocation failure ............. OK.\n");
+   }
+
+   if(opus_set_allocator(NULL,NULL,NULL)!=OPUS_OK)test_failed();
+   cfgs++;
+   dec=opus_decoder_create(48000,2,&err);
+   if(err!=OPUS_OK||dec==NULL)test_failed();
+   opus_decoder_destroy(dec);
+   cfgs+=2;
+   if(alloc_count!=0)test_failed();
+   fprintf(stdout,"    opus_set_allocator() restore default ......... OK.\n");
+   fprintf(stdout,"                    All custom allocator tests passed\n");
+   fprintf(stdout,"                            (%7d API invocations)\n",cfgs);
+
+   return cfgs;
+}
+
 #ifdef MALLOC_FAIL
 /* GLIBC 2.14 declares __malloc_hook as deprecated, generating a warning
  * under GCC. However, this is the cleanest way to test malloc failure
@@ -1898,6 +2079,8 @@ int main(int _argc, char **_argv)
    total+=test_parse();
    total+=test_enc_api();
    total+=test_repacketizer_api();
+   total+=test_scratch_arena_api();
+   total+=test_allocator_api();
    total+=test_malloc_fail();
 
    fprintf(stderr,"\nAll API tests passed.\nThe libopus API was invoked %d times.\n",total);
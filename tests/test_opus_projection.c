@@ -39,8 +39,8 @@
 #include "test_opus_common.h"
 #include "opus_projection.h"
 #include "mathops.h"
-#include "../src/mapping_matrix.c"
-#include "mathops.c"
+#include "cpu_support.h"
+#include "../src/mapping_matrix.h"
 
 #ifdef ENABLE_EXPERIMENTAL_AMBISONICS
 
@@ -141,6 +141,8 @@ void test_matrix_transform(void)
     -19661, 13107, 0, -13107, -22938, 9830, 0, -9830, -26214, 6554, 0, -6554,
     -29491, 3277, 0, -3277};
   opus_int16 output[40] = {0};
+  opus_int16 output_arch[40] = {0};
+  int arch = opus_select_arch();
 
 #ifndef DISABLE_FLOAT_API
   int i;
@@ -148,6 +150,7 @@ void test_matrix_transform(void)
   float flt_tolerance = 2e-5f;
   float input32[30] = {0};
   float output32[40] = {0};
+  float output32_arch[40] = {0};
   float expected_output32[40] = {0};
 
   /* Convert short to float representations. */
@@ -167,9 +170,12 @@ void test_matrix_transform(void)
   mapping_matrix_init(testing_matrix, 4, 3, 0, testing_matrix_data,
     12 * sizeof(opus_int16));
 
-  mapping_matrix_multiply_short(testing_matrix, input, testing_matrix->cols,
+  mapping_matrix_multiply_short_c(testing_matrix, input, testing_matrix->cols,
     output, testing_matrix->rows, frame_size);
-  if (!assert_transform_short(output, expected_output, 40, 1))
+  mapping_matrix_multiply_short(testing_matrix, input, testing_matrix->cols,
+    output_arch, testing_matrix->rows, frame_size, arch);
+  if (!assert_transform_short(output, expected_output, 40, 1) ||
+      !assert_transform_short(output_arch, output, 40, 0))
   {
     fprintf(stderr, "Matrix:\n");
     print_matrix(testing_matrix);
@@ -183,13 +189,19 @@ void test_matrix_transform(void)
     fprintf(stderr, "Output (short):\n");
     print_matrix_short(output, testing_matrix->rows, frame_size);
 
+    fprintf(stderr, "Output (short, arch %d):\n", arch);
+    print_matrix_short(output_arch, testing_matrix->rows, frame_size);
+
     goto bad_cleanup;
   }
 
 #ifndef DISABLE_FLOAT_API
-  mapping_matrix_multiply_float(testing_matrix, input32, testing_matrix->cols,
+  mapping_matrix_multiply_float_c(testing_matrix, input32, testing_matrix->cols,
     output32, testing_matrix->rows, frame_size);
-  if (!assert_transform_float(output32, expected_output32, 40, flt_tolerance))
+  mapping_matrix_multiply_float(testing_matrix, input32, testing_matrix->cols,
+    output32_arch, testing_matrix->rows, frame_size, arch);
+  if (!assert_transform_float(output32, expected_output32, 40, flt_tolerance) ||
+      !assert_transform_float(output32_arch, output32, 40, flt_tolerance))
   {
     fprintf(stderr, "Matrix:\n");
     print_matrix(testing_matrix);
@@ -203,6 +215,9 @@ void test_matrix_transform(void)
     fprintf(stderr, "Output (float):\n");
     print_matrix_float(output32, testing_matrix->rows, frame_size);
 
+    fprintf(stderr, "Output (float, arch %d):\n", arch);
+    print_matrix_float(output32_arch, testing_matrix->rows, frame_size);
+
     goto bad_cleanup;
   }
 #endif
@@ -213,6 +228,87 @@ bad_cleanup:
   test_failed();
 }
 
+/* Checks the optimized multiplies against the C ones on a matrix wide
+   enough to fill whole vectors of output rows and leave a partial one. */
+void test_matrix_transform_arch(int rows, int cols, int frame_size)
+{
+  opus_int32 matrix_size;
+  MappingMatrix *testing_matrix;
+  opus_int16 *matrix_data;
+  opus_int16 *input;
+  opus_int16 *output;
+  opus_int16 *output_arch;
+#ifndef DISABLE_FLOAT_API
+  float *input32;
+  float *output32;
+  float *output32_arch;
+#endif
+  opus_uint32 seed = 42;
+  int arch = opus_select_arch();
+  int i;
+
+  matrix_data = (opus_int16 *)malloc(rows * cols * sizeof(opus_int16));
+  input = (opus_int16 *)malloc(cols * frame_size * sizeof(opus_int16));
+  output = (opus_int16 *)malloc(rows * frame_size * sizeof(opus_int16));
+  output_arch = (opus_int16 *)malloc(rows * frame_size * sizeof(opus_int16));
+  for (i = 0; i < rows * cols; i++)
+  {
+    seed = seed * 1664525 + 1013904223;
+    matrix_data[i] = (opus_int16)(seed >> 16);
+  }
+  for (i = 0; i < cols * frame_size; i++)
+  {
+    seed = seed * 1664525 + 1013904223;
+    input[i] = (opus_int16)(seed >> 16);
+  }
+
+  matrix_size = mapping_matrix_get_size(rows, cols);
+  testing_matrix = (MappingMatrix *)malloc(matrix_size);
+  mapping_matrix_init(testing_matrix, rows, cols, 0, matrix_data,
+    rows * cols * sizeof(opus_int16));
+
+  mapping_matrix_multiply_short_c(testing_matrix, input, cols, output, rows,
+    frame_size);
+  mapping_matrix_multiply_short(testing_matrix, input, cols, output_arch, rows,
+    frame_size, arch);
+  if (!assert_transform_short(output_arch, output, rows * frame_size, 0))
+  {
+    fprintf(stderr, "%d x %d short multiply differs from C for arch %d\n",
+      rows, cols, arch);
+    test_failed();
+  }
+
+#ifndef DISABLE_FLOAT_API
+  input32 = (float *)malloc(cols * frame_size * sizeof(float));
+  output32 = (float *)malloc(rows * frame_size * sizeof(float));
+  output32_arch = (float *)malloc(rows * frame_size * sizeof(float));
+  for (i = 0; i < cols * frame_size; i++)
+  {
+    input32[i] = INT16_TO_FLOAT(input[i]);
+  }
+  mapping_matrix_multiply_float_c(testing_matrix, input32, cols, output32,
+    rows, frame_size);
+  mapping_matrix_multiply_float(testing_matrix, input32, cols, output32_arch,
+    rows, frame_size, arch);
+  if (!assert_transform_float(output32_arch, output32, rows * frame_size,
+      1e-5f))
+  {
+    fprintf(stderr, "%d x %d float multiply differs from C for arch %d\n",
+      rows, cols, arch);
+    test_failed();
+  }
+  free(input32);
+  free(output32);
+  free(output32_arch);
+#endif
+
+  free(testing_matrix);
+  free(matrix_data);
+  free(input);
+  free(output);
+  free(output_arch);
+}
+
 void test_creation_arguments(const int channels, const int mapping_family)
 {
   int streams;
@@ -405,6 +501,8 @@ int main(int _argc, char **_argv)
 
   /* Test matrix creation/multiplication. */
   test_matrix_transform();
+  test_matrix_transform_arch(18, 18, 960);
+  test_matrix_transform_arch(11, 11, 120);
 
   /* Test full range of channels in creation arguments. */
   for (i = 0; i < 255; i++)
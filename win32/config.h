@@ -40,6 +40,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #define OPUS_X86_MAY_HAVE_SSE
 #define OPUS_X86_MAY_HAVE_SSE2
 #define OPUS_X86_MAY_HAVE_SSE4_1
+#define OPUS_X86_MAY_HAVE_AVX2
 
 /* Presume SSE functions, if compiled to use SSE/SSE2/AVX (note that AMD64 implies SSE2, and AVX
    implies SSE4.1) */
@@ -52,8 +53,11 @@ POSSIBILITY OF SUCH DAMAGE.
 #if defined(__AVX__)
 #define OPUS_X86_PRESUME_SSE4_1 1
 #endif
+#if defined(__AVX2__)
+#define OPUS_X86_PRESUME_AVX2 1
+#endif
 
-#if !defined(OPUS_X86_PRESUME_SSE4_1) || !defined(OPUS_X86_PRESUME_SSE2) || !defined(OPUS_X86_PRESUME_SSE)
+#if !defined(OPUS_X86_PRESUME_AVX2) || !defined(OPUS_X86_PRESUME_SSE4_1) || !defined(OPUS_X86_PRESUME_SSE2) || !defined(OPUS_X86_PRESUME_SSE)
 #define OPUS_HAVE_RTCD 1
 #endif
 